@@ -347,6 +347,52 @@ static int ns16550_read_task(rtems_termios_device_context *base)
   return -1;
 }
 
+static size_t ns16550_read_fifo(
+  ns16550_context *ctx,
+  char            *buf,
+  size_t           len
+)
+{
+  uintptr_t port = ctx->port;
+  ns16550_get_reg get = ctx->get_reg;
+  size_t n = 0;
+
+  while (n < len && (get(port, NS16550_LINE_STATUS) & SP_LSR_RDY) != 0) {
+    buf[n] = (char) get(port, NS16550_RECEIVE_BUFFER);
+    ++n;
+  }
+
+  return n;
+}
+
+static size_t ns16550_read_task_block(
+  rtems_termios_device_context *base,
+  char                         *buf,
+  size_t                        len
+)
+{
+  ns16550_context *ctx = (ns16550_context *) base;
+  size_t n;
+
+  n = ns16550_read_fifo(ctx, buf, len);
+
+  /* If the buffer is full, then Termios calls again for the remaining ones */
+  if (n < len) {
+    ns16550_clear_and_set_interrupts(ctx, 0, SP_INT_RX_ENABLE);
+  }
+
+  return n;
+}
+
+static size_t ns16550_polled_read_block(
+  rtems_termios_device_context *base,
+  char                         *buf,
+  size_t                        len
+)
+{
+  return ns16550_read_fifo((ns16550_context *) base, buf, len);
+}
+
 /*
  *  ns16550_initialize_interrupts
  *
@@ -856,7 +902,8 @@ const rtems_termios_device_handler ns16550_handler_polled = {
   .poll_read = ns16550_polled_getchar,
   .write = ns16550_write_support_polled,
   .set_attributes = ns16550_set_attributes,
-  .mode = TERMIOS_POLLED
+  .mode = TERMIOS_POLLED,
+  .poll_read_block = ns16550_polled_read_block
 };
 
 const rtems_termios_device_handler ns16550_handler_task = {
@@ -865,5 +912,6 @@ const rtems_termios_device_handler ns16550_handler_task = {
   .poll_read = ns16550_read_task,
   .write = ns16550_write_support_task,
   .set_attributes = ns16550_set_attributes,
-  .mode = TERMIOS_TASK_DRIVEN
+  .mode = TERMIOS_TASK_DRIVEN,
+  .poll_read_block = ns16550_read_task_block
 };
@@ -0,0 +1,9 @@
+AC_DEFUN([RTEMS_ENABLE_SMP_LOCK_MCS],
+  [AC_ARG_ENABLE(smp-lock-mcs,
+    [AS_HELP_STRING([--enable-smp-lock-mcs],[use MCS locks for the SMP locks and thread queue locks (default=no)])],
+    [case "${enableval}" in 
+      yes) RTEMS_HAS_SMP_LOCK_MCS=yes ;;
+      no) RTEMS_HAS_SMP_LOCK_MCS=no ;;
+      *) AC_MSG_ERROR(bad value ${enableval} for enable smp-lock-mcs option) ;;
+    esac],
+    [RTEMS_HAS_SMP_LOCK_MCS=no])])
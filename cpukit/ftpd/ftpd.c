@@ -247,6 +247,34 @@ static struct rtems_ftpd_configuration *ftpd_config;
 /* this is not prototyped in strict ansi mode */
 FILE *fdopen (int fildes, const char *mode);
 
+/*
+ * Transfer structure.
+ *
+ * Binary transfers overlap the file system and the network I/O.  The transfer
+ * task of a session reads the file for RETR or writes it for STOR, while the
+ * session task sends or receives the data.  Both tasks pass the data through
+ * a ring of buffers.  A buffer length of zero marks the end of the data, a
+ * negative length an error.
+ */
+typedef struct
+{
+  rtems_mutex              mutex;
+  rtems_condition_variable cond;
+  rtems_id                 tid;     /* Transfer task id or 0 if none */
+  int                      fd;      /* File read or written by the task */
+  bool                     store;   /* true - STOR, false - RETR */
+  bool                     busy;    /* Task works on a transfer */
+  bool                     abort;   /* Consumer stopped the transfer */
+  bool                     failed;  /* Task could not write the file */
+  int                      count;   /* Count of buffers */
+  size_t                   size;    /* Size of a buffer */
+  int                      *len;    /* Data length of each buffer */
+  char                     *data;   /* Buffer space */
+  int                      head;    /* Next buffer to fill */
+  int                      tail;    /* Next buffer to drain */
+  int                      filled;  /* Count of filled buffers */
+} FTPD_Transfer_t;
+
 /*SessionInfo structure.
  *
  * The following structure is allocated for each session.
@@ -267,6 +295,7 @@ typedef struct
   char                *user;       /* user name (0 if not supplied) */
   char                user_buf[256]; /* user name buffer */
   bool                auth;        /* true if user/pass was valid, false if not or not supplied */
+  FTPD_Transfer_t     xfer;        /* Binary transfer engine */
 } FTPD_SessionInfo_t;
 
 
@@ -305,6 +334,12 @@ static int ftpd_timeout = 0;
  */
 static int ftpd_access = 0;
 
+/*
+ * Size and count of binary transfer buffers.
+ */
+static size_t ftpd_transfer_size = FTPD_DATASIZE;
+static int ftpd_transfer_buffers = FTPD_TRANSFER_BUFFERS;
+
 static void
 yield(void)
 {
@@ -372,7 +407,15 @@ task_pool_done(int count)
 {
   int i;
   for(i = 0; i < count; ++i)
-    rtems_task_delete(task_pool.info[i].tid);
+  {
+    FTPD_Transfer_t *xfer = &task_pool.info[i].xfer;
+    if (task_pool.info[i].tid != 0)
+      rtems_task_delete(task_pool.info[i].tid);
+    if (xfer->tid != 0)
+      rtems_task_delete(xfer->tid);
+    rtems_mutex_destroy(&xfer->mutex);
+    rtems_condition_variable_destroy(&xfer->cond);
+  }
   free(task_pool.info);
   free(task_pool.queue);
   rtems_mutex_destroy(&task_pool.mutex);
@@ -396,6 +439,59 @@ task_pool_done(int count)
  *
  */
 static void session(rtems_task_argument arg); /* Forward declare */
+static void transfer_task(rtems_task_argument arg); /* Forward declare */
+
+/*
+ * transfer_task_init
+ *
+ * Create and start the transfer task of a session.  Without a transfer task
+ * the session transfers the data itself.
+ *
+ * Input parameters:
+ *   info     - corresponding SessionInfo structure
+ *   id       - last character of the task name
+ *   priority - priority the task is started with
+ *
+ * Output parameters:
+ *   NONE
+ *
+ */
+static void
+transfer_task_init(FTPD_SessionInfo_t *info, char id,
+  rtems_task_priority priority)
+{
+  FTPD_Transfer_t *xfer = &info->xfer;
+  rtems_status_code sc;
+
+  rtems_mutex_init(&xfer->mutex, "FTPD");
+  rtems_condition_variable_init(&xfer->cond, "FTPD");
+  xfer->tid = 0;
+
+  if (ftpd_transfer_buffers < 2)
+    return;
+
+  sc = rtems_task_create(rtems_build_name('F', 'T', 'X', id),
+    priority, FTPD_STACKSIZE,
+    RTEMS_PREEMPT | RTEMS_NO_TIMESLICE |
+    RTEMS_NO_ASR | RTEMS_INTERRUPT_LEVEL(0),
+    RTEMS_FLOATING_POINT | RTEMS_LOCAL,
+    &xfer->tid);
+  if (sc == RTEMS_SUCCESSFUL)
+  {
+    sc = rtems_task_start(
+      xfer->tid, transfer_task, (rtems_task_argument)info);
+    if (sc != RTEMS_SUCCESSFUL)
+    {
+      rtems_task_delete(xfer->tid);
+      xfer->tid = 0;
+    }
+  }
+  else
+    xfer->tid = 0;
+  if (sc != RTEMS_SUCCESSFUL)
+    syslog(LOG_WARNING, "ftpd: Could not create/start transfer task: %s",
+      rtems_status_text(sc));
+}
 
 static int
 task_pool_init(int count, rtems_task_priority priority)
@@ -411,7 +507,7 @@ task_pool_init(int count, rtems_task_priority priority)
   rtems_counting_semaphore_init(&task_pool.sem, "FTPD", (unsigned int) count);
 
   task_pool.info = (FTPD_SessionInfo_t*)
-    malloc(sizeof(FTPD_SessionInfo_t) * count);
+    calloc(count, sizeof(FTPD_SessionInfo_t));
   task_pool.queue = (FTPD_SessionInfo_t**)
     malloc(sizeof(FTPD_SessionInfo_t*) * count);
   if (NULL == task_pool.info || NULL == task_pool.queue)
@@ -424,6 +520,8 @@ task_pool_init(int count, rtems_task_priority priority)
   for(i = 0; i < count; ++i)
   {
     FTPD_SessionInfo_t *info = &task_pool.info[i];
+    /* The session task may use the transfer as soon as it is started */
+    transfer_task_init(info, id, priority);
     sc = rtems_task_create(rtems_build_name('F', 'T', 'P', id),
       priority, FTPD_STACKSIZE,
       RTEMS_PREEMPT | RTEMS_NO_TIMESLICE |
@@ -435,7 +533,7 @@ task_pool_init(int count, rtems_task_priority priority)
       sc = rtems_task_start(
         info->tid, session, (rtems_task_argument)info);
       if (sc != RTEMS_SUCCESSFUL)
-        task_pool_done(i);
+        task_pool_done(i + 1);
     }
     else
       task_pool_done(i + 1);
@@ -741,6 +839,332 @@ send_mode_reply(FTPD_SessionInfo_t *info)
     send_reply(info, 150, "Opening ASCII mode data connection.");
 }
 
+/*
+ * Binary transfer engine routines
+ *
+ */
+
+/*
+ * transfer_get_empty
+ *
+ * Wait for an empty buffer (producer side).
+ *
+ * Input parameters:
+ *   xfer - transfer of the session
+ *
+ * Output parameters:
+ *   returns the buffer, or NULL if the consumer stopped the transfer
+ *
+ */
+static char *
+transfer_get_empty(FTPD_Transfer_t *xfer)
+{
+  char *buf = NULL;
+
+  rtems_mutex_lock(&xfer->mutex);
+  while (xfer->filled == xfer->count && !xfer->abort)
+    rtems_condition_variable_wait(&xfer->cond, &xfer->mutex);
+  if (!xfer->abort)
+    buf = xfer->data + xfer->head * xfer->size;
+  rtems_mutex_unlock(&xfer->mutex);
+  return buf;
+}
+
+/*
+ * transfer_put_filled
+ *
+ * Pass the buffer obtained by transfer_get_empty() to the consumer.
+ *
+ * Input parameters:
+ *   xfer - transfer of the session
+ *   len  - data length, 0 at the end of data, negative on error
+ *
+ * Output parameters:
+ *   NONE
+ *
+ */
+static void
+transfer_put_filled(FTPD_Transfer_t *xfer, int len)
+{
+  rtems_mutex_lock(&xfer->mutex);
+  xfer->len[xfer->head] = len;
+  if (++xfer->head >= xfer->count)
+    xfer->head = 0;
+  ++xfer->filled;
+  rtems_condition_variable_broadcast(&xfer->cond);
+  rtems_mutex_unlock(&xfer->mutex);
+}
+
+/*
+ * transfer_get_filled
+ *
+ * Wait for a filled buffer (consumer side).
+ *
+ * Input parameters:
+ *   xfer - transfer of the session
+ *   len  - pointer to the data length
+ *
+ * Output parameters:
+ *   returns the buffer, '*len' is set to the data length
+ *
+ */
+static char *
+transfer_get_filled(FTPD_Transfer_t *xfer, int *len)
+{
+  char *buf;
+
+  rtems_mutex_lock(&xfer->mutex);
+  while (xfer->filled == 0)
+    rtems_condition_variable_wait(&xfer->cond, &xfer->mutex);
+  buf = xfer->data + xfer->tail * xfer->size;
+  *len = xfer->len[xfer->tail];
+  rtems_mutex_unlock(&xfer->mutex);
+  return buf;
+}
+
+/*
+ * transfer_put_empty
+ *
+ * Return the buffer obtained by transfer_get_filled() to the producer.
+ *
+ * Input parameters:
+ *   xfer - transfer of the session
+ *
+ * Output parameters:
+ *   NONE
+ *
+ */
+static void
+transfer_put_empty(FTPD_Transfer_t *xfer)
+{
+  rtems_mutex_lock(&xfer->mutex);
+  if (++xfer->tail >= xfer->count)
+    xfer->tail = 0;
+  --xfer->filled;
+  rtems_condition_variable_broadcast(&xfer->cond);
+  rtems_mutex_unlock(&xfer->mutex);
+}
+
+/*
+ * transfer_abort
+ *
+ * Stop the producer (consumer side).
+ *
+ * Input parameters:
+ *   xfer - transfer of the session
+ *
+ * Output parameters:
+ *   NONE
+ *
+ */
+static void
+transfer_abort(FTPD_Transfer_t *xfer)
+{
+  rtems_mutex_lock(&xfer->mutex);
+  xfer->abort = true;
+  rtems_condition_variable_broadcast(&xfer->cond);
+  rtems_mutex_unlock(&xfer->mutex);
+}
+
+/*
+ * transfer_task
+ *
+ * Transfer task of a session.  Reads or writes the file of each binary
+ * transfer started by transfer_start().
+ *
+ * Input parameters:
+ *   arg - corresponding SessionInfo structure
+ *
+ * Output parameters:
+ *   NONE
+ *
+ */
+static void
+transfer_task(rtems_task_argument arg)
+{
+  FTPD_Transfer_t *const xfer = &((FTPD_SessionInfo_t *)arg)->xfer;
+
+  while (1)
+  {
+    rtems_event_set set;
+    char *buf;
+    int n;
+
+    rtems_event_receive(FTPD_RTEMS_EVENT, RTEMS_EVENT_ANY, RTEMS_NO_TIMEOUT,
+      &set);
+
+    if (xfer->store)
+    {
+      buf = transfer_get_filled(xfer, &n);
+      while (n > 0)
+      {
+        if (write(xfer->fd, buf, n) != n)
+        {
+          xfer->failed = true;
+          transfer_abort(xfer);
+          break;
+        }
+        transfer_put_empty(xfer);
+        buf = transfer_get_filled(xfer, &n);
+      }
+    }
+    else
+    {
+      while ((buf = transfer_get_empty(xfer)) != NULL)
+      {
+        n = read(xfer->fd, buf, xfer->size);
+        transfer_put_filled(xfer, n);
+        if (n <= 0)
+          break;
+      }
+    }
+
+    rtems_mutex_lock(&xfer->mutex);
+    xfer->busy = false;
+    rtems_condition_variable_broadcast(&xfer->cond);
+    rtems_mutex_unlock(&xfer->mutex);
+  }
+}
+
+/*
+ * transfer_start
+ *
+ * Hand the file of a binary transfer to the transfer task of the session.
+ *
+ * Input parameters:
+ *   info  - corresponding SessionInfo structure
+ *   fd    - file to read or write
+ *   store - true for STOR, false for RETR
+ *
+ * Output parameters:
+ *   returns true on success, false if the session has to transfer the data
+ *   itself
+ *
+ */
+static bool
+transfer_start(FTPD_SessionInfo_t *info, int fd, bool store)
+{
+  FTPD_Transfer_t *xfer = &info->xfer;
+  int count = ftpd_transfer_buffers;
+
+  if (xfer->tid == 0)
+    return false;
+
+  xfer->len = malloc(count * (sizeof(*xfer->len) + ftpd_transfer_size));
+  if (xfer->len == NULL)
+    return false;
+
+  xfer->data = (char *)(xfer->len + count);
+  xfer->count = count;
+  xfer->size = ftpd_transfer_size;
+  xfer->head = xfer->tail = xfer->filled = 0;
+  xfer->fd = fd;
+  xfer->store = store;
+  xfer->abort = false;
+  xfer->failed = false;
+  xfer->busy = true;
+  rtems_event_send(xfer->tid, FTPD_RTEMS_EVENT);
+  return true;
+}
+
+/*
+ * transfer_finish
+ *
+ * Wait for the transfer task to finish the transfer.
+ *
+ * Input parameters:
+ *   info - corresponding SessionInfo structure
+ *
+ * Output parameters:
+ *   returns true on success, false if the transfer task could not write the
+ *   file
+ *
+ */
+static bool
+transfer_finish(FTPD_SessionInfo_t *info)
+{
+  FTPD_Transfer_t *xfer = &info->xfer;
+
+  rtems_mutex_lock(&xfer->mutex);
+  while (xfer->busy)
+    rtems_condition_variable_wait(&xfer->cond, &xfer->mutex);
+  rtems_mutex_unlock(&xfer->mutex);
+
+  free(xfer->len);
+  xfer->len = NULL;
+  return !xfer->failed;
+}
+
+/*
+ * retrieve_binary
+ *
+ * Send a file through the transfer task.
+ *
+ * Input parameters:
+ *   info - corresponding SessionInfo structure
+ *   s    - data socket
+ *
+ * Output parameters:
+ *   returns 0 on success, -1 on error
+ *
+ */
+static int
+retrieve_binary(FTPD_SessionInfo_t *info, int s)
+{
+  FTPD_Transfer_t *xfer = &info->xfer;
+  char *buf;
+  int n;
+
+  buf = transfer_get_filled(xfer, &n);
+  while (n > 0)
+  {
+    if (send(s, buf, n, 0) != n)
+    {
+      transfer_abort(xfer);
+      n = -1;
+      break;
+    }
+    transfer_put_empty(xfer);
+    yield();
+    buf = transfer_get_filled(xfer, &n);
+  }
+
+  transfer_finish(info);
+  return n < 0 ? -1 : 0;
+}
+
+/*
+ * store_binary
+ *
+ * Receive a file through the transfer task.
+ *
+ * Input parameters:
+ *   info - corresponding SessionInfo structure
+ *   s    - data socket
+ *
+ * Output parameters:
+ *   returns 1 on success, 0 if the file could not be written
+ *
+ */
+static int
+store_binary(FTPD_SessionInfo_t *info, int s)
+{
+  FTPD_Transfer_t *xfer = &info->xfer;
+  char *buf;
+  int n;
+
+  while ((buf = transfer_get_empty(xfer)) != NULL)
+  {
+    n = recv(s, buf, xfer->size, 0);
+    transfer_put_filled(xfer, n > 0 ? n : 0);
+    if (n <= 0)
+      break;
+    yield();
+  }
+
+  return transfer_finish(info);
+}
+
 /*
  * command_retrieve
  *
@@ -793,11 +1217,25 @@ command_retrieve(FTPD_SessionInfo_t  *info, char const *filename)
 
     if(info->xfer_mode == TYPE_I)
     {
-      while ((n = read(fd, buf, FTPD_DATASIZE)) > 0)
+      off_t sent = 0;
+
+      /*
+       * Overlap the file and network I/O with the transfer task.  Otherwise,
+       * let the network stack read the file directly into the socket
+       * buffers.  Use the copy loop only if sendfile() is not supported.
+       */
+      if (transfer_start(info, fd, false))
+        n = retrieve_binary(info, s);
+      else if (sendfile(fd, s, 0, 0, NULL, &sent, 0) == 0)
+        n = 0;
+      else if (sent == 0 && (errno == EINVAL || errno == ENOSYS))
       {
-        if(send(s, buf, n, 0) != n)
-          break;
-        yield();
+        while ((n = read(fd, buf, FTPD_DATASIZE)) > 0)
+        {
+          if(send(s, buf, n, 0) != n)
+            break;
+          yield();
+        }
       }
     }
     else if (info->xfer_mode == TYPE_A)
@@ -1018,7 +1456,11 @@ command_store(FTPD_SessionInfo_t *info, char const *filename)
       return;
     }
 
-    if(info->xfer_mode == TYPE_I)
+    if(info->xfer_mode == TYPE_I && !null && transfer_start(info, fd, true))
+    {
+      res = store_binary(info, s);
+    }
+    else if(info->xfer_mode == TYPE_I)
     {
       while ((n = recv(s, buf, FTPD_DATASIZE, 0)) > 0)
       {
@@ -2103,6 +2545,16 @@ rtems_ftpd_start(const struct rtems_ftpd_configuration* config)
 
   ftpd_access = ftpd_config->access;
 
+  ftpd_transfer_size = FTPD_DATASIZE;
+  if (ftpd_config->transfer_size > 0)
+    ftpd_transfer_size = ftpd_config->transfer_size;
+  ftpd_config->transfer_size = ftpd_transfer_size;
+
+  ftpd_transfer_buffers = FTPD_TRANSFER_BUFFERS;
+  if (ftpd_config->transfer_buffers > 0)
+    ftpd_transfer_buffers = ftpd_config->transfer_buffers;
+  ftpd_config->transfer_buffers = ftpd_transfer_buffers;
+
   ftpd_root = "/";
   if (ftpd_config->root && ftpd_config->root[0] == '/' )
     ftpd_root = ftpd_config->root;
@@ -162,6 +162,23 @@ struct mg_callbacks {
 // Refer to https://github.com/valenok/mongoose/blob/master/UserManual.md
 // for the list of valid option and their possible values.
 //
+// With "event_loop" set to "yes", the listening thread multiplexes all
+// connections which wait for a request or receive the body of a static file.
+// The "num_threads" worker threads then only process complete requests, so
+// a few workers serve many keep-alive clients.
+//
+// With "static_cache_size" set to a non-zero number of bytes, static files
+// of at most "static_cache_file_size" bytes are kept in memory together with
+// their response headers. The cache is keyed by the path, modification time
+// and size of a file and evicts the least recently used files. Files served
+// through the open_file callback are not cached.
+//
+// If the library is configured with --enable-mghttpd-zlib, then a gzip
+// compressed variant of text files is kept as well and sent to clients which
+// accept it, unless "static_cache_gzip" is "no". Applications must link
+// with libz in this case. Otherwise, "static_cache_gzip" defaults to "no"
+// and has no effect.
+//
 // Return:
 //   web server context, or NULL on error.
 struct mg_context *mg_start(const struct mg_callbacks *callbacks,
@@ -186,6 +203,21 @@ void mg_stop(struct mg_context *);
 const char *mg_get_option(const struct mg_context *ctx, const char *name);
 
 
+// Static file cache statistics, see "static_cache_size".
+struct mg_cache_stats {
+  unsigned long hits;       // Requests served from the cache
+  unsigned long gzip_hits;  // Hits which sent the gzip compressed variant
+  unsigned long misses;     // Requests for cacheable files which read the file
+  unsigned long evictions;  // Entries removed to make room for other files
+  unsigned long entries;    // Files in the cache
+  size_t bytes;             // Memory used by the cache
+};
+
+
+// Get the statistics of the static file cache.
+void mg_get_cache_stats(struct mg_context *ctx, struct mg_cache_stats *stats);
+
+
 // Return array of strings that represent valid configuration options.
 // For each option, option name and default value is returned, i.e. the
 // number of entries in the array equals to number_of_options x 2.
@@ -117,6 +117,7 @@ typedef struct rtems_capture_control
   uint32_t                      by_valid;
   rtems_capture_from            by[RTEMS_CAPTURE_TRIGGER_TASKS];
   struct rtems_capture_control* next;
+  struct rtems_capture_control* index_next;
 } rtems_capture_control;
 
 /**
@@ -258,19 +259,19 @@ typedef void (*rtems_capture_timestamp)(rtems_capture_time* time);
 /**
  * @brief Capture record lock context.
  *
- * This structure is used to lock a per CPU buffer when opeining recording. The
- * per CPU buffer is held locked until the record close is called. Locking
- * masks interrupts so use this lock only when needed and do not hold it for
- * long.
- *
- * The lock first masks the CPU interrupt before taking the interrupt
- * lock. This stops a thread context taking the lock and then an interrupt on
- * the same CPU attempting to take the lock so creating a deadlock.
+ * This structure is used to lock the per CPU buffer of the current CPU when
+ * opening recording. The per CPU buffer is held locked until the record close
+ * is called. Locking masks interrupts so use this lock only when needed and do
+ * not hold it for long.
  *
+ * The per CPU buffer is only written by its CPU, so masking the interrupts of
+ * this CPU is sufficient. No interrupt lock is taken and recording on
+ * different CPUs does not interfere. The record close publishes the record to
+ * the reader.
  */
 typedef struct {
-  rtems_interrupt_lock_context lock_context;
-  rtems_interrupt_lock*        lock;
+  rtems_interrupt_level level;
+  uint32_t              cpu;
 } rtems_capture_record_lock_context;
 
 /**
@@ -580,6 +581,48 @@ rtems_status_code rtems_capture_read (uint32_t     cpu,
  */
 rtems_status_code rtems_capture_release (uint32_t cpu, uint32_t count);
 
+/**
+ * @brief Capture record visitor.
+ *
+ * @param[in] cpu The cpu number that the record was recorded on
+ * @param[in] rec The capture record. It may be mis-aligned.
+ * @param[in] arg The visitor argument.
+ *
+ * @see rtems_capture_drain().
+ */
+typedef void (*rtems_capture_record_visitor)(uint32_t                    cpu,
+                                             const rtems_capture_record* rec,
+                                             void*                       arg);
+
+/**
+ * @brief Capture drain records.
+ *
+ * This function passes up to the specified number of records of the capture
+ * buffer of a cpu to the visitor in recording order and releases them. The
+ * records are released in blocks of continous memory, so the visitor sees
+ * both parts of a wrapped buffer within one call. The records must not be
+ * used after the visitor returns.
+ *
+ * In contrast to rtems_capture_read, this function may be used while capture
+ * control is enabled. The per CPU buffers are single producer and single
+ * consumer rings, so draining does not block recording on any cpu.
+ *
+ * @param[in]  cpu The cpu number that the records were recorded on
+ * @param[in]  max The maximum number of records to drain
+ * @param[in]  visitor The visitor called for each record
+ * @param[in]  arg The visitor argument
+ * @param[out] drained will contain the number of records drained
+ *
+ * @retval This method returns RTEMS_SUCCESSFUL if there was not an
+ *         error. Otherwise, a status code is returned indicating the
+ *         source of the error.
+ */
+rtems_status_code rtems_capture_drain (uint32_t                     cpu,
+                                       uint32_t                     max,
+                                       rtems_capture_record_visitor visitor,
+                                       void*                        arg,
+                                       uint32_t*                    drained);
+
 /**
  * @brief Capture filter
  *
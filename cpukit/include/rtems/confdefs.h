@@ -147,6 +147,10 @@ extern rtems_initialization_tasks_table Initialization_tasks[];
  * This macro defines the number of POSIX file descriptors allocated
  * and managed by libio.  These are the "integer" file descriptors that
  * are used by calls like open(2) and read(2).
+ *
+ * In case it is specified as rtems_resource_unlimited(n), then the table of
+ * file descriptors starts with n entries and is extended on demand.  Each
+ * extension doubles the table size and is allocated from the workspace.
  */
 #ifndef CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS
   #define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 3
@@ -158,13 +162,18 @@ extern rtems_initialization_tasks_table Initialization_tasks[];
 #define _CONFIGURE_LIBIO_POSIX_KEYS 1
 
 #ifdef CONFIGURE_INIT
-  rtems_libio_t rtems_libio_iops[CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS];
+  rtems_libio_t rtems_libio_iops[
+    CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS & ~RTEMS_UNLIMITED_OBJECTS
+  ];
 
   /**
    * When instantiating the configuration tables, this variable is
    * initialized to specify the maximum number of file descriptors.
    */
   const uint32_t rtems_libio_number_iops = RTEMS_ARRAY_SIZE(rtems_libio_iops);
+
+  const bool rtems_libio_iops_unlimited =
+    rtems_resource_is_unlimited(CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS);
 #endif
 
 #ifdef CONFIGURE_SMP_MAXIMUM_PROCESSORS
@@ -195,6 +204,54 @@ extern rtems_initialization_tasks_table Initialization_tasks[];
   #warning "CONFIGURE_SMP_APPLICATION is obsolete since RTEMS 5.1"
 #endif
 
+/**
+ * This configuration parameter defines the maximum time in nanoseconds a
+ * contended lock operation of a self-contained mutex, for example
+ * rtems_mutex_lock(), spins while the owner executes on another processor.
+ * If the mutex could not be obtained within this time, then the thread blocks.
+ * A value of zero disables the spinning.  The value is ignored in
+ * uniprocessor configurations.
+ */
+#ifndef CONFIGURE_SELF_CONTAINED_MUTEX_SPIN_TIME
+  #define CONFIGURE_SELF_CONTAINED_MUTEX_SPIN_TIME 0
+#endif
+
+/**
+ * This configuration parameter defines the count of self-contained mutexes
+ * for which statistics are recorded, see rtems_mutex_get_statistics().  A
+ * mutex obtains its entry with the first contended lock operation and
+ * releases it with rtems_mutex_destroy(), rtems_recursive_mutex_destroy() or
+ * mtx_destroy().  A mutex may get no entry if the table entries near its hash
+ * index are in use.  The internal locks of Newlib are destroyed by the inline
+ * _Mutex_Destroy() and _Mutex_recursive_Destroy() functions of Newlib, so
+ * they keep their entry.
+ */
+#ifndef CONFIGURE_SELF_CONTAINED_MUTEX_STATISTICS
+  #define CONFIGURE_SELF_CONTAINED_MUTEX_STATISTICS 0
+#endif
+
+#ifdef CONFIGURE_INIT
+  #if CONFIGURE_SELF_CONTAINED_MUTEX_STATISTICS > 0
+    #include <rtems/score/muteximpl.h>
+
+    Mutex_Statistics
+      _Mutex_Statistics[ CONFIGURE_SELF_CONTAINED_MUTEX_STATISTICS ];
+
+    const size_t _Mutex_Statistics_count =
+      CONFIGURE_SELF_CONTAINED_MUTEX_STATISTICS;
+
+    RTEMS_SYSINIT_ITEM(
+      _Mutex_Statistics_initialize,
+      RTEMS_SYSINIT_DATA_STRUCTURES,
+      RTEMS_SYSINIT_ORDER_MIDDLE
+    );
+  #endif
+
+  #ifdef RTEMS_SMP
+    const uint32_t _Mutex_Spin_time = CONFIGURE_SELF_CONTAINED_MUTEX_SPIN_TIME;
+  #endif
+#endif
+
 /*
  * This sets up the resources for the FIFOs/pipes.
  */
@@ -330,6 +387,15 @@ extern rtems_initialization_tasks_table Initialization_tasks[];
                     IMFS_MEMFILE_DEFAULT_BYTES_PER_BLOCK
 #endif
 
+/**
+ * Directories of the IMFS with more entries than this threshold use a hash
+ * table to look up entries.  A value of zero selects the default threshold,
+ * IMFS_DIRECTORY_HASH_DISABLED disables the hash tables.
+ */
+#ifndef CONFIGURE_IMFS_DIRECTORY_HASH_THRESHOLD
+  #define CONFIGURE_IMFS_DIRECTORY_HASH_THRESHOLD 0
+#endif
+
 /**
  * This defines the IMFS file system table entry.
  */
@@ -583,6 +649,8 @@ extern rtems_initialization_tasks_table Initialization_tasks[];
         &IMFS_mknod_control_device,
         #ifdef CONFIGURE_IMFS_DISABLE_MKNOD_FILE
           &IMFS_mknod_control_enosys,
+        #elif defined(CONFIGURE_IMFS_ENABLE_EXTENT_FILES)
+          &IMFS_mknod_control_extfile,
         #else
           &IMFS_mknod_control_memfile,
         #endif
@@ -596,7 +664,8 @@ extern rtems_initialization_tasks_table Initialization_tasks[];
       static const IMFS_mount_data _Configure_IMFS_mount_data = {
         &_Configure_IMFS_fs_info,
         &_Configure_IMFS_ops,
-        &_Configure_IMFS_mknod_controls
+        &_Configure_IMFS_mknod_controls,
+        CONFIGURE_IMFS_DIRECTORY_HASH_THRESHOLD
       };
     #endif
 
@@ -690,6 +759,7 @@ extern rtems_initialization_tasks_table Initialization_tasks[];
  *  - CONFIGURE_SCHEDULER_SIMPLE_SMP - Simple SMP Priority Scheduler
  *  - CONFIGURE_SCHEDULER_EDF - EDF Scheduler
  *  - CONFIGURE_SCHEDULER_EDF_SMP - EDF SMP Scheduler
+ *  - CONFIGURE_SCHEDULER_WORK_STEALING_SMP - Work Stealing SMP Scheduler
  *  - CONFIGURE_SCHEDULER_CBS - CBS Scheduler
  *  - CONFIGURE_SCHEDULER_USER  - user provided scheduler
  *
@@ -731,6 +801,7 @@ extern rtems_initialization_tasks_table Initialization_tasks[];
     !defined(CONFIGURE_SCHEDULER_SIMPLE_SMP) && \
     !defined(CONFIGURE_SCHEDULER_EDF) && \
     !defined(CONFIGURE_SCHEDULER_EDF_SMP) && \
+    !defined(CONFIGURE_SCHEDULER_WORK_STEALING_SMP) && \
     !defined(CONFIGURE_SCHEDULER_CBS)
   #if defined(RTEMS_SMP) && _CONFIGURE_MAXIMUM_PROCESSORS > 1
     /**
@@ -925,6 +996,26 @@ extern rtems_initialization_tasks_table Initialization_tasks[];
   #endif
 #endif
 
+/*
+ * If the Work Stealing SMP Scheduler is selected, then configure for it.
+ */
+#if defined(CONFIGURE_SCHEDULER_WORK_STEALING_SMP)
+  #if !defined(CONFIGURE_SCHEDULER_NAME)
+    /** Configure the name of the scheduler instance */
+    #define CONFIGURE_SCHEDULER_NAME rtems_build_name('M', 'W', 'S', ' ')
+  #endif
+
+  #if !defined(CONFIGURE_SCHEDULER_TABLE_ENTRIES)
+    /** Configure the context needed by the scheduler instance */
+    #define CONFIGURE_SCHEDULER \
+      RTEMS_SCHEDULER_WORK_STEALING_SMP(dflt, _CONFIGURE_MAXIMUM_PROCESSORS)
+
+    /** Configure the controls for this scheduler instance */
+    #define CONFIGURE_SCHEDULER_TABLE_ENTRIES \
+      RTEMS_SCHEDULER_TABLE_WORK_STEALING_SMP(dflt, CONFIGURE_SCHEDULER_NAME)
+  #endif
+#endif
+
 /*
  * If the CBS Scheduler is selected, then configure for it.
  */
@@ -2710,6 +2801,9 @@ struct _reent *__getreent(void)
     #ifdef CONFIGURE_SCHEDULER_STRONG_APA
       Scheduler_strong_APA_Node Strong_APA;
     #endif
+    #ifdef CONFIGURE_SCHEDULER_WORK_STEALING_SMP
+      Scheduler_work_stealing_SMP_Node Work_stealing_SMP;
+    #endif
     #ifdef CONFIGURE_SCHEDULER_USER_PER_THREAD
       CONFIGURE_SCHEDULER_USER_PER_THREAD User;
     #endif
@@ -65,6 +65,172 @@ void rtems_cpu_usage_top_with_plugin( const rtems_printer *printer );
 
 void rtems_cpu_usage_top( void );
 
+/**
+ * @brief CPU usage sort orders.
+ */
+typedef enum {
+  RTEMS_CPU_USAGE_SORT_ID,
+  RTEMS_CPU_USAGE_SORT_REAL_PRIORITY,
+  RTEMS_CPU_USAGE_SORT_CURRENT_PRIORITY,
+  RTEMS_CPU_USAGE_SORT_TOTAL,
+  RTEMS_CPU_USAGE_SORT_CURRENT
+} rtems_cpu_usage_sort_order;
+
+/**
+ * @brief CPU usage sample of a thread.
+ */
+typedef struct {
+  /**
+   * @brief The thread identifier.
+   */
+  rtems_id id;
+
+  /**
+   * @brief The thread name or the entry point if the thread has no name.
+   */
+  char name[ 16 ];
+
+  /**
+   * @brief The real priority of the thread.
+   */
+  rtems_task_priority real_priority;
+
+  /**
+   * @brief The current priority of the thread.
+   */
+  rtems_task_priority current_priority;
+
+  /**
+   * @brief The CPU time used by the thread since the last CPU usage reset in
+   * nanoseconds.
+   */
+  uint64_t total_time;
+
+  /**
+   * @brief The CPU time used by the thread in the sample period in
+   * nanoseconds.
+   */
+  uint64_t current_time;
+} rtems_cpu_usage_thread_sample;
+
+/**
+ * @brief CPU usage summary of all threads of a sample.
+ */
+typedef struct {
+  /**
+   * @brief The uptime since the last CPU usage reset in nanoseconds.
+   */
+  uint64_t uptime;
+
+  /**
+   * @brief The time since the previous sample or the last CPU usage reset in
+   * nanoseconds.
+   */
+  uint64_t period;
+
+  /**
+   * @brief The CPU time used by all threads since the last CPU usage reset in
+   * nanoseconds.
+   */
+  uint64_t total_time;
+
+  /**
+   * @brief The CPU time used by the idle threads since the last CPU usage
+   * reset in nanoseconds.
+   */
+  uint64_t idle_time;
+
+  /**
+   * @brief The CPU time used by all threads in the sample period in
+   * nanoseconds.
+   */
+  uint64_t current_time;
+
+  /**
+   * @brief The CPU time used by the idle threads in the sample period in
+   * nanoseconds.
+   */
+  uint64_t current_idle_time;
+
+  /**
+   * @brief The count of threads.
+   */
+  uint32_t thread_count;
+
+  /**
+   * @brief The sum of the stack sizes of all threads in bytes.
+   */
+  uintptr_t stack_size;
+} rtems_cpu_usage_summary;
+
+typedef struct rtems_cpu_usage_sampler_entry rtems_cpu_usage_sampler_entry;
+
+/**
+ * @brief CPU usage sampler.
+ *
+ * The sampler keeps the CPU time used by each thread of the previous sample in
+ * a hash table indexed by the thread identifier.  This allows an incremental
+ * computation of the CPU time used in the sample period with one pass over all
+ * threads.  The members are private to the implementation.
+ *
+ * @see rtems_cpu_usage_sampler_initialize() and rtems_cpu_usage_sample().
+ */
+typedef struct {
+  rtems_cpu_usage_sampler_entry *table;
+  size_t                         capacity;
+  rtems_cpu_usage_sampler_entry *last_table;
+  size_t                         last_capacity;
+  uint64_t                       last_uptime;
+  uint64_t                       last_reset;
+  bool                           has_last_sample;
+} rtems_cpu_usage_sampler;
+
+/**
+ * @brief Initializes a CPU usage sampler.
+ *
+ * @param[out] sampler The sampler to initialize.
+ */
+void rtems_cpu_usage_sampler_initialize( rtems_cpu_usage_sampler *sampler );
+
+/**
+ * @brief Destroys a CPU usage sampler and frees its resources.
+ *
+ * @param[in] sampler The sampler to destroy.
+ */
+void rtems_cpu_usage_sampler_destroy( rtems_cpu_usage_sampler *sampler );
+
+/**
+ * @brief Samples the CPU usage of all threads.
+ *
+ * The CPU time used in the sample period is the difference to the previous
+ * sample of this sampler.  In the first sample the CPU time used in the sample
+ * period is zero for all threads.  If the CPU usage was reset by
+ * rtems_cpu_usage_reset() since the previous sample, then the sample period
+ * starts at the reset.
+ *
+ * Only the first threads according to the sort order are returned.  They are
+ * selected with a bounded heap, so the cost of a sample is linear in the
+ * count of threads for a small count of selected threads.  The threads are
+ * iterated once without a lock, so the sample is not an atomic snapshot.
+ *
+ * @param[in] sampler The sampler.
+ * @param[in] order The sort order of the selected threads.
+ * @param[out] threads The selected threads sorted by the sort order.
+ * @param[in, out] thread_count The maximum count of selected threads on entry
+ *   and the actual count of selected threads on return.
+ * @param[out] summary The summary of all threads.
+ *
+ * @retval RTEMS_SUCCESSFUL Successful operation.
+ * @retval RTEMS_NO_MEMORY Not enough memory for the sampler hash table.
+ */
+rtems_status_code rtems_cpu_usage_sample(
+  rtems_cpu_usage_sampler       *sampler,
+  rtems_cpu_usage_sort_order     order,
+  rtems_cpu_usage_thread_sample *threads,
+  size_t                        *thread_count,
+  rtems_cpu_usage_summary       *summary
+);
+
 /**
  *  @brief Reset CPU usage.
  *
@@ -17,7 +17,8 @@ extern "C" {
 enum {
   FTPD_BUFSIZE  = 256,       /* Size for temporary buffers */
   FTPD_DATASIZE = 4 * 1024,      /* Size for file transfer buffers */
-  FTPD_STACKSIZE = RTEMS_MINIMUM_STACK_SIZE + FTPD_DATASIZE /* Tasks stack size */
+  FTPD_STACKSIZE = RTEMS_MINIMUM_STACK_SIZE + FTPD_DATASIZE, /* Tasks stack size */
+  FTPD_TRANSFER_BUFFERS = 2  /* Default count of binary transfer buffers */
 };
 
 /* FTPD access control flags */
@@ -55,6 +56,13 @@ struct rtems_ftpd_configuration
    rtems_shell_login_check_t login;            /* Login check or 0 to ignore
                                                   user/passwd. */
    bool                    verbose;            /* Say hello! */
+   size_t                  transfer_size;      /* Size of a binary transfer
+                                                  buffer or 0 for
+                                                  FTPD_DATASIZE */
+   int                     transfer_buffers;   /* Count of binary transfer
+                                                  buffers or 0 for
+                                                  FTPD_TRANSFER_BUFFERS, 1 -
+                                                  no transfer tasks */
 };
 
 /*
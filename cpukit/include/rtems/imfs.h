@@ -96,6 +96,20 @@ typedef block_p *block_ptr;
 #define IMFS_MEMFILE_MAXIMUM_SIZE \
   (LAST_TRIPLY_INDIRECT * IMFS_MEMFILE_BYTES_PER_BLOCK)
 
+/**
+ *  IMFS "extent file" information
+ *
+ *  Extent files map their data with a small array of variable-size extents
+ *  sorted by file offset.  Each new extent is at least as large as all
+ *  previous extents together, so the number of extents grows only
+ *  logarithmically with the file size up to IMFS_EXTFILE_MAXIMUM_EXTENT_SIZE.
+ *  Large files need far fewer allocator calls and less metadata than memfiles
+ *  and read and write operations copy large contiguous areas.
+ */
+#define IMFS_EXTFILE_MINIMUM_EXTENT_SIZE 128
+
+#define IMFS_EXTFILE_MAXIMUM_EXTENT_SIZE ( 1024 * 1024 )
+
 /** @} */
 
 /**
@@ -260,10 +274,24 @@ struct IMFS_jnode_tt {
 
 #define IMFS_NODE_FLAG_NAME_ALLOCATED 0x1
 
+/*
+ *  Directories with more entries than the hash threshold get an additional
+ *  hash table of their entries to speed up the path evaluation.  The entries
+ *  chain is the authoritative list and defines the readdir() order.
+ */
+
+#define IMFS_DIRECTORY_HASH_THRESHOLD_DEFAULT 32
+
+#define IMFS_DIRECTORY_HASH_DISABLED SIZE_MAX
+
 typedef struct {
   IMFS_jnode_t                          Node;
   rtems_chain_control                   Entries;
   rtems_filesystem_mount_table_entry_t *mt_fs;
+  size_t                                entry_count;
+  size_t                                hash_threshold;
+  size_t                                hash_capacity;
+  IMFS_jnode_t                        **hash_table;
 } IMFS_directory_t;
 
 typedef struct {
@@ -299,6 +327,19 @@ typedef struct {
   block_p         direct;           /* pointer to file image */
 } IMFS_linearfile_t;
 
+typedef struct {
+  off_t   offset;                   /* file offset of the first byte */
+  size_t  size;                     /* size of extent in bytes */
+  block_p data;
+} IMFS_extent_t;
+
+typedef struct {
+  IMFS_filebase_t File;
+  IMFS_extent_t  *extents;          /* sorted by file offset */
+  size_t          extent_count;
+  size_t          extent_capacity;  /* slots in the extents array */
+} IMFS_extfile_t;
+
 /* Support copy on write for linear files */
 typedef union {
   IMFS_jnode_t      Node;
@@ -339,6 +380,11 @@ static inline IMFS_memfile_t *IMFS_iop_to_memfile( const rtems_libio_t *iop )
   return (IMFS_memfile_t *) iop->pathinfo.node_access;
 }
 
+static inline IMFS_extfile_t *IMFS_iop_to_extfile( const rtems_libio_t *iop )
+{
+  return (IMFS_extfile_t *) iop->pathinfo.node_access;
+}
+
 static inline time_t _IMFS_get_time( void )
 {
   struct bintime now;
@@ -384,12 +430,21 @@ typedef struct {
 typedef struct {
   IMFS_directory_t Root_directory;
   const IMFS_mknod_controls *mknod_controls;
+  size_t directory_hash_threshold;
 } IMFS_fs_info_t;
 
 typedef struct {
   IMFS_fs_info_t *fs_info;
   const rtems_filesystem_operations_table *ops;
   const IMFS_mknod_controls *mknod_controls;
+
+  /**
+   * @brief Directories with more entries than this threshold are hashed.
+   *
+   * A value of zero selects IMFS_DIRECTORY_HASH_THRESHOLD_DEFAULT.  Use
+   * IMFS_DIRECTORY_HASH_DISABLED to use linear directory searches only.
+   */
+  size_t directory_hash_threshold;
 } IMFS_mount_data;
 
 /*
@@ -400,6 +455,7 @@ extern const IMFS_mknod_control IMFS_mknod_control_dir_default;
 extern const IMFS_mknod_control IMFS_mknod_control_dir_minimal;
 extern const IMFS_mknod_control IMFS_mknod_control_device;
 extern const IMFS_mknod_control IMFS_mknod_control_memfile;
+extern const IMFS_mknod_control IMFS_mknod_control_extfile;
 extern const IMFS_node_control IMFS_node_control_linfile;
 extern const IMFS_mknod_control IMFS_mknod_control_fifo;
 extern const IMFS_mknod_control IMFS_mknod_control_enosys;
@@ -434,7 +490,10 @@ extern void IMFS_fsunmount(
  * extensions.  The TAR is not actually mounted under the IMFS.
  * Directories from the TAR file are created as usual in the IMFS.
  * File entries are created as IMFS_LINEAR_FILE nodes with their nods
- * pointing to addresses in the TAR image.
+ * pointing to addresses in the TAR image.  Reads use the TAR image
+ * directly.  The file content is copied into a memfile on the first
+ * write or truncate operation.  Shared mappings are not supported,
+ * since they would allow writes to the TAR image.
  *
  * Here we create the mountpoint directory and load the tarfs at
  * that node.  Once the IMFS has been mounted, we work through the
@@ -866,6 +925,39 @@ static inline void IMFS_Set_handlers( rtems_filesystem_location_info_t *loc )
   loc->handlers = node->control->handlers;
 }
 
+/**
+ * @brief Adds the entry to the hash table of the directory.
+ *
+ * The entry must be already on the entries chain of the directory.  The hash
+ * table is created or enlarged on demand.  In case there is not enough memory
+ * for the hash table, the directory falls back to linear searches.
+ */
+void IMFS_directory_hash_insert(
+  IMFS_directory_t *dir,
+  IMFS_jnode_t     *entry_node
+);
+
+/**
+ * @brief Removes the entry from the hash table of the directory.
+ */
+void IMFS_directory_hash_remove(
+  IMFS_directory_t *dir,
+  IMFS_jnode_t     *entry_node
+);
+
+/**
+ * @brief Looks up an entry by name in the hash table of the directory.
+ *
+ * The directory must have a hash table.
+ *
+ * @retval NULL No entry with this name exists.
+ */
+IMFS_jnode_t *IMFS_directory_hash_find(
+  const IMFS_directory_t *dir,
+  const char             *name,
+  size_t                  namelen
+);
+
 static inline void IMFS_add_to_directory(
   IMFS_jnode_t *dir_node,
   IMFS_jnode_t *entry_node
@@ -875,11 +967,24 @@ static inline void IMFS_add_to_directory(
 
   entry_node->Parent = dir_node;
   rtems_chain_append_unprotected( &dir->Entries, &entry_node->Node );
+  ++dir->entry_count;
+
+  if ( dir->hash_table != NULL || dir->entry_count > dir->hash_threshold ) {
+    IMFS_directory_hash_insert( dir, entry_node );
+  }
 }
 
 static inline void IMFS_remove_from_directory( IMFS_jnode_t *node )
 {
-  IMFS_assert( node->Parent != NULL );
+  IMFS_directory_t *dir = (IMFS_directory_t *) node->Parent;
+
+  IMFS_assert( dir != NULL );
+  --dir->entry_count;
+
+  if ( dir->hash_table != NULL ) {
+    IMFS_directory_hash_remove( dir, node );
+  }
+
   node->Parent = NULL;
   rtems_chain_extract_unprotected( &node->Node );
 }
@@ -1323,6 +1323,7 @@ struct rtems_libio_tt {
   rtems_filesystem_location_info_t        pathinfo;
   uint32_t                                data0;     /* private to "driver" */
   void                                   *data1;     /* ... */
+  int                                     descriptor; /* index in iop table */
 };
 
 /**
@@ -56,10 +56,40 @@ extern "C" {
  *  File descriptor Table Information
  */
 
+/**
+ * @brief Count of statically allocated iops.
+ *
+ * In case the iop table is unlimited, this is also the size of the first
+ * table extension.  Each further extension doubles the table size.
+ */
 extern const uint32_t rtems_libio_number_iops;
+extern const bool rtems_libio_iops_unlimited;
 extern rtems_libio_t rtems_libio_iops[];
-extern void *rtems_libio_iop_free_head;
-extern void **rtems_libio_iop_free_tail;
+
+/**
+ * @brief Maximum count of iop table blocks.
+ *
+ * The first block is rtems_libio_iops[], the other blocks are allocated from
+ * the workspace on demand.
+ */
+#define RTEMS_LIBIO_IOP_BLOCK_COUNT 32
+
+extern rtems_libio_t *rtems_libio_iop_blocks[ RTEMS_LIBIO_IOP_BLOCK_COUNT ];
+
+/**
+ * @brief Current size of the iop table.
+ */
+extern Atomic_Uint rtems_libio_iop_table_size;
+
+/**
+ * @brief Returns the current size of the iop table.
+ *
+ * All file descriptors less than this value map to an iop.
+ */
+static inline uint32_t rtems_libio_iop_get_table_size( void )
+{
+  return _Atomic_Load_uint( &rtems_libio_iop_table_size, ATOMIC_ORDER_ACQUIRE );
+}
 
 extern const rtems_filesystem_file_handlers_r rtems_filesystem_null_handlers;
 
@@ -147,7 +177,21 @@ static inline unsigned int rtems_libio_iop_flags_clear(
  */
 static inline rtems_libio_t *rtems_libio_iop( int fd )
 {
-  return &rtems_libio_iops[ fd ];
+  uint32_t index;
+  uint32_t block;
+
+  index = (uint32_t) fd;
+
+  if ( RTEMS_PREDICT_TRUE( index < rtems_libio_number_iops ) ) {
+    return &rtems_libio_iops[ index ];
+  }
+
+  /* Block n > 0 starts at rtems_libio_number_iops * 2^(n - 1) */
+  block = 32U - (uint32_t) __builtin_clz( index / rtems_libio_number_iops );
+
+  return &rtems_libio_iop_blocks[ block ][
+    index - ( rtems_libio_number_iops << ( block - 1 ) )
+  ];
 }
 
 /**
@@ -205,12 +249,14 @@ static inline void rtems_libio_iop_drop( rtems_libio_t *iop )
 /*
  *  rtems_libio_iop_to_descriptor
  *
- *  Macro to convert an internal file descriptor pointer (iop) into
+ *  Convert an internal file descriptor pointer (iop) into
  *  the integer file descriptor used by the "section 2" system calls.
  */
 
-#define rtems_libio_iop_to_descriptor(_iop) \
-  ((_iop) - &rtems_libio_iops[0])
+static inline int rtems_libio_iop_to_descriptor( const rtems_libio_t *iop )
+{
+  return iop->descriptor;
+}
 
 /*
  *  rtems_libio_check_is_open
@@ -234,7 +280,7 @@ static inline void rtems_libio_iop_drop( rtems_libio_t *iop )
 #define LIBIO_GET_IOP( _fd, _iop ) \
   do { \
     unsigned int _flags; \
-    if ( (uint32_t) ( _fd ) >= rtems_libio_number_iops ) { \
+    if ( (uint32_t) ( _fd ) >= rtems_libio_iop_get_table_size() ) { \
       rtems_set_errno_and_return_minus_one( EBADF ); \
     } \
     _iop = rtems_libio_iop( _fd ); \
@@ -255,7 +301,7 @@ static inline void rtems_libio_iop_drop( rtems_libio_t *iop )
   do { \
     unsigned int _flags; \
     unsigned int _mandatory; \
-    if ( (uint32_t) ( _fd ) >= rtems_libio_number_iops ) { \
+    if ( (uint32_t) ( _fd ) >= rtems_libio_iop_get_table_size() ) { \
       rtems_set_errno_and_return_minus_one( EBADF ); \
     } \
     _iop = rtems_libio_iop( _fd ); \
@@ -409,6 +455,18 @@ void rtems_libio_free(
   rtems_libio_t *iop
 );
 
+/**
+ * @brief Initializes the iop table and the per-processor free lists.
+ */
+void rtems_libio_iop_table_initialize( void );
+
+/**
+ * @brief Returns the count of free iops.
+ *
+ * Iops of future table extensions are not taken into account.
+ */
+uint32_t rtems_libio_iop_free_count( void );
+
 /*
  *  File System Routine Prototypes
  */
@@ -49,7 +49,8 @@ extern "C" {
  * Profiling information includes critical timing values such as the maximum
  * time of disabled thread dispatching which is a measure for the thread
  * dispatch latency.  On SMP configurations statistics of all SMP locks in the
- * system are available.
+ * system are available.  Contended SMP lock acquire operations are recorded
+ * per processor by lock and call site, see rtems_profiling_smp_lock_call_site.
  *
  * Profiling information can be retrieved via rtems_profiling_iterate() and
  * reported as an XML dump via rtems_profiling_report_xml().  These functions
@@ -75,7 +76,14 @@ typedef enum {
    *
    * @see rtems_profiling_smp_lock.
    */
-  RTEMS_PROFILING_SMP_LOCK
+  RTEMS_PROFILING_SMP_LOCK,
+
+  /**
+   * @brief Type of SMP lock call site profiling data.
+   *
+   * @see rtems_profiling_smp_lock_call_site.
+   */
+  RTEMS_PROFILING_SMP_LOCK_CALL_SITE
 } rtems_profiling_type;
 
 /**
@@ -88,6 +96,11 @@ typedef struct {
   rtems_profiling_type type;
 } rtems_profiling_header;
 
+/**
+ * @brief Count of latency histogram buckets for per-CPU profiling.
+ */
+#define RTEMS_PROFILING_LATENCY_BUCKETS 12
+
 /**
  * @brief Per-CPU profiling data.
  *
@@ -176,6 +189,55 @@ typedef struct {
    * This value may overflow.
    */
   uint64_t total_interrupt_time;
+
+  /**
+   * @brief The lower bounds of the latency histogram buckets in nanoseconds.
+   *
+   * The lower bound of each bucket is four times the lower bound of its
+   * predecessor, except for the first bucket which has a lower bound of zero.
+   * The last bucket has no upper bound.
+   */
+  uint32_t latency_lower_bounds[RTEMS_PROFILING_LATENCY_BUCKETS];
+
+  /**
+   * @brief The interrupt delay histogram if supported by the hardware.
+   *
+   * The count for index N corresponds to an interrupt delay greater than or
+   * equal to the lower bound N and less than the lower bound N plus one.
+   *
+   * The values may overflow.
+   *
+   * @see max_interrupt_delay.
+   */
+  uint32_t interrupt_delay_histogram[RTEMS_PROFILING_LATENCY_BUCKETS];
+
+  /**
+   * @brief The histogram of the times of disabled thread dispatching.
+   *
+   * The count for index N corresponds to a time of disabled thread dispatching
+   * greater than or equal to the lower bound N and less than the lower bound N
+   * plus one.
+   *
+   * The values may overflow.
+   */
+  uint32_t thread_dispatch_disabled_histogram[RTEMS_PROFILING_LATENCY_BUCKETS];
+
+  /**
+   * @brief The unblock to run latency histogram.
+   *
+   * The unblock to run latency is the time interval from the unblock of a
+   * thread, e.g. due to a semaphore release or an event send, up to the
+   * selection of this thread for execution by this processor.  Only the first
+   * selection after an unblock operation is counted, so the selection of a
+   * preempted thread does not contribute to the histogram.
+   *
+   * The count for index N corresponds to an unblock to run latency greater
+   * than or equal to the lower bound N and less than the lower bound N plus
+   * one.
+   *
+   * The values may overflow.
+   */
+  uint32_t unblock_to_run_histogram[RTEMS_PROFILING_LATENCY_BUCKETS];
 } rtems_profiling_per_cpu;
 
 /**
@@ -263,6 +325,96 @@ typedef struct {
   uint64_t contention_counts[RTEMS_PROFILING_SMP_LOCK_CONTENTION_COUNTS];
 } rtems_profiling_smp_lock;
 
+/**
+ * @brief Count of lock wait time histogram buckets for SMP lock call site
+ * profiling.
+ */
+#define RTEMS_PROFILING_SMP_LOCK_WAIT_TIME_BUCKETS 4
+
+/**
+ * @brief SMP lock call site profiling data.
+ *
+ * Each processor records the contended lock acquire operations by lock and
+ * call site.  The call site is the return address of the lock acquire
+ * function.  A lock acquire operation is contended if the lock was not
+ * immediately available.  Uncontended lock acquire operations are not
+ * recorded.  The count of call sites per processor is limited.  In case the
+ * limit is reached, then further call sites are only visible in the SMP lock
+ * profiling data.
+ *
+ * The lock wait time is the lock acquire time of a contended lock acquire
+ * operation.  The lock hold time is the lock section time which follows a
+ * contended lock acquire operation.
+ */
+typedef struct {
+  /**
+   * @brief The profiling data header.
+   */
+  rtems_profiling_header header;
+
+  /**
+   * @brief The processor index of this profiling data.
+   */
+  uint32_t processor_index;
+
+  /**
+   * @brief The lock name.
+   */
+  const char *name;
+
+  /**
+   * @brief The call site.
+   */
+  const void *call_site;
+
+  /**
+   * @brief The count of contended lock acquire operations.
+   *
+   * This value may overflow.
+   */
+  uint64_t contention_count;
+
+  /**
+   * @brief The maximum lock wait time in nanoseconds.
+   */
+  uint32_t max_wait_time;
+
+  /**
+   * @brief The maximum lock hold time in nanoseconds.
+   */
+  uint32_t max_hold_time;
+
+  /**
+   * @brief Total lock wait time in nanoseconds.
+   *
+   * This value may overflow.
+   */
+  uint64_t total_wait_time;
+
+  /**
+   * @brief Total lock hold time in nanoseconds.
+   *
+   * This value may overflow.
+   */
+  uint64_t total_hold_time;
+
+  /**
+   * @brief The lower bounds of the lock wait time histogram buckets in
+   * nanoseconds.
+   */
+  uint32_t wait_time_lower_bounds[RTEMS_PROFILING_SMP_LOCK_WAIT_TIME_BUCKETS];
+
+  /**
+   * @brief The lock wait time histogram.
+   *
+   * The count for index N corresponds to a lock wait time greater than or
+   * equal to the lower bound N and less than the lower bound N plus one.
+   *
+   * The values may overflow.
+   */
+  uint32_t wait_time_histogram[RTEMS_PROFILING_SMP_LOCK_WAIT_TIME_BUCKETS];
+} rtems_profiling_smp_lock_call_site;
+
 /**
  * @brief Collection of profiling data.
  */
@@ -281,6 +433,11 @@ typedef union {
    * @brief SMP lock profiling data if indicated by the header.
    */
   rtems_profiling_smp_lock smp_lock;
+
+  /**
+   * @brief SMP lock call site profiling data if indicated by the header.
+   */
+  rtems_profiling_smp_lock_call_site smp_lock_call_site;
 } rtems_profiling_data;
 
 /**
@@ -316,4 +316,25 @@
     RTEMS_SCHEDULER_TABLE_SIMPLE_SMP( name, obj_name )
 #endif
 
+#ifdef CONFIGURE_SCHEDULER_WORK_STEALING_SMP
+  #include <rtems/score/schedulerworkstealingsmp.h>
+
+  #define SCHEDULER_WORK_STEALING_SMP_CONTEXT_NAME( name ) \
+    SCHEDULER_CONTEXT_NAME( work_stealing_SMP_ ## name )
+
+  #define RTEMS_SCHEDULER_WORK_STEALING_SMP( name, max_cpu_count ) \
+    static struct { \
+      Scheduler_work_stealing_SMP_Context Base; \
+      Scheduler_work_stealing_SMP_Ready_queue Ready[ ( max_cpu_count ) ]; \
+    } SCHEDULER_WORK_STEALING_SMP_CONTEXT_NAME( name )
+
+  #define RTEMS_SCHEDULER_TABLE_WORK_STEALING_SMP( name, obj_name ) \
+    { \
+      &SCHEDULER_WORK_STEALING_SMP_CONTEXT_NAME( name ).Base.Base.Base, \
+      SCHEDULER_WORK_STEALING_SMP_ENTRY_POINTS, \
+      SCHEDULER_WORK_STEALING_SMP_MAXIMUM_PRIORITY, \
+      ( obj_name ) \
+    }
+#endif
+
 #endif /* _RTEMS_SAPI_SCHEDULER_H */
@@ -359,6 +359,20 @@
   #define RTEMS_PREDICT_FALSE( _exp ) ( _exp )
 #endif
 
+/**
+ * @brief Returns the return address of the current function.
+ *
+ * In case the function using this macro is inlined, then the return address
+ * of the function into which it was inlined is returned.
+ *
+ * @return The return address or NULL if not supported by the compiler.
+ */
+#if defined(__GNUC__)
+  #define RTEMS_RETURN_ADDRESS() __builtin_return_address( 0 )
+#else
+  #define RTEMS_RETURN_ADDRESS() NULL
+#endif
+
 #if __cplusplus >= 201103L
   #define RTEMS_STATIC_ASSERT(cond, msg) \
     static_assert(cond, # msg)
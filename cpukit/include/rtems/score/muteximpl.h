@@ -15,8 +15,12 @@
 #ifndef _RTEMS_SCORE_MUTEXIMPL_H
 #define _RTEMS_SCORE_MUTEXIMPL_H
 
+#include <rtems/score/atomic.h>
 #include <rtems/score/threadqimpl.h>
 
+#include <sys/lock.h>
+#include <rtems/thread.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -30,6 +34,116 @@ typedef struct {
   unsigned int nest_level;
 } Mutex_recursive_Control;
 
+/**
+ * @brief Statistics of a self-contained mutex.
+ *
+ * An entry is claimed by the first contended acquire of a mutex and is
+ * released by rtems_mutex_destroy() and rtems_recursive_mutex_destroy().
+ */
+typedef struct _Mutex_Statistics_entry {
+  /**
+   * @brief The address of the mutex or zero if this entry is unused.
+   */
+  Atomic_Uintptr mutex;
+
+  /**
+   * @brief Count of acquires which found the mutex owned by another thread.
+   */
+  Atomic_Ulong contended;
+
+  /**
+   * @brief Count of contended acquires which obtained the mutex while
+   * spinning.
+   */
+  Atomic_Ulong spin_acquired;
+
+  /**
+   * @brief Count of contended acquires which had to block.
+   */
+  Atomic_Ulong blocked;
+} Mutex_Statistics;
+
+/**
+ * @brief The table of mutex statistics in use.
+ *
+ * The structure is defined in <rtems/thread.h>, so that the inline destroy
+ * functions can check the count of table entries.  The entries member points
+ * to Mutex_Statistics table entries.  A count of zero disables the
+ * statistics.
+ */
+typedef struct _Mutex_Statistics_table Mutex_Statistics_table;
+
+/**
+ * @brief The table of mutex statistics in use.
+ *
+ * Set up by _Mutex_Statistics_initialize().
+ */
+extern Mutex_Statistics_table _Mutex_Statistics_table;
+
+/**
+ * @brief The table of mutex statistics.
+ *
+ * Defined by the application configuration via
+ * CONFIGURE_SELF_CONTAINED_MUTEX_STATISTICS, if it is greater than zero.
+ */
+extern Mutex_Statistics _Mutex_Statistics[];
+
+/**
+ * @brief The count of entries in the table of mutex statistics.
+ */
+extern const size_t _Mutex_Statistics_count;
+
+#if defined(RTEMS_SMP)
+/**
+ * @brief The maximum time in nanoseconds a contended acquire spins while the
+ * owner executes on another processor before it blocks.
+ *
+ * A value of zero disables the spinning.  Defined by the application
+ * configuration via CONFIGURE_SELF_CONTAINED_MUTEX_SPIN_TIME.
+ */
+extern const uint32_t _Mutex_Spin_time;
+#endif
+
+/**
+ * @brief Makes the table of mutex statistics defined by the application
+ * configuration available.
+ */
+void _Mutex_Statistics_initialize( void );
+
+/**
+ * @brief Looks up the statistics entry of the mutex.
+ *
+ * Only a bounded count of table entries is examined.  This function must be
+ * called with interrupts enabled.
+ *
+ * @param[in] mutex The mutex.
+ * @param[in] claim Claim an entry for this mutex, if none exists.
+ *
+ * @return The statistics entry or NULL if the mutex has no entry and none
+ * could be claimed.
+ */
+Mutex_Statistics *_Mutex_Statistics_lookup(
+  const struct _Mutex_Control *mutex,
+  bool                         claim
+);
+
+/**
+ * @brief Returns the statistics entry of the mutex.
+ *
+ * @see _Mutex_Statistics_lookup().
+ */
+RTEMS_INLINE_ROUTINE Mutex_Statistics *_Mutex_Statistics_get(
+  const struct _Mutex_Control *mutex,
+  bool                         claim
+)
+{
+  if ( RTEMS_PREDICT_TRUE( _Mutex_Statistics_table.count == 0 ) ) {
+    return NULL;
+  }
+
+  return _Mutex_Statistics_lookup( mutex, claim );
+}
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -39,7 +39,7 @@ extern "C" {
 
 #if defined(RTEMS_SMP)
   #if defined(RTEMS_PROFILING)
-    #define PER_CPU_CONTROL_SIZE_APPROX ( 512 + CPU_INTERRUPT_FRAME_SIZE )
+    #define PER_CPU_CONTROL_SIZE_APPROX ( 768 + CPU_INTERRUPT_FRAME_SIZE )
   #elif defined(RTEMS_DEBUG) || CPU_SIZEOF_POINTER > 4
     #define PER_CPU_CONTROL_SIZE_APPROX ( 256 + CPU_INTERRUPT_FRAME_SIZE )
   #else
@@ -173,6 +173,29 @@ typedef enum {
 
 #endif /* defined( RTEMS_SMP ) */
 
+#if defined( RTEMS_PROFILING )
+/**
+ * @brief Count of latency histogram buckets.
+ */
+#define PER_CPU_STATS_LATENCY_BUCKETS 12
+
+/**
+ * @brief Lower bound of the second latency histogram bucket in CPU counter
+ * ticks.
+ *
+ * The first bucket counts the latencies below this bound.  The lower bound of
+ * each following bucket is four times the lower bound of its predecessor.  The
+ * last bucket counts all latencies greater than or equal to its lower bound.
+ */
+#define PER_CPU_STATS_LATENCY_FIRST_BOUND \
+  ( 1U << PER_CPU_STATS_LATENCY_FIRST_BOUND_LOG2 )
+
+/**
+ * @brief Binary logarithm of PER_CPU_STATS_LATENCY_FIRST_BOUND.
+ */
+#define PER_CPU_STATS_LATENCY_FIRST_BOUND_LOG2 4
+#endif
+
 /**
  * @brief Per-CPU statistics.
  */
@@ -242,6 +265,34 @@ typedef struct {
    * This value may overflow.
    */
   uint64_t total_interrupt_time;
+
+  /**
+   * @brief Histogram of the interrupt delays if supported by the hardware.
+   *
+   * The values may overflow.
+   *
+   * @see PER_CPU_STATS_LATENCY_FIRST_BOUND.
+   */
+  uint32_t interrupt_delay_histogram[ PER_CPU_STATS_LATENCY_BUCKETS ];
+
+  /**
+   * @brief Histogram of the times of disabled thread dispatching.
+   *
+   * The values may overflow.
+   *
+   * @see PER_CPU_STATS_LATENCY_FIRST_BOUND.
+   */
+  uint32_t thread_dispatch_disabled_histogram[ PER_CPU_STATS_LATENCY_BUCKETS ];
+
+  /**
+   * @brief Histogram of the times between the unblock of a thread and its
+   * selection for execution on this processor.
+   *
+   * The values may overflow.
+   *
+   * @see PER_CPU_STATS_LATENCY_FIRST_BOUND.
+   */
+  uint32_t unblock_to_run_histogram[ PER_CPU_STATS_LATENCY_BUCKETS ];
 #endif /* defined( RTEMS_PROFILING ) */
 } Per_CPU_Stats;
 
@@ -544,7 +595,8 @@ extern Per_CPU_Control_envelope _Per_CPU_Information[] CPU_STRUCTURE_ALIGNMENT;
   _SMP_ticket_lock_Acquire( \
     &( cpu )->Lock, \
     &( cpu )->Lock_stats, \
-    &( cpu )->Lock_stats_context \
+    &( cpu )->Lock_stats_context, \
+    RTEMS_RETURN_ADDRESS() \
   )
 #else
 #define _Per_CPU_Acquire( cpu ) \
@@ -38,6 +38,42 @@ extern "C" {
  * @{
  */
 
+#if defined( RTEMS_PROFILING )
+/**
+ * @brief Increments the latency histogram bucket of the specified latency.
+ *
+ * The histogram is owned by one processor, so no synchronization is
+ * necessary.
+ *
+ * @param histogram The latency histogram.
+ * @param latency The latency in CPU counter ticks.
+ *
+ * @see PER_CPU_STATS_LATENCY_FIRST_BOUND.
+ */
+static inline void _Profiling_Update_latency_histogram(
+  uint32_t          *histogram,
+  CPU_Counter_ticks  latency
+)
+{
+  uint32_t index;
+
+  if ( latency < PER_CPU_STATS_LATENCY_FIRST_BOUND ) {
+    index = 0;
+  } else {
+    uint32_t msb;
+
+    msb = 31U - (uint32_t) __builtin_clz( (uint32_t) latency );
+    index = ( msb - PER_CPU_STATS_LATENCY_FIRST_BOUND_LOG2 ) / 2 + 1;
+
+    if ( index >= PER_CPU_STATS_LATENCY_BUCKETS ) {
+      index = PER_CPU_STATS_LATENCY_BUCKETS - 1;
+    }
+  }
+
+  ++histogram[ index ];
+}
+#endif
+
 static inline void _Profiling_Thread_dispatch_disable(
   Per_CPU_Control *cpu,
   uint32_t previous_thread_dispatch_disable_level
@@ -91,6 +127,10 @@ static inline void _Profiling_Thread_dispatch_enable(
     );
 
     stats->total_thread_dispatch_disabled_time += delta;
+    _Profiling_Update_latency_histogram(
+      stats->thread_dispatch_disabled_histogram,
+      delta
+    );
 
     if ( stats->max_thread_dispatch_disabled_time < delta ) {
       stats->max_thread_dispatch_disabled_time = delta;
@@ -113,12 +153,45 @@ static inline void _Profiling_Update_max_interrupt_delay(
   if ( stats->max_interrupt_delay < interrupt_delay ) {
     stats->max_interrupt_delay = interrupt_delay;
   }
+
+  _Profiling_Update_latency_histogram(
+    stats->interrupt_delay_histogram,
+    interrupt_delay
+  );
 #else
   (void) cpu;
   (void) interrupt_delay;
 #endif
 }
 
+/**
+ * @brief Updates the unblock to run latency histogram of the processor.
+ *
+ * Must be called with interrupts disabled on the processor which selected the
+ * unblocked thread for execution.
+ *
+ * @param cpu The processor.
+ * @param unblock_instant The unblock instant of the thread in CPU counter
+ *   ticks.
+ */
+static inline void _Profiling_Update_unblock_to_run_latency(
+  Per_CPU_Control   *cpu,
+  CPU_Counter_ticks  unblock_instant
+)
+{
+#if defined( RTEMS_PROFILING )
+  Per_CPU_Stats *stats = &cpu->Stats;
+
+  _Profiling_Update_latency_histogram(
+    stats->unblock_to_run_histogram,
+    _CPU_Counter_difference( _CPU_Counter_read(), unblock_instant )
+  );
+#else
+  (void) cpu;
+  (void) unblock_instant;
+#endif
+}
+
 /**
  * @brief Updates the interrupt profiling statistics.
  *
@@ -0,0 +1,267 @@
+/**
+ * @file
+ *
+ * @brief Work Stealing SMP Scheduler API
+ *
+ * @ingroup ScoreSchedulerSMPWorkStealing
+ */
+
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifndef _RTEMS_SCORE_SCHEDULERWORKSTEALINGSMP_H
+#define _RTEMS_SCORE_SCHEDULERWORKSTEALINGSMP_H
+
+#include <rtems/score/scheduler.h>
+#include <rtems/score/schedulerpriority.h>
+#include <rtems/score/schedulersmp.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup ScoreSchedulerSMPWorkStealing Work Stealing SMP Scheduler
+ *
+ * @ingroup ScoreSchedulerSMP
+ *
+ * The Work Stealing SMP Scheduler is a semi-partitioned fixed-priority
+ * scheduler.  Each processor owns a ready queue and each ready thread is
+ * enqueued in the ready queue of its home processor.  The home processor of a
+ * thread is the processor which executed it most recently.
+ *
+ * An unblocked thread preempts the thread of its home processor if it has a
+ * higher priority.  Otherwise, it stays in the ready queue of its home
+ * processor.  In case a processor of the scheduler instance executes an idle
+ * thread, then this processor is used instead of the home processor.
+ *
+ * In case a processor needs a new thread, then it selects the highest priority
+ * thread of its own ready queue.  Only if this queue is empty or contains only
+ * idle threads, the processor steals the highest priority thread from the
+ * ready queues of the other processors.  The ready queue search starts with
+ * the next processor to spread the stealing.
+ *
+ * Threads with a processor affinity which does not include all processors of
+ * the scheduler instance are bound to the highest numbered processor of the
+ * affinity set, in the same way as the EDF SMP scheduler does it.  Pinned
+ * threads are bound to their pinning processor.  Bound threads are never
+ * stolen by other processors.
+ *
+ * This scheduler trades the strict global priority order of the other SMP
+ * schedulers for shorter ready queues and less processor to processor
+ * interaction.  A ready thread may wait while another processor executes a
+ * lower priority thread until its home processor becomes available or a
+ * processor runs out of work.  Like all SMP schedulers, the operations of one
+ * scheduler instance are serialized by the scheduler instance lock.  Use
+ * clustered scheduling with one work stealing scheduler instance per cluster
+ * to partition this lock.
+ *
+ * The thread preempt mode will be ignored.
+ *
+ * @{
+ */
+
+typedef struct {
+  Scheduler_SMP_Node Base;
+
+  /**
+   * @brief The ready queue which contains this node in case it is ready.
+   */
+  RBTree_Control *ready_queue;
+
+  /**
+   * @brief The index of the home processor of this node.
+   *
+   * This is the processor which executed the node most recently.  It
+   * determines the ready queue of nodes which are not bound to a processor.
+   */
+  uint32_t home;
+
+  /**
+   * @brief The processor index plus one of the processor to which this node
+   * is bound depending on the processor affinity and pinning of the thread.
+   *
+   * The value zero indicates that the node may migrate to all processors of
+   * the scheduler instance.
+   */
+  uint32_t bound;
+
+  /**
+   * @brief Bound processor index plus one according to thread affinity.
+   */
+  uint32_t affinity_bound;
+
+  /**
+   * @brief Bound processor index plus one according to thread pinning.
+   */
+  uint32_t pinning_bound;
+} Scheduler_work_stealing_SMP_Node;
+
+typedef struct {
+  /**
+   * @brief The ready nodes bound to this processor.
+   *
+   * These nodes are never stolen by other processors.
+   */
+  RBTree_Control Bound;
+
+  /**
+   * @brief The ready nodes with this processor as the home processor.
+   *
+   * Other processors may steal nodes from this queue.
+   */
+  RBTree_Control Migratable;
+
+  /**
+   * @brief The scheduled node of the corresponding processor.
+   *
+   * This is a hint, see _Scheduler_work_stealing_SMP_Get_scheduled().
+   */
+  Scheduler_work_stealing_SMP_Node *scheduled;
+} Scheduler_work_stealing_SMP_Ready_queue;
+
+typedef struct {
+  Scheduler_SMP_Context Base;
+
+  /**
+   * @brief A table with one ready queue per processor.
+   *
+   * The table index is the processor index.
+   */
+  Scheduler_work_stealing_SMP_Ready_queue Ready[ RTEMS_ZERO_LENGTH_ARRAY ];
+} Scheduler_work_stealing_SMP_Context;
+
+#define SCHEDULER_WORK_STEALING_SMP_MAXIMUM_PRIORITY 255
+
+/**
+ * @brief Entry points for the Work Stealing SMP Scheduler.
+ */
+#define SCHEDULER_WORK_STEALING_SMP_ENTRY_POINTS \
+  { \
+    _Scheduler_work_stealing_SMP_Initialize, \
+    _Scheduler_default_Schedule, \
+    _Scheduler_work_stealing_SMP_Yield, \
+    _Scheduler_work_stealing_SMP_Block, \
+    _Scheduler_work_stealing_SMP_Unblock, \
+    _Scheduler_work_stealing_SMP_Update_priority, \
+    _Scheduler_default_Map_priority, \
+    _Scheduler_default_Unmap_priority, \
+    _Scheduler_work_stealing_SMP_Ask_for_help, \
+    _Scheduler_work_stealing_SMP_Reconsider_help_request, \
+    _Scheduler_work_stealing_SMP_Withdraw_node, \
+    _Scheduler_work_stealing_SMP_Pin, \
+    _Scheduler_work_stealing_SMP_Unpin, \
+    _Scheduler_work_stealing_SMP_Add_processor, \
+    _Scheduler_work_stealing_SMP_Remove_processor, \
+    _Scheduler_work_stealing_SMP_Node_initialize, \
+    _Scheduler_default_Node_destroy, \
+    _Scheduler_default_Release_job, \
+    _Scheduler_default_Cancel_job, \
+    _Scheduler_default_Tick, \
+    _Scheduler_work_stealing_SMP_Start_idle, \
+    _Scheduler_work_stealing_SMP_Set_affinity \
+  }
+
+void _Scheduler_work_stealing_SMP_Initialize(
+  const Scheduler_Control *scheduler
+);
+
+void _Scheduler_work_stealing_SMP_Node_initialize(
+  const Scheduler_Control *scheduler,
+  Scheduler_Node          *node,
+  Thread_Control          *the_thread,
+  Priority_Control         priority
+);
+
+void _Scheduler_work_stealing_SMP_Block(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *thread,
+  Scheduler_Node          *node
+);
+
+void _Scheduler_work_stealing_SMP_Unblock(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *thread,
+  Scheduler_Node          *node
+);
+
+void _Scheduler_work_stealing_SMP_Update_priority(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *the_thread,
+  Scheduler_Node          *node
+);
+
+bool _Scheduler_work_stealing_SMP_Ask_for_help(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *the_thread,
+  Scheduler_Node          *node
+);
+
+void _Scheduler_work_stealing_SMP_Reconsider_help_request(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *the_thread,
+  Scheduler_Node          *node
+);
+
+void _Scheduler_work_stealing_SMP_Withdraw_node(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *the_thread,
+  Scheduler_Node          *node,
+  Thread_Scheduler_state   next_state
+);
+
+void _Scheduler_work_stealing_SMP_Pin(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *the_thread,
+  Scheduler_Node          *node,
+  struct Per_CPU_Control  *cpu
+);
+
+void _Scheduler_work_stealing_SMP_Unpin(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *the_thread,
+  Scheduler_Node          *node,
+  struct Per_CPU_Control  *cpu
+);
+
+void _Scheduler_work_stealing_SMP_Add_processor(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *idle
+);
+
+Thread_Control *_Scheduler_work_stealing_SMP_Remove_processor(
+  const Scheduler_Control *scheduler,
+  struct Per_CPU_Control  *cpu
+);
+
+void _Scheduler_work_stealing_SMP_Yield(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *thread,
+  Scheduler_Node          *node
+);
+
+void _Scheduler_work_stealing_SMP_Start_idle(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *idle,
+  struct Per_CPU_Control  *cpu
+);
+
+bool _Scheduler_work_stealing_SMP_Set_affinity(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *thread,
+  Scheduler_Node          *node,
+  const Processor_mask    *affinity
+);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTEMS_SCORE_SCHEDULERWORKSTEALINGSMP_H */
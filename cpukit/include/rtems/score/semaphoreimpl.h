@@ -17,6 +17,7 @@
 
 #include <sys/lock.h>
 
+#include <rtems/score/atomic.h>
 #include <rtems/score/percpu.h>
 #include <rtems/score/threadqimpl.h>
 
@@ -26,7 +27,7 @@ extern "C" {
 
 typedef struct {
   Thread_queue_Syslock_queue Queue;
-  unsigned int count;
+  Atomic_Uint count;
 } Sem_Control;
 
 #define SEMAPHORE_TQ_OPERATIONS &_Thread_queue_Operations_priority
@@ -36,6 +37,55 @@ static inline Sem_Control *_Sem_Get( struct _Semaphore_Control *_sem )
   return (Sem_Control *) _sem;
 }
 
+/**
+ * @brief Decrements the semaphore count if it is positive.
+ *
+ * This function may be called without the queue lock.  The count is
+ * incremented only with the queue lock acquired and only if no thread waits
+ * for the semaphore.  A thread which found a zero count with the queue lock
+ * acquired is enqueued before the lock is released, so it cannot miss a post.
+ *
+ * @retval true The count was decremented.
+ * @retval false The count is zero.
+ */
+static inline bool _Sem_Try_decrement( Sem_Control *sem )
+{
+  unsigned int count;
+
+  count = _Atomic_Load_uint( &sem->count, ATOMIC_ORDER_RELAXED );
+
+  while ( count > 0 ) {
+    if (
+      _Atomic_Compare_exchange_uint(
+        &sem->count,
+        &count,
+        count - 1,
+        ATOMIC_ORDER_ACQUIRE,
+        ATOMIC_ORDER_RELAXED
+      )
+    ) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static inline unsigned int _Sem_Get_count( Sem_Control *sem )
+{
+  return _Atomic_Load_uint( &sem->count, ATOMIC_ORDER_RELAXED );
+}
+
+/**
+ * @brief Increments the semaphore count.
+ *
+ * The queue lock must be acquired and no thread may wait for the semaphore.
+ */
+static inline void _Sem_Increment( Sem_Control *sem )
+{
+  _Atomic_Fetch_add_uint( &sem->count, 1, ATOMIC_ORDER_RELEASE );
+}
+
 static inline Thread_Control *_Sem_Queue_acquire_critical(
   Sem_Control          *sem,
   Thread_queue_Context *queue_context
@@ -25,6 +25,7 @@
 #if defined(RTEMS_SMP)
 
 #include <rtems/score/smplockstats.h>
+#include <rtems/score/smplockmcs.h>
 #include <rtems/score/smplockticket.h>
 #include <rtems/score/isrlevel.h>
 
@@ -45,12 +46,18 @@ extern "C" {
  * @brief The SMP lock provides mutual exclusion for SMP systems at the lowest
  * level.
  *
- * The SMP lock is implemented as a ticket lock.  This provides fairness in
- * case of concurrent lock attempts.
+ * The SMP lock is implemented as a ticket lock by default.  This provides
+ * fairness in case of concurrent lock attempts.
  *
- * This SMP lock API uses a local context for acquire and release pairs.  Such
- * a context may be used to implement for example the Mellor-Crummey and Scott
- * (MCS) locks in the future.
+ * This SMP lock API uses a local context for acquire and release pairs.  In
+ * case RTEMS_SMP_LOCK_MCS is defined (configure option
+ * --enable-smp-lock-mcs), then this context is used to implement the SMP lock
+ * as a Mellor-Crummey and Scott (MCS) lock.  The MCS lock provides the same
+ * fairness as the ticket lock, however, each waiting processor busy waits on
+ * its own context and not on a cache line shared by all waiting processors.
+ * This reduces the cache line transfers under high lock contention.  The
+ * context used for an acquire must be used for the corresponding release and
+ * it must not be moved or reused in between.
  *
  * @{
  */
@@ -63,7 +70,11 @@ extern "C" {
  * @brief SMP lock control.
  */
 typedef struct {
+#if defined(RTEMS_SMP_LOCK_MCS)
+  SMP_MCS_lock_Control MCS_lock;
+#else
   SMP_ticket_lock_Control Ticket_lock;
+#endif
 #if defined(RTEMS_DEBUG)
   /**
    * @brief The index of the owning processor of this lock.
@@ -92,7 +103,9 @@ typedef struct {
 #if defined(RTEMS_DEBUG)
   SMP_lock_Control *lock_used_for_acquire;
 #endif
-#if defined(RTEMS_PROFILING)
+#if defined(RTEMS_SMP_LOCK_MCS)
+  SMP_MCS_lock_Context MCS_context;
+#elif defined(RTEMS_PROFILING)
   SMP_lock_Stats_context Stats_context;
 #endif
 } SMP_lock_Context;
@@ -101,24 +114,30 @@ typedef struct {
 #define SMP_LOCK_NO_OWNER 0
 #endif
 
+#if defined(RTEMS_SMP_LOCK_MCS)
+  #define SMP_LOCK_DO_INITIALIZER SMP_MCS_LOCK_INITIALIZER
+#else
+  #define SMP_LOCK_DO_INITIALIZER SMP_TICKET_LOCK_INITIALIZER
+#endif
+
 /**
  * @brief SMP lock control initializer for static initialization.
  */
 #if defined(RTEMS_DEBUG) && defined(RTEMS_PROFILING)
   #define SMP_LOCK_INITIALIZER( name ) \
     { \
-      SMP_TICKET_LOCK_INITIALIZER, \
+      SMP_LOCK_DO_INITIALIZER, \
       SMP_LOCK_NO_OWNER, \
       SMP_LOCK_STATS_INITIALIZER( name ) \
     }
 #elif defined(RTEMS_DEBUG)
   #define SMP_LOCK_INITIALIZER( name ) \
-    { SMP_TICKET_LOCK_INITIALIZER, SMP_LOCK_NO_OWNER }
+    { SMP_LOCK_DO_INITIALIZER, SMP_LOCK_NO_OWNER }
 #elif defined(RTEMS_PROFILING)
   #define SMP_LOCK_INITIALIZER( name ) \
-    { SMP_TICKET_LOCK_INITIALIZER, SMP_LOCK_STATS_INITIALIZER( name ) }
+    { SMP_LOCK_DO_INITIALIZER, SMP_LOCK_STATS_INITIALIZER( name ) }
 #else
-  #define SMP_LOCK_INITIALIZER( name ) { SMP_TICKET_LOCK_INITIALIZER }
+  #define SMP_LOCK_INITIALIZER( name ) { SMP_LOCK_DO_INITIALIZER }
 #endif
 
 static inline void _SMP_lock_Initialize_inline(
@@ -126,7 +145,11 @@ static inline void _SMP_lock_Initialize_inline(
   const char       *name
 )
 {
+#if defined(RTEMS_SMP_LOCK_MCS)
+  _SMP_MCS_lock_Initialize( &lock->MCS_lock );
+#else
   _SMP_ticket_lock_Initialize( &lock->Ticket_lock );
+#endif
 #if defined(RTEMS_DEBUG)
   lock->owner = SMP_LOCK_NO_OWNER;
 #endif
@@ -158,7 +181,11 @@ void _SMP_lock_Initialize(
 
 static inline void _SMP_lock_Destroy_inline( SMP_lock_Control *lock )
 {
+#if defined(RTEMS_SMP_LOCK_MCS)
+  _SMP_MCS_lock_Destroy( &lock->MCS_lock );
+#else
   _SMP_ticket_lock_Destroy( &lock->Ticket_lock );
+#endif
   _SMP_lock_Stats_destroy( &lock->Stats );
 }
 
@@ -187,9 +214,13 @@ static inline uint32_t _SMP_lock_Who_am_I( void )
 }
 #endif
 
-static inline void _SMP_lock_Acquire_inline(
+static inline void _SMP_lock_Do_acquire(
   SMP_lock_Control *lock,
   SMP_lock_Context *context
+#if defined(RTEMS_PROFILING)
+  ,
+  const void       *call_site
+#endif
 )
 {
 #if defined(RTEMS_DEBUG)
@@ -197,16 +228,38 @@ static inline void _SMP_lock_Acquire_inline(
 #else
   (void) context;
 #endif
+#if defined(RTEMS_SMP_LOCK_MCS)
+  _SMP_MCS_lock_Acquire(
+    &lock->MCS_lock,
+    &context->MCS_context,
+    &lock->Stats,
+    call_site
+  );
+#else
   _SMP_ticket_lock_Acquire(
     &lock->Ticket_lock,
     &lock->Stats,
-    &context->Stats_context
+    &context->Stats_context,
+    call_site
   );
+#endif
 #if defined(RTEMS_DEBUG)
   lock->owner = _SMP_lock_Who_am_I();
 #endif
 }
 
+/*
+ * The call site recorded for a contended acquire is the return address of
+ * the function using this inline acquire.
+ */
+#if defined(RTEMS_PROFILING)
+  #define _SMP_lock_Acquire_inline( lock, context ) \
+    _SMP_lock_Do_acquire( lock, context, RTEMS_RETURN_ADDRESS() )
+#else
+  #define _SMP_lock_Acquire_inline( lock, context ) \
+    _SMP_lock_Do_acquire( lock, context )
+#endif
+
 /**
  * @brief Acquires an SMP lock.
  *
@@ -236,10 +289,14 @@ static inline void _SMP_lock_Release_inline(
 #else
   (void) context;
 #endif
+#if defined(RTEMS_SMP_LOCK_MCS)
+  _SMP_MCS_lock_Release( &lock->MCS_lock, &context->MCS_context );
+#else
   _SMP_ticket_lock_Release(
     &lock->Ticket_lock,
     &context->Stats_context
   );
+#endif
 }
 
 /**
@@ -132,7 +132,8 @@ static inline void _SMP_MCS_lock_Do_acquire(
   SMP_MCS_lock_Context   *context
 #if defined(RTEMS_PROFILING)
   ,
-  SMP_lock_Stats         *stats
+  SMP_lock_Stats         *stats,
+  const void             *call_site
 #endif
 )
 {
@@ -172,7 +173,8 @@ static inline void _SMP_MCS_lock_Do_acquire(
     &acquire_context,
     stats,
     &context->Stats_context,
-    context->queue_length
+    context->queue_length,
+    call_site
   );
 #endif
 }
@@ -187,12 +189,13 @@ static inline void _SMP_MCS_lock_Do_acquire(
  * @param lock The SMP MCS lock control.
  * @param context The SMP MCS lock context.
  * @param stats The SMP lock statistics.
+ * @param call_site The call site recorded for a contended acquire.
  */
 #if defined(RTEMS_PROFILING)
-  #define _SMP_MCS_lock_Acquire( lock, context, stats ) \
-    _SMP_MCS_lock_Do_acquire( lock, context, stats )
+  #define _SMP_MCS_lock_Acquire( lock, context, stats, call_site ) \
+    _SMP_MCS_lock_Do_acquire( lock, context, stats, call_site )
 #else
-  #define _SMP_MCS_lock_Acquire( lock, context, stats ) \
+  #define _SMP_MCS_lock_Acquire( lock, context, stats, call_site ) \
     _SMP_MCS_lock_Do_acquire( lock, context )
 #endif
 
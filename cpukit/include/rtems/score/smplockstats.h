@@ -118,8 +118,102 @@ typedef struct {
    * @brief The lock name.
    */
   const char *name;
+
+  /**
+   * @brief Indicates if call site statistics may exist for this lock.
+   *
+   * @see SMP_lock_Call_site_stats.
+   */
+  bool has_call_sites;
 } SMP_lock_Stats;
 
+/**
+ * @brief Count of call site statistics per processor.
+ */
+#define SMP_LOCK_STATS_CALL_SITES 16
+
+/**
+ * @brief Count of lock wait time histogram buckets for call site statistics.
+ */
+#define SMP_LOCK_STATS_WAIT_TIME_BUCKETS 4
+
+/**
+ * @brief The upper bound of the first lock wait time histogram bucket in CPU
+ * counter ticks.
+ *
+ * The upper bound of the next bucket is the upper bound of the previous
+ * bucket multiplied by eight.  The last bucket has no upper bound.
+ */
+#define SMP_LOCK_STATS_WAIT_TIME_FIRST_BOUND 64
+
+/**
+ * @brief SMP lock call site statistics.
+ *
+ * Each processor records the contended lock acquire operations by lock and
+ * call site.  The call site is the return address of the lock acquire
+ * function.  A lock acquire operation is contended if the lock was not
+ * immediately available.  Uncontended lock acquire operations are not recorded
+ * to keep the overhead low.
+ *
+ * The lock wait time is the lock acquire time of a contended lock acquire
+ * operation.  The lock hold time is the lock section time which follows a
+ * contended lock acquire operation.
+ */
+typedef struct {
+  /**
+   * @brief The lock statistics of this call site.
+   *
+   * In case this field is NULL, then this call site statistics entry is
+   * unused.
+   */
+  const SMP_lock_Stats *stats;
+
+  /**
+   * @brief The call site.
+   */
+  const void *call_site;
+
+  /**
+   * @brief The count of contended lock acquire operations.
+   *
+   * This value may overflow.
+   */
+  uint64_t contention_count;
+
+  /**
+   * @brief Total lock wait time in CPU counter ticks.
+   *
+   * This value may overflow.
+   */
+  uint64_t total_wait_time;
+
+  /**
+   * @brief Total lock hold time in CPU counter ticks.
+   *
+   * This value may overflow.
+   */
+  uint64_t total_hold_time;
+
+  /**
+   * @brief The maximum lock wait time in CPU counter ticks.
+   */
+  CPU_Counter_ticks max_wait_time;
+
+  /**
+   * @brief The maximum lock hold time in CPU counter ticks.
+   */
+  CPU_Counter_ticks max_hold_time;
+
+  /**
+   * @brief The lock wait time histogram.
+   *
+   * @see SMP_LOCK_STATS_WAIT_TIME_FIRST_BOUND.
+   *
+   * The values may overflow.
+   */
+  uint32_t wait_time_histogram[ SMP_LOCK_STATS_WAIT_TIME_BUCKETS ];
+} SMP_lock_Call_site_stats;
+
 /**
  * @brief Local context for SMP lock statistics.
  */
@@ -135,13 +229,19 @@ typedef struct {
    * @brief The lock stats used for the last lock acquire.
    */
   SMP_lock_Stats *stats;
+
+  /**
+   * @brief The call site statistics of the last lock acquire in case it was
+   * contended, otherwise NULL.
+   */
+  SMP_lock_Call_site_stats *call_site;
 } SMP_lock_Stats_context;
 
 /**
  * @brief SMP lock statistics initializer for static initialization.
  */
 #define SMP_LOCK_STATS_INITIALIZER( name ) \
-  { { NULL, NULL }, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, name }
+  { { NULL, NULL }, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0, name, false }
 
 /**
  * @brief Initializes an SMP lock statistics block.
@@ -172,6 +272,57 @@ void _SMP_lock_Stats_register_or_max_section_time(
   CPU_Counter_ticks  max_section_time
 );
 
+/**
+ * @brief Records a contended lock acquire operation in the call site
+ * statistics of the current processor.
+ *
+ * @param[in] stats The SMP lock statistics block.
+ * @param[in, out] stats_context The SMP lock statistics context.
+ * @param[in] call_site The call site of the lock acquire operation.
+ * @param[in] wait_time The lock wait time in CPU counter ticks.
+ */
+void _SMP_lock_Stats_call_site_acquire(
+  SMP_lock_Stats         *stats,
+  SMP_lock_Stats_context *stats_context,
+  const void             *call_site,
+  CPU_Counter_ticks       wait_time
+);
+
+/**
+ * @brief Records the lock hold time after a contended lock acquire operation
+ * in the call site statistics of the current processor.
+ *
+ * @param[in] stats_context The SMP lock statistics context.
+ * @param[in] hold_time The lock hold time in CPU counter ticks.
+ */
+void _SMP_lock_Stats_call_site_release(
+  const SMP_lock_Stats_context *stats_context,
+  CPU_Counter_ticks             hold_time
+);
+
+/**
+ * @brief Gets a snapshot of the next used call site statistics entry of a
+ * processor.
+ *
+ * @param[in] cpu_index The index of the processor.
+ * @param[in, out] index The call site statistics index to start the search.
+ *   It is updated to the index after the returned entry.  Start with zero.
+ * @param[out] snapshot The snapshot of the call site statistics.  The stats
+ *   field of the snapshot is set to NULL.
+ * @param[out] name The buffer for the lock name.
+ * @param[in] name_size The size of the lock name buffer.
+ *
+ * @retval true A snapshot of a used entry was returned.
+ * @retval false There are no more used entries.
+ */
+bool _SMP_lock_Stats_call_site_next(
+  uint32_t                  cpu_index,
+  size_t                   *index,
+  SMP_lock_Call_site_stats *snapshot,
+  char                     *name,
+  size_t                    name_size
+);
+
 typedef struct {
   CPU_Counter_ticks first;
 } SMP_lock_Stats_acquire_context;
@@ -187,7 +338,8 @@ static inline void _SMP_lock_Stats_acquire_end(
   const SMP_lock_Stats_acquire_context *acquire_context,
   SMP_lock_Stats                       *stats,
   SMP_lock_Stats_context               *stats_context,
-  unsigned int                          queue_length
+  unsigned int                          queue_length,
+  const void                           *call_site
 )
 {
   CPU_Counter_ticks second;
@@ -199,6 +351,17 @@ static inline void _SMP_lock_Stats_acquire_end(
 
   ++stats->usage_count;
 
+  if ( RTEMS_PREDICT_FALSE( queue_length > 0 ) ) {
+    _SMP_lock_Stats_call_site_acquire(
+      stats,
+      stats_context,
+      call_site,
+      delta
+    );
+  } else {
+    stats_context->call_site = NULL;
+  }
+
   stats->total_acquire_time += delta;
 
   if ( stats->max_acquire_time < delta ) {
@@ -237,6 +400,10 @@ static inline void _SMP_lock_Stats_release_update(
   if ( stats->max_section_time < delta ) {
     _SMP_lock_Stats_register_or_max_section_time( stats, delta );
   }
+
+  if ( RTEMS_PREDICT_FALSE( stats_context->call_site != NULL ) ) {
+    _SMP_lock_Stats_call_site_release( stats_context, delta );
+  }
 }
 
 typedef struct {
@@ -83,7 +83,8 @@ static inline void _SMP_ticket_lock_Do_acquire(
 #if defined(RTEMS_PROFILING)
   ,
   SMP_lock_Stats          *stats,
-  SMP_lock_Stats_context  *stats_context
+  SMP_lock_Stats_context  *stats_context,
+  const void              *call_site
 #endif
 )
 {
@@ -119,7 +120,8 @@ static inline void _SMP_ticket_lock_Do_acquire(
     &acquire_context,
     stats,
     stats_context,
-    initial_queue_length
+    initial_queue_length,
+    call_site
   );
 #endif
 }
@@ -134,12 +136,13 @@ static inline void _SMP_ticket_lock_Do_acquire(
  * @param[in] lock The SMP ticket lock control.
  * @param[in] stats The SMP lock statistics.
  * @param[out] stats_context The SMP lock statistics context.
+ * @param[in] call_site The call site recorded for a contended acquire.
  */
 #if defined(RTEMS_PROFILING)
-  #define _SMP_ticket_lock_Acquire( lock, stats, stats_context ) \
-    _SMP_ticket_lock_Do_acquire( lock, stats, stats_context )
+  #define _SMP_ticket_lock_Acquire( lock, stats, stats_context, call_site ) \
+    _SMP_ticket_lock_Do_acquire( lock, stats, stats_context, call_site )
 #else
-  #define _SMP_ticket_lock_Acquire( lock, stats, stats_context ) \
+  #define _SMP_ticket_lock_Acquire( lock, stats, stats_context, call_site ) \
     _SMP_ticket_lock_Do_acquire( lock )
 #endif
 
@@ -788,6 +788,25 @@ struct _Thread_Control {
   SMP_lock_Stats Potpourri_stats;
 #endif
 
+#if defined(RTEMS_PROFILING)
+  /**
+   * @brief The instant of the last unblock operation of this thread in CPU
+   * counter ticks.
+   *
+   * This value is only valid if unblock_pending is true.
+   */
+  CPU_Counter_ticks unblock_instant;
+
+  /**
+   * @brief Indicates if this thread was unblocked and not yet selected for
+   * execution by a processor.
+   *
+   * It is used to update the unblock to run latency histogram of the
+   * processor which selects this thread for execution.
+   */
+  bool unblock_pending;
+#endif
+
   /** This field is true if the thread is an idle thread. */
   bool                                  is_idle;
 #if defined(RTEMS_MULTIPROCESSING)
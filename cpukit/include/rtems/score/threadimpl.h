@@ -27,6 +27,7 @@
 #include <rtems/score/interr.h>
 #include <rtems/score/isr.h>
 #include <rtems/score/objectimpl.h>
+#include <rtems/score/profiling.h>
 #include <rtems/score/schedulernodeimpl.h>
 #include <rtems/score/statesimpl.h>
 #include <rtems/score/status.h>
@@ -834,6 +835,13 @@ RTEMS_INLINE_ROUTINE Thread_Control *_Thread_Get_heir_and_make_it_executing(
   cpu_self->dispatch_necessary = false;
   cpu_self->executing = heir;
 
+#if defined(RTEMS_PROFILING)
+  if ( heir->unblock_pending ) {
+    heir->unblock_pending = false;
+    _Profiling_Update_unblock_to_run_latency( cpu_self, heir->unblock_instant );
+  }
+#endif
+
   return heir;
 }
 
@@ -404,11 +404,20 @@ struct Thread_queue_Queue {
    * Must be the first component of this structure to be able to re-use
    * implementation parts for structures defined by Newlib <sys/lock.h>.
    *
+   * The storage is defined by the ticket lock.  In case RTEMS_SMP_LOCK_MCS is
+   * defined, then this storage is used by an MCS lock.  A zero initialized
+   * storage is an unlocked lock in both cases.
+   *
    * @see _Thread_queue_Acquire(), _Thread_queue_Acquire_critical() and
    * _Thread_queue_Release().
    */
 #if defined(RTEMS_SMP)
-  SMP_ticket_lock_Control Lock;
+  union {
+    SMP_ticket_lock_Control Ticket_lock;
+#if defined(RTEMS_SMP_LOCK_MCS)
+    SMP_MCS_lock_Control MCS_lock;
+#endif
+  } Lock;
 #endif
 
   /**
@@ -430,7 +430,11 @@ RTEMS_INLINE_ROUTINE void _Thread_queue_Queue_initialize(
 )
 {
 #if defined(RTEMS_SMP)
-  _SMP_ticket_lock_Initialize( &queue->Lock );
+#if defined(RTEMS_SMP_LOCK_MCS)
+  _SMP_MCS_lock_Initialize( &queue->Lock.MCS_lock );
+#else
+  _SMP_ticket_lock_Initialize( &queue->Lock.Ticket_lock );
+#endif
 #endif
   queue->heads = NULL;
   queue->owner = NULL;
@@ -446,11 +450,21 @@ RTEMS_INLINE_ROUTINE void _Thread_queue_Queue_do_acquire_critical(
 )
 {
 #if defined(RTEMS_SMP)
+#if defined(RTEMS_SMP_LOCK_MCS)
+  _SMP_MCS_lock_Acquire(
+    &queue->Lock.MCS_lock,
+    &lock_context->Lock_context.MCS_context,
+    lock_stats,
+    RTEMS_RETURN_ADDRESS()
+  );
+#else
   _SMP_ticket_lock_Acquire(
-    &queue->Lock,
+    &queue->Lock.Ticket_lock,
     lock_stats,
-    &lock_context->Lock_context.Stats_context
+    &lock_context->Lock_context.Stats_context,
+    RTEMS_RETURN_ADDRESS()
   );
+#endif
 #else
   (void) queue;
   (void) lock_context;
@@ -473,10 +487,17 @@ RTEMS_INLINE_ROUTINE void _Thread_queue_Queue_release_critical(
 )
 {
 #if defined(RTEMS_SMP)
+#if defined(RTEMS_SMP_LOCK_MCS)
+  _SMP_MCS_lock_Release(
+    &queue->Lock.MCS_lock,
+    &lock_context->Lock_context.MCS_context
+  );
+#else
   _SMP_ticket_lock_Release(
-    &queue->Lock,
+    &queue->Lock.Ticket_lock,
     &lock_context->Lock_context.Stats_context
   );
+#endif
 #else
   (void) queue;
   (void) lock_context;
@@ -1113,7 +1134,7 @@ void _Thread_queue_Initialize(
       .Lock_stats = SMP_LOCK_STATS_INITIALIZER( _name ), \
       .owner = SMP_LOCK_NO_OWNER, \
       .Queue = { \
-        .Lock = SMP_TICKET_LOCK_INITIALIZER, \
+        .Lock = { .Ticket_lock = SMP_TICKET_LOCK_INITIALIZER }, \
         .heads = NULL, \
         .owner = NULL, \
         .name = _name \
@@ -1124,7 +1145,7 @@ void _Thread_queue_Initialize(
     { \
       .owner = SMP_LOCK_NO_OWNER, \
       .Queue = { \
-        .Lock = SMP_TICKET_LOCK_INITIALIZER, \
+        .Lock = { .Ticket_lock = SMP_TICKET_LOCK_INITIALIZER }, \
         .heads = NULL, \
         .owner = NULL, \
         .name = _name \
@@ -1135,7 +1156,7 @@ void _Thread_queue_Initialize(
     { \
       .Lock_stats = SMP_LOCK_STATS_INITIALIZER( _name ), \
       .Queue = { \
-        .Lock = SMP_TICKET_LOCK_INITIALIZER, \
+        .Lock = { .Ticket_lock = SMP_TICKET_LOCK_INITIALIZER }, \
         .heads = NULL, \
         .owner = NULL, \
         .name = _name \
@@ -1145,7 +1166,7 @@ void _Thread_queue_Initialize(
   #define THREAD_QUEUE_INITIALIZER( _name ) \
     { \
       .Queue = { \
-        .Lock = SMP_TICKET_LOCK_INITIALIZER, \
+        .Lock = { .Ticket_lock = SMP_TICKET_LOCK_INITIALIZER }, \
         .heads = NULL, \
         .owner = NULL, \
         .name = _name \
@@ -1167,7 +1188,11 @@ RTEMS_INLINE_ROUTINE void _Thread_queue_Destroy(
 )
 {
 #if defined(RTEMS_SMP)
-  _SMP_ticket_lock_Destroy( &the_thread_queue->Queue.Lock );
+#if defined(RTEMS_SMP_LOCK_MCS)
+  _SMP_MCS_lock_Destroy( &the_thread_queue->Queue.Lock.MCS_lock );
+#else
+  _SMP_ticket_lock_Destroy( &the_thread_queue->Queue.Lock.Ticket_lock );
+#endif
   _SMP_lock_Stats_destroy( &the_thread_queue->Lock_stats );
 #endif
 }
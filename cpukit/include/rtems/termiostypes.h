@@ -47,6 +47,11 @@ struct ttywakeup {
 
 /*
  * Variables associated with the character buffer
+ *
+ * For the raw input buffer, the Tail is only written by the producer
+ * (rtems_termios_enqueue_raw_characters()) and the Head is only written by
+ * the consumer (the reading task).  This allows both sides to move blocks
+ * of characters without the device lock if no flow control is active.
  */
 struct rtems_termios_rawbuf {
   char *theBuf;
@@ -238,6 +243,29 @@ typedef struct {
    * @brief Termios device mode.
    */
   rtems_termios_device_mode mode;
+
+  /**
+   * @brief Polled read of a block of characters.
+   *
+   * This handler is optional.  In case mode is TERMIOS_TASK_DRIVEN, then it
+   * is used instead of poll_read() to fetch all currently received characters
+   * at once.  In case mode is TERMIOS_POLLED, then it is used instead of
+   * poll_read() if no input processing is enabled (non-canonical mode without
+   * echo and without character translations).  The poll_read() handler must
+   * be provided nonetheless.
+   *
+   * @param[in] context The Termios device context.
+   * @param[out] buf The input buffer.
+   * @param[in] len The input buffer length in characters.
+   *
+   * @return The count of characters stored in the input buffer.  Zero
+   *   indicates that no data is currently available.
+   */
+  size_t (*poll_read_block)(
+    rtems_termios_device_context *context,
+    char                         *buf,
+    size_t                        len
+  );
 } rtems_termios_device_handler;
 
 /**
@@ -17,6 +17,7 @@
 
 #include <sys/lock.h>
 #include <errno.h>
+#include <stddef.h>
 #include <stdint.h>
 
 __BEGIN_DECLS
@@ -59,11 +60,73 @@ static __inline void rtems_mutex_unlock( rtems_mutex *mutex )
   _Mutex_Release( mutex );
 }
 
+/* Implementation detail, see Mutex_Statistics_table */
+struct _Mutex_Statistics_table {
+  struct _Mutex_Statistics_entry *entries;
+  size_t count;
+};
+
+extern struct _Mutex_Statistics_table _Mutex_Statistics_table;
+
+/* Releases the statistics entry of the mutex, if it has one */
+void _Mutex_Statistics_release( const struct _Mutex_Control * );
+
+static __inline void _Mutex_Statistics_release_if_enabled(
+  const struct _Mutex_Control *mutex
+)
+{
+  if ( _Mutex_Statistics_table.count != 0 ) {
+    _Mutex_Statistics_release( mutex );
+  }
+}
+
 static __inline void rtems_mutex_destroy( rtems_mutex *mutex )
 {
+  _Mutex_Statistics_release_if_enabled( mutex );
   _Mutex_Destroy( mutex );
 }
 
+/**
+ * @brief Statistics of a mutex.
+ *
+ * The statistics are only recorded if the application configuration provides
+ * a table for them, see CONFIGURE_SELF_CONTAINED_MUTEX_STATISTICS.  The
+ * statistics of a mutex are discarded by rtems_mutex_destroy() and
+ * rtems_recursive_mutex_destroy().
+ */
+typedef struct {
+  /**
+   * @brief Count of lock operations which found the mutex owned by another
+   * thread.
+   */
+  unsigned long contended;
+
+  /**
+   * @brief Count of contended lock operations which obtained the mutex while
+   * spinning, see CONFIGURE_SELF_CONTAINED_MUTEX_SPIN_TIME.
+   */
+  unsigned long spin_acquired;
+
+  /**
+   * @brief Count of contended lock operations which had to block.
+   */
+  unsigned long blocked;
+} rtems_mutex_statistics;
+
+/**
+ * @brief Gets the statistics of a mutex.
+ *
+ * @param[in] mutex The mutex.
+ * @param[out] statistics The statistics of the mutex.
+ *
+ * @retval 0 Successful operation.
+ * @retval ENOENT No contended lock operation was recorded for this mutex.
+ */
+int rtems_mutex_get_statistics(
+  const rtems_mutex      *mutex,
+  rtems_mutex_statistics *statistics
+);
+
 typedef struct _Mutex_recursive_Control rtems_recursive_mutex;
 
 #define RTEMS_RECURSIVE_MUTEX_INITIALIZER( name ) \
@@ -108,9 +171,18 @@ static __inline void rtems_recursive_mutex_destroy(
   rtems_recursive_mutex *mutex
 )
 {
+  _Mutex_Statistics_release_if_enabled( &mutex->_Mutex );
   _Mutex_recursive_Destroy( mutex );
 }
 
+static __inline int rtems_recursive_mutex_get_statistics(
+  const rtems_recursive_mutex *mutex,
+  rtems_mutex_statistics      *statistics
+)
+{
+  return rtems_mutex_get_statistics( &mutex->_Mutex, statistics );
+}
+
 typedef struct _Condition_Control rtems_condition_variable;
 
 #define RTEMS_CONDITION_VARIABLE_INITIALIZER( name ) \
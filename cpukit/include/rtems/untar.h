@@ -19,11 +19,13 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <tar.h>
 #include <zlib.h>
 #include <xz.h>
 
 #include <rtems/print.h>
+#include <rtems/rtems/tasks.h>
 
 /**
  *  @defgroup libmisc_untar_img Untar Image
@@ -238,6 +240,207 @@ int Untar_FromXzChunk_Print(
   const rtems_printer* printer
 );
 
+/**
+ * @brief Default count of writer tasks of a parallel extraction.
+ */
+#define UNTAR_PARALLEL_DEFAULT_WRITER_COUNT 2
+
+/**
+ * @brief Default size of the data buffers of a parallel extraction.
+ */
+#define UNTAR_PARALLEL_DEFAULT_BUFFER_SIZE (16 * 1024)
+
+/**
+ * @brief Compression of the archive stream of a parallel extraction.
+ */
+typedef enum {
+  UNTAR_PARALLEL_TAR,
+  UNTAR_PARALLEL_GZ,
+  UNTAR_PARALLEL_XZ
+} Untar_ParallelFormat;
+
+/**
+ * @brief Progress of a parallel extraction.
+ */
+typedef struct {
+  /**
+   * @brief Count of regular files.
+   */
+  unsigned long files;
+
+  /**
+   * @brief Count of directories.
+   */
+  unsigned long directories;
+
+  /**
+   * @brief Count of symbolic links.
+   */
+  unsigned long links;
+
+  /**
+   * @brief Count of members which had to wait for the writers to finish an
+   * earlier member with a conflicting path.
+   */
+  unsigned long barriers;
+
+  /**
+   * @brief Count of uncompressed archive bytes processed so far.
+   */
+  uint64_t archive_bytes;
+
+  /**
+   * @brief Count of bytes written to files so far.
+   */
+  uint64_t file_bytes;
+
+  /**
+   * @brief Time since the start of the extraction in nanoseconds.
+   */
+  uint64_t elapsed_ns;
+} Untar_ParallelStatistics;
+
+/**
+ * @brief Configuration of a parallel extraction.
+ *
+ * Zero initialized members select the defaults.
+ */
+typedef struct {
+  /**
+   * @brief Compression of the archive stream.
+   */
+  Untar_ParallelFormat format;
+
+  /**
+   * @brief Count of writer tasks.
+   *
+   * The application must configure the tasks.  Writers which cannot be
+   * created are omitted.  Without writers, the files are written by the
+   * calling task.
+   */
+  size_t writer_count;
+
+  /**
+   * @brief Priority of the writer tasks, zero selects the priority of the
+   * calling task.
+   */
+  rtems_task_priority writer_priority;
+
+  /**
+   * @brief Size of the data and decompression buffers.
+   */
+  size_t buffer_size;
+
+  /**
+   * @brief Count of data buffers, this bounds the files in flight.
+   */
+  size_t buffer_count;
+
+  /**
+   * @brief Maximum XZ dictionary size.
+   */
+  uint32_t xz_dict_max;
+
+  /**
+   * @brief Optional handler called by the parsing stage after each member.
+   */
+  void ( *progress )( const Untar_ParallelStatistics *stats, void *arg );
+
+  /**
+   * @brief Argument of the progress handler.
+   */
+  void *progress_arg;
+
+  /**
+   * @brief Optional printer for messages.
+   */
+  const rtems_printer *printer;
+} Untar_ParallelConfig;
+
+typedef struct Untar_ParallelContext Untar_ParallelContext;
+
+/**
+ * @brief Creates the context of a parallel extraction.
+ *
+ * The archive is processed by a pipeline.  The task which feeds the archive
+ * decompresses it and parses the headers.  It creates directories and
+ * symbolic links in archive order and passes the file contents to the writer
+ * tasks, which create and write the regular files in parallel.  A member
+ * waits for the writers to finish all earlier files with a path which is
+ * equal to or a parent of its path, or vice versa.  Paths which alias through
+ * symbolic links are not detected.
+ *
+ * The writer tasks use the global user environment, so relative paths are
+ * resolved with respect to the global current directory.  In case the
+ * calling task has a private user environment, the files are written by the
+ * calling task.
+ *
+ * @param[out] ctx Pointer to the created context.
+ * @param config The configuration.  May be NULL to select the defaults.
+ *
+ * @retval UNTAR_SUCCESSFUL Successful operation.
+ * @retval UNTAR_FAIL Not enough memory or decompressor error.
+ */
+int Untar_ParallelContext_Create(
+  Untar_ParallelContext **ctx,
+  const Untar_ParallelConfig *config
+);
+
+/**
+ * @brief Feeds a chunk of the archive stream to a parallel extraction.
+ *
+ * The chunk is copied, so it may be reused after the call.  This function
+ * blocks while all data buffers are in use.
+ *
+ * @retval UNTAR_SUCCESSFUL Successful operation.
+ * @retval UNTAR_FAIL For a faulty step within the process.
+ * @retval UNTAR_INVALID_CHECKSUM For an invalid header checksum.
+ * @retval UNTAR_GZ_INFLATE_FAILED For a corrupt GZ stream.
+ */
+int Untar_FromChunk_Parallel(
+  Untar_ParallelContext *ctx,
+  const void *chunk,
+  size_t chunk_size
+);
+
+/**
+ * @brief Waits for the writers, deletes them and destroys the context.
+ *
+ * @param ctx The context.
+ * @param[out] stats The final statistics.  May be NULL.
+ *
+ * @return The first error of the extraction, otherwise UNTAR_SUCCESSFUL.
+ */
+int Untar_ParallelContext_Finish(
+  Untar_ParallelContext *ctx,
+  Untar_ParallelStatistics *stats
+);
+
+/**
+ * @brief Extracts an archive in memory in parallel.
+ *
+ * The writers use the file contents in place for uncompressed archives.
+ *
+ * @see Untar_ParallelContext_Create().
+ */
+int Untar_FromMemory_Parallel(
+  const void *tar_buf,
+  size_t size,
+  const Untar_ParallelConfig *config,
+  Untar_ParallelStatistics *stats
+);
+
+/**
+ * @brief Extracts an archive file in parallel.
+ *
+ * @see Untar_ParallelContext_Create().
+ */
+int Untar_FromFile_Parallel(
+  const char *tar_name,
+  const Untar_ParallelConfig *config,
+  Untar_ParallelStatistics *stats
+);
+
 /**************************************************************************
  * This converts octal ASCII number representations into an
  * unsigned long.  Only support 32-bit numbers for now.
@@ -253,6 +456,21 @@ _rtems_octal2ulong(const char *octascii, size_t len);
 extern int
 _rtems_tar_header_checksum(const char *bufr);
 
+/************************************************************************
+ * Decode a TAR header and create the directories and symbolic links it
+ * describes.  For a regular file the path to it is created.
+ ************************************************************************/
+extern int
+Untar_ProcessHeader(
+  const char          *bufr,
+  char                *fname,
+  unsigned long       *mode,
+  unsigned long       *file_size,
+  unsigned long       *nblocks,
+  unsigned char       *linkflag,
+  const rtems_printer *printer
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,7 +28,7 @@ int close(
   unsigned int   flags;
   int            rc;
 
-  if ( (uint32_t) fd >= rtems_libio_number_iops ) {
+  if ( (uint32_t) fd >= rtems_libio_iop_get_table_size() ) {
     rtems_set_errno_and_return_minus_one( EBADF );
   }
 
@@ -65,7 +65,7 @@ static int duplicate2_iop( rtems_libio_t *iop, int fd2 )
   rtems_libio_t *iop2;
   int            rv = 0;
 
-  if ( (uint32_t) fd2 >= rtems_libio_number_iops ) {
+  if ( (uint32_t) fd2 >= rtems_libio_iop_get_table_size() ) {
     rtems_set_errno_and_return_minus_one( EBADF );
   }
 
@@ -27,6 +27,8 @@
 #include <rtems.h>
 #include <rtems/libio_.h>
 #include <rtems/assoc.h>
+#include <rtems/score/percpudata.h>
+#include <rtems/score/wkspace.h>
 
 /* define this to alias O_NDELAY to  O_NONBLOCK, i.e.,
  * O_NDELAY is accepted on input but fcntl(F_GETFL) returns
@@ -106,26 +108,272 @@ int rtems_libio_to_fcntl_flags( unsigned int flags )
   return fcntl_flags;
 }
 
-rtems_libio_t *rtems_libio_allocate( void )
+/*
+ * Free iops are kept in one FIFO list per processor.  Released iops are
+ * appended to the list of the current processor and allocations try this
+ * list first, so that processors opening and closing files concurrently do
+ * not contend for a common lock.
+ */
+typedef struct {
+  rtems_interrupt_lock  lock;
+  void                 *head;
+  void                **tail;
+  uint32_t              count;
+} rtems_libio_iop_free_list;
+
+static PER_CPU_DATA_ITEM( rtems_libio_iop_free_list, rtems_libio_iop_free );
+
+rtems_libio_t *rtems_libio_iop_blocks[ RTEMS_LIBIO_IOP_BLOCK_COUNT ];
+
+Atomic_Uint rtems_libio_iop_table_size = ATOMIC_INITIALIZER_UINT( 0 );
+
+static uint32_t rtems_libio_iop_block_next = 1;
+
+static rtems_libio_iop_free_list *rtems_libio_iop_get_free_list(
+  uint32_t cpu_index
+)
 {
-  rtems_libio_t *iop;
+  Per_CPU_Control           *cpu;
+  rtems_libio_iop_free_list *free_list;
+
+  cpu = _Per_CPU_Get_by_index( cpu_index );
+  free_list = PER_CPU_DATA_GET(
+    cpu,
+    rtems_libio_iop_free_list,
+    rtems_libio_iop_free
+  );
+
+  return free_list;
+}
 
-  rtems_libio_lock();
+static uint32_t rtems_libio_iop_get_cpu_index( void )
+{
+  return _Per_CPU_Get_index( _Per_CPU_Get_snapshot() );
+}
 
-  iop = rtems_libio_iop_free_head;
+static void rtems_libio_iop_append(
+  rtems_libio_iop_free_list *free_list,
+  rtems_libio_t             *first,
+  void                     **last,
+  uint32_t                   count
+)
+{
+  rtems_interrupt_lock_context lock_context;
+
+  rtems_interrupt_lock_acquire( &free_list->lock, &lock_context );
+  *free_list->tail = first;
+  free_list->tail = last;
+  free_list->count += count;
+  rtems_interrupt_lock_release( &free_list->lock, &lock_context );
+}
+
+static rtems_libio_t *rtems_libio_iop_get(
+  rtems_libio_iop_free_list *free_list
+)
+{
+  rtems_interrupt_lock_context  lock_context;
+  rtems_libio_t                *iop;
+
+  rtems_interrupt_lock_acquire( &free_list->lock, &lock_context );
+
+  iop = free_list->head;
 
   if ( iop != NULL ) {
     void *next;
 
     next = iop->data1;
-    rtems_libio_iop_free_head = next;
+    free_list->head = next;
+    --free_list->count;
 
     if ( next == NULL ) {
-      rtems_libio_iop_free_tail = &rtems_libio_iop_free_head;
+      free_list->tail = &free_list->head;
     }
   }
 
-  rtems_libio_unlock();
+  rtems_interrupt_lock_release( &free_list->lock, &lock_context );
+
+  return iop;
+}
+
+static rtems_libio_t *rtems_libio_iop_get_any( uint32_t cpu_self )
+{
+  rtems_libio_t *iop;
+  uint32_t       cpu_max;
+  uint32_t       cpu_index;
+
+  iop = rtems_libio_iop_get( rtems_libio_iop_get_free_list( cpu_self ) );
+
+  if ( RTEMS_PREDICT_TRUE( iop != NULL ) ) {
+    return iop;
+  }
+
+  cpu_max = rtems_configuration_get_maximum_processors();
+
+  for ( cpu_index = 0; cpu_index < cpu_max; ++cpu_index ) {
+    if ( cpu_index != cpu_self ) {
+      iop = rtems_libio_iop_get( rtems_libio_iop_get_free_list( cpu_index ) );
+
+      if ( iop != NULL ) {
+        break;
+      }
+    }
+  }
+
+  return iop;
+}
+
+static void rtems_libio_iop_append_block(
+  rtems_libio_iop_free_list *free_list,
+  rtems_libio_t             *iops,
+  uint32_t                   count,
+  uint32_t                   descriptor
+)
+{
+  uint32_t i;
+
+  if ( count == 0 ) {
+    return;
+  }
+
+  for ( i = 0; ( i + 1 ) < count; ++i ) {
+    iops[ i ].data1 = &iops[ i + 1 ];
+    iops[ i ].descriptor = (int) ( descriptor + i );
+  }
+
+  iops[ count - 1 ].descriptor = (int) ( descriptor + count - 1 );
+  iops[ count - 1 ].data1 = NULL;
+  rtems_libio_iop_append(
+    free_list,
+    &iops[ 0 ],
+    &iops[ count - 1 ].data1,
+    count
+  );
+}
+
+/*
+ * Adds a block to the iop table which doubles its size.  Must be called with
+ * the libio lock held.  Returns the first iop of the new block, the others
+ * are added to the free list of the current processor.
+ */
+static rtems_libio_t *rtems_libio_iop_table_extend( uint32_t cpu_self )
+{
+  rtems_libio_t *iops;
+  uint32_t       block;
+  uint32_t       size;
+
+  block = rtems_libio_iop_block_next;
+  size = rtems_libio_iop_get_table_size();
+
+  if (
+    size == 0
+      || block >= RTEMS_LIBIO_IOP_BLOCK_COUNT
+      || size > (uint32_t) INT_MAX / 2
+  ) {
+    return NULL;
+  }
+
+  iops = _Workspace_Allocate( size * sizeof( *iops ) );
+  if ( iops == NULL ) {
+    return NULL;
+  }
+
+  memset( iops, 0, size * sizeof( *iops ) );
+  iops[ 0 ].descriptor = (int) size;
+
+  /* The new descriptors must be mappable before anyone can obtain them */
+  rtems_libio_iop_blocks[ block ] = iops;
+  rtems_libio_iop_block_next = block + 1;
+  _Atomic_Store_uint(
+    &rtems_libio_iop_table_size,
+    2 * size,
+    ATOMIC_ORDER_RELEASE
+  );
+
+  rtems_libio_iop_append_block(
+    rtems_libio_iop_get_free_list( cpu_self ),
+    &iops[ 1 ],
+    size - 1,
+    size + 1
+  );
+
+  return &iops[ 0 ];
+}
+
+void rtems_libio_iop_table_initialize( void )
+{
+  uint32_t cpu_max;
+  uint32_t cpu_index;
+
+  cpu_max = rtems_configuration_get_maximum_processors();
+
+  for ( cpu_index = 0; cpu_index < cpu_max; ++cpu_index ) {
+    rtems_libio_iop_free_list *free_list;
+
+    free_list = rtems_libio_iop_get_free_list( cpu_index );
+    rtems_interrupt_lock_initialize( &free_list->lock, "LibIO Free" );
+    free_list->head = NULL;
+    free_list->tail = &free_list->head;
+    free_list->count = 0;
+  }
+
+  rtems_libio_iop_blocks[ 0 ] = rtems_libio_iops;
+  _Atomic_Store_uint(
+    &rtems_libio_iop_table_size,
+    rtems_libio_number_iops,
+    ATOMIC_ORDER_RELEASE
+  );
+
+  /* The standard file descriptors are opened by the boot processor */
+  rtems_libio_iop_append_block(
+    rtems_libio_iop_get_free_list( 0 ),
+    rtems_libio_iops,
+    rtems_libio_number_iops,
+    0
+  );
+}
+
+uint32_t rtems_libio_iop_free_count( void )
+{
+  uint32_t cpu_max;
+  uint32_t cpu_index;
+  uint32_t count;
+
+  cpu_max = rtems_configuration_get_maximum_processors();
+  count = 0;
+
+  for ( cpu_index = 0; cpu_index < cpu_max; ++cpu_index ) {
+    rtems_libio_iop_free_list    *free_list;
+    rtems_interrupt_lock_context  lock_context;
+
+    free_list = rtems_libio_iop_get_free_list( cpu_index );
+    rtems_interrupt_lock_acquire( &free_list->lock, &lock_context );
+    count += free_list->count;
+    rtems_interrupt_lock_release( &free_list->lock, &lock_context );
+  }
+
+  return count;
+}
+
+rtems_libio_t *rtems_libio_allocate( void )
+{
+  rtems_libio_t *iop;
+  uint32_t       cpu_self;
+
+  cpu_self = rtems_libio_iop_get_cpu_index();
+  iop = rtems_libio_iop_get_any( cpu_self );
+
+  if ( iop == NULL && rtems_libio_iops_unlimited ) {
+    rtems_libio_lock();
+
+    /* Another thread may have extended the table in the meantime */
+    iop = rtems_libio_iop_get_any( cpu_self );
+
+    if ( iop == NULL ) {
+      iop = rtems_libio_iop_table_extend( cpu_self );
+    }
+
+    rtems_libio_unlock();
+  }
 
   return iop;
 }
@@ -134,13 +382,17 @@ void rtems_libio_free(
   rtems_libio_t *iop
 )
 {
-  rtems_filesystem_location_free( &iop->pathinfo );
+  int descriptor;
 
-  rtems_libio_lock();
+  rtems_filesystem_location_free( &iop->pathinfo );
 
+  descriptor = iop->descriptor;
   iop = memset( iop, 0, sizeof( *iop ) );
-  *rtems_libio_iop_free_tail = iop;
-  rtems_libio_iop_free_tail = &iop->data1;
-
-  rtems_libio_unlock();
+  iop->descriptor = descriptor;
+  rtems_libio_iop_append(
+    rtems_libio_iop_get_free_list( rtems_libio_iop_get_cpu_index() ),
+    iop,
+    &iop->data1,
+    1
+  );
 }
@@ -41,24 +41,11 @@ void rtems_libio_unlock( void )
   _API_Mutex_Unlock( &rtems_libio_mutex );
 }
 
-void *rtems_libio_iop_free_head;
-
-void **rtems_libio_iop_free_tail = &rtems_libio_iop_free_head;
-
 static void rtems_libio_init( void )
 {
-    uint32_t i;
-    rtems_libio_t *iop;
     int eno;
 
-    if (rtems_libio_number_iops > 0)
-    {
-        iop = rtems_libio_iop_free_head = &rtems_libio_iops[0];
-        for (i = 0 ; (i + 1) < rtems_libio_number_iops ; i++, iop++)
-          iop->data1 = iop + 1;
-        iop->data1 = NULL;
-        rtems_libio_iop_free_tail = &iop->data1;
-    }
+    rtems_libio_iop_table_initialize();
 
   /*
    *  Create the posix key for user environment.
@@ -54,21 +54,17 @@ static const struct {
 
 static int open_files(void)
 {
-  int free_count = 0;
-  rtems_libio_t *iop;
+  int free_count;
+  int table_size;
 
   rtems_libio_lock();
 
-  iop = rtems_libio_iop_free_head;
-  while (iop != NULL) {
-    ++free_count;
-
-    iop = iop->data1;
-  }
+  table_size = (int) rtems_libio_iop_get_table_size();
+  free_count = (int) rtems_libio_iop_free_count();
 
   rtems_libio_unlock();
 
-  return (int) rtems_libio_number_iops - free_count;
+  return table_size - free_count;
 }
 
 static void get_heap_info(Heap_Control *heap, Heap_Information_block *info)
@@ -24,6 +24,7 @@
 #include <rtems/libio.h>
 #include <rtems/imfs.h>
 #include <rtems/score/assert.h>
+#include <rtems/score/atomic.h>
 #include <ctype.h>
 #include <errno.h>
 #include <stdio.h>
@@ -62,6 +63,11 @@
 #define FL_MDXON   0x200U    /* input controlled with XON/XOFF protocol    */
 #define FL_MDXOF   0x400U    /* output controlled with XON/XOFF protocol   */
 
+#define FL_MDMASK  (FL_MDRTS | FL_MDXON | FL_MDXOF)
+
+/* input flags which require processing of each received character */
+#define IFLAG_PROCESSING (IGNCR | ISTRIP | IUCLC | ICRNL | INLCR)
+
 #define NODISC(n) \
   { NULL,  NULL,  NULL,  NULL, \
     NULL,  NULL,  NULL,  NULL }
@@ -637,9 +643,13 @@ flushInput (struct rtems_termios_tty *tty)
   rtems_termios_device_context *ctx = tty->device_context;
   rtems_interrupt_lock_context lock_context;
 
+  /*
+   * Only the consumer side may be changed here, since the producer may append
+   * characters without the device lock.  All writers of the Head hold the
+   * device lock.
+   */
   rtems_termios_device_lock_acquire (ctx, &lock_context);
-  tty->rawInBuf.Tail = 0;
-  tty->rawInBuf.Head = 0;
+  tty->rawInBuf.Head = tty->rawInBuf.Tail;
   rtems_termios_device_lock_release (ctx, &lock_context);
 }
 
@@ -1375,6 +1385,27 @@ siprocPoll (unsigned char c, rtems_termios_tty *tty)
   return siproc (c, tty);
 }
 
+/*
+ * Read a block of characters directly into the cooked buffer.
+ * Returns -1 if no characters are available.
+ */
+static int
+pollReadBlock (rtems_termios_tty *tty)
+{
+  size_t n;
+
+  if (tty->ccount >= CBUFSIZE - 1)
+    return -1;
+
+  n = (*tty->handler.poll_read_block)(tty->device_context,
+    &tty->cbuf[tty->ccount], (size_t) (CBUFSIZE - 1 - tty->ccount));
+  if (n == 0)
+    return -1;
+
+  tty->ccount += (int) n;
+  return (int) n;
+}
+
 /*
  * Fill the input buffer by polling the device
  */
@@ -1395,10 +1426,18 @@ fillBufferPoll (struct rtems_termios_tty *tty)
     }
   } else {
     rtems_interval then, now;
+    bool block;
+
+    block = tty->handler.poll_read_block != NULL &&
+      (tty->termios.c_iflag & IFLAG_PROCESSING) == 0 &&
+      (tty->termios.c_lflag & ECHO) == 0;
 
     then = rtems_clock_get_ticks_since_boot();
     for (;;) {
-      n = (*tty->handler.poll_read)(tty->device_context);
+      if (block)
+        n = pollReadBlock (tty);
+      else
+        n = (*tty->handler.poll_read)(tty->device_context);
       if (n < 0) {
         if (tty->termios.c_cc[VMIN]) {
           if (tty->termios.c_cc[VTIME] && tty->ccount) {
@@ -1417,7 +1456,8 @@ fillBufferPoll (struct rtems_termios_tty *tty)
         }
         rtems_task_wake_after (1);
       } else {
-        siprocPoll (n, tty);
+        if (!block)
+          siprocPoll (n, tty);
         if (tty->ccount >= tty->termios.c_cc[VMIN])
           break;
         if (tty->termios.c_cc[VMIN] && tty->termios.c_cc[VTIME])
@@ -1427,6 +1467,61 @@ fillBufferPoll (struct rtems_termios_tty *tty)
   }
 }
 
+/*
+ * Copy characters from the raw input queue to the cooked buffer without the
+ * device lock.  This is only possible if the cooked input needs no processing
+ * and no flow control is active.  Returns the count of copied characters.
+ */
+static unsigned int
+copyRawInputBulk (struct rtems_termios_tty *tty)
+{
+  rtems_termios_device_context *ctx = tty->device_context;
+  rtems_interrupt_lock_context lock_context;
+  unsigned int size = tty->rawInBuf.Size;
+  unsigned int start = tty->rawInBuf.Head;
+  unsigned int head = start;
+  unsigned int tail = tty->rawInBuf.Tail;
+  unsigned int copied = 0;
+
+  /* Pairs with the release fence of the producer */
+  _Atomic_Fence (ATOMIC_ORDER_ACQUIRE);
+
+  while ((head != tail) && (tty->ccount < (CBUFSIZE-1))) {
+    unsigned int first;
+    unsigned int n;
+
+    first = (head + 1) % size;
+    if (tail >= first)
+      n = tail - first + 1;
+    else
+      n = size - first;
+
+    if (n > (unsigned int) (CBUFSIZE - 1 - tty->ccount))
+      n = CBUFSIZE - 1 - tty->ccount;
+
+    memcpy (&tty->cbuf[tty->ccount], &tty->rawInBuf.theBuf[first], n);
+    tty->ccount += n;
+    head = (head + n) % size;
+    copied += n;
+  }
+
+  if (copied > 0) {
+    /*
+     * The Head is only written under the device lock.  If it moved during the
+     * copy, then the input was flushed and the flushed Head must be kept.
+     */
+    rtems_termios_device_lock_acquire (ctx, &lock_context);
+    if (tty->rawInBuf.Head == start) {
+      /* Do not let the producer overwrite characters not yet copied */
+      _Atomic_Fence (ATOMIC_ORDER_RELEASE);
+      tty->rawInBuf.Head = head;
+    }
+    rtems_termios_device_lock_release (ctx, &lock_context);
+  }
+
+  return copied;
+}
+
 /*
  * Fill the input buffer from the raw input queue
  */
@@ -1441,60 +1536,75 @@ fillBufferQueue (struct rtems_termios_tty *tty)
     rtems_interrupt_lock_context lock_context;
 
     /*
-     * Process characters read from raw queue
+     * Move blocks of characters in raw mode
      */
+    if ((tty->flow_ctrl & FL_MDMASK) == 0 &&
+        (tty->termios.c_lflag & (ICANON | ECHO)) == 0) {
+      if (copyRawInputBulk (tty) > 0) {
+        if (tty->ccount >= tty->termios.c_cc[VMIN])
+          wait = false;
+        timeout = tty->rawInBufSemaphoreTimeout;
+      }
+    } else {
+      /*
+       * Process characters read from raw queue
+       */
 
-    rtems_termios_device_lock_acquire (ctx, &lock_context);
+      rtems_termios_device_lock_acquire (ctx, &lock_context);
 
-    while ((tty->rawInBuf.Head != tty->rawInBuf.Tail) &&
-                       (tty->ccount < (CBUFSIZE-1))) {
-      unsigned char c;
-      unsigned int newHead;
-
-      newHead = (tty->rawInBuf.Head + 1) % tty->rawInBuf.Size;
-      c = tty->rawInBuf.theBuf[newHead];
-      tty->rawInBuf.Head = newHead;
-
-      if(((tty->rawInBuf.Tail - newHead) % tty->rawInBuf.Size)
-         < tty->lowwater) {
-        tty->flow_ctrl &= ~FL_IREQXOF;
-        /* if tx stopped and XON should be sent... */
-        if (((tty->flow_ctrl & (FL_MDXON | FL_ISNTXOF))
-             ==                (FL_MDXON | FL_ISNTXOF))
-            && ((tty->rawOutBufState == rob_idle)
-          || (tty->flow_ctrl & FL_OSTOP))) {
-          /* XON should be sent now... */
-          (*tty->handler.write)(
-            tty->device_context, (void *)&(tty->termios.c_cc[VSTART]), 1);
-        } else if (tty->flow_ctrl & FL_MDRTS) {
-          tty->flow_ctrl &= ~FL_IRTSOFF;
-          /* activate RTS line */
-          if (tty->flow.start_remote_tx != NULL) {
-            tty->flow.start_remote_tx(tty->device_context);
+      while ((tty->rawInBuf.Head != tty->rawInBuf.Tail) &&
+                         (tty->ccount < (CBUFSIZE-1))) {
+        unsigned char c;
+        unsigned int newHead;
+
+        /* Pairs with the release fence of the producer */
+        _Atomic_Fence (ATOMIC_ORDER_ACQUIRE);
+        newHead = (tty->rawInBuf.Head + 1) % tty->rawInBuf.Size;
+        c = tty->rawInBuf.theBuf[newHead];
+        _Atomic_Fence (ATOMIC_ORDER_RELEASE);
+        tty->rawInBuf.Head = newHead;
+
+        if(((tty->rawInBuf.Tail - newHead) % tty->rawInBuf.Size)
+           < tty->lowwater) {
+          tty->flow_ctrl &= ~FL_IREQXOF;
+          /* if tx stopped and XON should be sent... */
+          if (((tty->flow_ctrl & (FL_MDXON | FL_ISNTXOF))
+               ==                (FL_MDXON | FL_ISNTXOF))
+              && ((tty->rawOutBufState == rob_idle)
+            || (tty->flow_ctrl & FL_OSTOP))) {
+            /* XON should be sent now... */
+            (*tty->handler.write)(
+              tty->device_context, (void *)&(tty->termios.c_cc[VSTART]), 1);
+          } else if (tty->flow_ctrl & FL_MDRTS) {
+            tty->flow_ctrl &= ~FL_IRTSOFF;
+            /* activate RTS line */
+            if (tty->flow.start_remote_tx != NULL) {
+              tty->flow.start_remote_tx(tty->device_context);
+            }
           }
         }
-      }
 
-      rtems_termios_device_lock_release (ctx, &lock_context);
+        rtems_termios_device_lock_release (ctx, &lock_context);
 
-      /* continue processing new character */
-      if (tty->termios.c_lflag & ICANON) {
-        if (siproc (c, tty)) {
-          /* In canonical mode, input is made available line by line */
-          return;
+        /* continue processing new character */
+        if (tty->termios.c_lflag & ICANON) {
+          if (siproc (c, tty)) {
+            /* In canonical mode, input is made available line by line */
+            return;
+          }
+        } else {
+          siproc (c, tty);
+          if (tty->ccount >= tty->termios.c_cc[VMIN])
+            wait = false;
         }
-      } else {
-        siproc (c, tty);
-        if (tty->ccount >= tty->termios.c_cc[VMIN])
-          wait = false;
+        timeout = tty->rawInBufSemaphoreTimeout;
+
+        rtems_termios_device_lock_acquire (ctx, &lock_context);
       }
-      timeout = tty->rawInBufSemaphoreTimeout;
 
-      rtems_termios_device_lock_acquire (ctx, &lock_context);
+      rtems_termios_device_lock_release (ctx, &lock_context);
     }
 
-    rtems_termios_device_lock_release (ctx, &lock_context);
-
     /*
      * Wait for characters
      */
@@ -1537,9 +1647,15 @@ rtems_termios_read_tty (struct rtems_termios_tty *tty, char *buffer,
     else
       fillBufferQueue (tty);
   }
-  while (count && (tty->cindex < tty->ccount)) {
-    *buffer++ = tty->cbuf[tty->cindex++];
-    count--;
+  if (tty->cindex < tty->ccount) {
+    uint32_t n = (uint32_t) (tty->ccount - tty->cindex);
+
+    if (n > count)
+      n = count;
+
+    memcpy (buffer, &tty->cbuf[tty->cindex], n);
+    tty->cindex += (int) n;
+    count -= n;
   }
   tty->tty_rcvwakeup = false;
   return initial_count - count;
@@ -1594,6 +1710,52 @@ mustCallReceiveCallback (const rtems_termios_tty *tty, unsigned char c,
   }
 }
 
+/*
+ * Append a block of characters to the raw queue without the device lock.
+ * This is only possible if the characters need no input processing and no
+ * flow control is active.  Returns the number of characters dropped because
+ * of overflow.
+ */
+static int
+enqueueRawBulk (struct rtems_termios_tty *tty, const char *buf, int len)
+{
+  unsigned int size = tty->rawInBuf.Size;
+  unsigned int head = tty->rawInBuf.Head;
+  unsigned int tail = tty->rawInBuf.Tail;
+  unsigned int toCopy = (unsigned int) len;
+
+  /* Pairs with the release fence of the consumer */
+  _Atomic_Fence (ATOMIC_ORDER_ACQUIRE);
+
+  while (toCopy > 0) {
+    unsigned int first;
+    unsigned int n;
+
+    first = (tail + 1) % size;
+    if (first == head)
+      break;
+
+    if (head > first)
+      n = head - first;
+    else
+      n = size - first;
+
+    if (n > toCopy)
+      n = toCopy;
+
+    memcpy (&tty->rawInBuf.theBuf[first], buf, n);
+    buf += n;
+    toCopy -= n;
+    tail = (tail + n) % size;
+  }
+
+  /* Make the characters visible before the new tail */
+  _Atomic_Fence (ATOMIC_ORDER_RELEASE);
+  tty->rawInBuf.Tail = tail;
+
+  return (int) toCopy;
+}
+
 /*
  * Place characters on raw queue.
  * NOTE: This routine runs in the context of the
@@ -1626,6 +1788,13 @@ rtems_termios_enqueue_raw_characters (void *ttyp, const char *buf, int len)
     return 0;
   }
 
+  if ((tty->flow_ctrl & FL_MDMASK) == 0 &&
+      (tty->termios.c_iflag & IFLAG_PROCESSING) == 0 &&
+      tty->tty_rcv.sw_pfn == NULL) {
+    dropped = enqueueRawBulk (tty, buf, len);
+    len = 0;
+  }
+
   while (len--) {
     c = *buf++;
     /* FIXME: implement IXANY: any character restarts output */
@@ -1713,6 +1882,8 @@ rtems_termios_enqueue_raw_characters (void *ttyp, const char *buf, int len)
 
       if (newTail != head) {
         tty->rawInBuf.theBuf[newTail] = c;
+        /* Pairs with the acquire fence of the consumer */
+        _Atomic_Fence (ATOMIC_ORDER_RELEASE);
         tty->rawInBuf.Tail = newTail;
 
         /*
@@ -1943,6 +2114,7 @@ static rtems_task rtems_termios_rxdaemon(rtems_task_argument argument)
   rtems_event_set the_event;
   int c;
   char c_buf;
+  char buf[64];
 
   while (1) {
     /*
@@ -1962,13 +2134,24 @@ static rtems_task rtems_termios_rxdaemon(rtems_task_argument argument)
     /*
      * do something
      */
-    c = tty->handler.poll_read(ctx);
-    if (c != EOF) {
-      /*
-       * poll_read did call enqueue on its own
-       */
-      c_buf = c;
-      rtems_termios_enqueue_raw_characters ( tty,&c_buf,1);
+    if (tty->handler.poll_read_block != NULL) {
+      size_t n;
+
+      do {
+        n = (*tty->handler.poll_read_block)(ctx, buf, sizeof (buf));
+        if (n > 0) {
+          rtems_termios_enqueue_raw_characters (tty, buf, (int) n);
+        }
+      } while (n == sizeof (buf));
+    } else {
+      c = tty->handler.poll_read(ctx);
+      if (c != EOF) {
+        /*
+         * poll_read did call enqueue on its own
+         */
+        c_buf = c;
+        rtems_termios_enqueue_raw_characters ( tty,&c_buf,1);
+      }
     }
   }
 }
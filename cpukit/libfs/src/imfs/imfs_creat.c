@@ -55,6 +55,13 @@ IMFS_jnode_t *IMFS_create_node(
 
     memcpy( RTEMS_DECONST( char *, node->name ), name, namelen );
 
+    if ( IMFS_is_directory( node ) ) {
+      const IMFS_fs_info_t *fs_info = parentloc->mt_entry->fs_info;
+      IMFS_directory_t *dir = (IMFS_directory_t *) node;
+
+      dir->hash_threshold = fs_info->directory_hash_threshold;
+    }
+
     /*
      *  This node MUST have a parent, so put it in that directory list.
      */
@@ -27,6 +27,7 @@ IMFS_jnode_t *IMFS_node_initialize_directory(
   IMFS_directory_t *dir = (IMFS_directory_t *) node;
 
   rtems_chain_initialize_empty( &dir->Entries );
+  dir->hash_threshold = IMFS_DIRECTORY_HASH_THRESHOLD_DEFAULT;
 
   return node;
 }
@@ -0,0 +1,208 @@
+/**
+ * @file
+ *
+ * @brief IMFS Directory Hash Tables
+ * @ingroup IMFS
+ */
+
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <rtems/imfs.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * The hash tables use open addressing with linear probing.  The load factor
+ * is at most one half, so there is always an unused slot which terminates the
+ * probe sequences.
+ */
+
+#define IMFS_DIRECTORY_HASH_MIN_CAPACITY 64
+
+static size_t IMFS_directory_hash( const char *name, size_t namelen )
+{
+  uint32_t hash = 2166136261U;
+  size_t i;
+
+  for ( i = 0; i < namelen; ++i ) {
+    hash ^= (unsigned char) name[ i ];
+    hash *= 16777619U;
+  }
+
+  return hash;
+}
+
+static size_t IMFS_directory_hash_slot(
+  const IMFS_jnode_t *entry_node,
+  size_t              mask
+)
+{
+  return IMFS_directory_hash( entry_node->name, entry_node->namelen ) & mask;
+}
+
+static void IMFS_directory_hash_put(
+  IMFS_jnode_t **table,
+  size_t         capacity,
+  IMFS_jnode_t  *entry_node
+)
+{
+  size_t mask = capacity - 1;
+  size_t i = IMFS_directory_hash_slot( entry_node, mask );
+
+  while ( table[ i ] != NULL ) {
+    i = ( i + 1 ) & mask;
+  }
+
+  table[ i ] = entry_node;
+}
+
+static void IMFS_directory_hash_free( IMFS_directory_t *dir )
+{
+  free( dir->hash_table );
+  dir->hash_table = NULL;
+  dir->hash_capacity = 0;
+}
+
+static bool IMFS_directory_hash_rebuild( IMFS_directory_t *dir )
+{
+  IMFS_jnode_t **table;
+  size_t capacity;
+  const rtems_chain_node *current;
+  const rtems_chain_node *tail;
+
+  capacity = IMFS_DIRECTORY_HASH_MIN_CAPACITY;
+
+  /* Leave room to grow before the next rebuild */
+  while ( capacity < 4 * dir->entry_count ) {
+    capacity *= 2;
+  }
+
+  table = calloc( capacity, sizeof( *table ) );
+  if ( table == NULL ) {
+    return false;
+  }
+
+  current = rtems_chain_immutable_first( &dir->Entries );
+  tail = rtems_chain_immutable_tail( &dir->Entries );
+
+  while ( current != tail ) {
+    IMFS_directory_hash_put( table, capacity, (IMFS_jnode_t *) current );
+    current = rtems_chain_immutable_next( current );
+  }
+
+  free( dir->hash_table );
+  dir->hash_table = table;
+  dir->hash_capacity = capacity;
+
+  return true;
+}
+
+void IMFS_directory_hash_insert(
+  IMFS_directory_t *dir,
+  IMFS_jnode_t     *entry_node
+)
+{
+  if ( 2 * dir->entry_count > dir->hash_capacity ) {
+    if ( IMFS_directory_hash_rebuild( dir ) ) {
+      return;
+    }
+
+    if ( dir->hash_table == NULL ) {
+      return;
+    }
+
+    /* Out of memory, keep the table as long as it has an unused slot */
+    if ( dir->entry_count >= dir->hash_capacity ) {
+      IMFS_directory_hash_free( dir );
+      return;
+    }
+  }
+
+  IMFS_directory_hash_put( dir->hash_table, dir->hash_capacity, entry_node );
+}
+
+void IMFS_directory_hash_remove(
+  IMFS_directory_t *dir,
+  IMFS_jnode_t     *entry_node
+)
+{
+  IMFS_jnode_t **table;
+  size_t mask;
+  size_t i;
+  size_t j;
+
+  if ( dir->entry_count <= dir->hash_threshold / 2 ) {
+    IMFS_directory_hash_free( dir );
+    return;
+  }
+
+  table = dir->hash_table;
+  mask = dir->hash_capacity - 1;
+  i = IMFS_directory_hash_slot( entry_node, mask );
+
+  while ( table[ i ] != entry_node ) {
+    IMFS_assert( table[ i ] != NULL );
+    i = ( i + 1 ) & mask;
+  }
+
+  /*
+   * Close the gap, so that the following entries of the probe sequence stay
+   * reachable.
+   */
+  j = i;
+
+  while ( true ) {
+    size_t k;
+
+    j = ( j + 1 ) & mask;
+
+    if ( table[ j ] == NULL ) {
+      break;
+    }
+
+    k = IMFS_directory_hash_slot( table[ j ], mask );
+
+    if ( i <= j ? ( k <= i || k > j ) : ( k <= i && k > j ) ) {
+      table[ i ] = table[ j ];
+      i = j;
+    }
+  }
+
+  table[ i ] = NULL;
+}
+
+IMFS_jnode_t *IMFS_directory_hash_find(
+  const IMFS_directory_t *dir,
+  const char             *name,
+  size_t                  namelen
+)
+{
+  IMFS_jnode_t * const *table = dir->hash_table;
+  size_t mask = dir->hash_capacity - 1;
+  size_t i = IMFS_directory_hash( name, namelen ) & mask;
+  IMFS_jnode_t *entry;
+
+  while ( ( entry = table[ i ] ) != NULL ) {
+    bool match = entry->namelen == namelen
+      && memcmp( entry->name, name, namelen ) == 0;
+
+    if ( match ) {
+      return entry;
+    }
+
+    i = ( i + 1 ) & mask;
+  }
+
+  return NULL;
+}
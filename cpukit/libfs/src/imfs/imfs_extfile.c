@@ -0,0 +1,413 @@
+/**
+ * @file
+ *
+ * @brief IMFS Extent File Handlers
+ * @ingroup IMFS
+ */
+
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <rtems/imfs.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+static off_t IMFS_extfile_allocated( const IMFS_extfile_t *extfile )
+{
+  const IMFS_extent_t *last;
+
+  if ( extfile->extent_count == 0 ) {
+    return 0;
+  }
+
+  last = &extfile->extents[ extfile->extent_count - 1 ];
+
+  return last->offset + (off_t) last->size;
+}
+
+/*
+ * Returns the extent which contains the offset.  The offset must be less than
+ * the allocated size.
+ */
+static IMFS_extent_t *IMFS_extfile_find(
+  const IMFS_extfile_t *extfile,
+  off_t                 offset
+)
+{
+  size_t lo;
+  size_t hi;
+
+  IMFS_assert( offset < IMFS_extfile_allocated( extfile ) );
+
+  lo = 0;
+  hi = extfile->extent_count;
+
+  while ( hi - lo > 1 ) {
+    size_t mid = lo + ( hi - lo ) / 2;
+
+    if ( extfile->extents[ mid ].offset <= offset ) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+
+  return &extfile->extents[ lo ];
+}
+
+static bool IMFS_extfile_add_extent( IMFS_extfile_t *extfile, off_t needed )
+{
+  off_t          allocated;
+  size_t         size;
+  block_p        data;
+  IMFS_extent_t *extent;
+
+  if ( extfile->extent_count == extfile->extent_capacity ) {
+    size_t         capacity;
+    IMFS_extent_t *extents;
+
+    capacity = 2 * extfile->extent_capacity;
+
+    if ( capacity == 0 ) {
+      capacity = 4;
+    }
+
+    extents = realloc( extfile->extents, capacity * sizeof( *extents ) );
+    if ( extents == NULL ) {
+      return false;
+    }
+
+    extfile->extents = extents;
+    extfile->extent_capacity = capacity;
+  }
+
+  allocated = IMFS_extfile_allocated( extfile );
+
+  if ( allocated < IMFS_EXTFILE_MINIMUM_EXTENT_SIZE ) {
+    size = IMFS_EXTFILE_MINIMUM_EXTENT_SIZE;
+  } else if ( allocated < IMFS_EXTFILE_MAXIMUM_EXTENT_SIZE ) {
+    size = (size_t) allocated;
+  } else {
+    size = IMFS_EXTFILE_MAXIMUM_EXTENT_SIZE;
+  }
+
+  while ( (off_t) size < needed && size < IMFS_EXTFILE_MAXIMUM_EXTENT_SIZE ) {
+    size *= 2;
+  }
+
+  /* In case of a fragmented heap, try smaller extents */
+  while ( true ) {
+    data = malloc( size );
+
+    if ( data != NULL || size <= IMFS_EXTFILE_MINIMUM_EXTENT_SIZE ) {
+      break;
+    }
+
+    size /= 2;
+  }
+
+  if ( data == NULL ) {
+    return false;
+  }
+
+  extent = &extfile->extents[ extfile->extent_count ];
+  extent->offset = allocated;
+  extent->size = size;
+  extent->data = data;
+  ++extfile->extent_count;
+
+  return true;
+}
+
+static void IMFS_extfile_free_extents(
+  IMFS_extfile_t *extfile,
+  size_t          count
+)
+{
+  while ( extfile->extent_count > count ) {
+    --extfile->extent_count;
+    free( extfile->extents[ extfile->extent_count ].data );
+  }
+}
+
+static int IMFS_extfile_allocate( IMFS_extfile_t *extfile, off_t new_length )
+{
+  size_t count;
+  off_t  allocated;
+
+  count = extfile->extent_count;
+  allocated = IMFS_extfile_allocated( extfile );
+
+  while ( allocated < new_length ) {
+    if ( !IMFS_extfile_add_extent( extfile, new_length - allocated ) ) {
+      IMFS_extfile_free_extents( extfile, count );
+      rtems_set_errno_and_return_minus_one( ENOSPC );
+    }
+
+    allocated = IMFS_extfile_allocated( extfile );
+  }
+
+  return 0;
+}
+
+static void IMFS_extfile_zero(
+  const IMFS_extfile_t *extfile,
+  off_t                 start,
+  off_t                 length
+)
+{
+  const IMFS_extent_t *extent;
+  size_t               offset;
+
+  if ( length == 0 ) {
+    return;
+  }
+
+  extent = IMFS_extfile_find( extfile, start );
+  offset = (size_t) ( start - extent->offset );
+
+  while ( length > 0 ) {
+    size_t n = extent->size - offset;
+
+    if ( (off_t) n > length ) {
+      n = (size_t) length;
+    }
+
+    memset( &extent->data[ offset ], 0, n );
+    length -= (off_t) n;
+    offset = 0;
+    ++extent;
+  }
+}
+
+static void IMFS_extfile_copy_in(
+  const IMFS_extfile_t *extfile,
+  off_t                 start,
+  const unsigned char  *source,
+  size_t                length
+)
+{
+  const IMFS_extent_t *extent;
+  size_t               offset;
+
+  if ( length == 0 ) {
+    return;
+  }
+
+  extent = IMFS_extfile_find( extfile, start );
+  offset = (size_t) ( start - extent->offset );
+
+  while ( length > 0 ) {
+    size_t n = extent->size - offset;
+
+    if ( n > length ) {
+      n = length;
+    }
+
+    memcpy( &extent->data[ offset ], source, n );
+    source += n;
+    length -= n;
+    offset = 0;
+    ++extent;
+  }
+}
+
+static void IMFS_extfile_copy_out(
+  const IMFS_extfile_t *extfile,
+  off_t                 start,
+  unsigned char        *destination,
+  size_t                length
+)
+{
+  const IMFS_extent_t *extent;
+  size_t               offset;
+
+  if ( length == 0 ) {
+    return;
+  }
+
+  extent = IMFS_extfile_find( extfile, start );
+  offset = (size_t) ( start - extent->offset );
+
+  while ( length > 0 ) {
+    size_t n = extent->size - offset;
+
+    if ( n > length ) {
+      n = length;
+    }
+
+    memcpy( destination, &extent->data[ offset ], n );
+    destination += n;
+    length -= n;
+    offset = 0;
+    ++extent;
+  }
+}
+
+static ssize_t IMFS_extfile_read(
+  rtems_libio_t *iop,
+  void          *buffer,
+  size_t         count
+)
+{
+  IMFS_extfile_t *extfile;
+  off_t           start;
+
+  extfile = IMFS_iop_to_extfile( iop );
+  start = iop->offset;
+
+  if ( start >= extfile->File.size ) {
+    return 0;
+  }
+
+  if ( (off_t) count > extfile->File.size - start ) {
+    count = (size_t) ( extfile->File.size - start );
+  }
+
+  IMFS_extfile_copy_out( extfile, start, buffer, count );
+  IMFS_update_atime( &extfile->File.Node );
+  iop->offset = start + (off_t) count;
+
+  return (ssize_t) count;
+}
+
+static ssize_t IMFS_extfile_write(
+  rtems_libio_t *iop,
+  const void    *buffer,
+  size_t         count
+)
+{
+  IMFS_extfile_t *extfile;
+  off_t           start;
+  off_t           last;
+
+  if ( count == 0 ) {
+    return 0;
+  }
+
+  extfile = IMFS_iop_to_extfile( iop );
+
+  if ( rtems_libio_iop_is_append( iop ) ) {
+    iop->offset = extfile->File.size;
+  }
+
+  start = iop->offset;
+  last = start + (off_t) count;
+
+  if ( last > extfile->File.size ) {
+    int rv;
+
+    rv = IMFS_extfile_allocate( extfile, last );
+    if ( rv != 0 ) {
+      return rv;
+    }
+
+    /* The extents are not initialized, so fill a gap with zeros */
+    if ( start > extfile->File.size ) {
+      IMFS_extfile_zero(
+        extfile,
+        extfile->File.size,
+        start - extfile->File.size
+      );
+    }
+
+    extfile->File.size = last;
+  }
+
+  IMFS_extfile_copy_in( extfile, start, buffer, count );
+  IMFS_mtime_ctime_update( &extfile->File.Node );
+  iop->offset = last;
+
+  return (ssize_t) count;
+}
+
+static int IMFS_extfile_ftruncate(
+  rtems_libio_t *iop,
+  off_t          length
+)
+{
+  IMFS_extfile_t *extfile;
+
+  extfile = IMFS_iop_to_extfile( iop );
+
+  if ( length > extfile->File.size ) {
+    int rv;
+
+    rv = IMFS_extfile_allocate( extfile, length );
+    if ( rv != 0 ) {
+      return rv;
+    }
+
+    IMFS_extfile_zero(
+      extfile,
+      extfile->File.size,
+      length - extfile->File.size
+    );
+  } else {
+    size_t count;
+
+    /* Keep the extents up to the new end of file and reclaim the rest */
+    count = extfile->extent_count;
+
+    while ( count > 0 && extfile->extents[ count - 1 ].offset >= length ) {
+      --count;
+    }
+
+    IMFS_extfile_free_extents( extfile, count );
+  }
+
+  extfile->File.size = length;
+  IMFS_mtime_ctime_update( &extfile->File.Node );
+
+  return 0;
+}
+
+static void IMFS_extfile_destroy( IMFS_jnode_t *node )
+{
+  IMFS_extfile_t *extfile;
+
+  extfile = (IMFS_extfile_t *) node;
+  IMFS_extfile_free_extents( extfile, 0 );
+  free( extfile->extents );
+
+  IMFS_node_destroy_default( node );
+}
+
+static const rtems_filesystem_file_handlers_r IMFS_extfile_handlers = {
+  .open_h = rtems_filesystem_default_open,
+  .close_h = rtems_filesystem_default_close,
+  .read_h = IMFS_extfile_read,
+  .write_h = IMFS_extfile_write,
+  .ioctl_h = rtems_filesystem_default_ioctl,
+  .lseek_h = rtems_filesystem_default_lseek_file,
+  .fstat_h = IMFS_stat_file,
+  .ftruncate_h = IMFS_extfile_ftruncate,
+  .fsync_h = rtems_filesystem_default_fsync_or_fdatasync_success,
+  .fdatasync_h = rtems_filesystem_default_fsync_or_fdatasync_success,
+  .fcntl_h = rtems_filesystem_default_fcntl,
+  .kqfilter_h = rtems_filesystem_default_kqfilter,
+  .mmap_h = rtems_filesystem_default_mmap,
+  .poll_h = rtems_filesystem_default_poll,
+  .readv_h = rtems_filesystem_default_readv,
+  .writev_h = rtems_filesystem_default_writev
+};
+
+const IMFS_mknod_control IMFS_mknod_control_extfile = {
+  {
+    .handlers = &IMFS_extfile_handlers,
+    .node_initialize = IMFS_node_initialize_default,
+    .node_remove = IMFS_node_remove_default,
+    .node_destroy = IMFS_extfile_destroy
+  },
+  .node_size = sizeof( IMFS_extfile_t )
+};
@@ -61,6 +61,11 @@ int IMFS_initialize_support(
   IMFS_jnode_t *root_node;
 
   fs_info->mknod_controls = mount_data->mknod_controls;
+  fs_info->directory_hash_threshold = mount_data->directory_hash_threshold;
+
+  if ( fs_info->directory_hash_threshold == 0 ) {
+    fs_info->directory_hash_threshold = IMFS_DIRECTORY_HASH_THRESHOLD_DEFAULT;
+  }
 
   root_node = IMFS_initialize_node(
     &fs_info->Root_directory.Node,
@@ -71,6 +76,7 @@ int IMFS_initialize_support(
     NULL
   );
   IMFS_assert( root_node != NULL );
+  fs_info->Root_directory.hash_threshold = fs_info->directory_hash_threshold;
 
   mt_entry->fs_info = fs_info;
   mt_entry->ops = mount_data->ops;
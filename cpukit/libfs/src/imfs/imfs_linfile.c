@@ -21,6 +21,48 @@
 
 #include <rtems/imfs.h>
 
+/*
+ * Returns true, if the linear file was converted into a memfile through
+ * another file descriptor.  In this case the handlers of the file descriptor
+ * are updated.
+ */
+static bool IMFS_linfile_is_converted( rtems_libio_t *iop )
+{
+  IMFS_jnode_t *node = iop->pathinfo.node_access;
+
+  if ( node->control != &IMFS_node_control_linfile ) {
+    IMFS_Set_handlers( &iop->pathinfo );
+    return true;
+  }
+
+  return false;
+}
+
+/*
+ * Perform 'copy on write' for linear files.  This is done on the first
+ * modification and not already during open(), so read-only users of a
+ * writeable file descriptor keep the data in the tar image.
+ */
+static int IMFS_linfile_convert( rtems_libio_t *iop, size_t count )
+{
+  IMFS_file_t *file = IMFS_iop_to_file( iop );
+  const unsigned char *buffer = file->Linearfile.direct;
+
+  file->Node.control            = &IMFS_mknod_control_memfile.node_control;
+  file->File.size               = 0;
+  file->Memfile.indirect        = 0;
+  file->Memfile.doubly_indirect = 0;
+  file->Memfile.triply_indirect = 0;
+
+  IMFS_Set_handlers( &iop->pathinfo );
+
+  if ((count != 0)
+   && (IMFS_memfile_write(&file->Memfile, 0, buffer, count) == -1))
+      return -1;
+
+  return 0;
+}
+
 static ssize_t IMFS_linfile_read(
   rtems_libio_t *iop,
   void          *buffer,
@@ -32,6 +74,13 @@ static ssize_t IMFS_linfile_read(
   size_t size = file->File.size;
   const unsigned char *data = file->Linearfile.direct;
 
+  if ( IMFS_linfile_is_converted( iop ) ) {
+    return ( *iop->pathinfo.handlers->read_h )( iop, buffer, count );
+  }
+
+  if (start >= (off_t) size)
+    return 0;
+
   if (count > size - start)
     count = size - start;
 
@@ -42,49 +91,54 @@ static ssize_t IMFS_linfile_read(
   return (ssize_t) count;
 }
 
-static int IMFS_linfile_open(
+static ssize_t IMFS_linfile_write(
   rtems_libio_t *iop,
-  const char    *pathname,
-  int            oflag,
-  mode_t         mode
+  const void    *buffer,
+  size_t         count
 )
 {
-  IMFS_file_t *file;
-
-  file = iop->pathinfo.node_access;
+  if ( !IMFS_linfile_is_converted( iop ) ) {
+    IMFS_file_t *file = IMFS_iop_to_file( iop );
 
-  /*
-   * Perform 'copy on write' for linear files
-   */
-  if (rtems_libio_iop_is_writeable(iop)) {
-    uint32_t count = file->File.size;
-    const unsigned char *buffer = file->Linearfile.direct;
-
-    file->Node.control            = &IMFS_mknod_control_memfile.node_control;
-    file->File.size               = 0;
-    file->Memfile.indirect        = 0;
-    file->Memfile.doubly_indirect = 0;
-    file->Memfile.triply_indirect = 0;
+    if ( IMFS_linfile_convert( iop, file->File.size ) != 0 ) {
+      return -1;
+    }
+  }
 
-    IMFS_Set_handlers( &iop->pathinfo );
+  return ( *iop->pathinfo.handlers->write_h )( iop, buffer, count );
+}
 
-    if ((count != 0)
-     && (IMFS_memfile_write(&file->Memfile, 0, buffer, count) == -1))
-        return -1;
+static int IMFS_linfile_ftruncate(
+  rtems_libio_t *iop,
+  off_t          length
+)
+{
+  if ( !IMFS_linfile_is_converted( iop ) ) {
+    IMFS_file_t *file = IMFS_iop_to_file( iop );
+    size_t count = file->File.size;
+
+    /* Do not copy data which is truncated anyway, e.g. for O_TRUNC */
+    if ( length < (off_t) count ) {
+      count = (size_t) length;
+    }
+
+    if ( IMFS_linfile_convert( iop, count ) != 0 ) {
+      return -1;
+    }
   }
 
-  return 0;
+  return ( *iop->pathinfo.handlers->ftruncate_h )( iop, length );
 }
 
 static const rtems_filesystem_file_handlers_r IMFS_linfile_handlers = {
-  .open_h = IMFS_linfile_open,
+  .open_h = rtems_filesystem_default_open,
   .close_h = rtems_filesystem_default_close,
   .read_h = IMFS_linfile_read,
-  .write_h = rtems_filesystem_default_write,
+  .write_h = IMFS_linfile_write,
   .ioctl_h = rtems_filesystem_default_ioctl,
   .lseek_h = rtems_filesystem_default_lseek_file,
   .fstat_h = IMFS_stat_file,
-  .ftruncate_h = rtems_filesystem_default_ftruncate,
+  .ftruncate_h = IMFS_linfile_ftruncate,
   .fsync_h = rtems_filesystem_default_fsync_or_fdatasync_success,
   .fdatasync_h = rtems_filesystem_default_fsync_or_fdatasync_success,
   .fcntl_h = rtems_filesystem_default_fcntl,
@@ -102,9 +102,29 @@
 /* lifetime of NFS attributes in a NfsNode;
  * the time is in seconds and the lifetime is
  * infinite if the symbol is #undef
+ * This value can be overridden at run-time by setting
+ * the global variable 'nfsAttrCacheTtl'.
  */
 #define CONFIG_ATTR_LIFETIME			10/*secs*/
 
+/* lifetime (secs) of cached directory entries, i.e.
+ * the results of successful and failed (ENOENT)
+ * LOOKUPs.  These values can be overridden at run-time
+ * by setting the global variables 'nfsDentryCacheTtl'
+ * and 'nfsNegDentryCacheTtl'.
+ */
+#define CONFIG_DENTRY_LIFETIME			10/*secs*/
+#define CONFIG_NEG_DENTRY_LIFETIME		3/*secs*/
+
+/* Size of the per-mount attribute and directory entry
+ * caches (number of entries, must be a power of two).
+ * The caches are direct mapped; only names shorter
+ * than CONFIG_DENTRY_NAMLEN are cached.
+ */
+#define CONFIG_ATTR_CACHE_SIZE			64
+#define CONFIG_DENTRY_CACHE_SIZE		128
+#define CONFIG_DENTRY_NAMLEN			32
+
 /*
  * The 'st_blksize' (stat(2)) value this nfs
  * client should report. If set to zero then the server's fattr data
@@ -121,6 +141,17 @@
  */
 #define DEFAULT_NFS_ST_BLKSIZE			NFS_MAXDATA
 
+/*
+ * The number of READ or WRITE RPCs an open file may
+ * have in flight (read-ahead / write-behind).
+ * A window of one (or less) makes every read/write
+ * a synchronous RPC round trip.
+ * This value can be overridden at run-time by setting
+ * the global variable 'nfsRpcWindow'; it is sampled
+ * when a file does its first read or write.
+ */
+#define DEFAULT_NFS_RPC_WINDOW			4
+
 /* dont change this without changing the maximal write size */
 #define CONFIG_NFS_BIG_XACT_SIZE		UDPMSGSIZE	/* dont change this */
 
@@ -500,16 +531,47 @@ xdr_serporid(XDR *xdrs, serporid *objp)
 
 typedef uint32_t	TimeStamp;
 
+/* Use the uptime, it is available even if the TOD was
+ * never set.  The offset makes sure that a zero age
+ * always means 'never obtained'.
+ */
 static inline TimeStamp
 nowSeconds(void)
 {
-  rtems_interval rval;
-  rtems_clock_get_seconds_since_epoch( &rval );
-  return rval;
+  return (TimeStamp) rtems_clock_get_uptime_seconds() + 1;
 }
 
 
 /* Per mounted FS structure */
+/* An entry of the per-mount attribute cache
+ */
+typedef struct NfsAttrCacheEntryRec_ {
+	int				valid;
+	TimeStamp		age;
+	nfs_fh			file;
+	fattr			attributes;
+} NfsAttrCacheEntryRec, *NfsAttrCacheEntry;
+
+/* An entry of the per-mount directory entry cache;
+ * a negative entry records a name which does not
+ * exist.  The directory's mtime at the time of the
+ * LOOKUP allows to detect (some) stale entries.
+ */
+typedef enum {
+	DENTRY_INVALID = 0,
+	DENTRY_POSITIVE,
+	DENTRY_NEGATIVE
+} NfsDentryState;
+
+typedef struct NfsDentryCacheEntryRec_ {
+	NfsDentryState	state;
+	TimeStamp		age;
+	nfstime			dirMtime;
+	nfs_fh			dir;
+	nfs_fh			file;
+	char			name[CONFIG_DENTRY_NAMLEN];
+} NfsDentryCacheEntryRec, *NfsDentryCacheEntry;
+
 typedef struct NfsRec_ {
 		/* the NFS server we're talking to.
 		 */
@@ -543,6 +605,23 @@ typedef struct NfsRec_ {
 		/* Who we pretend we are
 		 */
 	u_long								 uid,gid;
+		/* Lifetimes (secs) of cached attributes and
+		 * directory entries; sampled from the global
+		 * variables when the NFS is mounted.
+		 * Zero disables caching, a negative value
+		 * never expires.
+		 */
+	int									 attrTtl;
+	int									 dentryTtl;
+	int									 negDentryTtl;
+		/* The attribute and directory entry caches
+		 * (NULL if disabled) and their counters;
+		 * protected by 'cacheLock'.
+		 */
+	rtems_mutex							 cacheLock;
+	NfsAttrCacheEntry					 attrCache;
+	NfsDentryCacheEntry					 dentryCache;
+	NfsCacheStatsRec					 cacheStats;
 } NfsRec, *Nfs;
 
 typedef struct NfsNodeRec_ {
@@ -576,8 +655,69 @@ typedef struct NfsNodeRec_ {
 		/* A timestamp for the stats
 		 */
 	TimeStamp		age;
+		/* Outstanding read-ahead / write-behind
+		 * RPCs of an open file (NULL if there
+		 * never were any).
+		 */
+	struct NfsPipeRec_ *pipe;
 } NfsNodeRec, *NfsNode;
 
+/* An RPC slot of a pipelined file.
+ */
+typedef struct NfsPipeSlotRec_ {
+		/* The transaction in flight, NULL
+		 * once it has been waited for.
+		 */
+	RpcUdpXact		xact;
+		/* The file offset and the number of
+		 * bytes this slot reads or writes
+		 */
+	uint32_t		offset;
+	uint32_t		count;
+		/* The result of a completed slot;
+		 * the number of bytes read or -1
+		 * with the error number in 'error'.
+		 */
+	ssize_t			done;
+	int				error;
+	union {
+		readres		rr;
+		attrstat	as;
+	}				res;
+} NfsPipeSlotRec, *NfsPipeSlot;
+
+/* The read-ahead / write-behind state of an
+ * open file.  The slots form a ring of RPCs
+ * to consecutive file offsets, the oldest one
+ * is at 'head'.  A pipe carries either reads
+ * or writes but never both at the same time.
+ */
+typedef struct NfsPipeRec_ {
+	int				window;
+	int				head;
+	int				pending;
+	int				writing;
+		/* Error number of a failed write-behind;
+		 * reported by the next write, fsync or close.
+		 */
+	int				error;
+		/* Bytes of the head slot the reader has
+		 * already consumed
+		 */
+	uint32_t		consumed;
+		/* File offset of the next read-ahead
+		 */
+	uint32_t		ahead;
+		/* End of the last read, used to detect
+		 * sequential access
+		 */
+	uint32_t		last;
+		/* Read-ahead data, NFS_MAXDATA per slot
+		 */
+	char		   *buf;
+	NfsPipeSlotRec	slot[];
+} NfsPipeRec, *NfsPipe;
+
 /*****************************************
 	Forward Declarations
  *****************************************/
@@ -706,6 +846,29 @@ static struct nfsstats {
 #endif
 int nfsStBlksize = DEFAULT_NFS_ST_BLKSIZE;
 
+/*
+ * Global variable to tune the number of
+ * READ/WRITE RPCs an open file keeps in flight.
+ */
+#ifndef DEFAULT_NFS_RPC_WINDOW
+#define DEFAULT_NFS_RPC_WINDOW	4
+#endif
+int nfsRpcWindow = DEFAULT_NFS_RPC_WINDOW;
+
+/*
+ * Global variables to tune the lifetime (secs) of
+ * cached attributes and directory entries of NFS
+ * mounted afterwards.  Zero disables caching, a
+ * negative value never expires.
+ */
+#ifdef CONFIG_ATTR_LIFETIME
+int nfsAttrCacheTtl = CONFIG_ATTR_LIFETIME;
+#else
+int nfsAttrCacheTtl = -1;
+#endif
+int nfsDentryCacheTtl = CONFIG_DENTRY_LIFETIME;
+int nfsNegDentryCacheTtl = CONFIG_NEG_DENTRY_LIFETIME;
+
 
 /*****************************************
 	Implementation
@@ -821,6 +984,20 @@ Nfs rval = calloc(1,sizeof(*rval));
 
 	if (rval) {
 		rval->server     = server;
+
+		rval->attrTtl      = nfsAttrCacheTtl;
+		rval->dentryTtl    = nfsDentryCacheTtl;
+		rval->negDentryTtl = nfsNegDentryCacheTtl;
+		rtems_mutex_init(&rval->cacheLock, "NFS Cache");
+
+		/* no caching if there is not enough memory */
+		if (rval->attrTtl)
+			rval->attrCache   = calloc(CONFIG_ATTR_CACHE_SIZE,
+									   sizeof(*rval->attrCache));
+		if (rval->dentryTtl || rval->negDentryTtl)
+			rval->dentryCache = calloc(CONFIG_DENTRY_CACHE_SIZE,
+									   sizeof(*rval->dentryCache));
+
 		LOCK(nfsGlob.llock);
 			rval->next 		   = nfsGlob.mounted_fs;
 			nfsGlob.mounted_fs = rval;
@@ -856,6 +1033,9 @@ register Nfs prev;
 
 	nfs->next = 0; /* paranoia */
 	rpcUdpServerDestroy(nfs->server);
+	free(nfs->attrCache);
+	free(nfs->dentryCache);
+	rtems_mutex_destroy(&nfs->cacheLock);
 	free(nfs);
 }
 
@@ -903,6 +1083,8 @@ rtems_interrupt_lock_context lock_context;
 		NFS_GLOBAL_RELEASE(&lock_context);
 		rval->nfs       = nfs;
 		rval->str		= 0;
+		rval->pipe		= 0;
+		rval->age		= 0;
 	} else {
 		errno = ENOMEM;
 	}
@@ -963,6 +1145,9 @@ NfsNode rval = nfsNodeCreate(node->nfs, 0);
 	if (rval) {
 		*rval = *node;
 
+		/* pipelined RPCs belong to the open file */
+		rval->pipe = 0;
+
 		/* must clone the string also */
 		if (node->str) {
 			rval->args.name = rval->str = strdup(node->str);
@@ -1123,26 +1308,48 @@ int			refuse;
 	return 0;
 }
 
-/* NFS RPC wrapper.
- *
- * ARGS:	srvr	the NFS server we want to call
- * 			proc	the NFSPROC_xx we want to invoke
- * 			xargs   xdr routine to wrap the arguments
- * 			pargs   pointer to the argument object
- * 			xres	xdr routine to unwrap the results
- * 			pres	pointer to the result object
+/* Map an RPC error to errno and report it.
+ */
+static void
+nfscall_error(int proc, enum clnt_stat stat)
+{
+	fprintf(stderr,
+			"NFS (proc %i) - %s\n",
+			proc,
+			clnt_sperrno(stat));
+
+	switch (stat) {
+		/* TODO: this is probably not complete and/or fully accurate */
+		case RPC_CANTENCODEARGS : errno = EINVAL;	break;
+		case RPC_AUTHERROR  	: errno = EPERM;	break;
+
+		case RPC_CANTSEND		:
+		case RPC_CANTRECV		: /* hope they have errno set */
+		case RPC_SYSTEMERROR	: break;
+
+		default             	: errno = EIO;		break;
+	}
+
+	if (!errno)
+		errno = EIO;
+}
+
+/* Start a NFS RPC without waiting for the reply.
  *
- * RETURNS:	0 on success, -1 on error with errno set.
+ * ARGS:	see 'nfscall()' below
  *
- * NOTE:	the caller assumes that errno is set to
- *			a nonzero value if this routine returns
- *			an error (nonzero return value).
+ * RETURNS:	transaction on success, NULL on error
+ * 			with errno set.
  *
- *			This routine prints RPC error messages to
- *			stderr.
+ * NOTE:	the arguments are encoded immediately,
+ * 			i.e. the caller may reuse 'pargs' when this
+ * 			routine returns.  The results are decoded
+ * 			into 'pres' by nfscall_wait() which must be
+ * 			called exactly once for each transaction
+ * 			returned by this routine.
  */
-STATIC int
-nfscall(
+STATIC RpcUdpXact
+nfscall_send(
 	RpcUdpServer	srvr,
 	int				proc,
 	xdrproc_t		xargs,
@@ -1153,8 +1360,6 @@ nfscall(
 RpcUdpXact		xact;
 enum clnt_stat	stat;
 RpcUdpXactPool	pool;
-int				rval = -1;
-
 
 	switch (proc) {
 		case NFSPROC_SYMLINK:
@@ -1167,7 +1372,7 @@ int				rval = -1;
 
 	if ( !xact ) {
 		errno = ENOMEM;
-		return -1;
+		return 0;
 	}
 
 	if ( RPC_SUCCESS != (stat=rpcUdpSend(
@@ -1179,38 +1384,293 @@ int				rval = -1;
 								pres,
 								xargs,
 								pargs,
-								0)) ||
-	     RPC_SUCCESS != (stat=rpcUdpRcv(xact)) ) {
-
-		fprintf(stderr,
-				"NFS (proc %i) - %s\n",
-				proc,
-				clnt_sperrno(stat));
+								0)) ) {
+		nfscall_error(proc, stat);
+		rpcUdpXactPoolPut(xact);
+		return 0;
+	}
 
-		switch (stat) {
-			/* TODO: this is probably not complete and/or fully accurate */
-			case RPC_CANTENCODEARGS : errno = EINVAL;	break;
-			case RPC_AUTHERROR  	: errno = EPERM;	break;
+	return xact;
+}
 
-			case RPC_CANTSEND		:
-			case RPC_CANTRECV		: /* hope they have errno set */
-			case RPC_SYSTEMERROR	: break;
+/* Wait for the reply of a NFS RPC started by
+ * nfscall_send() and release the transaction.
+ *
+ * RETURNS:	0 on success, -1 on error with errno set.
+ */
+STATIC int
+nfscall_wait(RpcUdpXact xact, int proc)
+{
+enum clnt_stat	stat;
+int				rval = 0;
 
-			default             	: errno = EIO;		break;
-		}
-	} else {
-		rval = 0;
+	if ( RPC_SUCCESS != (stat=rpcUdpRcv(xact)) ) {
+		nfscall_error(proc, stat);
+		rval = -1;
 	}
 
 	/* release the transaction back into the pool */
 	rpcUdpXactPoolPut(xact);
 
-	if (rval && !errno)
-		errno = EIO;
-
 	return rval;
 }
 
+/* NFS RPC wrapper.
+ *
+ * ARGS:	srvr	the NFS server we want to call
+ * 			proc	the NFSPROC_xx we want to invoke
+ * 			xargs   xdr routine to wrap the arguments
+ * 			pargs   pointer to the argument object
+ * 			xres	xdr routine to unwrap the results
+ * 			pres	pointer to the result object
+ *
+ * RETURNS:	0 on success, -1 on error with errno set.
+ *
+ * NOTE:	the caller assumes that errno is set to
+ *			a nonzero value if this routine returns
+ *			an error (nonzero return value).
+ *
+ *			This routine prints RPC error messages to
+ *			stderr.
+ */
+STATIC int
+nfscall(
+	RpcUdpServer	srvr,
+	int				proc,
+	xdrproc_t		xargs,
+	void *			pargs,
+	xdrproc_t		xres,
+	void *			pres)
+{
+RpcUdpXact		xact;
+
+	xact = nfscall_send(srvr, proc, xargs, pargs, xres, pres);
+
+	if ( !xact )
+		return -1;
+
+	return nfscall_wait(xact, proc);
+}
+
+/*****************************************
+	Attribute and directory entry caches
+
+	Each mounted NFS caches the attributes
+	of recently used file handles and the
+	results of recent LOOKUPs (including
+	failed ones).  Entries expire after the
+	configured lifetimes and are invalidated
+	by local modifications.
+ *****************************************/
+
+static uint32_t
+nfsCacheHash(uint32_t h, const void *buf, size_t len)
+{
+const unsigned char *p = buf;
+
+	/* FNV-1a */
+	while (len-- > 0) {
+		h ^= *p++;
+		h *= 16777619;
+	}
+	return h;
+}
+
+#define NFS_CACHE_HASH_INIT	2166136261U
+
+/* Check whether something obtained at 'age' is still
+ * valid for the lifetime 'ttl'.  A zero 'age' marks
+ * something that was never obtained or invalidated.
+ */
+static int
+nfsCacheFresh(TimeStamp age, int ttl)
+{
+	if (age == 0)
+		return 0;
+	if (ttl < 0)
+		return 1;
+	return ttl > 0 && nowSeconds() - age <= (TimeStamp) ttl;
+}
+
+static NfsAttrCacheEntry
+nfsAttrCacheSlot(Nfs nfs, const nfs_fh *file)
+{
+uint32_t h = nfsCacheHash(NFS_CACHE_HASH_INIT, file, sizeof(*file));
+
+	return &nfs->attrCache[h & (CONFIG_ATTR_CACHE_SIZE - 1)];
+}
+
+/* Copy fresh cached attributes into a node.
+ *
+ * RETURNS:	nonzero on a cache hit.
+ */
+static int
+nfsAttrCacheGet(NfsNode node)
+{
+Nfs					nfs = node->nfs;
+NfsAttrCacheEntry	e;
+int					hit = 0;
+
+	if (!nfs->attrCache)
+		return 0;
+
+	rtems_mutex_lock(&nfs->cacheLock);
+	e = nfsAttrCacheSlot(nfs, &SERP_FILE(node));
+	if ( e->valid
+		 && !memcmp(&e->file, &SERP_FILE(node), sizeof(e->file))
+		 && nfsCacheFresh(e->age, nfs->attrTtl) ) {
+		SERP_ATTR(node) = e->attributes;
+		node->age       = e->age;
+		nfs->cacheStats.attrHits++;
+		hit = 1;
+	}
+	rtems_mutex_unlock(&nfs->cacheLock);
+
+	return hit;
+}
+
+/* Enter the attributes of a node into the cache
+ */
+static void
+nfsAttrCachePut(NfsNode node)
+{
+Nfs					nfs = node->nfs;
+NfsAttrCacheEntry	e;
+
+	if (!nfs->attrCache)
+		return;
+
+	rtems_mutex_lock(&nfs->cacheLock);
+	e = nfsAttrCacheSlot(nfs, &SERP_FILE(node));
+	e->valid      = 1;
+	e->age        = node->age;
+	e->file       = SERP_FILE(node);
+	e->attributes = SERP_ATTR(node);
+	rtems_mutex_unlock(&nfs->cacheLock);
+}
+
+static void
+nfsAttrCacheInvalidate(Nfs nfs, const nfs_fh *file)
+{
+NfsAttrCacheEntry	e;
+
+	if (!nfs->attrCache)
+		return;
+
+	rtems_mutex_lock(&nfs->cacheLock);
+	e = nfsAttrCacheSlot(nfs, file);
+	if (e->valid && !memcmp(&e->file, file, sizeof(e->file)))
+		e->valid = 0;
+	rtems_mutex_unlock(&nfs->cacheLock);
+}
+
+static NfsDentryCacheEntry
+nfsDentryCacheSlot(Nfs nfs, const nfs_fh *dir, const char *name)
+{
+uint32_t h = nfsCacheHash(NFS_CACHE_HASH_INIT, dir, sizeof(*dir));
+
+	h = nfsCacheHash(h, name, strlen(name));
+	return &nfs->dentryCache[h & (CONFIG_DENTRY_CACHE_SIZE - 1)];
+}
+
+/* Look up a name in the directory entry cache.
+ * The file handle of a positive entry is copied
+ * to 'file'.
+ *
+ * RETURNS:	DENTRY_POSITIVE or DENTRY_NEGATIVE on
+ * 			a hit, DENTRY_INVALID otherwise.
+ */
+static NfsDentryState
+nfsDentryCacheGet(NfsNode dir, const char *name, nfs_fh *file)
+{
+Nfs					nfs   = dir->nfs;
+NfsDentryState		state = DENTRY_INVALID;
+NfsDentryCacheEntry	e;
+int					ttl;
+
+	if (!nfs->dentryCache || strlen(name) >= CONFIG_DENTRY_NAMLEN)
+		return DENTRY_INVALID;
+
+	rtems_mutex_lock(&nfs->cacheLock);
+	e = nfsDentryCacheSlot(nfs, &SERP_FILE(dir), name);
+	if ( e->state != DENTRY_INVALID
+		 && !memcmp(&e->dir, &SERP_FILE(dir), sizeof(e->dir))
+		 && !strcmp(e->name, name) ) {
+		ttl = e->state == DENTRY_POSITIVE ? nfs->dentryTtl : nfs->negDentryTtl;
+
+		if ( nfsCacheFresh(e->age, ttl)
+			 && e->dirMtime.seconds  == SERP_ATTR(dir).mtime.seconds
+			 && e->dirMtime.useconds == SERP_ATTR(dir).mtime.useconds ) {
+			state = e->state;
+			if (state == DENTRY_POSITIVE) {
+				*file = e->file;
+				nfs->cacheStats.lookupHits++;
+			} else {
+				nfs->cacheStats.lookupNegHits++;
+			}
+		} else {
+			/* expired or the directory changed */
+			e->state = DENTRY_INVALID;
+		}
+	}
+	rtems_mutex_unlock(&nfs->cacheLock);
+
+	return state;
+}
+
+/* Enter the result of a LOOKUP into the directory entry
+ * cache; a NULL 'file' records a name that does not exist.
+ */
+static void
+nfsDentryCachePut(NfsNode dir, const char *name, const nfs_fh *file)
+{
+Nfs					nfs = dir->nfs;
+NfsDentryCacheEntry	e;
+int					ttl = file ? nfs->dentryTtl : nfs->negDentryTtl;
+
+	if (!nfs->dentryCache || !ttl || strlen(name) >= CONFIG_DENTRY_NAMLEN)
+		return;
+
+	rtems_mutex_lock(&nfs->cacheLock);
+	e = nfsDentryCacheSlot(nfs, &SERP_FILE(dir), name);
+	e->state    = file ? DENTRY_POSITIVE : DENTRY_NEGATIVE;
+	e->age      = nowSeconds();
+	e->dirMtime = SERP_ATTR(dir).mtime;
+	e->dir      = SERP_FILE(dir);
+	if (file)
+		e->file = *file;
+	strcpy(e->name, name);
+	rtems_mutex_unlock(&nfs->cacheLock);
+}
+
+static void
+nfsDentryCacheInvalidate(Nfs nfs, const nfs_fh *dir, const char *name)
+{
+NfsDentryCacheEntry	e;
+
+	if (!nfs->dentryCache || strlen(name) >= CONFIG_DENTRY_NAMLEN)
+		return;
+
+	rtems_mutex_lock(&nfs->cacheLock);
+	e = nfsDentryCacheSlot(nfs, dir, name);
+	if ( e->state != DENTRY_INVALID
+		 && !memcmp(&e->dir, dir, sizeof(e->dir))
+		 && !strcmp(e->name, name) )
+		e->state = DENTRY_INVALID;
+	rtems_mutex_unlock(&nfs->cacheLock);
+}
+
+/* A directory was modified locally: forget the affected
+ * name and the directory's attributes.
+ */
+static void
+nfsCacheDirModified(NfsNode dir, const nfs_fh *dirFile, const char *name)
+{
+	nfsDentryCacheInvalidate(dir->nfs, dirFile, name);
+	nfsAttrCacheInvalidate(dir->nfs, dirFile);
+	dir->age = 0;
+}
+
 /* Check the 'age' of a node's stats
  * and read the attributes from the server
  * if necessary.
@@ -1227,24 +1687,30 @@ static int
 updateAttr(NfsNode node, int force)
 {
 	int rv = 0;
+	Nfs nfs = node->nfs;
 
 	if (force
-#ifdef CONFIG_ATTR_LIFETIME
-		|| (nowSeconds() - node->age > CONFIG_ATTR_LIFETIME)
-#endif
+		|| (!nfsCacheFresh(node->age, nfs->attrTtl) && !nfsAttrCacheGet(node))
 	) {
 		rv = nfscall(
-			node->nfs->server,
+			nfs->server,
 			NFSPROC_GETATTR,
 			(xdrproc_t) xdr_nfs_fh, &SERP_FILE(node),
 			(xdrproc_t) xdr_attrstat, &node->serporid
 		);
 
+		rtems_mutex_lock(&nfs->cacheLock);
+		nfs->cacheStats.attrRpcs++;
+		rtems_mutex_unlock(&nfs->cacheLock);
+
 		if (rv == 0) {
 			rv = nfsEvaluateStatus(node->serporid.status);
 
 			if (rv == 0) {
 				node->age = nowSeconds();
+				nfsAttrCachePut(node);
+			} else {
+				nfsAttrCacheInvalidate(nfs, &SERP_FILE(node));
 			}
 		}
 	}
@@ -1421,6 +1887,24 @@ static int nfs_search_in_directory(
 	/* remember args / directory fh */
 	memcpy(&entry->args, &SERP_FILE(dir), sizeof(dir->args));
 
+	switch (nfsDentryCacheGet(dir, part, &SERP_FILE(entry))) {
+		case DENTRY_NEGATIVE:
+			return -1;
+
+		case DENTRY_POSITIVE:
+			entry->age = 0;
+			if (updateAttr(entry, 0 /* only if old */) == 0)
+				return 0;
+			/* maybe the file is gone; ask the server */
+			nfsDentryCacheInvalidate(nfs, &SERP_FILE(dir), part);
+			SERP_FILE(entry) = SERP_FILE(dir);
+			SERP_ARGS(entry).diroparg.name = part;
+			break;
+
+		default:
+			break;
+	}
+
 #if DEBUG & DEBUG_EVALPATH
 	fprintf(stderr,"Looking up '%s'\n",part);
 #endif
@@ -1432,11 +1916,18 @@ static int nfs_search_in_directory(
 		(xdrproc_t) xdr_serporid,  &entry->serporid
 	);
 
-	if (rv == 0 && entry->serporid.status == NFS_OK) {
-		int force_update = 1;
+	rtems_mutex_lock(&nfs->cacheLock);
+	nfs->cacheStats.lookupRpcs++;
+	rtems_mutex_unlock(&nfs->cacheLock);
 
-		rv = updateAttr(entry, force_update);
+	if (rv == 0 && entry->serporid.status == NFS_OK) {
+		/* the reply carries the attributes as well */
+		entry->age = nowSeconds();
+		nfsAttrCachePut(entry);
+		nfsDentryCachePut(dir, part, &SERP_FILE(entry));
 	} else {
+		if (rv == 0 && entry->serporid.status == NFSERR_NOENT)
+			nfsDentryCachePut(dir, part, NULL);
 		rv = -1;
 	}
 
@@ -1505,6 +1996,7 @@ static int nfs_move_node(NfsNode dst, const NfsNode src, const char *part)
 	}
 
 	*dst = *src;
+	dst->pipe = NULL;
 
 	dst->str = dst->args.name = strdup(part);
 	if (dst->str != NULL) {
@@ -1638,6 +2130,11 @@ char *dupname;
 		(xdrproc_t)xdr_nfsstat, &status
 	);
 
+	/* the link count of the target changes as well */
+	nfsCacheDirModified(pNode, &SERP_FILE(pNode), dupname);
+	nfsAttrCacheInvalidate(tNode->nfs, &SERP_FILE(tNode));
+	tNode->age = 0;
+
 	if (rv == 0) {
 		rv = nfsEvaluateStatus(status);
 #if DEBUG & DEBUG_SYSCALLS
@@ -1686,6 +2183,9 @@ char			*name = NFSPROC_REMOVE == proc ?
 		(xdrproc_t)xdr_nfsstat, &status
 	);
 
+	nfsCacheDirModified(parentloc->node_access, &node->args.dir, node->args.name);
+	nfsAttrCacheInvalidate(nfs, &SERP_FILE(node));
+
 	if (rv == 0) {
 		rv = nfsEvaluateStatus(status);
 #if DEBUG & DEBUG_SYSCALLS
@@ -2013,6 +2513,8 @@ char					*dupname;
 		(xdrproc_t)xdr_diropres, &res
 	);
 
+	nfsCacheDirModified(node, &SERP_FILE(node), dupname);
+
 	if (rv == 0) {
 		rv = nfsEvaluateStatus(res.status);
 #if DEBUG & DEBUG_SYSCALLS
@@ -2109,6 +2611,8 @@ char					*dupname;
 		(xdrproc_t)xdr_nfsstat, &status
 	);
 
+	nfsCacheDirModified(node, &SERP_FILE(node), dupname);
+
 	if (rv == 0) {
 		rv = nfsEvaluateStatus(status);
 #if DEBUG & DEBUG_SYSCALLS
@@ -2200,6 +2704,10 @@ static int nfs_rename(
 			&status
 		);
 
+		nfsCacheDirModified(oldParentNode, &SERP_FILE(oldParentNode), oldNode->str);
+		nfsCacheDirModified(newParentNode, &SERP_FILE(newParentNode), dupname);
+		nfsAttrCacheInvalidate(nfs, &SERP_FILE(oldNode));
+
 		if (rv == 0) {
 			rv = nfsEvaluateStatus(status);
 		}
@@ -2350,11 +2858,280 @@ DirInfo		di;
 	return 0;
 }
 
+/*****************************************
+	Pipelined reads and writes
+
+	An open file keeps up to 'nfsRpcWindow'
+	READ or WRITE RPCs in flight through the
+	RPCIOD.  Reads are served from read-ahead
+	slots as long as the file is accessed
+	sequentially.  Writes return once their
+	data is encoded into a transaction; a
+	failed write is reported by a subsequent
+	write, fsync or close.
+ *****************************************/
+
+/* Get the pipe of an open file; it is created on
+ * demand.
+ *
+ * RETURNS:	pipe or NULL if pipelining is disabled
+ * 			or no memory is available (the caller
+ * 			falls back to synchronous RPCs then).
+ */
+static NfsPipe
+nfsPipeGet(NfsNode node)
+{
+NfsPipe	pipe = node->pipe;
+int		window;
+
+	if (pipe)
+		return pipe;
+
+	window = nfsRpcWindow;
+
+	if (window <= 1)
+		return 0;
+
+	pipe = calloc(1, sizeof(*pipe) + window * sizeof(pipe->slot[0]));
+
+	if (pipe) {
+		pipe->window = window;
+		node->pipe   = pipe;
+	}
+
+	return pipe;
+}
+
+/* Wait for the oldest RPC of a pipe unless this
+ * was already done and record its result.
+ */
+static void
+nfsPipeComplete(NfsNode node, NfsPipe pipe)
+{
+NfsPipeSlot	slot = &pipe->slot[pipe->head];
+int			rv;
+
+	if (!slot->xact)
+		return;
+
+	rv = nfscall_wait(slot->xact, pipe->writing ? NFSPROC_WRITE : NFSPROC_READ);
+	slot->xact = 0;
+
+	if (rv == 0) {
+		if (pipe->writing) {
+			rv = nfsEvaluateStatus(slot->res.as.status);
+
+			if (rv == 0) {
+				/* replies are processed in order, so these are the latest */
+				SERP_ATTR(node) = slot->res.as.attrstat_u.attributes;
+				node->age = nowSeconds();
+				nfsAttrCachePut(node);
+				slot->done = slot->count;
+			}
+		} else {
+			rv = nfsEvaluateStatus(slot->res.rr.status);
+
+			if (rv == 0) {
+				slot->done = slot->res.rr.readres_u.reply.data.data_len;
+			}
+		}
+	}
+
+	if (rv) {
+		slot->done  = -1;
+		slot->error = errno;
+	}
+}
+
+/* Complete and remove the oldest RPC of a pipe;
+ * a failed write is recorded in the pipe.
+ */
+static void
+nfsPipeRetire(NfsNode node, NfsPipe pipe)
+{
+NfsPipeSlot	slot = &pipe->slot[pipe->head];
+
+	nfsPipeComplete(node, pipe);
+
+	if (pipe->writing && slot->done < 0 && !pipe->error) {
+		pipe->error = slot->error;
+		/* try at least to recover the current attributes */
+		updateAttr(node, 1 /* force */);
+	}
+
+	pipe->head     = (pipe->head + 1) % pipe->window;
+	pipe->consumed = 0;
+	pipe->pending--;
+}
+
+/* Wait for all RPCs of a pipe; outstanding writes
+ * are completed, read-ahead data is discarded.
+ */
+static void
+nfsPipeDrain(NfsNode node, NfsPipe pipe)
+{
+	while (pipe->pending > 0)
+		nfsPipeRetire(node, pipe);
+
+	pipe->writing = 0;
+}
+
+/* Drain the pipe of an open file and report
+ * (and clear) a deferred write error.
+ *
+ * RETURNS:	0 on success, -1 on error with errno set.
+ */
+static int
+nfsPipeFlush(NfsNode node)
+{
+NfsPipe	pipe = node->pipe;
+
+	if (!pipe)
+		return 0;
+
+	nfsPipeDrain(node, pipe);
+
+	if (pipe->error) {
+		errno       = pipe->error;
+		pipe->error = 0;
+		return -1;
+	}
+
+	return 0;
+}
+
+/* Keep the read-ahead window filled.  At least one
+ * READ is kept in flight, further ones only up to the
+ * (cached) end of file.
+ */
+static void
+nfsPipeFill(NfsNode node, NfsPipe pipe)
+{
+Nfs			nfs  = node->nfs;
+NfsPipeSlot	slot;
+RpcUdpXact	xact;
+uint32_t	count;
+int			idx;
+
+	while (pipe->pending < pipe->window && pipe->ahead < UINT32_MAX) {
+		if (pipe->pending > 0 && pipe->ahead >= SERP_ATTR(node).size)
+			break;
+
+		count = UINT32_MAX - pipe->ahead;
+		if (count > NFS_MAXDATA)
+			count = NFS_MAXDATA;
+
+		idx  = (pipe->head + pipe->pending) % pipe->window;
+		slot = &pipe->slot[idx];
+
+		SERP_ARGS(node).readarg.offset		= pipe->ahead;
+		SERP_ARGS(node).readarg.count	  	= count;
+		SERP_ARGS(node).readarg.totalcount	= UINT32_C(0xdeadbeef);
+
+		slot->res.rr.readres_u.reply.data.data_val = pipe->buf + idx * NFS_MAXDATA;
+
+		xact = nfscall_send(
+			nfs->server,
+			NFSPROC_READ,
+			(xdrproc_t)xdr_readargs, &SERP_FILE(node),
+			(xdrproc_t)xdr_readres, &slot->res.rr
+		);
+
+		if (!xact)
+			break;
+
+		slot->xact   = xact;
+		slot->offset = pipe->ahead;
+		slot->count  = count;
+		pipe->ahead += count;
+		pipe->pending++;
+	}
+}
+
+/* Read from the read-ahead slots of a pipe.
+ *
+ * RETURNS:	number of bytes read, 0 at end of file
+ * 			or -1 on error with errno set.
+ */
+static ssize_t
+nfsPipeRead(NfsNode node, NfsPipe pipe, uint32_t offset, char *in, size_t count)
+{
+ssize_t		rv = 0;
+NfsPipeSlot	slot;
+uint32_t	avail;
+
+	if (pipe->pending == 0)
+		pipe->ahead = offset;
+
+	while (count > 0) {
+		nfsPipeFill(node, pipe);
+
+		if (pipe->pending == 0) {
+			/* could not send anything; errno is set */
+			if (rv == 0)
+				rv = -1;
+			break;
+		}
+
+		slot = &pipe->slot[pipe->head];
+		nfsPipeComplete(node, pipe);
+
+		if (slot->done < 0) {
+			nfsPipeDrain(node, pipe);
+			errno = slot->error;
+			if (rv == 0)
+				rv = -1;
+			break;
+		}
+
+		avail = (uint32_t) slot->done - pipe->consumed;
+		if (avail > count)
+			avail = count;
+
+		memcpy(in, pipe->buf + pipe->head * NFS_MAXDATA + pipe->consumed, avail);
+		pipe->consumed += avail;
+		in             += avail;
+		count          -= avail;
+		rv             += avail;
+
+		if (pipe->consumed == (uint32_t) slot->done) {
+			if ((uint32_t) slot->done < slot->count) {
+				/* short read: end of file, the rest is beyond */
+				nfsPipeDrain(node, pipe);
+				break;
+			}
+			nfsPipeRetire(node, pipe);
+		}
+	}
+
+	return rv;
+}
+
 static int nfs_file_close(
 	rtems_libio_t *iop
 )
 {
-	return 0;
+int		rv;
+NfsNode	node = iop->pathinfo.node_access;
+NfsPipe	pipe = node->pipe;
+
+	if (!pipe)
+		return 0;
+
+	rv = nfsPipeFlush(node);
+
+	free(pipe->buf);
+	free(pipe);
+	node->pipe = 0;
+
+	return rv;
+}
+
+static int nfs_file_fsync(
+	rtems_libio_t *iop
+)
+{
+	return nfsPipeFlush(iop->pathinfo.node_access);
 }
 
 static int nfs_dir_close(
@@ -2418,6 +3195,7 @@ static ssize_t nfs_file_read(
 {
 	ssize_t rv = 0;
 	NfsNode node = iop->pathinfo.node_access;
+	NfsPipe pipe = nfsPipeGet(node);
 	uint32_t offset = iop->offset;
 	char *in = buffer;
 
@@ -2435,6 +3213,37 @@ static ssize_t nfs_file_read(
 		count = UINT32_MAX - offset;
 	}
 
+	if (pipe != NULL) {
+		if (pipe->writing) {
+			nfsPipeDrain(node, pipe);
+		} else if (
+			pipe->pending > 0
+				&& pipe->slot[pipe->head].offset + pipe->consumed != offset
+		) {
+			/* not sequential, the read-ahead is useless */
+			nfsPipeDrain(node, pipe);
+		}
+
+		if (pipe->pending > 0 || offset == pipe->last || count > NFS_MAXDATA) {
+			if (pipe->buf == NULL) {
+				pipe->buf = malloc(pipe->window * NFS_MAXDATA);
+			}
+
+			if (pipe->buf != NULL) {
+				rv = nfsPipeRead(node, pipe, offset, in, count);
+
+				if (rv > 0) {
+					offset += (uint32_t) rv;
+					iop->offset = offset;
+				}
+
+				pipe->last = offset;
+
+				return rv;
+			}
+		}
+	}
+
 	do {
 		size_t chunk = count <= NFS_MAXDATA ? count : NFS_MAXDATA;
 		ssize_t done = nfs_file_read_chunk(node, offset, in, chunk);
@@ -2456,6 +3265,10 @@ static ssize_t nfs_file_read(
 		iop->offset = offset;
 	}
 
+	if (pipe != NULL) {
+		pipe->last = offset;
+	}
+
 	return rv;
 }
 
@@ -2520,6 +3333,94 @@ RpcUdpServer	server = ((Nfs)iop->pathinfo.mt_entry->fs_info)->server;
 	return rv;
 }
 
+/* Queue the data of a write to the pipe of an open
+ * file, waiting only if the window is full.
+ */
+static ssize_t nfs_file_write_behind(
+	rtems_libio_t *iop,
+	NfsPipe        pipe,
+	const void    *buffer,
+	size_t        count
+)
+{
+ssize_t		rv  = 0;
+NfsNode		node = iop->pathinfo.node_access;
+Nfs			nfs  = node->nfs;
+const char	*out = buffer;
+uint32_t	offset;
+NfsPipeSlot	slot;
+RpcUdpXact	xact;
+uint32_t	chunk;
+
+	if (iop->offset < 0) {
+		errno = EINVAL;
+		return -1;
+	}
+	if ((uintmax_t) iop->offset >= UINT32_MAX) {
+		errno = EFBIG;
+		return -1;
+	}
+
+	offset = iop->offset;
+
+	if (count > UINT32_MAX - offset) {
+		count = UINT32_MAX - offset;
+	}
+
+	pipe->writing = 1;
+
+	while (count > 0) {
+		if (pipe->pending == pipe->window) {
+			nfsPipeRetire(node, pipe);
+			if (pipe->error)
+				break;
+		}
+
+		chunk = count <= NFS_MAXDATA ? count : NFS_MAXDATA;
+		slot  = &pipe->slot[(pipe->head + pipe->pending) % pipe->window];
+
+		SERP_ARGS(node).writearg.beginoffset   = UINT32_C(0xdeadbeef);
+		SERP_ARGS(node).writearg.offset        = offset;
+		SERP_ARGS(node).writearg.totalcount	   = UINT32_C(0xdeadbeef);
+		SERP_ARGS(node).writearg.data.data_len = chunk;
+		SERP_ARGS(node).writearg.data.data_val = (void*)out;
+
+		/* the data is copied into the transaction right away */
+		xact = nfscall_send(
+			nfs->server,
+			NFSPROC_WRITE,
+			(xdrproc_t)xdr_writeargs, &SERP_FILE(node),
+			(xdrproc_t)xdr_attrstat, &slot->res.as
+		);
+
+		if (!xact) {
+			if (rv == 0)
+				rv = -1;
+			break;
+		}
+
+		slot->xact   = xact;
+		slot->offset = offset;
+		slot->count  = chunk;
+		pipe->pending++;
+
+		offset += chunk;
+		out    += chunk;
+		count  -= chunk;
+		rv     += chunk;
+	}
+
+	if (rv > 0) {
+		iop->offset = offset;
+	} else if (rv == 0 && pipe->error) {
+		errno       = pipe->error;
+		pipe->error = 0;
+		rv          = -1;
+	}
+
+	return rv;
+}
+
 static ssize_t nfs_file_write(
 	rtems_libio_t *iop,
 	const void    *buffer,
@@ -2529,6 +3430,22 @@ static ssize_t nfs_file_write(
 ssize_t rv;
 NfsNode 	node = iop->pathinfo.node_access;
 Nfs			nfs  = node->nfs;
+NfsPipe		pipe = nfsPipeGet(node);
+
+	if (pipe) {
+		/* appending needs the size after all previous writes */
+		if (!pipe->writing || rtems_libio_iop_is_append(iop))
+			nfsPipeDrain(node, pipe);
+
+		if (pipe->error) {
+			errno       = pipe->error;
+			pipe->error = 0;
+			return -1;
+		}
+
+		if (!rtems_libio_iop_is_append(iop))
+			return nfs_file_write_behind(iop, pipe, buffer, count);
+	}
 
 	if (count > NFS_MAXDATA)
 		count = NFS_MAXDATA;
@@ -2580,6 +3497,7 @@ Nfs			nfs  = node->nfs;
 
 		if (rv == 0) {
 			node->age = nowSeconds();
+			nfsAttrCachePut(node);
 
 			iop->offset += count;
 			rv = count;
@@ -2669,6 +3587,11 @@ static int nfs_fstat(
 NfsNode	node = loc->node_access;
 fattr	*fa  = &SERP_ATTR(node);
 
+	/* the attributes must reflect pending writes */
+	if (node->pipe && node->pipe->writing) {
+		nfsPipeDrain(node, node->pipe);
+	}
+
 	if (updateAttr(node, 0 /* only if old */)) {
 		return -1;
 	}
@@ -2789,6 +3712,7 @@ u_int					mode;
 
 		if (rv == 0) {
 			node->age = nowSeconds();
+			nfsAttrCachePut(node);
 		} else {
 #if DEBUG & DEBUG_SYSCALLS
 			fprintf(stderr,"nfs_sattr: %s\n",strerror(errno));
@@ -2817,6 +3741,7 @@ static int nfs_file_ftruncate(
 )
 {
 sattr					arg;
+NfsNode					node = iop->pathinfo.node_access;
 
 	if (length < 0) {
 		errno = EINVAL;
@@ -2828,12 +3753,17 @@ sattr					arg;
 		return -1;
 	}
 
+	/* pending writes must not extend the file afterwards */
+	if (node->pipe) {
+		nfsPipeDrain(node, node->pipe);
+	}
+
 	arg.size = length;
 	/* must not modify any other attribute; if we are not the owner
 	 * of the file or directory but only have write access changing
 	 * any attribute besides 'size' will fail...
 	 */
-	return nfs_sattr(iop->pathinfo.node_access,
+	return nfs_sattr(node,
 					 &arg,
 					 SATTR_SIZE);
 }
@@ -2849,8 +3779,8 @@ struct _rtems_filesystem_file_handlers_r nfs_file_file_handlers = {
 	.lseek_h     = rtems_filesystem_default_lseek_file,
 	.fstat_h     = nfs_fstat,
 	.ftruncate_h = nfs_file_ftruncate,
-	.fsync_h     = rtems_filesystem_default_fsync_or_fdatasync,
-	.fdatasync_h = rtems_filesystem_default_fsync_or_fdatasync,
+	.fsync_h     = nfs_file_fsync,
+	.fdatasync_h = nfs_file_fsync,
 	.fcntl_h     = rtems_filesystem_default_fcntl,
 	.kqfilter_h  = rtems_filesystem_default_kqfilter,
 	.mmap_h      = rtems_filesystem_default_mmap,
@@ -2956,11 +3886,26 @@ Nfs		nfs;
 	LOCK(nfsGlob.llock);
 
 	for (nfs = nfsGlob.mounted_fs; nfs; nfs=nfs->next) {
+		NfsCacheStatsRec stats;
+
 		fprintf(f,"%s on ", nfs->mt_entry->dev);
 		if (rtems_filesystem_resolve_location(mntpt, MAXPATHLEN, &nfs->mt_entry->mt_fs_root->location))
 			fprintf(f,"<UNABLE TO LOOKUP MOUNTPOINT>\n");
 		else
 			fprintf(f,"%s\n",mntpt);
+
+		rtems_mutex_lock(&nfs->cacheLock);
+		stats = nfs->cacheStats;
+		rtems_mutex_unlock(&nfs->cacheLock);
+
+		fprintf(f,
+				"  GETATTR: %lu cached, %lu RPCs;"
+				" LOOKUP: %lu cached, %lu cached ENOENT, %lu RPCs\n",
+				stats.attrHits,
+				stats.attrRpcs,
+				stats.lookupHits,
+				stats.lookupNegHits,
+				stats.lookupRpcs);
 	}
 
 	UNLOCK(nfsGlob.llock);
@@ -2969,6 +3914,33 @@ Nfs		nfs;
 	return 0;
 }
 
+/* Get the cache counters of the NFS mounted at 'mountpoint' */
+int
+nfsCacheStatsGet(const char *mountpoint, NfsCacheStatsRec *stats)
+{
+Nfs		nfs;
+int		rval = -1;
+
+	LOCK(nfsGlob.llock);
+
+	for (nfs = nfsGlob.mounted_fs; nfs; nfs=nfs->next) {
+		if ( nfs->mt_entry && !strcmp(nfs->mt_entry->target, mountpoint) ) {
+			rtems_mutex_lock(&nfs->cacheLock);
+			*stats = nfs->cacheStats;
+			rtems_mutex_unlock(&nfs->cacheLock);
+			rval = 0;
+			break;
+		}
+	}
+
+	UNLOCK(nfsGlob.llock);
+
+	if (rval)
+		errno = ENOENT;
+
+	return rval;
+}
+
 #if 0
 CCJ_REMOVE_MOUNT
 /* convenience wrapper
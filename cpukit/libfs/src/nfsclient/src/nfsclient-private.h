@@ -12,3 +12,24 @@ struct __rpc_xdr;
 enum xdr_op;
 
 void xdrmbuf_create(struct __rpc_xdr *, struct mbuf *, enum xdr_op);
+
+/* Jacobson/Karels round trip time estimator of a server */
+typedef struct RpcRttEstimatorRec_ {
+	long	srtt;	/* smoothed round trip time (ticks, scaled by 8)      */
+	long	rttvar;	/* round trip time variation (ticks, scaled by 4)    */
+} RpcRttEstimator;
+
+/* Returns the retry period clamped to [min_period, max_period] */
+long rpcRttUpdate(RpcRttEstimator *est, long trip, long min_period,
+    long max_period);
+
+/* Index of the daemon owning a transaction; the hash table
+ * slot of the XID selects it, so that all retransmissions
+ * and the reply of a transaction are handled by the same
+ * daemon.
+ */
+static inline int
+rpcXidToIod(unsigned long xid, unsigned long hash_msk, int iod_count)
+{
+	return (int) ((xid & hash_msk) % (unsigned long) iod_count);
+}
@@ -126,11 +126,25 @@
 #define RPCIOD_STACK		10000
 #define RPCIOD_PRIO			100	/* *fallback* priority */
 
+/* number of daemons sharing the RPC traffic; each
+ * one uses its own socket. May be overridden by
+ * setting 'rpciodCount' prior to calling rpcUdpInit()
+ */
+#define RPCIOD_COUNT		1
+#define RPCIOD_MAX_COUNT	8
+
 /* depth of the message queue for sending
- * RPC requests to the daemon
+ * RPC requests to a daemon. May be overridden by
+ * setting 'rpciodQueueDepth' prior to calling rpcUdpInit()
  */
 #define RPCIOD_QDEPTH		20
 
+/* Minimum retransmission interval (ticks); round
+ * trips are measured in ticks, so this keeps the
+ * clock granularity from triggering retransmissions
+ */
+#define RPCIOD_RETX_MIN		2
+
 /* Maximum retry limit for retransmission */
 #define RPCIOD_RETX_CAP_S	3 /* seconds */
 
@@ -143,14 +157,10 @@ static struct timeval _rpc_default_timeout = { 10 /* secs */, 0 /* usecs */ };
  */
 #define RPCIOD_REFRESH		2
 
-/* Events we are using; the RPC_EVENT
- * MUST NOT be used by any application
- * thread doing RPC IO (e.g. NFS)
+/* Events the daemon is using; requestors are woken
+ * through a semaphore in each transaction so that a task
+ * may have several transactions outstanding at a time.
  */
-#define RTEMS_RPC_EVENT		RTEMS_EVENT_30	/* THE event used by RPCIO. Every task doing
-											 * RPC IO will receive this - hence it is
-											 * RESERVED
-											 */
 #define RPCIOD_RX_EVENT		RTEMS_EVENT_1	/* Events the RPCIOD is using/waiting for */
 #define RPCIOD_TX_EVENT		RTEMS_EVENT_2
 #define RPCIOD_KILL_EVENT	RTEMS_EVENT_3	/* send to the daemon to kill it          */
@@ -247,9 +257,14 @@ typedef struct RpcUdpServerRec_ {
 											 * experience will show if the current (1)
 											 * approach has to be changed.
 											 */
+		rtems_mutex			lock;			/* protects the retry period, the round
+											 * trip estimate and the statistics; several
+											 * daemons may talk to this server
+											 */
 		TimeoutT			retry_period;	/* dynamically adjusted retry period
 											 * (based on packet roundtrip time)
 											 */
+		RpcRttEstimator		rtt;			/* round trip time estimate                */
 		/* STATISTICS */
 		unsigned long		retrans;		/* how many retries were issued by this server         */
 		unsigned long		requests;		/* how many requests have been sent                    */
@@ -293,7 +308,8 @@ typedef struct RpcUdpXactRec_ {
 		struct rpc_err		status;		/* RPC reply error status                       */
 		long				age;		/* age info; needed to manage retransmission    */
 		long				trip;		/* record round trip time in ticks              */
-		rtems_id			requestor;	/* the task waiting for this XACT to complete   */
+		int					retx;		/* number of retransmissions                    */
+		rtems_binary_semaphore	done;	/* posted when this XACT completes              */
 		RpcUdpXactPool		pool;		/* if this XACT belong to a pool, this is it    */
 		XDR					xdrs;		/* argument encoder stream                      */
 		int					xdrpos;     /* stream position after the (permanent) header */
@@ -329,9 +345,26 @@ static RpcUdpXact xactHashTbl[XACT_HASHS]={0};
 static u_long     xidUpper   [XACT_HASHS]={0};
 static unsigned   xidHashSeed            = 0 ;
 
+/* An RPC I/O daemon.  Each daemon owns a socket and
+ * a request queue.  A transaction is always handled
+ * by the same daemon which is selected by its hash
+ * table slot (i.e. the lower bits of the XID).
+ */
+typedef struct RpcIodRec_ {
+		rtems_id			tid;		/* task id of the daemon                        */
+		rtems_id			msgQ;		/* message queue where the daemon picks up
+										 * requests
+										 */
+		int					sock;		/* the socket this daemon is using              */
+		/* STATISTICS */
+		unsigned long		sent;		/* packets sent (including retransmissions)     */
+		unsigned long		received;	/* replies matched to a transaction             */
+		unsigned long		dropped;	/* replies dropped (late, redundant, unknown)   */
+} RpcIodRec, *RpcIod;
+
 /* forward declarations */
 static RpcUdpXact
-sockRcv(void);
+sockRcv(RpcIod iod);
 
 static void
 rpcio_daemon(rtems_task_argument);
@@ -356,11 +389,14 @@ static void paranoia_ref (caddr_t closure, u_int size);
 
 static RpcUdpServer		rpcUdpServers = 0;	/* linked list of all servers; protected by llock */
 
-static int				ourSock = -1;		/* the socket we are using for communication */
-static rtems_id			rpciod  = 0;		/* task id of the RPC daemon                 */
-static rtems_id			msgQ    = 0;		/* message queue where the daemon picks up
-											 * requests
+static RpcIodRec		rpciods[RPCIOD_MAX_COUNT];	/* the RPC daemons             */
+static int				nRpciods = 0;		/* number of running daemons                 */
+static int				rpciodUp = 0;		/* daemons accept transactions; protected by
+											 * hlock
 											 */
+
+/* the daemon handling a transaction */
+#define XACT_IOD(xact)	(&rpciods[rpcXidToIod((xact)->obuf.xid, XACT_HASH_MSK, nRpciods)])
 #ifndef NDEBUG
 static rtems_recursive_mutex	llock;		/* MUTEX protecting the server list */
 static rtems_recursive_mutex	hlock;		/* MUTEX protecting the hash table and the list of servers */
@@ -373,6 +409,8 @@ static rtems_interval	ticksPerSec;		/* cached system clock rate (WHO IS ASSUMED
 											 */
 
 rtems_task_priority		rpciodPriority = 0;
+int						rpciodCount    = RPCIOD_COUNT;
+int						rpciodQueueDepth = RPCIOD_QDEPTH;
 #ifdef RTEMS_SMP
 const cpu_set_t			*rpciodCpuset = 0;
 size_t				rpciodCpusetSize = 0;
@@ -562,6 +600,7 @@ struct pmap		pmaparg;
 	rval->auth 			= auth;
 
 	MU_CREAT( &rval->authlock );
+	rtems_mutex_init( &rval->lock, "RPCs" );
 
 	/* link into list */
 	MU_LOCK( llock );
@@ -605,6 +644,7 @@ RpcUdpServer prev;
 	auth_destroy(s->auth);
 
 	MU_DESTROY(s->authlock);
+	rtems_mutex_destroy(&s->lock);
 	MY_FREE(s);
 }
 
@@ -612,20 +652,34 @@ int
 rpcUdpStats(FILE *f)
 {
 RpcUdpServer s;
+int          i;
 
 	if (!f) f = stdout;
 
 	fprintf(f,"RPCIOD statistics:\n");
 
+	for (i = 0; i < nRpciods; i++) {
+		fprintf(f,"\nDaemon %i:\n", i);
+		fprintf(f,"  packets     sent: %10lu,      received: %10lu\n",
+						rpciods[i].sent, rpciods[i].received);
+		fprintf(f,"   replies dropped: %10lu\n",
+						rpciods[i].dropped);
+	}
+
 	MU_LOCK(llock);
 	for (s = rpcUdpServers; s; s=s->next) {
+		rtems_mutex_lock(&s->lock);
 		fprintf(f,"\nServer -- %s:\n", s->name);
 		fprintf(f,"  requests    sent: %10ld, retransmitted: %10ld\n",
 						s->requests, s->retrans);
 		fprintf(f,"         timed out: %10ld,   send errors: %10ld\n",
 						s->timeouts, s->errors);
+		fprintf(f,"  smoothed round trip: %ums, variation: %ums\n",
+						(unsigned)((s->rtt.srtt >> 3) * 1000 / ticksPerSec),
+						(unsigned)((s->rtt.rttvar >> 2) * 1000 / ticksPerSec) );
 		fprintf(f,"  current retransmission interval: %dms\n",
 						(unsigned)(s->retry_period * 1000 / ticksPerSec) );
+		rtems_mutex_unlock(&s->lock);
 	}
 	MU_UNLOCK(llock);
 
@@ -658,8 +712,10 @@ register int	i,j;
 		header.rm_call.cb_prog    = program;
 		header.rm_call.cb_vers    = version;
 		xdrmem_create(&(rval->xdrs), rval->obuf.buf, size, XDR_ENCODE);
+		rtems_binary_semaphore_init(&rval->done, "RPCx");
 
 		if (!xdr_callhdr(&(rval->xdrs), &header)) {
+			rtems_binary_semaphore_destroy(&rval->done);
 			MY_FREE(rval);
 			return 0;
 		}
@@ -667,8 +723,8 @@ register int	i,j;
 		MU_LOCK(hlock);
 		rval->obuf.xid = (xidHashSeed++ ^ ((uintptr_t)rval>>10)) & XACT_HASH_MSK;
 		i=j=(rval->obuf.xid & XACT_HASH_MSK);
-		if (msgQ) {
-			/* if there's no message queue, refuse to
+		if (rpciodUp) {
+			/* if there's no daemon, refuse to
 			 * give them transactions; we might be in the process to
 			 * go away...
 			 */
@@ -687,6 +743,7 @@ register int	i,j;
 		MU_UNLOCK(hlock);
 		if (i==j) {
 			XDR_DESTROY(&rval->xdrs);
+			rtems_binary_semaphore_destroy(&rval->done);
 			MY_FREE(rval);
 			return 0;
 		}
@@ -719,6 +776,7 @@ int i = xact->obuf.xid & XACT_HASH_MSK;
 		bufFree(&xact->ibuf);
 
 		XDR_DESTROY(&xact->xdrs);
+		rtems_binary_semaphore_destroy(&xact->done);
 		MY_FREE(xact);
 }
 
@@ -741,6 +799,7 @@ rpcUdpSend(
 register XDR	*xdrs;
 unsigned long	ms;
 va_list			ap;
+RpcIod			iod;
 
 	va_start(ap,pargs);
 
@@ -789,12 +848,12 @@ va_list			ap;
 
 	va_end(ap);
 
-	rtems_task_ident(RTEMS_SELF, RTEMS_WHO_AM_I, &xact->requestor);
-	if ( rtems_message_queue_send( msgQ, &xact, sizeof(xact)) ) {
+	iod = XACT_IOD(xact);
+	if ( rtems_message_queue_send( iod->msgQ, &xact, sizeof(xact)) ) {
 		return RPC_CANTSEND;
 	}
 	/* wakeup the rpciod */
-	ASSERT( RTEMS_SUCCESSFUL==rtems_event_send(rpciod, RPCIOD_TX_EVENT) );
+	ASSERT( RTEMS_SUCCESSFUL==rtems_event_send(iod->tid, RPCIOD_TX_EVENT) );
 
 	return RPC_SUCCESS;
 }
@@ -810,20 +869,13 @@ rpcUdpRcv(RpcUdpXact xact)
 int					refresh;
 XDR			reply_xdrs;
 struct rpc_msg		reply_msg;
-rtems_status_code	status;
-rtems_event_set		gotEvents;
 
 	refresh = 0;
 
 	do {
 
 	/* block for the reply */
-	status = rtems_event_receive(
-		RTEMS_RPC_EVENT,
-		RTEMS_WAIT | RTEMS_EVENT_ANY,
-		RTEMS_NO_TIMEOUT,
-		&gotEvents);
-	ASSERT( status == RTEMS_SUCCESSFUL );
+	rtems_binary_semaphore_wait(&xact->done);
 
 	if (xact->status.re_status) {
 #ifdef MBUF_RX
@@ -878,13 +930,14 @@ rtems_event_set		gotEvents;
 #endif
 
 	if (refresh && locked_refresh(xact->server)) {
-		rtems_task_ident(RTEMS_SELF, RTEMS_WHO_AM_I, &xact->requestor);
-		if ( rtems_message_queue_send(msgQ, &xact, sizeof(xact)) ) {
+		RpcIod iod = XACT_IOD(xact);
+
+		if ( rtems_message_queue_send(iod->msgQ, &xact, sizeof(xact)) ) {
 			return RPC_CANTSEND;
 		}
 		/* wakeup the rpciod */
 		fprintf(stderr,"RPCIO INFO: refreshing my AUTH\n");
-		ASSERT( RTEMS_SUCCESSFUL==rtems_event_send(rpciod, RPCIOD_TX_EVENT) );
+		ASSERT( RTEMS_SUCCESSFUL==rtems_event_send(iod->tid, RPCIOD_TX_EVENT) );
 	}
 
 	} while ( 0 &&  refresh-- > 0 );
@@ -899,8 +952,8 @@ rtems_event_set		gotEvents;
 static void
 rxWakeupCB(struct socket *sock, void *arg)
 {
-  rtems_id *rpciod = (rtems_id*) arg;
-  rtems_event_send(*rpciod, RPCIOD_RX_EVENT);
+  RpcIod iod = (RpcIod) arg;
+  rtems_event_send(iod->tid, RPCIOD_RX_EVENT);
 }
 
 void
@@ -915,70 +968,120 @@ rpcSetXIDs(uint32_t xid)
 	}
 }
 
-int
-rpcUdpInit(void)
+/* Create the socket, queue and task of a daemon;
+ * the task is not started.
+ */
+static int
+rpciodCreate(RpcIod iod, int i)
 {
-int			s;
 rtems_status_code	status;
 int			noblock = 1;
 struct sockwakeup	wkup;
+int			s;
+
+	iod->sock=socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (iod->sock<0)
+		return -1;
+
+	bindresvport(iod->sock,(struct sockaddr_in*)0);
+	s = ioctl(iod->sock, FIONBIO, (char*)&noblock);
+	assert( s == 0 );
+
+	status = rtems_task_create(
+									rtems_build_name('R','P','C', i ? '0' + i : 'd'),
+									rpciodPriority,
+									RPCIOD_STACK,
+									RTEMS_DEFAULT_MODES,
+									/* fprintf saves/restores FP registers on PPC :-( */
+									RTEMS_DEFAULT_ATTRIBUTES | RTEMS_FLOATING_POINT,
+									&iod->tid);
+	if ( status != RTEMS_SUCCESSFUL ) {
+		close(iod->sock);
+		return -1;
+	}
+
+#ifdef RTEMS_SMP
+	if ( rpciodCpuset != 0 )
+		rtems_task_set_affinity( iod->tid, rpciodCpusetSize, rpciodCpuset );
+#endif
+
+	wkup.sw_pfn = rxWakeupCB;
+	wkup.sw_arg = iod;
+	assert( 0==setsockopt(iod->sock, SOL_SOCKET, SO_RCVWAKEUP, &wkup, sizeof(wkup)) );
+	status = rtems_message_queue_create(
+									rtems_build_name('R','P','C', i ? 'a' + i : 'q'),
+									rpciodQueueDepth,
+									sizeof(RpcUdpXact),
+									RTEMS_DEFAULT_ATTRIBUTES,
+									&iod->msgQ);
+	if ( status != RTEMS_SUCCESSFUL ) {
+		rtems_task_delete(iod->tid);
+		close(iod->sock);
+		return -1;
+	}
+
+	return 0;
+}
 
-	if (ourSock < 0) {
+int
+rpcUdpInit(void)
+{
+rtems_status_code	status;
+int			i;
+
+	if (!nRpciods) {
     fprintf(stderr,"RTEMS-RPCIOD, " \
             "Till Straumann, Stanford/SLAC/SSRL 2002, " \
             "See LICENSE file for licensing info.\n");
 
-		ourSock=socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-		if (ourSock>=0) {
-			bindresvport(ourSock,(struct sockaddr_in*)0);
-			s = ioctl(ourSock, FIONBIO, (char*)&noblock);
-			assert( s == 0 );
-			/* assume nobody tampers with the clock !! */
-			ticksPerSec = rtems_clock_get_ticks_per_second();
-			MU_CREAT( &hlock );
-			MU_CREAT( &llock );
-
-			if ( !rpciodPriority ) {
-				/* use configured networking priority */
-				if ( ! (rpciodPriority = rtems_bsdnet_config.network_task_priority) )
-					rpciodPriority = RPCIOD_PRIO;	/* fallback value */
-			}
+		/* assume nobody tampers with the clock !! */
+		ticksPerSec = rtems_clock_get_ticks_per_second();
+		MU_CREAT( &hlock );
+		MU_CREAT( &llock );
 
-			status = rtems_task_create(
-											rtems_build_name('R','P','C','d'),
-											rpciodPriority,
-											RPCIOD_STACK,
-											RTEMS_DEFAULT_MODES,
-											/* fprintf saves/restores FP registers on PPC :-( */
-											RTEMS_DEFAULT_ATTRIBUTES | RTEMS_FLOATING_POINT,
-											&rpciod);
-			assert( status == RTEMS_SUCCESSFUL );
+		if ( !rpciodPriority ) {
+			/* use configured networking priority */
+			if ( ! (rpciodPriority = rtems_bsdnet_config.network_task_priority) )
+				rpciodPriority = RPCIOD_PRIO;	/* fallback value */
+		}
 
 #ifdef RTEMS_SMP
-			if ( rpciodCpuset == 0 ) {
-				rpciodCpuset = rtems_bsdnet_config.network_task_cpuset;
-				rpciodCpusetSize = rtems_bsdnet_config.network_task_cpuset_size;
-			}
-			if ( rpciodCpuset != 0 )
-				rtems_task_set_affinity( rpciod, rpciodCpusetSize, rpciodCpuset );
+		if ( rpciodCpuset == 0 ) {
+			rpciodCpuset = rtems_bsdnet_config.network_task_cpuset;
+			rpciodCpusetSize = rtems_bsdnet_config.network_task_cpuset_size;
+		}
 #endif
 
-			wkup.sw_pfn = rxWakeupCB;
-			wkup.sw_arg = &rpciod;
-			assert( 0==setsockopt(ourSock, SOL_SOCKET, SO_RCVWAKEUP, &wkup, sizeof(wkup)) );
-			status = rtems_message_queue_create(
-											rtems_build_name('R','P','C','q'),
-											RPCIOD_QDEPTH,
-											sizeof(RpcUdpXact),
-											RTEMS_DEFAULT_ATTRIBUTES,
-											&msgQ);
-			assert( status == RTEMS_SUCCESSFUL );
-			status = rtems_task_start( rpciod, rpcio_daemon, 0 );
-			assert( status == RTEMS_SUCCESSFUL );
+		if ( rpciodCount < 1 )
+			rpciodCount = 1;
+		if ( rpciodCount > RPCIOD_MAX_COUNT )
+			rpciodCount = RPCIOD_MAX_COUNT;
 
-		} else {
+		for ( i = 0; i < rpciodCount; i++ ) {
+			memset(&rpciods[i], 0, sizeof(rpciods[i]));
+			if ( rpciodCreate(&rpciods[i], i) )
+				break;
+		}
+
+		if ( i < rpciodCount ) {
+			while ( --i >= 0 ) {
+				rtems_message_queue_delete(rpciods[i].msgQ);
+				rtems_task_delete(rpciods[i].tid);
+				close(rpciods[i].sock);
+			}
+			MU_DESTROY( hlock );
+			MU_DESTROY( llock );
 			return -1;
 		}
+
+		/* the transaction to daemon mapping depends on this */
+		nRpciods = rpciodCount;
+		rpciodUp = 1;
+
+		for ( i = 0; i < nRpciods; i++ ) {
+			status = rtems_task_start( rpciods[i].tid, rpcio_daemon, (rtems_task_argument)&rpciods[i] );
+			assert( status == RTEMS_SUCCESSFUL );
+		}
 	}
 	return 0;
 }
@@ -986,14 +1089,37 @@ struct sockwakeup	wkup;
 int
 rpcUdpCleanup(void)
 {
-	rtems_event_send(rpciod, RPCIOD_KILL_EVENT);
-	/* synchronize with daemon */
-	rtems_binary_semaphore_wait_timed_ticks(&fini, 5*ticksPerSec);
-	/* if the message queue is still there, something went wrong */
-	if (!msgQ) {
-		rtems_task_delete(rpciod);
+int i;
+
+	MU_LOCK(hlock);
+	for (i=XACT_HASHS-1; i>=0; i--) {
+		if (xactHashTbl[i]) {
+			break;
+		}
+	}
+	if (i<0) {
+		/* prevent them from creating and enqueueing more messages */
+		rpciodUp = 0;
+	}
+	MU_UNLOCK(hlock);
+
+	if (i>=0) {
+		fprintf(stderr,"RPCIO There are still transactions circulating; I refuse to go away\n");
+		fprintf(stderr,"(1st in slot %i)\n",i);
+		return 1;
+	}
+
+	for (i=0; i<nRpciods; i++) {
+		rtems_event_send(rpciods[i].tid, RPCIOD_KILL_EVENT);
+		/* synchronize with daemon */
+		rtems_binary_semaphore_wait_timed_ticks(&fini, 5*ticksPerSec);
+		rtems_task_delete(rpciods[i].tid);
 	}
-	return (msgQ !=0);
+	nRpciods = 0;
+
+	MU_DESTROY(hlock);
+
+	return 0;
 }
 
 /* Another API - simpler but less efficient.
@@ -1134,6 +1260,7 @@ nodeAppend(ListNode l, ListNode n)
 static void
 rpcio_daemon(rtems_task_argument arg)
 {
+RpcIod            iod = (RpcIod) arg;
 rtems_status_code stat;
 RpcUdpXact        xact;
 RpcUdpServer      srv;
@@ -1142,11 +1269,9 @@ long			  			now;	/* need to do signed comparison with age! */
 rtems_event_set   events;
 ListNode          newList;
 size_t            size;
-rtems_id          q          =  0;
 ListNodeRec       listHead   = {0, 0};
 unsigned long     epoch      = RPCIOD_EPOCH_SECS * ticksPerSec;
 unsigned long			max_period = RPCIOD_RETX_CAP_S * ticksPerSec;
-rtems_status_code	status;
 
 
         then = rtems_clock_get_ticks_since_boot();
@@ -1164,32 +1289,13 @@ rtems_status_code	status;
 		}
 
 		if (events & RPCIOD_KILL_EVENT) {
-			int i;
 
 #if (DEBUG) & DEBUG_EVENTS
 			fprintf(stderr,"RPCIO: got KILL event\n");
 #endif
 
-			MU_LOCK(hlock);
-			for (i=XACT_HASHS-1; i>=0; i--) {
-				if (xactHashTbl[i]) {
-					break;
-				}
-			}
-			if (i<0) {
-				/* prevent them from creating and enqueueing more messages */
-				q=msgQ;
-				/* messages queued after we executed this assignment will fail */
-				msgQ=0;
-			}
-			MU_UNLOCK(hlock);
-			if (i>=0) {
-				fprintf(stderr,"RPCIO There are still transactions circulating; I refuse to go away\n");
-				fprintf(stderr,"(1st in slot %i)\n",i);
-				rtems_binary_semaphore_post(&fini);
-			} else {
-				break;
-			}
+			/* rpcUdpCleanup() made sure that no transactions exist */
+			break;
 		}
 
         	unow = rtems_clock_get_ticks_since_boot();
@@ -1212,7 +1318,7 @@ rtems_status_code	status;
 			fprintf(stderr,"RPCIO: got RX event\n");
 #endif
 
-			while ((xact=sockRcv())) {
+			while ((xact=sockRcv(iod))) {
 
 				/* extract from the retransmission list */
 				nodeXtract(&xact->node);
@@ -1231,27 +1337,23 @@ rtems_status_code	status;
 
 				srv                    = xact->server;
 
-				/* adjust the server's retry period */
-				{
-					register TimeoutT rtry = srv->retry_period;
-					register TimeoutT trip = xact->trip;
+				iod->received++;
 
-					ASSERT( trip >= 0 );
-
-					if ( 0==trip )
-						trip = 1;
-
-					/* retry_new = 0.75*retry_old + 0.25 * 8 * roundrip */
-					rtry   = (3*rtry + (trip << 3)) >> 2;
-
-					if ( rtry > max_period )
-						rtry = max_period;
+				/* adjust the server's retry period; a reply to
+				 * a retransmitted request can not be attributed
+				 * to a particular attempt (Karn)
+				 */
+				if ( 0 == xact->retx ) {
+					ASSERT( xact->trip >= 0 );
 
-					srv->retry_period = rtry;
+					rtems_mutex_lock(&srv->lock);
+					srv->retry_period = rpcRttUpdate(&srv->rtt, xact->trip,
+											RPCIOD_RETX_MIN, max_period);
+					rtems_mutex_unlock(&srv->lock);
 				}
 
 				/* wakeup requestor */
-				rtems_event_send(xact->requestor, RTEMS_RPC_EVENT);
+				rtems_binary_semaphore_post(&xact->done);
 			}
 		}
 
@@ -1262,7 +1364,7 @@ rtems_status_code	status;
 #endif
 
 			while (RTEMS_SUCCESSFUL == rtems_message_queue_receive(
-											msgQ,
+											iod->msgQ,
 											&xact,
 											&size,
 											RTEMS_NO_WAIT,
@@ -1272,6 +1374,7 @@ rtems_status_code	status;
 
 				xact->age  = now;
 				xact->trip = FIRST_ATTEMPT;
+				xact->retx = 0;
 			}
 		}
 
@@ -1292,7 +1395,9 @@ rtems_status_code	status;
 					xact->status.re_errno  = ETIMEDOUT;
 					xact->status.re_status = RPC_TIMEDOUT;
 
+					rtems_mutex_lock(&srv->lock);
 					srv->timeouts++;
+					rtems_mutex_unlock(&srv->lock);
 
 					/* Change the ID - there might still be
 					 * a reply on the way. When it arrives we
@@ -1306,10 +1411,7 @@ rtems_status_code	status;
 #if (DEBUG) & DEBUG_TIMEOUT
 					fprintf(stderr,"RPCIO XACT timed out; waking up requestor\n");
 #endif
-					if ( rtems_event_send(xact->requestor, RTEMS_RPC_EVENT) ) {
-						rtems_panic("RPCIO PANIC: requestor id was 0x%08" PRIx32,
-									xact->requestor);
-					}
+					rtems_binary_semaphore_post(&xact->done);
 
 				} else {
 					int len;
@@ -1319,7 +1421,9 @@ rtems_status_code	status;
 #ifdef MBUF_TX
 					xact->refcnt = 1;	/* sendto itself */
 #endif
-					if ( len != SENDTO( ourSock,
+					iod->sent++;
+
+					if ( len != SENDTO( iod->sock,
 										xact->obuf.buf,
 										len,
 										0,
@@ -1334,18 +1438,21 @@ rtems_status_code	status;
 
 						xact->status.re_errno  = errno;
 						xact->status.re_status = RPC_CANTSEND;
+						rtems_mutex_lock(&srv->lock);
 						srv->errors++;
+						rtems_mutex_unlock(&srv->lock);
 
 						/* wakeup requestor */
 						fprintf(stderr,"RPCIO: SEND failure\n");
-						status = rtems_event_send(xact->requestor, RTEMS_RPC_EVENT);
-						assert( status == RTEMS_SUCCESSFUL );
+						rtems_binary_semaphore_post(&xact->done);
 
 					} else {
 						/* send successful; calculate retransmission time
 						 * and enqueue to temporary list
 						 */
+						rtems_mutex_lock(&srv->lock);
 						if (FIRST_ATTEMPT != xact->trip) {
+							xact->retx++;
 #if (DEBUG) & DEBUG_TIMEOUT
 							fprintf(stderr,
 								"timed out; tolive is %i (ticks), retry period is %i (ticks)\n",
@@ -1395,6 +1502,7 @@ rtems_status_code	status;
 						xact->age       = now + capped_period;
 						xact->tolive   -= capped_period;
 						}
+						rtems_mutex_unlock(&srv->lock);
 						/* enqueue to the list of newly sent transactions */
 						xact->node.next = newList;
 						newList         = &xact->node;
@@ -1456,14 +1564,14 @@ rtems_status_code	status;
 #endif
 	}
 	/* close our socket; shut down the receiver */
-	close(ourSock);
+	close(iod->sock);
 
 #if 0 /* if we get here, no transactions exist, hence there can be none
 	   * in the queue whatsoever
 	   */
 	/* flush the message queue */
 	while (RTEMS_SUCCESSFUL == rtems_message_queue_receive(
-										q,
+										iod->msgQ,
 										&xact,
 										&size,
 										RTEMS_NO_WAIT,
@@ -1475,13 +1583,11 @@ rtems_status_code	status;
 
 	for (xact=((RpcUdpXact)listHead.next); xact; xact=((RpcUdpXact)xact->node.next)) {
 			xact->status.re_status = RPC_TIMEDOUT;
-			rtems_event_send(xact->requestor, RTEMS_RPC_EVENT);
+			rtems_binary_semaphore_post(&xact->done);
 	}
 #endif
 
-	rtems_message_queue_delete(q);
-
-	MU_DESTROY(hlock);
+	rtems_message_queue_delete(iod->msgQ);
 
 	fprintf(stderr,"RPC daemon exited...\n");
 
@@ -1638,7 +1744,7 @@ int        len  = (int)XDR_GETPOS(&xact->xdrs);
 #define RPCIOD_RXBUFSZ	UDPMSGSIZE
 
 static RpcUdpXact
-sockRcv(void)
+sockRcv(RpcIod iod)
 {
 int					len,i;
 uint32_t				xid;
@@ -1666,7 +1772,7 @@ RpcUdpXact			xact     = 0;
 		bufFree(&ibuf);
 
 	len  = recv_mbuf_from(
-					ourSock,
+					iod->sock,
 					&ibuf,
 					RPCIOD_RXBUFSZ,
 				    &fromAddr.sa,
@@ -1677,7 +1783,7 @@ RpcUdpXact			xact     = 0;
 	if ( !ibuf )
 		goto cleanup; /* no memory - drop this message */
 
-	len  = recvfrom(ourSock,
+	len  = recvfrom(iod->sock,
 				    ibuf->buf,
 				    RPCIOD_RXBUFSZ,
 				    0,
@@ -1706,6 +1812,7 @@ RpcUdpXact			xact     = 0;
 	i = (xid=XID(ibuf)) & XACT_HASH_MSK;
 
 	if ( !(xact=xactHashTbl[i])                                             ||
+		   XACT_IOD(xact)                     != iod                        ||
 		   xact->obuf.xid                     != xid                        ||
 #ifdef REJECT_SERVERIP_MISMATCH
 		   xact->server->addr.sin.sin_addr.s_addr != fromAddr.sin.sin_addr.s_addr	||
@@ -1741,6 +1848,7 @@ RpcUdpXact			xact     = 0;
 					xid);
 		}
 		/* forget about this one and try again */
+		iod->dropped++;
 		xact = 0;
 	}
 
@@ -1768,6 +1876,9 @@ cleanup:
  * included mbuf.h only a couple of lines above - see comment up
  * there...
  */
-#if RTEMS_RPC_EVENT & SOSLEEP_EVENT & SBWAIT_EVENT & NETISR_EVENTS
+/* The daemons never wait for the netisr events, they only
+ * must not collide with the events of the socket layer.
+ */
+#if (RPCIOD_RX_EVENT | RPCIOD_TX_EVENT | RPCIOD_KILL_EVENT) & (SOSLEEP_EVENT | SBWAIT_EVENT)
 #error ILLEGAL EVENT CONFIGURATION
 #endif
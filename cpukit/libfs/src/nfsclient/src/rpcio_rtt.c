@@ -0,0 +1,58 @@
+/**
+ * @file
+ *
+ * @brief RPC Round Trip Time Estimator
+ * @ingroup libfs
+ */
+
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <sys/types.h>
+
+#include "nfsclient-private.h"
+
+/* Feed a round trip time sample (ticks) into the
+ * estimator and derive the retry period
+ * (Jacobson/Karels: srtt + 4*rttvar).
+ */
+long
+rpcRttUpdate(RpcRttEstimator *est, long trip, long min_period, long max_period)
+{
+long	delta;
+long	rto;
+
+	if ( 0 == trip )
+		trip = 1;
+
+	if ( 0 == est->srtt ) {
+		/* first sample */
+		est->srtt   = trip << 3;
+		est->rttvar = trip << 1;
+	} else {
+		/* srtt = 7/8 srtt + 1/8 trip; rttvar = 3/4 rttvar + 1/4 |delta| */
+		delta        = trip - (est->srtt >> 3);
+		est->srtt   += delta;
+		if ( delta < 0 )
+			delta = -delta;
+		est->rttvar += delta - (est->rttvar >> 2);
+	}
+
+	rto = (est->srtt >> 3) + est->rttvar;
+
+	if ( rto < min_period )
+		rto = min_period;
+	if ( rto > max_period )
+		rto = max_period;
+
+	return rto;
+}
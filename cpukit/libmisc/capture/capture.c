@@ -55,17 +55,26 @@
 #define RTEMS_CAPTURE_RECORD_EVENTS  (0)
 #endif
 
+/*
+ * The per CPU data is cache line aligned, since the record buffer head is
+ * written by each CPU for each record.
+ */
 typedef struct {
-  rtems_capture_buffer records;
-  uint32_t             count;
-  rtems_id             reader;
-  rtems_interrupt_lock lock;
-  uint32_t             flags;
+  rtems_capture_buffer records RTEMS_ALIGNED (CPU_CACHE_LINE_BYTES);
+  Atomic_Uint          flags;
 } rtems_capture_per_cpu_data;
 
+/*
+ * The controls with a task id are indexed by the object index of the id. The
+ * size must be a power of two.
+ */
+#define RTEMS_CAPTURE_CONTROL_ID_INDEX_SIZE 32
+
 typedef struct {
   uint32_t                flags;
   rtems_capture_control*  controls;
+  rtems_capture_control*  controls_by_id[RTEMS_CAPTURE_CONTROL_ID_INDEX_SIZE];
+  rtems_capture_control*  controls_by_name;
   int                     extension_index;
   rtems_capture_timestamp timestamp;
   rtems_task_priority     ceiling;
@@ -86,13 +95,12 @@ static rtems_capture_global_data capture_global = {
    ( &capture_per_cpu[ _cpu ] )
 
 #define capture_records_on_cpu( _cpu ) capture_per_cpu[ _cpu ].records
-#define capture_count_on_cpu( _cpu )   capture_per_cpu[ _cpu ].count
 #define capture_flags_on_cpu( _cpu )   capture_per_cpu[ _cpu ].flags
-#define capture_reader_on_cpu( _cpu )  capture_per_cpu[ _cpu ].reader
-#define capture_lock_on_cpu( _cpu )    capture_per_cpu[ _cpu ].lock
 
 #define capture_flags_global     capture_global.flags
 #define capture_controls         capture_global.controls
+#define capture_controls_by_id   capture_global.controls_by_id
+#define capture_controls_by_name capture_global.controls_by_name
 #define capture_extension_index  capture_global.extension_index
 #define capture_timestamp        capture_global.timestamp
 #define capture_ceiling          capture_global.ceiling
@@ -262,19 +270,103 @@ rtems_capture_by_in_to (uint32_t               events,
   return 0;
 }
 
+/*
+ * This function returns the index list head of controls with a task id.
+ */
+static inline rtems_capture_control**
+rtems_capture_control_id_index (rtems_id id)
+{
+  return &capture_controls_by_id[rtems_object_id_get_index (id) &
+                                 (RTEMS_CAPTURE_CONTROL_ID_INDEX_SIZE - 1)];
+}
+
+/*
+ * This function returns the index list head of a control. Controls with a
+ * task id are indexed by id, all other controls are on the name list.
+ */
+static inline rtems_capture_control**
+rtems_capture_control_index (const rtems_capture_control* control)
+{
+  if (control->id != 0)
+    return rtems_capture_control_id_index (control->id);
+
+  return &capture_controls_by_name;
+}
+
+static void
+rtems_capture_control_index_insert (rtems_capture_control* control)
+{
+  rtems_capture_control** head = rtems_capture_control_index (control);
+
+  control->index_next = *head;
+  *head = control;
+}
+
+static void
+rtems_capture_control_index_extract (rtems_capture_control* control)
+{
+  rtems_capture_control** prev = rtems_capture_control_index (control);
+
+  while (*prev != control)
+    prev = &(*prev)->index_next;
+
+  *prev = control->index_next;
+}
+
 /*
  * This function searches for a trigger given a name.
+ *
+ * A control with a task id only matches a name and id with the same id, so
+ * only the corresponding id index list needs to be searched if an id is
+ * given.
  */
 static inline rtems_capture_control*
 rtems_capture_find_control (rtems_name name, rtems_id id)
 {
   rtems_capture_control* control;
-  for (control = capture_controls; control != NULL; control = control->next)
-    if (rtems_capture_match_name_id (name, id, control->name, control->id))
-      break;
+
+  if (id != 0)
+  {
+    for (control = *rtems_capture_control_id_index (id);
+         control != NULL;
+         control = control->index_next)
+      if (rtems_capture_match_name_id (name, id, control->name, control->id))
+        break;
+  }
+  else
+  {
+    for (control = capture_controls; control != NULL; control = control->next)
+      if (rtems_capture_match_name_id (name, id, control->name, control->id))
+        break;
+  }
+
   return control;
 }
 
+/*
+ * This function searches for the control of a task. A control of the task id
+ * has precedence over a control of the task name.
+ */
+static rtems_capture_control*
+rtems_capture_find_task_control (rtems_name name, rtems_id id)
+{
+  rtems_capture_control* control;
+
+  for (control = *rtems_capture_control_id_index (id);
+       control != NULL;
+       control = control->index_next)
+    if (rtems_capture_match_name_id (control->name, control->id, name, id))
+      return control;
+
+  for (control = capture_controls_by_name;
+       control != NULL;
+       control = control->index_next)
+    if (rtems_capture_match_name_id (control->name, control->id, name, id))
+      return control;
+
+  return NULL;
+}
+
 /*
  * This function checks if a new control structure matches
  * the given task and sets the control if it does.
@@ -284,26 +376,16 @@ rtems_capture_initialize_control (rtems_tcb *tcb, void *arg)
 {
   if (tcb->Capture.control == NULL)
   {
-    rtems_name             name = rtems_build_name(0, 0, 0, 0);
-    rtems_id               id;
-    rtems_capture_control* control;
+    rtems_name name = rtems_build_name(0, 0, 0, 0);
+    rtems_id   id;
 
     /*
-     * We need to scan the default control list to initialise
-     * this control.
+     * We need to search the controls to initialise this control.
      */
     id = tcb->Object.id;
     if (rtems_capture_task_api (id) != OBJECTS_POSIX_API)
       rtems_object_get_classic_name (id, &name);
-    for (control = capture_controls; control != NULL; control = control->next)
-    {
-      if (rtems_capture_match_name_id (control->name, control->id,
-                                       name, id))
-      {
-        tcb->Capture.control = control;
-        break;
-      }
-    }
+    tcb->Capture.control = rtems_capture_find_task_control (name, id);
   }
 
   return false;
@@ -343,6 +425,7 @@ rtems_capture_create_control (rtems_name name, rtems_id id)
 
     control->next    = capture_controls;
     capture_controls = control;
+    rtems_capture_control_index_insert (control);
 
     _Thread_Iterate (rtems_capture_initialize_control, NULL);
 
@@ -355,17 +438,18 @@ rtems_capture_create_control (rtems_name name, rtems_id id)
 void
 rtems_capture_record_lock (rtems_capture_record_lock_context* context)
 {
-  rtems_capture_per_cpu_data* cpu;
-  cpu = capture_per_cpu_get (rtems_get_current_processor ());
-  rtems_interrupt_lock_interrupt_disable (&context->lock_context);
-  context->lock = &cpu->lock;
-  rtems_interrupt_lock_acquire_isr (&cpu->lock, &context->lock_context);
+  /*
+   * Only this CPU writes to its buffer. Masking the interrupts makes the
+   * access exclusive and ensures the thread stays on this CPU.
+   */
+  rtems_interrupt_local_disable (context->level);
+  context->cpu = rtems_get_current_processor ();
 }
 
 void
 rtems_capture_record_unlock (rtems_capture_record_lock_context* context)
 {
-  rtems_interrupt_lock_release (context->lock, &context->lock_context);
+  rtems_interrupt_local_enable (context->level);
 }
 
 void*
@@ -379,18 +463,16 @@ rtems_capture_record_open (rtems_tcb*                         tcb,
 
   size += sizeof (rtems_capture_record);
 
-  cpu = capture_per_cpu_get (rtems_get_current_processor ());
-
   rtems_capture_record_lock (context);
 
+  cpu = capture_per_cpu_get (context->cpu);
+
   ptr = rtems_capture_buffer_allocate (&cpu->records, size);
   if (ptr != NULL)
   {
     rtems_capture_record in;
     rtems_capture_time time;
 
-    ++cpu->count;
-
     if ((events & RTEMS_CAPTURE_RECORD_EVENTS) == 0)
       tcb->Capture.flags |= RTEMS_CAPTURE_TRACED;
 
@@ -409,7 +491,8 @@ rtems_capture_record_open (rtems_tcb*                         tcb,
     ptr = rtems_capture_record_append(ptr, &in, sizeof(in));
   }
   else
-    cpu->flags |= RTEMS_CAPTURE_OVERFLOW;
+    _Atomic_Fetch_or_uint (&cpu->flags, RTEMS_CAPTURE_OVERFLOW,
+                           ATOMIC_ORDER_RELAXED);
 
   return ptr;
 }
@@ -417,32 +500,31 @@ rtems_capture_record_open (rtems_tcb*                         tcb,
 void
 rtems_capture_record_close (rtems_capture_record_lock_context* context)
 {
+  rtems_capture_per_cpu_data* cpu;
+
+  cpu = capture_per_cpu_get (context->cpu);
+  rtems_capture_buffer_commit (&cpu->records);
   rtems_capture_record_unlock (context);
 }
 
 void
 rtems_capture_initialize_task( rtems_tcb* tcb )
 {
-  rtems_capture_control*       control;
   rtems_name                   name = rtems_build_name(0, 0, 0, 0);
   rtems_id                     id = rtems_capture_task_id (tcb);
   rtems_interrupt_lock_context lock_context;
 
   /*
-   * We need to scan the default control list to initialize
-   * this control if it is a new task.
+   * We need to search the controls to initialize this control if it is a new
+   * task.
    */
   if (rtems_capture_task_api (id) != OBJECTS_POSIX_API)
     rtems_object_get_classic_name (id, &name);
 
   rtems_interrupt_lock_acquire (&capture_lock_global, &lock_context);
 
-  if (tcb->Capture.control == NULL) {
-    for (control = capture_controls; control != NULL; control = control->next)
-      if (rtems_capture_match_name_id (control->name, control->id,
-                                       name, id))
-        tcb->Capture.control = control;
-  }
+  if (tcb->Capture.control == NULL)
+    tcb->Capture.control = rtems_capture_find_task_control (name, id);
 
   tcb->Capture.flags |= RTEMS_CAPTURE_INIT_TASK;
 
@@ -601,21 +683,22 @@ rtems_capture_open (uint32_t   size, rtems_capture_timestamp timestamp RTEMS_UNU
 
   count = rtems_get_processor_count();
   if (capture_per_cpu == NULL) {
-    capture_per_cpu = calloc( count, sizeof( *capture_per_cpu ) );
+    capture_per_cpu = rtems_cache_aligned_malloc( count * sizeof( *capture_per_cpu ) );
+    if (capture_per_cpu == NULL) {
+      return RTEMS_NO_MEMORY;
+    }
+
+    memset( capture_per_cpu, 0, count * sizeof( *capture_per_cpu ) );
   }
 
   for (i=0; i<count; i++) {
     buff = &capture_records_on_cpu(i);
     rtems_capture_buffer_create( buff, size );
+    _Atomic_Init_uint( &capture_flags_on_cpu( i ), 0 );
     if (buff->buffer == NULL) {
       sc = RTEMS_NO_MEMORY;
       break;
     }
-
-    rtems_interrupt_lock_initialize(
-      &capture_lock_on_cpu( i ),
-      "Capture Per-CPU"
-    );
   }
 
   capture_flags_global   = 0;
@@ -686,11 +769,12 @@ rtems_capture_close (void)
   }
 
   capture_controls = NULL;
+  memset (capture_controls_by_id, 0, sizeof (capture_controls_by_id));
+  capture_controls_by_name = NULL;
+
   for (cpu=0; cpu < rtems_get_processor_count(); cpu++) {
     if (capture_records_on_cpu(cpu).buffer)
       rtems_capture_buffer_destroy( &capture_records_on_cpu(cpu) );
-
-    rtems_interrupt_lock_destroy( &capture_lock_on_cpu( cpu ) );
   }
 
   free( capture_per_cpu );
@@ -750,6 +834,30 @@ rtems_capture_set_monitor (bool enable)
   return RTEMS_SUCCESSFUL;
 }
 
+/*
+ * Only one reader per CPU is allowed since the per CPU buffers are single
+ * consumer rings.
+ */
+static bool
+rtems_capture_reader_obtain (uint32_t cpu)
+{
+  unsigned int flags;
+
+  flags = _Atomic_Fetch_or_uint (&capture_flags_on_cpu (cpu),
+                                 RTEMS_CAPTURE_READER_ACTIVE,
+                                 ATOMIC_ORDER_ACQUIRE);
+
+  return (flags & RTEMS_CAPTURE_READER_ACTIVE) == 0;
+}
+
+static void
+rtems_capture_reader_release (uint32_t cpu)
+{
+  _Atomic_Fetch_and_uint (&capture_flags_on_cpu (cpu),
+                          ~RTEMS_CAPTURE_READER_ACTIVE,
+                          ATOMIC_ORDER_RELEASE);
+}
+
 /*
  * This function clears the capture trace flag in the tcb.
  */
@@ -788,15 +896,16 @@ rtems_capture_flush (bool prime)
     else
       capture_flags_global &= ~RTEMS_CAPTURE_OVERFLOW;
 
+    /*
+     * Records may still be committed on other CPUs, so only the consumer side
+     * of the buffers is used to discard the records.
+     */
     for (cpu=0; cpu < rtems_get_processor_count(); cpu++) {
-      RTEMS_INTERRUPT_LOCK_REFERENCE( lock, &(capture_lock_on_cpu( cpu )) )
-      rtems_interrupt_lock_context lock_context_per_cpu;
-
-      rtems_interrupt_lock_acquire (lock, &lock_context_per_cpu);
-      capture_count_on_cpu(cpu) = 0;
-      if (capture_records_on_cpu(cpu).buffer)
-        rtems_capture_buffer_flush( &capture_records_on_cpu(cpu) );
-      rtems_interrupt_lock_release (lock, &lock_context_per_cpu);
+      if (rtems_capture_reader_obtain (cpu)) {
+        if (capture_records_on_cpu(cpu).buffer)
+          rtems_capture_buffer_discard( &capture_records_on_cpu(cpu) );
+        rtems_capture_reader_release (cpu);
+      }
     }
 
     rtems_interrupt_lock_release (&capture_lock_global, &lock_context_global);
@@ -867,6 +976,7 @@ rtems_capture_watch_del (rtems_name name, rtems_id id)
       rtems_interrupt_lock_acquire (&capture_lock_global, &lock_context);
 
       *prev_control = control->next;
+      rtems_capture_control_index_extract (control);
 
       rtems_interrupt_lock_release (&capture_lock_global, &lock_context);
 
@@ -1236,50 +1346,55 @@ rtems_capture_read (uint32_t cpu, size_t* read, const void** recs)
   rtems_status_code sc = RTEMS_NOT_CONFIGURED;
   if (capture_per_cpu != NULL)
   {
-    RTEMS_INTERRUPT_LOCK_REFERENCE (lock, &(capture_lock_on_cpu (cpu)))
-    rtems_interrupt_lock_context lock_context;
-    size_t                       recs_size = 0;
-    rtems_capture_buffer*        records;
-    uint32_t*                    flags;
+    size_t                recs_size = 0;
+    rtems_capture_buffer* records;
 
     *read = 0;
     *recs = NULL;
 
     records = &(capture_records_on_cpu (cpu));
-    flags = &(capture_flags_on_cpu (cpu));
 
-    rtems_interrupt_lock_acquire (lock, &lock_context);
+    if ( (capture_flags_global & RTEMS_CAPTURE_ON) != 0 )
+      return RTEMS_UNSATISFIED;
 
     /*
      * Only one reader is allowed.
      */
 
-    if (*flags & RTEMS_CAPTURE_READER_ACTIVE)
-    {
-      rtems_interrupt_lock_release (lock, &lock_context);
+    if (!rtems_capture_reader_obtain (cpu))
       return RTEMS_RESOURCE_IN_USE;
-    }
-
-    if ( (capture_flags_global & RTEMS_CAPTURE_ON) != 0 )
-    {
-      rtems_interrupt_lock_release (lock, &lock_context);
-      return RTEMS_UNSATISFIED;
-    }
-
-    *flags |= RTEMS_CAPTURE_READER_ACTIVE;
 
     *recs = rtems_capture_buffer_peek( records, &recs_size );
 
     *read = rtems_capture_count_records( *recs, recs_size );
 
-    rtems_interrupt_lock_release (lock, &lock_context);
-
     sc = RTEMS_SUCCESSFUL;
   }
 
   return sc;
 }
 
+/*
+ * This function returns the size of the specified count of records. The
+ * count is limited by the available records.
+ */
+static size_t
+rtems_capture_records_size (const uint8_t* ptr, size_t ptr_size, uint32_t* count)
+{
+  size_t   rel_size = 0;
+  uint32_t counted = 0;
+
+  while (counted < *count && rel_size < ptr_size) {
+    const rtems_capture_record* rec = (const rtems_capture_record*) ptr;
+    rel_size += rec->size;
+    ptr += rec->size;
+    ++counted;
+  }
+
+  *count = counted;
+  return rel_size;
+}
+
 /*
  * This function releases the requested number of record slots back
  * to the capture engine. The count must match the number read.
@@ -1290,62 +1405,94 @@ rtems_capture_release (uint32_t cpu, uint32_t count)
   rtems_status_code sc = RTEMS_NOT_CONFIGURED;
   if (capture_per_cpu != NULL)
   {
-    rtems_interrupt_lock_context lock_context;
-    uint8_t*                     ptr;
-    rtems_capture_record*        rec;
-    uint32_t                     counted;
-    size_t                       ptr_size = 0;
-    size_t                       rel_size = 0;
-    RTEMS_INTERRUPT_LOCK_REFERENCE( lock, &(capture_lock_on_cpu( cpu )) )
-    rtems_capture_buffer*        records = &(capture_records_on_cpu( cpu ));
-    uint32_t*                    flags = &(capture_flags_on_cpu( cpu ));
-    uint32_t*                    total = &(capture_count_on_cpu( cpu ));
+    uint8_t*              ptr;
+    size_t                ptr_size = 0;
+    size_t                rel_size = 0;
+    uint32_t              counted;
+    rtems_capture_buffer* records = &(capture_records_on_cpu( cpu ));
 
     sc = RTEMS_SUCCESSFUL;
 
-    rtems_interrupt_lock_acquire (lock, &lock_context);
-
-    if (count > *total) {
-      count = *total;
-    }
-
-    if ( (capture_flags_global & RTEMS_CAPTURE_ON) != 0 ) {
-      rtems_interrupt_lock_release (lock, &lock_context);
+    if ( (capture_flags_global & RTEMS_CAPTURE_ON) != 0 )
       return RTEMS_UNSATISFIED;
-    }
-
-    counted = count;
 
     ptr = rtems_capture_buffer_peek( records, &ptr_size );
-    _Assert(ptr_size >= (count * sizeof(*rec) ));
 
-    rel_size = 0;
-    while (counted--) {
-      rec = (rtems_capture_record*) ptr;
-      rel_size += rec->size;
-      _Assert( rel_size <= ptr_size );
-      ptr += rec->size;
-    }
+    counted = count;
+    rel_size = rtems_capture_records_size( ptr, ptr_size, &counted );
+    _Assert( rel_size <= ptr_size );
 
     if (rel_size > ptr_size ) {
       sc = RTEMS_INVALID_NUMBER;
       rel_size = ptr_size;
     }
 
-    *total -= count;
-
-    if (count) {
+    if (rel_size > 0) {
       rtems_capture_buffer_free( records, rel_size );
     }
 
-    *flags &= ~RTEMS_CAPTURE_READER_ACTIVE;
-
-    rtems_interrupt_lock_release (lock, &lock_context);
+    rtems_capture_reader_release (cpu);
   }
 
   return sc;
 }
 
+rtems_status_code
+rtems_capture_drain (uint32_t                     cpu,
+                     uint32_t                     max,
+                     rtems_capture_record_visitor visitor,
+                     void*                        arg,
+                     uint32_t*                    drained)
+{
+  rtems_capture_buffer* records;
+  uint32_t              total = 0;
+
+  *drained = 0;
+
+  if (capture_per_cpu == NULL)
+    return RTEMS_NOT_CONFIGURED;
+
+  if (cpu >= rtems_get_processor_count ())
+    return RTEMS_INVALID_NUMBER;
+
+  if (!rtems_capture_reader_obtain (cpu))
+    return RTEMS_RESOURCE_IN_USE;
+
+  records = &(capture_records_on_cpu (cpu));
+
+  /*
+   * Each iteration visits one block of continous records and releases the
+   * whole block at once. A wrapped buffer has two blocks.
+   */
+  while (total < max)
+  {
+    const uint8_t* ptr;
+    size_t         ptr_size;
+    size_t         rel_size = 0;
+
+    ptr = rtems_capture_buffer_peek (records, &ptr_size);
+    if (ptr == NULL)
+      break;
+
+    while (total < max && rel_size < ptr_size)
+    {
+      const rtems_capture_record* rec;
+
+      rec = (const rtems_capture_record*) (ptr + rel_size);
+      (*visitor) (cpu, rec, arg);
+      rel_size += rec->size;
+      ++total;
+    }
+
+    rtems_capture_buffer_free (records, rel_size);
+  }
+
+  rtems_capture_reader_release (cpu);
+
+  *drained = total;
+  return RTEMS_SUCCESSFUL;
+}
+
 /*
  * This function returns a string for an event based on the bit in the
  * event. The functions takes the bit offset as a number not the bit
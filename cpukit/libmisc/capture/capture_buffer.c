@@ -27,69 +27,86 @@
 #include "capture_buffer.h"
 
 void*
-rtems_capture_buffer_allocate (rtems_capture_buffer* buffer, size_t size)
+rtems_capture_buffer_peek (rtems_capture_buffer* buffer, size_t* size)
 {
-  void* ptr = NULL;
+  uintptr_t head;
+  uintptr_t tail;
+
+  head = _Atomic_Load_uintptr (&buffer->head, ATOMIC_ORDER_ACQUIRE);
+  tail = _Atomic_Load_uintptr (&buffer->tail, ATOMIC_ORDER_RELAXED);
 
-  if ((buffer->count + size) <= buffer->end)
+  if (head == tail)
   {
-    size_t end;
+    *size = 0;
+    return NULL;
+  }
 
+  if (head < tail)
+  {
     /*
-     * Determine if the end of free space is marked with the end of buffer
-     * space, or the head of allocated space.
-     *
-     * |...|head| freespace |tail| ...| end
-     *
-     * tail|.....|head| freespace| end
+     * The head wrapped. The end is stable until the tail wrapped as well.
      */
-    if (buffer->tail > buffer->head)
+    if (tail == buffer->end)
     {
-      end = buffer->tail;
-    } else
-    {
-      end = buffer->end;
+      tail = 0;
+      _Atomic_Store_uintptr (&buffer->tail, tail, ATOMIC_ORDER_RELEASE);
     }
-
-    /*
-     * Can we allocate it easily?
-     */
-    if ((buffer->head + size) <= end)
+    else
     {
-      ptr = &buffer->buffer[buffer->head];
-      buffer->head += size;
-      buffer->count = buffer->count + size;
-      if (buffer->max_rec < size)
-        buffer->max_rec = size;
+      *size = buffer->end - tail;
+      return &buffer->buffer[tail];
     }
-    else
+  }
+
+  *size = head - tail;
+  return &buffer->buffer[tail];
+}
+
+void*
+rtems_capture_buffer_allocate (rtems_capture_buffer* buffer, size_t size)
+{
+  void*  ptr = NULL;
+  size_t head;
+  size_t tail;
+
+  head = buffer->next;
+  tail = _Atomic_Load_uintptr (&buffer->tail, ATOMIC_ORDER_ACQUIRE);
+
+  /*
+   * Keep at least one byte free, otherwise a full buffer cannot be
+   * distinguished from an empty buffer.
+   *
+   * |...|head| freespace |tail| ...| end
+   *
+   * tail|.....|head| freespace| end
+   */
+  if (head < tail)
+  {
+    if ((head + size) < tail)
     {
-      /*
-       * We have to consider wrapping around to the front of the buffer
-       *
-       * If there is no room at the end of the buffer and we have we already
-       * wrapped then we can't allocate and if there is room at the front of
-       * the buffer.
-       */
-      if ((end != buffer->tail) && (buffer->tail >= size))
-      {
-        /*
-         * Change the end pointer to the last used byte, so a read will wrap
-         * when out of data
-         */
-        buffer->end = buffer->head;
-
-        /*
-         * Now return the buffer
-         */
-        ptr = buffer->buffer;
-        buffer->head = size;
-        buffer->count = buffer->count + size;
-        if (buffer->max_rec < size)
-          buffer->max_rec = size;
-      }
+      ptr = &buffer->buffer[head];
+      buffer->next = head + size;
     }
   }
+  else if ((head + size) <= buffer->size)
+  {
+    ptr = &buffer->buffer[head];
+    buffer->next = head + size;
+  }
+  else if (size < tail)
+  {
+    /*
+     * Wrap around to the front of the buffer. Change the end to the last used
+     * byte, so a read will wrap when out of data. The commit publishes the
+     * end together with the head.
+     */
+    ptr = buffer->buffer;
+    buffer->end = head;
+    buffer->next = size;
+  }
+
+  if (ptr != NULL && buffer->max_rec < size)
+    buffer->max_rec = size;
 
   return ptr;
 }
@@ -105,25 +122,15 @@ rtems_capture_buffer_free (rtems_capture_buffer* buffer, size_t size)
     return NULL;
 
   ptr = rtems_capture_buffer_peek (buffer, &buff_size);
-  next = buffer->tail + size;
 
   /*
-   * Check if we are freeing space past the end of the buffer
+   * Check if we are freeing space past the end of the contiguous records
    */
-  _Assert (! rtems_capture_buffer_is_empty( buffer));
-  _Assert (!((buffer->tail > buffer->head) && (next > buffer->end)));
-  _Assert (!((buffer->tail < buffer->head) && (next > buffer->head)));
+  _Assert (ptr != NULL);
+  _Assert (size <= buff_size);
 
-  buffer->count = buffer->count - size;
-
-  if (next == buffer->end)
-  {
-    buffer->end = buffer->size;
-    buffer->tail = 0;
-  } else
-  {
-    buffer->tail = next;
-  }
+  next = (size_t) ((uint8_t*) ptr - buffer->buffer) + size;
+  _Atomic_Store_uintptr (&buffer->tail, next, ATOMIC_ORDER_RELEASE);
 
   return ptr;
 }
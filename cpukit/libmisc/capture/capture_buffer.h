@@ -28,6 +28,8 @@
 
 #include <stdlib.h>
 
+#include <rtems/score/atomic.h>
+
 /**@{*/
 #ifdef __cplusplus
 extern "C" {
@@ -35,23 +37,38 @@ extern "C" {
 
 /**
  * Capture buffer. There is one per CPU.
+ *
+ * The buffer is a single producer and single consumer ring of variable length
+ * records. The producer is the CPU owning the buffer with interrupts
+ * disabled. It allocates a record, fills it and then commits it. The consumer
+ * is the capture reader which may run on any CPU. No locks are used. The head
+ * is only written by the producer and the tail is only written by the
+ * consumer.
+ *
+ * Head == Tail for empty. In case the head is less than the tail, then the
+ * head has wrapped and the records between the tail and the end are followed
+ * by the records between the buffer start and the head.
  */
 typedef struct rtems_capture_buffer {
-  uint8_t* buffer;       /**< The per cpu buffer. */
-  size_t   size;         /**< The size of the buffer in bytes. */
-  size_t   count;        /**< The number of used bytes in the buffer. */
-  size_t   head;         /**< First record. */
-  size_t   tail;         /**< Head == Tail for empty. */
-  size_t   end;          /**< Buffer current end, it may move in. */
-  size_t   max_rec;      /**< The largest record in the buffer. */
+  uint8_t*       buffer;   /**< The per cpu buffer. */
+  size_t         size;     /**< The size of the buffer in bytes. */
+  Atomic_Uintptr head;     /**< End of the committed records. */
+  size_t         next;     /**< Head after the commit of allocated records. */
+  size_t         end;      /**< Buffer current end, valid if head wrapped. */
+  size_t         max_rec;  /**< The largest record in the buffer. */
+  Atomic_Uintptr tail;     /**< First record. */
 } rtems_capture_buffer;
 
+/*
+ * Reset the buffer. There must be no producer or consumer.
+ */
 static inline void
 rtems_capture_buffer_flush (rtems_capture_buffer* buffer)
 {
+  _Atomic_Store_uintptr (&buffer->head, 0, ATOMIC_ORDER_RELAXED);
+  _Atomic_Store_uintptr (&buffer->tail, 0, ATOMIC_ORDER_RELAXED);
+  buffer->next = 0;
   buffer->end = buffer->size;
-  buffer->head = buffer->tail =  0;
-  buffer->count = 0;
   buffer->max_rec = 0;
 }
 
@@ -74,40 +91,31 @@ rtems_capture_buffer_destroy (rtems_capture_buffer*  buffer)
 static inline bool
 rtems_capture_buffer_is_empty (rtems_capture_buffer* buffer)
 {
-   return buffer->count == 0;
+  return _Atomic_Load_uintptr (&buffer->head, ATOMIC_ORDER_ACQUIRE) ==
+    _Atomic_Load_uintptr (&buffer->tail, ATOMIC_ORDER_RELAXED);
 }
 
-static inline bool
-rtems_capture_buffer_is_full (rtems_capture_buffer* buffer)
+/*
+ * Makes the allocated records visible to the consumer. Called by the
+ * producer.
+ */
+static inline void
+rtems_capture_buffer_commit (rtems_capture_buffer* buffer)
 {
-   return buffer->count == buffer->size;
+  _Atomic_Store_uintptr (&buffer->head, buffer->next, ATOMIC_ORDER_RELEASE);
 }
 
-static inline bool
-rtems_capture_buffer_has_wrapped (rtems_capture_buffer* buffer)
+/*
+ * Discards all committed records. Called by the consumer.
+ */
+static inline void
+rtems_capture_buffer_discard (rtems_capture_buffer* buffer)
 {
-  if (buffer->tail > buffer->head)
-    return true;
-
-  return false;
+  uintptr_t head = _Atomic_Load_uintptr (&buffer->head, ATOMIC_ORDER_ACQUIRE);
+  _Atomic_Store_uintptr (&buffer->tail, head, ATOMIC_ORDER_RELEASE);
 }
 
-static inline void*
-rtems_capture_buffer_peek (rtems_capture_buffer* buffer, size_t* size)
-{
-  if (rtems_capture_buffer_is_empty (buffer))
-  {
-    *size = 0;
-    return NULL;
-  }
-
-  if (buffer->tail > buffer->head)
-    *size = buffer->end - buffer->tail;
-  else
-    *size = buffer->head - buffer->tail;
-
-  return &buffer->buffer[buffer->tail];
-}
+void* rtems_capture_buffer_peek (rtems_capture_buffer* buffer, size_t* size);
 
 void* rtems_capture_buffer_allocate (rtems_capture_buffer* buffer, size_t size);
 
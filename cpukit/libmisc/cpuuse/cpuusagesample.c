@@ -0,0 +1,454 @@
+/**
+ * @file
+ *
+ * @brief CPU Usage Sample
+ * @ingroup libmisc_cpuuse CPU Usage
+ */
+
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rtems/cpuuse.h>
+#include <rtems/rtems/tasksimpl.h>
+#include <rtems/score/threadimpl.h>
+#include <rtems/score/todimpl.h>
+
+#include "cpuuseimpl.h"
+
+/*
+ * An entry with an identifier of zero is unused since no thread has this
+ * identifier.
+ */
+struct rtems_cpu_usage_sampler_entry {
+  rtems_id id;
+  uint64_t total_time;
+};
+
+#define CPU_USAGE_SAMPLER_INITIAL_CAPACITY 64
+
+typedef struct {
+  rtems_cpu_usage_sampler       *sampler;
+  rtems_cpu_usage_sort_order     order;
+  rtems_cpu_usage_thread_sample *threads;
+  size_t                         thread_capacity;
+  size_t                         thread_count;
+  rtems_cpu_usage_summary       *summary;
+  bool                           restart;
+  bool                           overflow;
+} CPU_usage_Sample_context;
+
+static size_t CPU_usage_Hash( rtems_id id, size_t capacity )
+{
+  return ( id ^ ( id >> 16 ) ) & ( capacity - 1 );
+}
+
+static rtems_cpu_usage_sampler_entry *CPU_usage_Find(
+  rtems_cpu_usage_sampler_entry *table,
+  size_t                         capacity,
+  rtems_id                       id
+)
+{
+  size_t i;
+
+  if ( capacity == 0 ) {
+    return NULL;
+  }
+
+  i = CPU_usage_Hash( id, capacity );
+
+  /* The load factor is at most one half, so there is always an unused entry */
+  while ( table[ i ].id != 0 ) {
+    if ( table[ i ].id == id ) {
+      return &table[ i ];
+    }
+
+    i = ( i + 1 ) & ( capacity - 1 );
+  }
+
+  return NULL;
+}
+
+static void CPU_usage_Insert(
+  rtems_cpu_usage_sampler_entry *table,
+  size_t                         capacity,
+  rtems_id                       id,
+  uint64_t                       total_time
+)
+{
+  size_t i;
+
+  i = CPU_usage_Hash( id, capacity );
+
+  while ( table[ i ].id != 0 ) {
+    i = ( i + 1 ) & ( capacity - 1 );
+  }
+
+  table[ i ].id = id;
+  table[ i ].total_time = total_time;
+}
+
+/*
+ * Returns true, if the first thread is listed before the second thread in
+ * the specified sort order.
+ */
+static bool CPU_usage_Is_before(
+  const rtems_cpu_usage_thread_sample *a,
+  const rtems_cpu_usage_thread_sample *b,
+  rtems_cpu_usage_sort_order           order
+)
+{
+  switch ( order ) {
+    case RTEMS_CPU_USAGE_SORT_REAL_PRIORITY:
+      if ( a->real_priority != b->real_priority ) {
+        return a->real_priority < b->real_priority;
+      }
+      break;
+    case RTEMS_CPU_USAGE_SORT_CURRENT_PRIORITY:
+      if ( a->current_priority != b->current_priority ) {
+        return a->current_priority < b->current_priority;
+      }
+      break;
+    case RTEMS_CPU_USAGE_SORT_TOTAL:
+      if ( a->total_time != b->total_time ) {
+        return a->total_time > b->total_time;
+      }
+      break;
+    case RTEMS_CPU_USAGE_SORT_CURRENT:
+      if ( a->current_time != b->current_time ) {
+        return a->current_time > b->current_time;
+      }
+      break;
+    default:
+      break;
+  }
+
+  return a->id < b->id;
+}
+
+static void CPU_usage_Swap(
+  rtems_cpu_usage_thread_sample *threads,
+  size_t                         i,
+  size_t                         j
+)
+{
+  rtems_cpu_usage_thread_sample tmp;
+
+  tmp = threads[ i ];
+  threads[ i ] = threads[ j ];
+  threads[ j ] = tmp;
+}
+
+/*
+ * The selected threads form a heap with the last thread in sort order at the
+ * root.
+ */
+static void CPU_usage_Sift_up(
+  rtems_cpu_usage_thread_sample *threads,
+  size_t                         i,
+  rtems_cpu_usage_sort_order     order
+)
+{
+  while ( i > 0 ) {
+    size_t parent = ( i - 1 ) / 2;
+
+    if ( !CPU_usage_Is_before( &threads[ parent ], &threads[ i ], order ) ) {
+      break;
+    }
+
+    CPU_usage_Swap( threads, parent, i );
+    i = parent;
+  }
+}
+
+static void CPU_usage_Sift_down(
+  rtems_cpu_usage_thread_sample *threads,
+  size_t                         count,
+  size_t                         i,
+  rtems_cpu_usage_sort_order     order
+)
+{
+  while ( true ) {
+    size_t left = 2 * i + 1;
+    size_t right = left + 1;
+    size_t last = i;
+
+    if (
+      left < count
+        && CPU_usage_Is_before( &threads[ last ], &threads[ left ], order )
+    ) {
+      last = left;
+    }
+
+    if (
+      right < count
+        && CPU_usage_Is_before( &threads[ last ], &threads[ right ], order )
+    ) {
+      last = right;
+    }
+
+    if ( last == i ) {
+      break;
+    }
+
+    CPU_usage_Swap( threads, last, i );
+    i = last;
+  }
+}
+
+static void CPU_usage_Get_name(
+  const Thread_Control          *the_thread,
+  rtems_cpu_usage_thread_sample *sample
+)
+{
+  _Thread_Get_name( the_thread, sample->name, sizeof( sample->name ) );
+
+  if ( sample->name[ 0 ] == '\0' ) {
+    snprintf(
+      sample->name,
+      sizeof( sample->name ),
+      "(%p)",
+      the_thread->Start.Entry.Kinds.Numeric.entry
+    );
+  }
+}
+
+static void CPU_usage_Select(
+  CPU_usage_Sample_context      *ctx,
+  const Thread_Control          *the_thread,
+  rtems_cpu_usage_thread_sample *sample
+)
+{
+  rtems_cpu_usage_thread_sample *threads;
+  size_t                         count;
+
+  threads = ctx->threads;
+  count = ctx->thread_count;
+
+  if ( count < ctx->thread_capacity ) {
+    threads[ count ] = *sample;
+    CPU_usage_Get_name( the_thread, &threads[ count ] );
+    CPU_usage_Sift_up( threads, count, ctx->order );
+    ctx->thread_count = count + 1;
+  } else if (
+    count > 0 && CPU_usage_Is_before( sample, &threads[ 0 ], ctx->order )
+  ) {
+    threads[ 0 ] = *sample;
+    CPU_usage_Get_name( the_thread, &threads[ 0 ] );
+    CPU_usage_Sift_down( threads, count, 0, ctx->order );
+  }
+}
+
+static bool CPU_usage_Sample_visitor( Thread_Control *the_thread, void *arg )
+{
+  CPU_usage_Sample_context      *ctx;
+  rtems_cpu_usage_sampler       *sampler;
+  rtems_cpu_usage_summary       *summary;
+  const Scheduler_Control       *scheduler;
+  rtems_cpu_usage_thread_sample  sample;
+  Timestamp_Control              used;
+
+  ctx = arg;
+  sampler = ctx->sampler;
+  summary = ctx->summary;
+
+  ++summary->thread_count;
+
+  if ( 2 * summary->thread_count > sampler->capacity ) {
+    ctx->overflow = true;
+  }
+
+  if ( ctx->overflow ) {
+    return false;
+  }
+
+  summary->stack_size += the_thread->Start.Initial_stack.size;
+
+  _Thread_Get_CPU_time_used( the_thread, &used );
+
+  sample.id = the_thread->Object.id;
+  sample.total_time = _Timestamp_Get_as_nanoseconds( &used );
+  sample.current_time = 0;
+
+  if ( ctx->restart ) {
+    sample.current_time = sample.total_time;
+  } else if ( sampler->has_last_sample ) {
+    const rtems_cpu_usage_sampler_entry *last;
+
+    last = CPU_usage_Find(
+      sampler->last_table,
+      sampler->last_capacity,
+      sample.id
+    );
+
+    /*
+     * A new thread or a CPU usage reset attributes the total CPU time to the
+     * sample period.
+     */
+    if ( last != NULL && last->total_time <= sample.total_time ) {
+      sample.current_time = sample.total_time - last->total_time;
+    } else {
+      sample.current_time = sample.total_time;
+    }
+  }
+
+  CPU_usage_Insert(
+    sampler->table,
+    sampler->capacity,
+    sample.id,
+    sample.total_time
+  );
+
+  summary->total_time += sample.total_time;
+  summary->current_time += sample.current_time;
+
+  if ( the_thread->is_idle ) {
+    summary->idle_time += sample.total_time;
+    summary->current_idle_time += sample.current_time;
+  }
+
+  scheduler = _Thread_Scheduler_get_home( the_thread );
+  sample.real_priority = _RTEMS_Priority_From_core(
+    scheduler,
+    the_thread->Real_priority.priority
+  );
+  sample.current_priority = _RTEMS_Priority_From_core(
+    scheduler,
+    _Thread_Get_priority( the_thread )
+  );
+
+  CPU_usage_Select( ctx, the_thread, &sample );
+
+  return false;
+}
+
+void rtems_cpu_usage_sampler_initialize( rtems_cpu_usage_sampler *sampler )
+{
+  memset( sampler, 0, sizeof( *sampler ) );
+}
+
+void rtems_cpu_usage_sampler_destroy( rtems_cpu_usage_sampler *sampler )
+{
+  free( sampler->table );
+  free( sampler->last_table );
+  rtems_cpu_usage_sampler_initialize( sampler );
+}
+
+rtems_status_code rtems_cpu_usage_sample(
+  rtems_cpu_usage_sampler       *sampler,
+  rtems_cpu_usage_sort_order     order,
+  rtems_cpu_usage_thread_sample *threads,
+  size_t                        *thread_count,
+  rtems_cpu_usage_summary       *summary
+)
+{
+  CPU_usage_Sample_context  ctx;
+  Timestamp_Control         uptime_at_last_reset;
+  Timestamp_Control         uptime;
+  uint64_t                  last_reset;
+  uint64_t                  period_begin;
+  size_t                    capacity;
+  size_t                    i;
+
+  uptime_at_last_reset = CPU_usage_Uptime_at_last_reset;
+  _TOD_Get_uptime( &uptime );
+  _Timestamp_Subtract( &uptime_at_last_reset, &uptime, &uptime );
+  last_reset = _Timestamp_Get_as_nanoseconds( &uptime_at_last_reset );
+
+  ctx.sampler = sampler;
+  ctx.order = order;
+  ctx.threads = threads;
+  ctx.thread_capacity = *thread_count;
+  ctx.summary = summary;
+
+  /*
+   * A CPU usage reset since the previous sample lowers the uptime and the CPU
+   * time of the threads.  Restart the sample period at the reset in this case.
+   */
+  ctx.restart = sampler->has_last_sample
+    && (
+      last_reset != sampler->last_reset
+        || _Timestamp_Get_as_nanoseconds( &uptime ) < sampler->last_uptime
+    );
+
+  if ( ctx.restart ) {
+    period_begin = 0;
+  } else {
+    period_begin = sampler->last_uptime;
+  }
+
+  capacity = sampler->capacity;
+
+  if ( capacity == 0 ) {
+    capacity = CPU_USAGE_SAMPLER_INITIAL_CAPACITY;
+  }
+
+  do {
+    if ( capacity != sampler->capacity ) {
+      free( sampler->table );
+      sampler->table = malloc( capacity * sizeof( *sampler->table ) );
+
+      if ( sampler->table == NULL ) {
+        sampler->capacity = 0;
+        *thread_count = 0;
+        return RTEMS_NO_MEMORY;
+      }
+
+      sampler->capacity = capacity;
+    }
+
+    memset( sampler->table, 0, capacity * sizeof( *sampler->table ) );
+    memset( summary, 0, sizeof( *summary ) );
+    ctx.thread_count = 0;
+    ctx.overflow = false;
+
+    _Thread_Iterate( CPU_usage_Sample_visitor, &ctx );
+
+    /* Retry with a load factor of at most one quarter */
+    while ( 4 * summary->thread_count > capacity ) {
+      capacity *= 2;
+    }
+  } while ( ctx.overflow );
+
+  /* Sort the selected threads, the last thread in sort order is the root */
+  i = ctx.thread_count;
+  while ( i > 1 ) {
+    --i;
+    CPU_usage_Swap( threads, 0, i );
+    CPU_usage_Sift_down( threads, i, 0, order );
+  }
+
+  *thread_count = ctx.thread_count;
+
+  summary->uptime = _Timestamp_Get_as_nanoseconds( &uptime );
+  summary->period = summary->uptime - period_begin;
+
+  sampler->last_uptime = summary->uptime;
+  sampler->last_reset = last_reset;
+  sampler->has_last_sample = true;
+
+  /* The current table is the last table of the next sample */
+  {
+    rtems_cpu_usage_sampler_entry *table = sampler->table;
+
+    sampler->table = sampler->last_table;
+    sampler->last_table = table;
+    capacity = sampler->capacity;
+    sampler->capacity = sampler->last_capacity;
+    sampler->last_capacity = capacity;
+  }
+
+  return RTEMS_SUCCESSFUL;
+}
@@ -44,35 +44,22 @@
 #include "cpuuseimpl.h"
 
 /*
- * Use a struct for all data to allow more than one top and to support the
- * thread iterator.
+ * Use a struct for all data to allow more than one top.
  */
 typedef struct
 {
-  volatile bool          thread_run;
-  volatile bool          thread_active;
-  volatile bool          single_page;
-  volatile uint32_t      sort_order;
-  volatile uint32_t      poll_rate_usecs;
-  volatile uint32_t      show;
-  const rtems_printer*   printer;
-  Timestamp_Control      zero;
-  Timestamp_Control      uptime;
-  Timestamp_Control      last_uptime;
-  Timestamp_Control      period;
-  int                    task_count;        /* Number of tasks. */
-  int                    last_task_count;   /* Number of tasks in the previous sample. */
-  int                    task_size;         /* The size of the arrays */
-  Thread_Control**       tasks;             /* List of tasks in this sample. */
-  Thread_Control**       last_tasks;        /* List of tasks in the last sample. */
-  Timestamp_Control*     usage;             /* Usage of task's in this sample. */
-  Timestamp_Control*     last_usage;        /* Usage of task's in the last sample. */
-  Timestamp_Control*     current_usage;     /* Current usage for this sample. */
-  Timestamp_Control      total;             /* Total run run, should equal the uptime. */
-  Timestamp_Control      idle;              /* Time spent in idle. */
-  Timestamp_Control      current;           /* Current time run in this period. */
-  Timestamp_Control      current_idle;      /* Current time in idle this period. */
-  uint32_t               stack_size;        /* Size of stack allocated. */
+  volatile bool                  thread_run;
+  volatile bool                  thread_active;
+  volatile bool                  single_page;
+  volatile uint32_t              sort_order;
+  volatile uint32_t              poll_rate_usecs;
+  volatile uint32_t              show;
+  const rtems_printer*           printer;
+  rtems_cpu_usage_sampler        sampler;
+  rtems_cpu_usage_summary        summary;
+  rtems_cpu_usage_thread_sample* tasks;             /* Tasks to display. */
+  size_t                         task_size;         /* The size of the array. */
+  size_t                         task_count;        /* Number of tasks to display. */
 } rtems_cpu_usage_data;
 
 /*
@@ -85,26 +72,22 @@ typedef struct
 #define RTEMS_TOP_SORT_CURRENT       (4)
 #define RTEMS_TOP_SORT_MAX           (4)
 
-static inline bool equal_to_uint32_t( uint32_t * lhs, uint32_t * rhs )
-{
-   if ( *lhs == *rhs )
-     return true;
-   else
-     return false;
-}
+static const rtems_cpu_usage_sort_order sort_orders[RTEMS_TOP_SORT_MAX + 1] = {
+  [RTEMS_TOP_SORT_ID] = RTEMS_CPU_USAGE_SORT_ID,
+  [RTEMS_TOP_SORT_REAL_PRI] = RTEMS_CPU_USAGE_SORT_REAL_PRIORITY,
+  [RTEMS_TOP_SORT_CURRENT_PRI] = RTEMS_CPU_USAGE_SORT_CURRENT_PRIORITY,
+  [RTEMS_TOP_SORT_TOTAL] = RTEMS_CPU_USAGE_SORT_TOTAL,
+  [RTEMS_TOP_SORT_CURRENT] = RTEMS_CPU_USAGE_SORT_CURRENT
+};
 
-static inline bool less_than_uint32_t( uint32_t * lhs, uint32_t * rhs )
+static void
+set_time(Timestamp_Control* time, uint64_t nanoseconds)
 {
-   if ( *lhs < *rhs )
-    return true;
-   else
-    return false;
+  _Timestamp_Set(time,
+                 nanoseconds / TOD_NANOSECONDS_PER_SECOND,
+                 nanoseconds % TOD_NANOSECONDS_PER_SECOND);
 }
 
-#define CPU_usage_Equal_to( _lhs, _rhs )  _Timestamp_Equal_to( _lhs, _rhs )
-#define CPU_usage_Set_to_zero( _time )    _Timestamp_Set_to_zero( _time )
-#define CPU_usage_Less_than( _lhs, _rhs ) _Timestamp_Less_than( _lhs, _rhs )
-
 static void
 print_memsize(rtems_cpu_usage_data* data, const uintptr_t size, const char* label)
 {
@@ -151,109 +134,47 @@ print_time(rtems_cpu_usage_data*    data,
 }
 
 /*
- * Count the number of tasks.
- */
-static bool
-task_counter(Thread_Control *thrad, void* arg)
-{
-  rtems_cpu_usage_data* data = (rtems_cpu_usage_data*) arg;
-  ++data->task_count;
-
-  return false;
-}
-
-/*
- * Create the sorted table with the current and total usage.
+ * Take a sample of the tasks to display.  The sampler selects the tasks with
+ * one pass over all threads, so only the displayed tasks need storage.
  */
 static bool
-task_usage(Thread_Control* thread, void* arg)
+task_sample(rtems_cpu_usage_data* data)
 {
-  rtems_cpu_usage_data* data = (rtems_cpu_usage_data*) arg;
-  Timestamp_Control     usage;
-  Timestamp_Control     current = data->zero;
-  int                   j;
+  uint32_t          sort_order = data->sort_order;
+  size_t            task_size;
+  rtems_status_code sc;
 
-  data->stack_size += thread->Start.Initial_stack.size;
-
-  _Thread_Get_CPU_time_used(thread, &usage);
-
-  for (j = 0; j < data->last_task_count; j++)
+  if (sort_order > RTEMS_TOP_SORT_MAX)
   {
-    if (thread == data->last_tasks[j])
-    {
-      _Timestamp_Subtract(&data->last_usage[j], &usage, &current);
-      break;
-    }
+    sort_order = RTEMS_TOP_SORT_CURRENT;
+    data->sort_order = sort_order;
   }
 
-  /*
-   * When not using nanosecond CPU usage resolution, we have to count the
-   * number of "ticks" we gave credit for to give the user a rough guideline as
-   * to what each number means proportionally.
-   */
-  _Timestamp_Add_to(&data->total, &usage);
-  _Timestamp_Add_to(&data->current, &current);
+  if (data->single_page && (data->show != 0))
+    task_size = data->show;
+  else
+    task_size = data->summary.thread_count + 1;
 
-  if (thread->Object.id == 0x09010001)
+  if (task_size > data->task_size)
   {
-    data->idle = usage;
-    data->current_idle = current;
-  }
+    rtems_cpu_usage_thread_sample* tasks;
 
-  /*
-   * Create the tasks to display soring as we create.
-   */
-  for (j = 0; j < data->task_count; j++)
-  {
-    if (data->tasks[j])
-    {
-      int k;
+    tasks = realloc(data->tasks, task_size * sizeof(*tasks));
+    if (tasks == NULL)
+      return false;
 
-      /*
-       * Sort on the current load.
-       */
-      switch (data->sort_order)
-      {
-        default:
-          data->sort_order = RTEMS_TOP_SORT_CURRENT;
-          /* drop through */
-        case RTEMS_TOP_SORT_CURRENT:
-          if (CPU_usage_Equal_to(&current, &data->zero) ||
-              CPU_usage_Less_than(&current, &data->current_usage[j]))
-            continue;
-        case RTEMS_TOP_SORT_TOTAL:
-          if (CPU_usage_Equal_to(&usage, &data->zero) ||
-              CPU_usage_Less_than(&usage, &data->usage[j]))
-            continue;
-        case RTEMS_TOP_SORT_REAL_PRI:
-          if (thread->Real_priority.priority > data->tasks[j]->Real_priority.priority)
-            continue;
-        case RTEMS_TOP_SORT_CURRENT_PRI:
-          if (
-            _Thread_Get_priority( thread )
-              > _Thread_Get_priority( data->tasks[j] )
-          ) {
-            continue;
-          }
-        case RTEMS_TOP_SORT_ID:
-          if (thread->Object.id < data->tasks[j]->Object.id)
-            continue;
-      }
-
-      for (k = (data->task_count - 1); k >= j; k--)
-      {
-        data->tasks[k + 1] = data->tasks[k];
-        data->usage[k + 1]  = data->usage[k];
-        data->current_usage[k + 1]  = data->current_usage[k];
-      }
-    }
-    data->tasks[j] = thread;
-    data->usage[j] = usage;
-    data->current_usage[j] = current;
-    break;
+    data->tasks = tasks;
+    data->task_size = task_size;
   }
 
-  return false;
+  data->task_count = task_size;
+  sc = rtems_cpu_usage_sample(&data->sampler,
+                              sort_orders[sort_order],
+                              data->tasks,
+                              &data->task_count,
+                              &data->summary);
+
+  return sc == RTEMS_SUCCESSFUL;
 }
 
 /*
@@ -266,79 +187,33 @@ static void
 rtems_cpuusage_top_thread (rtems_task_argument arg)
 {
   rtems_cpu_usage_data*  data = (rtems_cpu_usage_data*) arg;
-  char                   name[13];
-  int                    i;
+  size_t                 i;
   Heap_Information_block wksp;
   uint32_t               ival, fval;
-  int                    task_count;
+  size_t                 task_count;
   rtems_event_set        out;
   rtems_status_code      sc;
   bool                   first_time = true;
 
   data->thread_active = true;
 
-  _TOD_Get_uptime(&data->last_uptime);
-
-  CPU_usage_Set_to_zero(&data->zero);
+  rtems_cpu_usage_sampler_initialize(&data->sampler);
 
   while (data->thread_run)
   {
-    Timestamp_Control uptime_at_last_reset = CPU_usage_Uptime_at_last_reset;
-    size_t            tasks_size;
-    size_t            usage_size;
+    Timestamp_Control uptime;
+    Timestamp_Control period;
+    Timestamp_Control total;
+    Timestamp_Control current;
     Timestamp_Control load;
 
-    data->task_count = 0;
-    _Thread_Iterate(task_counter, data);
-
-    tasks_size = sizeof(Thread_Control*) * (data->task_count + 1);
-    usage_size = sizeof(Timestamp_Control) * (data->task_count + 1);
-
-    if (data->task_count > data->task_size)
-    {
-      data->tasks = realloc(data->tasks, tasks_size);
-      data->usage = realloc(data->usage, usage_size);
-      data->current_usage = realloc(data->current_usage, usage_size);
-      if ((data->tasks == NULL) || (data->usage == NULL) || (data->current_usage == NULL))
-      {
-        rtems_printf(data->printer, "top worker: error: no memory\n");
-        data->thread_run = false;
-        break;
-      }
-    }
-
-    memset(data->tasks, 0, tasks_size);
-    memset(data->usage, 0, usage_size);
-    memset(data->current_usage, 0, usage_size);
-
-    _Timestamp_Set_to_zero(&data->total);
-    _Timestamp_Set_to_zero(&data->current);
-    data->stack_size = 0;
-
-    _TOD_Get_uptime(&data->uptime);
-    _Timestamp_Subtract(&uptime_at_last_reset, &data->uptime, &data->uptime);
-    _Timestamp_Subtract(&data->last_uptime, &data->uptime, &data->period);
-    data->last_uptime = data->uptime;
-
-    _Thread_Iterate(task_usage, data);
-
-    if (data->task_count > data->task_size)
+    if (!task_sample(data))
     {
-      data->last_tasks = realloc(data->last_tasks, tasks_size);
-      data->last_usage = realloc(data->last_usage, usage_size);
-      if ((data->last_tasks == NULL) || (data->last_usage == NULL))
-      {
-        rtems_printf(data->printer, "top worker: error: no memory\n");
-        data->thread_run = false;
-        break;
-      }
-      data->task_size = data->task_count;
+      rtems_printf(data->printer, "top worker: error: no memory\n");
+      data->thread_run = false;
+      break;
     }
 
-    memcpy(data->last_tasks, data->tasks, tasks_size);
-    memcpy(data->last_usage, data->usage, usage_size);
-    data->last_task_count = data->task_count;
-
     /*
      * We need to loop again to get suitable current usage values as we need a
      * last sample to work.
@@ -350,6 +225,11 @@ rtems_cpuusage_top_thread (rtems_task_argument arg)
       continue;
     }
 
+    set_time(&uptime, data->summary.uptime);
+    set_time(&period, data->summary.period);
+    set_time(&total, data->summary.total_time);
+    set_time(&current, data->summary.current_time);
+
     _Protected_heap_Get_information(&_Workspace_Area, &wksp);
 
     if (data->single_page)
@@ -363,24 +243,27 @@ rtems_cpuusage_top_thread (rtems_task_argument arg)
      * Uptime and period of this sample.
      */
     rtems_printf(data->printer, "Uptime: ");
-    print_time(data, &data->uptime, 20);
+    print_time(data, &uptime, 20);
     rtems_printf(data->printer, " Period: ");
-    print_time(data, &data->period, 20);
+    print_time(data, &period, 20);
 
     /*
      * Task count, load and idle levels.
      */
-    rtems_printf(data->printer, "\nTasks: %4i  ", data->task_count);
+    rtems_printf(data->printer, "\nTasks: %4" PRIu32 "  ",
+                 data->summary.thread_count);
 
-    _Timestamp_Subtract(&data->idle, &data->total, &load);
-    _Timestamp_Divide(&load, &data->uptime, &ival, &fval);
+    set_time(&load, data->summary.total_time - data->summary.idle_time);
+    _Timestamp_Divide(&load, &uptime, &ival, &fval);
     rtems_printf(data->printer,
                  "Load Average: %4" PRIu32 ".%03" PRIu32 "%%", ival, fval);
-    _Timestamp_Subtract(&data->current_idle, &data->current, &load);
-    _Timestamp_Divide(&load, &data->period, &ival, &fval);
+    set_time(&load,
+             data->summary.current_time - data->summary.current_idle_time);
+    _Timestamp_Divide(&load, &period, &ival, &fval);
     rtems_printf(data->printer,
                  "  Load: %4" PRIu32 ".%03" PRIu32 "%%", ival, fval);
-    _Timestamp_Divide(&data->current_idle, &data->period, &ival, &fval);
+    set_time(&load, data->summary.current_idle_time);
+    _Timestamp_Divide(&load, &period, &ival, &fval);
     rtems_printf(data->printer,
                  "  Idle: %4" PRIu32 ".%03" PRIu32 "%%", ival, fval);
 
@@ -404,7 +287,7 @@ rtems_cpuusage_top_thread (rtems_task_argument arg)
       print_memsize(data, libc_heap.Used.total, "used");
     }
 
-    print_memsize(data, data->stack_size, "stack\n");
+    print_memsize(data, data->summary.stack_size, "stack\n");
 
     rtems_printf(data->printer,
        "\n"
@@ -421,12 +304,9 @@ rtems_cpuusage_top_thread (rtems_task_argument arg)
 
     for (i = 0; i < data->task_count; i++)
     {
-      Thread_Control*   thread = data->tasks[i];
-      Timestamp_Control usage;
-      Timestamp_Control current_usage;
-
-      if (thread == NULL)
-        break;
+      const rtems_cpu_usage_thread_sample* task = &data->tasks[i];
+      Timestamp_Control                    usage;
+      Timestamp_Control                    current_usage;
 
       if (data->single_page && (data->show != 0) && (i >= data->show))
         break;
@@ -437,31 +317,24 @@ rtems_cpuusage_top_thread (rtems_task_argument arg)
        */
       ++task_count;
 
-      /*
-       * If the API os POSIX print the entry point.
-       */
-      rtems_object_get_name(thread->Object.id, sizeof(name), name);
-      if (name[0] == '\0')
-        snprintf(name, sizeof(name) - 1, "(%p)", thread->Start.Entry.Kinds.Numeric.entry);
-
       rtems_printf(data->printer,
-                   " 0x%08" PRIx32 " | %-19s |  %3" PRId64 " |  %3" PRId64 "   | ",
-                   thread->Object.id,
-                   name,
-                   thread->Real_priority.priority,
-                   _Thread_Get_priority(thread));
+                   " 0x%08" PRIx32 " | %-19s |  %3" PRIu32 " |  %3" PRIu32 "   | ",
+                   task->id,
+                   task->name,
+                   task->real_priority,
+                   task->current_priority);
 
-      usage = data->usage[i];
-      current_usage = data->current_usage[i];
+      set_time(&usage, task->total_time);
+      set_time(&current_usage, task->current_time);
 
       /*
        * Print the information
        */
       print_time(data, &usage, 19);
-      _Timestamp_Divide(&usage, &data->total, &ival, &fval);
+      _Timestamp_Divide(&usage, &total, &ival, &fval);
       rtems_printf(data->printer,
                    " |%4" PRIu32 ".%03" PRIu32, ival, fval);
-      _Timestamp_Divide(&current_usage, &data->period, &ival, &fval);
+      _Timestamp_Divide(&current_usage, &period, &ival, &fval);
       rtems_printf(data->printer,
                    " |%4" PRIu32 ".%03" PRIu32 "\n", ival, fval);
     }
@@ -489,9 +362,7 @@ rtems_cpuusage_top_thread (rtems_task_argument arg)
   }
 
   free(data->tasks);
-  free(data->last_tasks);
-  free(data->last_usage);
-  free(data->current_usage);
+  rtems_cpu_usage_sampler_destroy(&data->sampler);
 
   data->thread_active = false;
 
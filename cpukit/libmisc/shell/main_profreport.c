@@ -16,16 +16,179 @@
   #include "config.h"
 #endif
 
+#include <inttypes.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include <rtems/profiling.h>
 #include <rtems/printer.h>
 #include <rtems/shell.h>
 #include <rtems/shellconfig.h>
 
+typedef struct {
+  char name[64];
+  const void *call_site;
+  uint64_t contention_count;
+  uint64_t total_wait_time;
+  uint64_t total_hold_time;
+  uint32_t max_wait_time;
+} call_site_entry;
+
+typedef struct {
+  call_site_entry *entries;
+  size_t count;
+  size_t capacity;
+  bool out_of_memory;
+} call_site_context;
+
+static void collect_call_site(void *arg, const rtems_profiling_data *data)
+{
+  call_site_context *ctx;
+  const rtems_profiling_smp_lock_call_site *call_site;
+  call_site_entry *entry;
+  size_t i;
+
+  if (data->header.type != RTEMS_PROFILING_SMP_LOCK_CALL_SITE) {
+    return;
+  }
+
+  ctx = arg;
+  call_site = &data->smp_lock_call_site;
+  entry = NULL;
+
+  /* Merge the call sites of all processors */
+  for (i = 0; i < ctx->count; ++i) {
+    if (
+      ctx->entries[i].call_site == call_site->call_site
+        && strcmp(ctx->entries[i].name, call_site->name) == 0
+    ) {
+      entry = &ctx->entries[i];
+      break;
+    }
+  }
+
+  if (entry == NULL) {
+    if (ctx->count == ctx->capacity) {
+      size_t capacity = ctx->capacity != 0 ? 2 * ctx->capacity : 16;
+      call_site_entry *entries;
+
+      entries = realloc(ctx->entries, capacity * sizeof(*entries));
+      if (entries == NULL) {
+        ctx->out_of_memory = true;
+        return;
+      }
+
+      ctx->entries = entries;
+      ctx->capacity = capacity;
+    }
+
+    entry = &ctx->entries[ctx->count];
+    ++ctx->count;
+    memset(entry, 0, sizeof(*entry));
+    strlcpy(entry->name, call_site->name, sizeof(entry->name));
+    entry->call_site = call_site->call_site;
+  }
+
+  entry->contention_count += call_site->contention_count;
+  entry->total_wait_time += call_site->total_wait_time;
+  entry->total_hold_time += call_site->total_hold_time;
+
+  if (entry->max_wait_time < call_site->max_wait_time) {
+    entry->max_wait_time = call_site->max_wait_time;
+  }
+}
+
+static int compare_call_sites(const void *a, const void *b)
+{
+  const call_site_entry *ea = a;
+  const call_site_entry *eb = b;
+
+  if (ea->total_wait_time > eb->total_wait_time) {
+    return -1;
+  }
+
+  if (ea->total_wait_time < eb->total_wait_time) {
+    return 1;
+  }
+
+  return 0;
+}
+
+static void print_separator(void)
+{
+  printf(
+    "---------------------------------------"
+    "---------------------------------------\n"
+  );
+}
+
+static int report_call_sites(size_t max_count)
+{
+  call_site_context ctx;
+  size_t i;
+
+  memset(&ctx, 0, sizeof(ctx));
+  rtems_profiling_iterate(collect_call_site, &ctx);
+
+  if (ctx.out_of_memory) {
+    fprintf(stderr, "profreport: not enough memory\n");
+  }
+
+  qsort(ctx.entries, ctx.count, sizeof(ctx.entries[0]), compare_call_sites);
+
+  if (max_count > ctx.count) {
+    max_count = ctx.count;
+  }
+
+  print_separator();
+  printf(
+    " TOTAL WAIT [ns] | MEAN WAIT | MAX WAIT  | MEAN HOLD | COUNT    | CALL SITE\n"
+    "                 | [ns]      | [ns]      | [ns]      |          | LOCK\n"
+  );
+  print_separator();
+
+  for (i = 0; i < max_count; ++i) {
+    const call_site_entry *entry = &ctx.entries[i];
+
+    printf(
+      " %15" PRIu64 " | %9" PRIu64 " | %9" PRIu32 " | %9" PRIu64
+        " | %8" PRIu64 " | %p\n"
+      "                 |           |           |           |          | %s\n",
+      entry->total_wait_time,
+      entry->total_wait_time / entry->contention_count,
+      entry->max_wait_time,
+      entry->total_hold_time / entry->contention_count,
+      entry->contention_count,
+      entry->call_site,
+      entry->name
+    );
+  }
+
+  print_separator();
+
+  free(ctx.entries);
+  return ctx.out_of_memory ? 1 : 0;
+}
+
 static int rtems_shell_main_profreport(int argc, char **argv)
 {
   rtems_printer printer;
+
+  if (argc == 3 && strcmp(argv[1], "-c") == 0) {
+    char *end;
+    unsigned long max_count = strtoul(argv[2], &end, 0);
+
+    if (*argv[2] != '\0' && *end == '\0') {
+      return report_call_sites(max_count);
+    }
+  }
+
+  if (argc != 1) {
+    fprintf(stderr, "%s: [-c COUNT]\n", argv[0]);
+    return 1;
+  }
+
   rtems_print_printer_printf(&printer);
   rtems_profiling_report_xml(
     "Shell",
@@ -39,7 +202,10 @@ static int rtems_shell_main_profreport(int argc, char **argv)
 
 rtems_shell_cmd_t rtems_shell_PROFREPORT_Command = {
   .name = "profreport",
-  .usage = "profreport",
+  .usage = "profreport [-c COUNT]\n"
+    "  Without options, print the profiling report in XML\n"
+    "  -c COUNT  print the COUNT SMP lock call sites with the highest\n"
+    "            total wait time of all processors",
   .topic = "rtems",
   .command = rtems_shell_main_profreport
 };
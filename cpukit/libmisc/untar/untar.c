@@ -246,7 +246,7 @@ Make_Path(const rtems_printer *printer, const char* filename, bool end_is_dir)
   return 0;
 }
 
-static int
+int
 Untar_ProcessHeader(
   const char          *bufr,
   char                *fname,
@@ -0,0 +1,1033 @@
+/**
+ * @file
+ *
+ * @brief Untar an Image with a Pipeline of Tasks
+ * @ingroup libmisc_untar_img Untar Image
+ */
+
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <sys/param.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems.h>
+#include <rtems/thread.h>
+#include <rtems/untar.h>
+#include <rtems/userenv.h>
+
+#define UNTAR_PARALLEL_WRITER_STACK_SIZE (4 * RTEMS_MINIMUM_STACK_SIZE)
+
+typedef struct Untar_ParallelFile {
+  struct Untar_ParallelFile *next;
+  bool in_use;
+  size_t writer;
+  int fd;
+  unsigned long mode;
+  char fname[100];
+} Untar_ParallelFile;
+
+/*
+ * A job is a segment of the contents of a file.  All jobs of a file go to the
+ * same writer in archive order.
+ */
+typedef struct Untar_ParallelJob {
+  struct Untar_ParallelJob *next;
+  Untar_ParallelFile *file;
+  const char *data;
+  size_t size;
+  bool first;
+  bool last;
+  char *buffer;
+} Untar_ParallelJob;
+
+typedef struct {
+  Untar_ParallelContext *ctx;
+  rtems_id id;
+  Untar_ParallelJob *head;
+  Untar_ParallelJob **tail;
+  size_t pending;
+  rtems_condition_variable job_available;
+} Untar_ParallelWriter;
+
+struct Untar_ParallelContext {
+  Untar_ParallelConfig config;
+
+  /*
+   * Protects the job and file pools, the writer queues and the statistics
+   * shared with the writers.
+   */
+  rtems_mutex mutex;
+  rtems_condition_variable job_done;
+  Untar_ParallelWriter *writers;
+  size_t writer_count;
+  size_t running_writers;
+  bool stop;
+  int writer_status;
+  Untar_ParallelJob *jobs;
+  Untar_ParallelJob *free_jobs;
+  Untar_ParallelFile *files;
+  Untar_ParallelFile *free_files;
+  size_t busy_files;
+  Untar_ParallelStatistics stats;
+  uint64_t start;
+
+  /* State of the parsing stage */
+  enum {
+    UNTAR_PARALLEL_HEADER,
+    UNTAR_PARALLEL_SKIP,
+    UNTAR_PARALLEL_WRITE,
+    UNTAR_PARALLEL_ERROR
+  } state;
+  char header[512];
+  char fname[100];
+  size_t done_bytes;
+  unsigned long todo_bytes;
+  unsigned long todo_blocks;
+  Untar_ParallelFile *file;
+  bool file_started;
+  Untar_ParallelJob *job;
+
+  /* State of the decompression stage */
+  z_stream strm;
+  bool strm_initialized;
+  struct xz_dec *xz;
+  struct xz_buf xz_buf;
+  bool stream_end;
+  char *inflate_buffer;
+};
+
+static void Untar_Parallel_print_error(
+  const Untar_ParallelContext *ctx,
+  const char                  *message,
+  const char                  *path
+)
+{
+  rtems_printf(ctx->config.printer, "untar: %s: %s: (%d) %s\n",
+               message, path, errno, strerror(errno));
+}
+
+static void Untar_Parallel_snapshot(
+  Untar_ParallelContext    *ctx,
+  Untar_ParallelStatistics *stats
+)
+{
+  rtems_mutex_lock(&ctx->mutex);
+  *stats = ctx->stats;
+  rtems_mutex_unlock(&ctx->mutex);
+  stats->elapsed_ns = rtems_clock_get_uptime_nanoseconds() - ctx->start;
+}
+
+/*
+ * Creates the file for the first job, writes the data and closes the file
+ * for the last job.  Called without the mutex.
+ */
+static int Untar_Parallel_write(
+  Untar_ParallelContext *ctx,
+  Untar_ParallelJob     *job,
+  size_t                *written
+)
+{
+  Untar_ParallelFile *file = job->file;
+  int retval = UNTAR_SUCCESSFUL;
+
+  *written = 0;
+
+  if (job->first) {
+    file->fd = creat(file->fname, file->mode);
+    if (file->fd < 0) {
+      Untar_Parallel_print_error(ctx, "open", file->fname);
+    }
+  }
+
+  if (file->fd >= 0 && job->size > 0) {
+    ssize_t n = write(file->fd, job->data, job->size);
+
+    if (n != (ssize_t) job->size) {
+      Untar_Parallel_print_error(ctx, "write", file->fname);
+      close(file->fd);
+      file->fd = -1;
+      retval = UNTAR_FAIL;
+    } else {
+      *written = job->size;
+    }
+  }
+
+  if (job->last && file->fd >= 0) {
+    close(file->fd);
+    file->fd = -1;
+  }
+
+  return retval;
+}
+
+/*
+ * Returns the job and, for the last job of a file, the file to the pools.
+ * Called with the mutex.
+ */
+static void Untar_Parallel_complete(
+  Untar_ParallelContext *ctx,
+  Untar_ParallelJob     *job,
+  int                    retval,
+  size_t                 written
+)
+{
+  ctx->stats.file_bytes += written;
+
+  if (retval != UNTAR_SUCCESSFUL && ctx->writer_status == UNTAR_SUCCESSFUL) {
+    ctx->writer_status = retval;
+  }
+
+  if (job->last) {
+    Untar_ParallelFile *file = job->file;
+
+    file->in_use = false;
+    file->next = ctx->free_files;
+    ctx->free_files = file;
+    --ctx->busy_files;
+  }
+
+  job->next = ctx->free_jobs;
+  ctx->free_jobs = job;
+  rtems_condition_variable_broadcast(&ctx->job_done);
+}
+
+static void Untar_Parallel_writer_task(rtems_task_argument arg)
+{
+  Untar_ParallelWriter *writer = (Untar_ParallelWriter *) arg;
+  Untar_ParallelContext *ctx = writer->ctx;
+
+  rtems_mutex_lock(&ctx->mutex);
+
+  while (true) {
+    Untar_ParallelJob *job = writer->head;
+    size_t written;
+    int retval;
+
+    if (job == NULL) {
+      if (ctx->stop) {
+        break;
+      }
+
+      rtems_condition_variable_wait(&writer->job_available, &ctx->mutex);
+      continue;
+    }
+
+    writer->head = job->next;
+    if (writer->head == NULL) {
+      writer->tail = &writer->head;
+    }
+
+    rtems_mutex_unlock(&ctx->mutex);
+    retval = Untar_Parallel_write(ctx, job, &written);
+    rtems_mutex_lock(&ctx->mutex);
+
+    --writer->pending;
+    Untar_Parallel_complete(ctx, job, retval, written);
+  }
+
+  --ctx->running_writers;
+  rtems_condition_variable_broadcast(&ctx->job_done);
+  rtems_mutex_unlock(&ctx->mutex);
+
+  /* Wait for the deletion in Untar_ParallelContext_Finish() */
+  (void) rtems_task_suspend(RTEMS_SELF);
+}
+
+static Untar_ParallelJob *Untar_Parallel_get_job(Untar_ParallelContext *ctx)
+{
+  Untar_ParallelJob *job;
+
+  rtems_mutex_lock(&ctx->mutex);
+
+  while (ctx->free_jobs == NULL) {
+    rtems_condition_variable_wait(&ctx->job_done, &ctx->mutex);
+  }
+
+  job = ctx->free_jobs;
+  ctx->free_jobs = job->next;
+  rtems_mutex_unlock(&ctx->mutex);
+
+  job->size = 0;
+
+  return job;
+}
+
+static void Untar_Parallel_dispatch(
+  Untar_ParallelContext *ctx,
+  Untar_ParallelJob     *job,
+  bool                   last
+)
+{
+  Untar_ParallelWriter *writer;
+
+  job->file = ctx->file;
+  job->first = !ctx->file_started;
+  job->last = last;
+  ctx->file_started = true;
+
+  if (last) {
+    ctx->file = NULL;
+  }
+
+  if (ctx->writer_count == 0) {
+    size_t written;
+    int retval;
+
+    retval = Untar_Parallel_write(ctx, job, &written);
+    rtems_mutex_lock(&ctx->mutex);
+    Untar_Parallel_complete(ctx, job, retval, written);
+    rtems_mutex_unlock(&ctx->mutex);
+    return;
+  }
+
+  rtems_mutex_lock(&ctx->mutex);
+  writer = &ctx->writers[job->file->writer];
+  job->next = NULL;
+  *writer->tail = job;
+  writer->tail = &job->next;
+  ++writer->pending;
+  rtems_condition_variable_signal(&writer->job_available);
+  rtems_mutex_unlock(&ctx->mutex);
+}
+
+static const char *Untar_Parallel_skip_current(const char *path)
+{
+  while (true) {
+    if (path[0] == '/') {
+      ++path;
+    } else if (path[0] == '.' && path[1] == '/') {
+      path += 2;
+    } else {
+      return path;
+    }
+  }
+}
+
+/*
+ * Returns true, if the paths are equal or one is a parent directory of the
+ * other.
+ */
+static bool Untar_Parallel_is_prefix(const char *a, const char *b)
+{
+  size_t n = strlen(a);
+
+  while (n > 0 && a[n - 1] == '/') {
+    --n;
+  }
+
+  return strncmp(a, b, n) == 0 && (b[n] == '\0' || b[n] == '/');
+}
+
+static bool Untar_Parallel_conflicts(
+  const Untar_ParallelContext *ctx,
+  const char                  *path
+)
+{
+  size_t i;
+
+  path = Untar_Parallel_skip_current(path);
+
+  for (i = 0; i < ctx->config.buffer_count; ++i) {
+    const Untar_ParallelFile *file = &ctx->files[i];
+
+    if (file->in_use) {
+      const char *other = Untar_Parallel_skip_current(file->fname);
+
+      if (
+        Untar_Parallel_is_prefix(path, other)
+          || Untar_Parallel_is_prefix(other, path)
+      ) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+/*
+ * Waits until no file in flight has a path which conflicts with the member,
+ * so that all operations on a path are carried out in archive order.
+ */
+static void Untar_Parallel_order(Untar_ParallelContext *ctx)
+{
+  char fname[100];
+  bool waited = false;
+
+  if (strncmp(&ctx->header[257], "ustar", 5) != 0) {
+    return;
+  }
+
+  strncpy(fname, ctx->header, sizeof(fname) - 1);
+  fname[sizeof(fname) - 1] = '\0';
+
+  rtems_mutex_lock(&ctx->mutex);
+
+  while (ctx->busy_files > 0 && Untar_Parallel_conflicts(ctx, fname)) {
+    waited = true;
+    rtems_condition_variable_wait(&ctx->job_done, &ctx->mutex);
+  }
+
+  if (waited) {
+    ++ctx->stats.barriers;
+  }
+
+  rtems_mutex_unlock(&ctx->mutex);
+}
+
+static void Untar_Parallel_start_file(
+  Untar_ParallelContext *ctx,
+  unsigned long          mode
+)
+{
+  Untar_ParallelFile *file;
+  size_t i;
+
+  rtems_mutex_lock(&ctx->mutex);
+
+  while (ctx->free_files == NULL) {
+    rtems_condition_variable_wait(&ctx->job_done, &ctx->mutex);
+  }
+
+  file = ctx->free_files;
+  ctx->free_files = file->next;
+  file->in_use = true;
+  ++ctx->busy_files;
+  ++ctx->stats.files;
+
+  /* Use the writer with the least pending work */
+  file->writer = 0;
+
+  for (i = 1; i < ctx->writer_count; ++i) {
+    if (ctx->writers[i].pending < ctx->writers[file->writer].pending) {
+      file->writer = i;
+    }
+  }
+
+  rtems_mutex_unlock(&ctx->mutex);
+
+  strlcpy(file->fname, ctx->fname, sizeof(file->fname));
+  file->mode = mode;
+  file->fd = -1;
+  ctx->file = file;
+  ctx->file_started = false;
+}
+
+static int Untar_Parallel_header(Untar_ParallelContext *ctx)
+{
+  unsigned long mode;
+  unsigned char linkflag;
+  int retval;
+
+  Untar_Parallel_order(ctx);
+
+  retval = Untar_ProcessHeader(
+    &ctx->header[0],
+    &ctx->fname[0],
+    &mode,
+    &ctx->todo_bytes,
+    &ctx->todo_blocks,
+    &linkflag,
+    ctx->config.printer
+  );
+
+  ctx->done_bytes = 0;
+
+  if (retval != UNTAR_SUCCESSFUL) {
+    return retval;
+  }
+
+  if (linkflag == REGTYPE) {
+    Untar_Parallel_start_file(ctx, mode);
+
+    if (ctx->todo_bytes == 0) {
+      Untar_Parallel_dispatch(ctx, Untar_Parallel_get_job(ctx), true);
+    } else {
+      ctx->state = UNTAR_PARALLEL_WRITE;
+    }
+  } else if (linkflag == DIRTYPE) {
+    ++ctx->stats.directories;
+  } else if (linkflag == SYMTYPE) {
+    ++ctx->stats.links;
+  } else {
+    return UNTAR_SUCCESSFUL;
+  }
+
+  if (ctx->config.progress != NULL) {
+    Untar_ParallelStatistics stats;
+
+    Untar_Parallel_snapshot(ctx, &stats);
+    (*ctx->config.progress)(&stats, ctx->config.progress_arg);
+  }
+
+  return UNTAR_SUCCESSFUL;
+}
+
+/*
+ * The parsing stage.  In case the chunk is persistent, the jobs refer to the
+ * file contents in place, otherwise the contents are copied to the job
+ * buffers.
+ */
+static int Untar_Parallel_process(
+  Untar_ParallelContext *ctx,
+  const char            *buf,
+  size_t                 todo,
+  bool                   persistent
+)
+{
+  size_t done = 0;
+
+  while (todo > 0) {
+    size_t remaining;
+    size_t consume;
+    int retval;
+
+    switch (ctx->state) {
+      case UNTAR_PARALLEL_HEADER:
+        remaining = 512 - ctx->done_bytes;
+        consume = MIN(remaining, todo);
+        memcpy(&ctx->header[ctx->done_bytes], &buf[done], consume);
+        ctx->done_bytes += consume;
+
+        if (ctx->done_bytes == 512) {
+          retval = Untar_Parallel_header(ctx);
+
+          if (retval != UNTAR_SUCCESSFUL) {
+            ctx->state = UNTAR_PARALLEL_ERROR;
+            return retval;
+          }
+        }
+
+        break;
+      case UNTAR_PARALLEL_SKIP:
+        remaining = ctx->todo_bytes - ctx->done_bytes;
+        consume = MIN(remaining, todo);
+        ctx->done_bytes += consume;
+
+        if (ctx->done_bytes == ctx->todo_bytes) {
+          ctx->state = UNTAR_PARALLEL_HEADER;
+          ctx->done_bytes = 0;
+        }
+
+        break;
+      case UNTAR_PARALLEL_WRITE: {
+        Untar_ParallelJob *job = ctx->job;
+        bool full;
+
+        remaining = ctx->todo_bytes - ctx->done_bytes;
+        consume = MIN(remaining, todo);
+
+        if (job == NULL) {
+          job = Untar_Parallel_get_job(ctx);
+          ctx->job = job;
+        }
+
+        if (persistent) {
+          job->data = &buf[done];
+          job->size = consume;
+          full = true;
+        } else {
+          if (job->buffer == NULL) {
+            job->buffer = malloc(ctx->config.buffer_size);
+
+            if (job->buffer == NULL) {
+              ctx->state = UNTAR_PARALLEL_ERROR;
+              return UNTAR_FAIL;
+            }
+          }
+
+          consume = MIN(consume, ctx->config.buffer_size - job->size);
+          memcpy(&job->buffer[job->size], &buf[done], consume);
+          job->data = job->buffer;
+          job->size += consume;
+          full = job->size == ctx->config.buffer_size;
+        }
+
+        ctx->done_bytes += consume;
+
+        if (ctx->done_bytes == ctx->todo_bytes) {
+          ctx->job = NULL;
+          Untar_Parallel_dispatch(ctx, job, true);
+          ctx->state = UNTAR_PARALLEL_SKIP;
+          ctx->todo_bytes = 512 * ctx->todo_blocks - ctx->todo_bytes;
+          ctx->done_bytes = 0;
+        } else if (full) {
+          ctx->job = NULL;
+          Untar_Parallel_dispatch(ctx, job, false);
+        }
+
+        break;
+      }
+      default:
+        return UNTAR_FAIL;
+    }
+
+    ctx->stats.archive_bytes += consume;
+    done += consume;
+    todo -= consume;
+  }
+
+  return UNTAR_SUCCESSFUL;
+}
+
+/*
+ * The decompression stage for GZ streams.
+ */
+static int Untar_Parallel_inflate(
+  Untar_ParallelContext *ctx,
+  const void            *chunk,
+  size_t                 chunk_size
+)
+{
+  if (ctx->stream_end) {
+    return UNTAR_SUCCESSFUL;
+  }
+
+  ctx->strm.next_in = (Bytef *) chunk;
+  ctx->strm.avail_in = chunk_size;
+
+  /* Inflate until the input is consumed and the output buffer is not full */
+  do {
+    size_t inflated_size;
+    int status;
+    int retval;
+
+    ctx->strm.next_out = (Bytef *) ctx->inflate_buffer;
+    ctx->strm.avail_out = ctx->config.buffer_size;
+
+    status = inflate(&ctx->strm, Z_NO_FLUSH);
+    if (status == Z_STREAM_END) {
+      ctx->stream_end = true;
+    } else if (status == Z_BUF_ERROR) {
+      break;
+    } else if (status != Z_OK) {
+      rtems_printf(ctx->config.printer, "Zlib inflate failed\n");
+      ctx->state = UNTAR_PARALLEL_ERROR;
+      return UNTAR_GZ_INFLATE_FAILED;
+    }
+
+    inflated_size = ctx->config.buffer_size - ctx->strm.avail_out;
+    retval = Untar_Parallel_process(
+      ctx,
+      ctx->inflate_buffer,
+      inflated_size,
+      false
+    );
+    if (retval != UNTAR_SUCCESSFUL) {
+      return retval;
+    }
+  } while (
+    !ctx->stream_end
+      && (ctx->strm.avail_in > 0 || ctx->strm.avail_out == 0)
+  );
+
+  return UNTAR_SUCCESSFUL;
+}
+
+/*
+ * The decompression stage for XZ streams.
+ */
+static int Untar_Parallel_xz(
+  Untar_ParallelContext *ctx,
+  const void            *chunk,
+  size_t                 chunk_size
+)
+{
+  if (ctx->stream_end) {
+    return UNTAR_SUCCESSFUL;
+  }
+
+  ctx->xz_buf.in = (const uint8_t *) chunk;
+  ctx->xz_buf.in_pos = 0;
+  ctx->xz_buf.in_size = chunk_size;
+  ctx->xz_buf.out = (uint8_t *) ctx->inflate_buffer;
+
+  /* Decompress until the input is consumed and the output buffer is not full */
+  do {
+    enum xz_ret status;
+    int retval;
+
+    ctx->xz_buf.out_pos = 0;
+    ctx->xz_buf.out_size = ctx->config.buffer_size;
+
+    status = xz_dec_run(ctx->xz, &ctx->xz_buf);
+    if (status == XZ_OPTIONS_ERROR) {
+      status = XZ_OK;
+    }
+
+    if (status == XZ_STREAM_END) {
+      ctx->stream_end = true;
+    } else if (status == XZ_BUF_ERROR && ctx->xz_buf.out_pos == 0) {
+      break;
+    } else if (status != XZ_OK) {
+      rtems_printf(ctx->config.printer, "XZ decompression failed (%d)\n",
+                   (int) status);
+      ctx->state = UNTAR_PARALLEL_ERROR;
+      return UNTAR_FAIL;
+    }
+
+    retval = Untar_Parallel_process(
+      ctx,
+      ctx->inflate_buffer,
+      ctx->xz_buf.out_pos,
+      false
+    );
+    if (retval != UNTAR_SUCCESSFUL) {
+      return retval;
+    }
+  } while (
+    !ctx->stream_end
+      && (
+        ctx->xz_buf.in_pos != ctx->xz_buf.in_size
+          || ctx->xz_buf.out_pos == ctx->xz_buf.out_size
+      )
+  );
+
+  return UNTAR_SUCCESSFUL;
+}
+
+static void Untar_Parallel_start_writers(Untar_ParallelContext *ctx)
+{
+  rtems_task_priority priority;
+  rtems_status_code sc;
+  size_t i;
+
+  /* The writers cannot share a private user environment */
+  if (rtems_current_user_env != &rtems_global_user_env) {
+    return;
+  }
+
+  priority = ctx->config.writer_priority;
+
+  if (priority == 0) {
+    sc = rtems_task_set_priority(RTEMS_SELF, RTEMS_CURRENT_PRIORITY, &priority);
+    if (sc != RTEMS_SUCCESSFUL) {
+      return;
+    }
+  }
+
+  for (i = 0; i < ctx->config.writer_count; ++i) {
+    Untar_ParallelWriter *writer = &ctx->writers[ctx->writer_count];
+
+    sc = rtems_task_create(
+      rtems_build_name('U', 'T', 'W', 'R'),
+      priority,
+      UNTAR_PARALLEL_WRITER_STACK_SIZE,
+      RTEMS_DEFAULT_MODES,
+      RTEMS_DEFAULT_ATTRIBUTES,
+      &writer->id
+    );
+    if (sc != RTEMS_SUCCESSFUL) {
+      break;
+    }
+
+    writer->ctx = ctx;
+    writer->head = NULL;
+    writer->tail = &writer->head;
+    writer->pending = 0;
+    rtems_condition_variable_init(&writer->job_available, "Untar Writer");
+
+    sc = rtems_task_start(
+      writer->id,
+      Untar_Parallel_writer_task,
+      (rtems_task_argument) writer
+    );
+    if (sc != RTEMS_SUCCESSFUL) {
+      rtems_condition_variable_destroy(&writer->job_available);
+      (void) rtems_task_delete(writer->id);
+      break;
+    }
+
+    ++ctx->writer_count;
+    ++ctx->running_writers;
+  }
+}
+
+static void Untar_Parallel_destroy(Untar_ParallelContext *ctx)
+{
+  size_t i;
+
+  if (ctx->jobs != NULL) {
+    for (i = 0; i < ctx->config.buffer_count; ++i) {
+      free(ctx->jobs[i].buffer);
+    }
+  }
+
+  if (ctx->strm_initialized) {
+    (void) inflateEnd(&ctx->strm);
+  }
+
+  if (ctx->xz != NULL) {
+    xz_dec_end(ctx->xz);
+  }
+
+  rtems_condition_variable_destroy(&ctx->job_done);
+  rtems_mutex_destroy(&ctx->mutex);
+  free(ctx->inflate_buffer);
+  free(ctx->writers);
+  free(ctx->files);
+  free(ctx->jobs);
+  free(ctx);
+}
+
+int Untar_ParallelContext_Create(
+  Untar_ParallelContext **ctx_ptr,
+  const Untar_ParallelConfig *config
+)
+{
+  Untar_ParallelContext *ctx;
+  size_t i;
+
+  *ctx_ptr = NULL;
+
+  ctx = calloc(1, sizeof(*ctx));
+  if (ctx == NULL) {
+    return UNTAR_FAIL;
+  }
+
+  rtems_mutex_init(&ctx->mutex, "Untar");
+  rtems_condition_variable_init(&ctx->job_done, "Untar Job Done");
+
+  if (config != NULL) {
+    ctx->config = *config;
+  }
+
+  if (ctx->config.writer_count == 0) {
+    ctx->config.writer_count = UNTAR_PARALLEL_DEFAULT_WRITER_COUNT;
+  }
+
+  if (ctx->config.buffer_size == 0) {
+    ctx->config.buffer_size = UNTAR_PARALLEL_DEFAULT_BUFFER_SIZE;
+  }
+
+  if (ctx->config.buffer_count == 0) {
+    ctx->config.buffer_count = 4 * ctx->config.writer_count;
+  }
+
+  ctx->jobs = calloc(ctx->config.buffer_count, sizeof(*ctx->jobs));
+  ctx->files = calloc(ctx->config.buffer_count, sizeof(*ctx->files));
+  ctx->writers = calloc(ctx->config.writer_count, sizeof(*ctx->writers));
+
+  if (ctx->jobs == NULL || ctx->files == NULL || ctx->writers == NULL) {
+    Untar_Parallel_destroy(ctx);
+    return UNTAR_FAIL;
+  }
+
+  for (i = 0; i < ctx->config.buffer_count; ++i) {
+    ctx->jobs[i].next = ctx->free_jobs;
+    ctx->free_jobs = &ctx->jobs[i];
+    ctx->files[i].next = ctx->free_files;
+    ctx->free_files = &ctx->files[i];
+  }
+
+  if (ctx->config.format != UNTAR_PARALLEL_TAR) {
+    ctx->inflate_buffer = malloc(ctx->config.buffer_size);
+    if (ctx->inflate_buffer == NULL) {
+      Untar_Parallel_destroy(ctx);
+      return UNTAR_FAIL;
+    }
+  }
+
+  if (ctx->config.format == UNTAR_PARALLEL_GZ) {
+    if (inflateInit2(&ctx->strm, 32 + MAX_WBITS) != Z_OK) {
+      Untar_Parallel_destroy(ctx);
+      return UNTAR_FAIL;
+    }
+
+    ctx->strm_initialized = true;
+  } else if (ctx->config.format == UNTAR_PARALLEL_XZ) {
+    xz_crc32_init();
+    ctx->xz = xz_dec_init(XZ_DYNALLOC, ctx->config.xz_dict_max);
+    if (ctx->xz == NULL) {
+      Untar_Parallel_destroy(ctx);
+      return UNTAR_FAIL;
+    }
+  }
+
+  ctx->writer_status = UNTAR_SUCCESSFUL;
+  ctx->state = UNTAR_PARALLEL_HEADER;
+  ctx->start = rtems_clock_get_uptime_nanoseconds();
+  Untar_Parallel_start_writers(ctx);
+
+  *ctx_ptr = ctx;
+  return UNTAR_SUCCESSFUL;
+}
+
+int Untar_FromChunk_Parallel(
+  Untar_ParallelContext *ctx,
+  const void *chunk,
+  size_t chunk_size
+)
+{
+  switch (ctx->config.format) {
+    case UNTAR_PARALLEL_GZ:
+      return Untar_Parallel_inflate(ctx, chunk, chunk_size);
+    case UNTAR_PARALLEL_XZ:
+      return Untar_Parallel_xz(ctx, chunk, chunk_size);
+    default:
+      return Untar_Parallel_process(ctx, chunk, chunk_size, false);
+  }
+}
+
+int Untar_ParallelContext_Finish(
+  Untar_ParallelContext *ctx,
+  Untar_ParallelStatistics *stats
+)
+{
+  Untar_ParallelStatistics final;
+  int retval;
+  size_t i;
+
+  /* A file is left over only in case of a truncated archive or an error */
+  if (ctx->file != NULL) {
+    Untar_ParallelJob *job = ctx->job;
+
+    if (job == NULL) {
+      job = Untar_Parallel_get_job(ctx);
+    }
+
+    ctx->job = NULL;
+    Untar_Parallel_dispatch(ctx, job, true);
+  }
+
+  rtems_mutex_lock(&ctx->mutex);
+
+  while (ctx->busy_files > 0) {
+    rtems_condition_variable_wait(&ctx->job_done, &ctx->mutex);
+  }
+
+  ctx->stop = true;
+
+  for (i = 0; i < ctx->writer_count; ++i) {
+    rtems_condition_variable_signal(&ctx->writers[i].job_available);
+  }
+
+  while (ctx->running_writers > 0) {
+    rtems_condition_variable_wait(&ctx->job_done, &ctx->mutex);
+  }
+
+  rtems_mutex_unlock(&ctx->mutex);
+
+  for (i = 0; i < ctx->writer_count; ++i) {
+    (void) rtems_task_delete(ctx->writers[i].id);
+    rtems_condition_variable_destroy(&ctx->writers[i].job_available);
+  }
+
+  Untar_Parallel_snapshot(ctx, &final);
+
+  if (ctx->state == UNTAR_PARALLEL_ERROR) {
+    retval = UNTAR_FAIL;
+  } else {
+    retval = ctx->writer_status;
+  }
+
+  rtems_printf(
+    ctx->config.printer,
+    "untar: %lu files, %lu dirs, %lu links, %" PRIu64 " bytes in %"
+      PRIu64 " us with %zu writers\n",
+    final.files,
+    final.directories,
+    final.links,
+    final.file_bytes,
+    final.elapsed_ns / 1000,
+    ctx->writer_count
+  );
+
+  if (stats != NULL) {
+    *stats = final;
+  }
+
+  Untar_Parallel_destroy(ctx);
+
+  return retval;
+}
+
+int Untar_FromMemory_Parallel(
+  const void *tar_buf,
+  size_t size,
+  const Untar_ParallelConfig *config,
+  Untar_ParallelStatistics *stats
+)
+{
+  Untar_ParallelContext *ctx;
+  int retval;
+  int retval_finish;
+
+  retval = Untar_ParallelContext_Create(&ctx, config);
+  if (retval != UNTAR_SUCCESSFUL) {
+    return retval;
+  }
+
+  rtems_printf(ctx->config.printer, "untar: memory at %p (%zu)\n",
+               tar_buf, size);
+
+  if (ctx->config.format == UNTAR_PARALLEL_TAR) {
+    retval = Untar_Parallel_process(ctx, tar_buf, size, true);
+  } else {
+    retval = Untar_FromChunk_Parallel(ctx, tar_buf, size);
+  }
+
+  retval_finish = Untar_ParallelContext_Finish(ctx, stats);
+
+  return retval != UNTAR_SUCCESSFUL ? retval : retval_finish;
+}
+
+int Untar_FromFile_Parallel(
+  const char *tar_name,
+  const Untar_ParallelConfig *config,
+  Untar_ParallelStatistics *stats
+)
+{
+  Untar_ParallelContext *ctx;
+  char *buf;
+  int fd;
+  int retval;
+  int retval_finish;
+
+  fd = open(tar_name, O_RDONLY);
+  if (fd < 0) {
+    return UNTAR_FAIL;
+  }
+
+  retval = Untar_ParallelContext_Create(&ctx, config);
+  if (retval != UNTAR_SUCCESSFUL) {
+    close(fd);
+    return retval;
+  }
+
+  buf = malloc(ctx->config.buffer_size);
+  if (buf == NULL) {
+    retval = UNTAR_FAIL;
+  }
+
+  while (retval == UNTAR_SUCCESSFUL) {
+    ssize_t n = read(fd, buf, ctx->config.buffer_size);
+
+    if (n <= 0) {
+      break;
+    }
+
+    retval = Untar_FromChunk_Parallel(ctx, buf, (size_t) n);
+  }
+
+  retval_finish = Untar_ParallelContext_Finish(ctx, stats);
+  free(buf);
+  close(fd);
+
+  return retval != UNTAR_SUCCESSFUL ? retval : retval_finish;
+}
@@ -46,6 +46,8 @@
 #include <sys/malloc.h>
 #include <sys/queue.h>
 #include <sys/uio.h>
+#include <netinet/in.h>
+#include <rtems/rtems_netinet_in.h>
 
 int
 uiomove(void *cp, int n, struct uio *uio)
@@ -99,6 +101,46 @@ uiomove(void *cp, int n, struct uio *uio)
 	return (0);
 }
 
+/*
+ * Like uiomove() for UIO_WRITE, but add the Internet checksum of the copied
+ * data to the partial checksum in *sump.  The off parameter is the offset of
+ * the destination within the packet.  This folds the checksum computation
+ * into the copy from the caller buffer, so the data is touched only once.
+ */
+int
+uiomove_cksum(void *cp, int n, struct uio *uio, uint32_t *sump, int off)
+{
+	register struct iovec *iov;
+	u_int cnt;
+	u_int sum;
+
+	if (uio->uio_rw != UIO_WRITE || uio->uio_segflg == UIO_NOCOPY)
+		return (EINVAL);
+	sum = *sump;
+	while (n > 0 && uio->uio_resid) {
+		iov = uio->uio_iov;
+		cnt = iov->iov_len;
+		if (cnt == 0) {
+			uio->uio_iov++;
+			uio->uio_iovcnt--;
+			continue;
+		}
+		if (cnt > n)
+			cnt = n;
+		sum = in_cksum_add(sum,
+		    in_cksum_copy(iov->iov_base, cp, cnt), off);
+		iov->iov_base += cnt;
+		iov->iov_len -= cnt;
+		uio->uio_resid -= cnt;
+		uio->uio_offset += cnt;
+		cp += cnt;
+		off += cnt;
+		n -= cnt;
+	}
+	*sump = sum;
+	return (0);
+}
+
 /*
  * General routine to allocate a hash table.
  */
@@ -55,6 +55,7 @@ SYSINIT(mbuf, SI_SUB_MBUF, SI_ORDER_FIRST, mbinit, NULL)
 struct mbuf *mbutl;
 char	*mclrefcnt;
 struct mbstat mbstat;
+struct mbpoolstat mbpoolstat;
 struct mbuf *mmbfree;
 union mcluster *mclfree;
 int	max_linkhdr;
@@ -260,7 +261,7 @@ m_copym(struct mbuf *m, int off0, uint32_t len, int wait)
 		if (m->m_flags & M_EXT) {
 			n->m_data = m->m_data + off;
 			if(!m->m_ext.ext_ref)
-				mclrefcnt[mtocl(m->m_ext.ext_buf)]++;
+				MCLREFCNT(m->m_ext.ext_buf)++;
 			else
 				(*(m->m_ext.ext_ref))(m->m_ext.ext_buf,
 							m->m_ext.ext_size);
@@ -302,7 +303,7 @@ m_copypacket(struct mbuf *m, int how)
 	n->m_len = m->m_len;
 	if (m->m_flags & M_EXT) {
 		n->m_data = m->m_data;
-		mclrefcnt[mtocl(m->m_ext.ext_buf)]++;
+		MCLREFCNT(m->m_ext.ext_buf)++;
 		n->m_ext = m->m_ext;
 		n->m_flags |= M_EXT;
 	} else {
@@ -321,7 +322,7 @@ m_copypacket(struct mbuf *m, int how)
 		n->m_len = m->m_len;
 		if (m->m_flags & M_EXT) {
 			n->m_data = m->m_data;
-			mclrefcnt[mtocl(m->m_ext.ext_buf)]++;
+			MCLREFCNT(m->m_ext.ext_buf)++;
 			n->m_ext = m->m_ext;
 			n->m_flags |= M_EXT;
 		} else {
@@ -600,7 +601,7 @@ extpacket:
 		n->m_flags |= M_EXT;
 		n->m_ext = m->m_ext;
 		if(!m->m_ext.ext_ref)
-			mclrefcnt[mtocl(m->m_ext.ext_buf)]++;
+			MCLREFCNT(m->m_ext.ext_buf)++;
 		else
 			(*(m->m_ext.ext_ref))(m->m_ext.ext_buf,
 						m->m_ext.ext_size);
@@ -192,6 +192,9 @@ soclose(struct socket *so)
 	rtems_sockbuf_close_notify(so, &so->so_snd);
 	rtems_sockbuf_close_notify(so, &so->so_rcv);
 
+	if (!LIST_EMPTY(&so->so_knotes))
+		rtems_bsdnet_knote_close(so);
+
 	if (so->so_options & SO_ACCEPTCONN) {
 		struct socket *sp, *sonext;
 
@@ -317,6 +320,39 @@ bad:
 }
 
 #define	SBLOCKWAIT(f)	(((f) & MSG_DONTWAIT) ? M_NOWAIT : M_WAITOK)
+
+/*
+ * Copies of at least this size are done without the network semaphore.
+ */
+#define	SOCOPY_UNLOCK_MIN	MINCLSIZE
+
+/*
+ * Copy data between the user and an mbuf which is either private or part of
+ * a socket buffer locked by sblock().  This is where the original code
+ * dropped the interrupt priority, so large copies release the network
+ * semaphore and tasks may copy the data of independent sockets in parallel.
+ * If hdr is not NULL, then the data checksum is accumulated in its packet
+ * header.
+ */
+static int
+socopy(caddr_t cp, int n, struct uio *uio, struct mbuf *hdr)
+{
+	uint32_t nest_count = 0;
+	int unlock = n >= SOCOPY_UNLOCK_MIN;
+	int error;
+
+	if (unlock)
+		nest_count = rtems_bsdnet_semaphore_release_recursive();
+	if (hdr != NULL)
+		error = uiomove_cksum(cp, n, uio, &hdr->m_pkthdr.csum_data,
+		    hdr->m_pkthdr.len);
+	else
+		error = uiomove(cp, n, uio);
+	if (unlock)
+		rtems_bsdnet_semaphore_obtain_recursive(nest_count);
+	return (error);
+}
+
 /*
  * Send on a socket.
  * If send must go all at once and message is larger than
@@ -339,7 +375,7 @@ sosend(struct socket *so, struct mbuf *addr, struct uio *uio,
     struct mbuf *top, struct mbuf *control, int flags)
 {
 	struct mbuf **mp;
-	register struct mbuf *m;
+	register struct mbuf *m, *hdr;
 	register long space, len, resid;
 	int clen = 0, error, s, dontroute, mlen;
 	int atomic = sosendallatonce(so) || top;
@@ -434,6 +470,10 @@ restart:
 				mlen = MHLEN;
 				m->m_pkthdr.len = 0;
 				m->m_pkthdr.rcvif = (struct ifnet *)0;
+				m->m_pkthdr.csum_data = 0;
+				if (atomic && (so->so_proto->pr_flags &
+				    PR_CKSUMDATA) != 0)
+					m->m_flags |= M_CSUM_DATA;
 			} else {
 				MGET(m, M_WAIT, MT_DATA);
 				mlen = MLEN;
@@ -455,7 +495,9 @@ nopages:
 					MH_ALIGN(m, len);
 			}
 			space -= len;
-			error = uiomove(mtod(m, caddr_t), (int)len, uio);
+			hdr = top != 0 ? top : m;
+			error = socopy(mtod(m, caddr_t), (int)len, uio,
+			    (hdr->m_flags & M_CSUM_DATA) != 0 ? hdr : NULL);
 			resid = uio->uio_resid;
 			m->m_len = len;
 			*mp = m;
@@ -469,9 +511,14 @@ nopages:
 				break;
 			}
 		    } while (space > 0 && atomic);
+		    s = splnet();				/* XXX */
+		    /*
+		     * The socket state may have changed during the copy.
+		     */
+		    if (so->so_state & SS_CANTSENDMORE)
+			    snderr(EPIPE);
 		    if (dontroute)
 			    so->so_options |= SO_DONTROUTE;
-		    s = splnet();				/* XXX */
 		    error = (*so->so_proto->pr_usrreqs->pru_send)(so,
 			(flags & MSG_OOB) ? PRUS_OOB :
 			/*
@@ -712,7 +759,8 @@ dontblock:
 		 */
 		if (mp == 0) {
 			splx(s);
-			error = uiomove(mtod(m, caddr_t) + moff, (int)len, uio);
+			error = socopy(mtod(m, caddr_t) + moff, (int)len, uio,
+			    NULL);
 			s = splnet();
 			if (error)
 				goto release;
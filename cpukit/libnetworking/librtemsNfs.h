@@ -98,6 +98,18 @@ extern "C" {
  */
 extern rtems_task_priority rpciodPriority;
 
+/** Number of daemons; may be setup prior to calling rpcUdpInit().
+ * Each daemon uses its own socket and request queue.  Transactions
+ * are distributed to the daemons according to their XID.
+ */
+extern int rpciodCount;
+
+/** Depth of the request queue of each daemon (default 20); may be setup
+ * prior to calling rpcUdpInit().  A request is refused with
+ * RPC_CANTSEND if the queue of its daemon is full.
+ */
+extern int rpciodQueueDepth;
+
 #ifdef RTEMS_SMP
 /** CPU affinity of daemon; may be setup prior to calling rpcUdpInit();
  * otherwise the network task CPU affinity from the rtems_bsdnet_config
@@ -169,6 +181,17 @@ rpcUdpCleanup(void);
 int
 nfsInit(int smallPoolDepth, int bigPoolDepth);
 
+/**
+ * @brief Number of READ/WRITE RPCs an open file keeps in flight.
+ *
+ * Sequential reads are served from read-ahead and writes return once their
+ * data is queued (write-behind).  Errors of queued writes are reported by a
+ * subsequent write(), fsync() or close().  A value of one or less selects
+ * synchronous RPCs.  The value is sampled by the first read or write of an
+ * open file.
+ */
+extern int nfsRpcWindow;
+
 /**
  * @brief Driver cleanup code.
  *
@@ -186,6 +209,52 @@ nfsCleanup(void);
 int
 nfsMountsShow(FILE *f);
 
+/**
+ * @brief Lifetimes in seconds of cached attributes, directory entries and
+ * failed lookups.
+ *
+ * Each mounted NFS caches the attributes of recently used files and the
+ * results of recent LOOKUP requests.  Local modifications invalidate the
+ * affected entries, remote ones become visible once an entry expired.  A
+ * value of zero disables the respective cache, a negative value never
+ * expires.  The values are sampled when a NFS is mounted.
+ */
+extern int nfsAttrCacheTtl;
+extern int nfsDentryCacheTtl;
+extern int nfsNegDentryCacheTtl;
+
+/**
+ * @brief Counters of the attribute and directory entry caches of a mounted
+ * NFS.
+ */
+typedef struct NfsCacheStatsRec_ {
+	/** @brief Attribute requests served from the cache. */
+	unsigned long attrHits;
+	/** @brief GETATTR requests sent to the server. */
+	unsigned long attrRpcs;
+	/** @brief Lookups served from the cache. */
+	unsigned long lookupHits;
+	/** @brief Lookups of non-existing names served from the cache. */
+	unsigned long lookupNegHits;
+	/** @brief LOOKUP requests sent to the server. */
+	unsigned long lookupRpcs;
+} NfsCacheStatsRec;
+
+/**
+ * @brief Get the cache counters of the NFS mounted at a mount point.
+ *
+ * The counters are also printed by nfsMountsShow().
+ *
+ * @param[in] mountpoint The mount point as passed to mount().
+ * @param[out] stats The counters.
+ *
+ * @retval 0 Successful operation.
+ * @retval -1 There is no NFS mounted at this mount point.  The errno is set
+ * to ENOENT.
+ */
+int
+nfsCacheStatsGet(const char *mountpoint, NfsCacheStatsRec *stats);
+
 /**
  * @brief Filesystem mount table mount handler.
  *
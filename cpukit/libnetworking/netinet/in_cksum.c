@@ -37,6 +37,154 @@
 
 #include <sys/param.h>
 #include <sys/mbuf.h>
+#include <string.h>
+
+/*
+ * Fold a 64-bit ones' complement sum into 16 bits.
+ */
+static __inline u_int
+in_cksum_fold(uint64_t sum)
+{
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+	return ((u_int)sum);
+}
+
+/*
+ * The sum of a buffer starting at an odd offset of the packet is the byte
+ * swapped sum of the buffer starting at an even offset.
+ */
+static __inline u_int
+in_cksum_swap(u_int sum)
+{
+	return (((sum & 0xff) << 8) | (sum >> 8));
+}
+
+/*
+ * Compute the partial checksum of a buffer which starts at an even offset of
+ * the packet and optionally copy it.  The words are summed up as 32-bit
+ * values in a 64-bit accumulator, so no carry has to be folded in the inner
+ * loop.  A buffer at an odd address is summed up as if it starts one byte
+ * earlier, which swaps the bytes of the result.
+ */
+static __inline u_int
+in_cksum_data(const u_char *p, u_char *d, int len)
+{
+	uint64_t sum = 0;
+	int byte_swapped = 0;
+	u_int result;
+	union {
+		u_char	c[2];
+		u_short	s;
+	} s_util;
+
+	if (len <= 0)
+		return (0);
+
+	if (1 & (uintptr_t) p) {
+		s_util.c[0] = 0;
+		s_util.c[1] = *p;
+		sum = s_util.s;
+		if (d != NULL)
+			*d++ = *p;
+		++p;
+		--len;
+		byte_swapped = 1;
+	}
+	if ((2 & (uintptr_t) p) && len >= 2) {
+		sum += *(const u_short *) p;
+		if (d != NULL) {
+			*(u_short *) d = *(const u_short *) p;
+			d += 2;
+		}
+		p += 2;
+		len -= 2;
+	}
+	/*
+	 * Unroll the loop to make overhead from
+	 * branches &c small.
+	 */
+	while (len >= 32) {
+		const uint32_t *w = (const uint32_t *) p;
+		uint32_t w0 = w[0], w1 = w[1], w2 = w[2], w3 = w[3];
+		uint32_t w4 = w[4], w5 = w[5], w6 = w[6], w7 = w[7];
+
+		sum += w0; sum += w1; sum += w2; sum += w3;
+		sum += w4; sum += w5; sum += w6; sum += w7;
+		if (d != NULL) {
+			uint32_t *v = (uint32_t *) d;
+
+			v[0] = w0; v[1] = w1; v[2] = w2; v[3] = w3;
+			v[4] = w4; v[5] = w5; v[6] = w6; v[7] = w7;
+			d += 32;
+		}
+		p += 32;
+		len -= 32;
+	}
+	while (len >= 4) {
+		uint32_t w0 = *(const uint32_t *) p;
+
+		sum += w0;
+		if (d != NULL) {
+			*(uint32_t *) d = w0;
+			d += 4;
+		}
+		p += 4;
+		len -= 4;
+	}
+	if (len >= 2) {
+		sum += *(const u_short *) p;
+		if (d != NULL) {
+			*(u_short *) d = *(const u_short *) p;
+			d += 2;
+		}
+		p += 2;
+		len -= 2;
+	}
+	if (len > 0) {
+		s_util.c[0] = *p;
+		s_util.c[1] = 0;
+		sum += s_util.s;
+		if (d != NULL)
+			*d = *p;
+	}
+
+	result = in_cksum_fold(sum);
+	if (byte_swapped)
+		result = in_cksum_swap(result);
+	return (result);
+}
+
+/*
+ * Copy a buffer and return its partial checksum, which is the folded but not
+ * complemented ones' complement sum of the buffer.  This avoids a second pass
+ * over the data in the copy paths of the protocols.  The buffer is assumed to
+ * start at an even offset of the packet.
+ */
+u_int
+in_cksum_copy(const void *src, void *dst, int len)
+{
+	if ((((uintptr_t) src ^ (uintptr_t) dst) & 3) != 0) {
+		memcpy(dst, src, len);
+		return (in_cksum_data(dst, NULL, len));
+	}
+
+	return (in_cksum_data(src, dst, len));
+}
+
+/*
+ * Add a partial checksum of data at the specified offset of the packet to a
+ * partial checksum.
+ */
+u_int
+in_cksum_add(u_int sum, u_int partial, int off)
+{
+	if (off & 1)
+		partial = in_cksum_swap(partial);
+	return (in_cksum_fold((uint64_t) sum + partial));
+}
 
 /*
  *  Try to use a CPU specific version, then punt to the portable C one.
@@ -76,111 +224,32 @@
  *
  * This routine is very heavily used in the network
  * code and should be modified for each CPU to be as fast as possible.
+ *
+ * The partial sums of the mbufs are computed word-at-a-time.  An mbuf which
+ * starts at an odd offset of the packet contributes its byte swapped sum.
  */
-
-#define ADDCARRY(x)  (x > 65535L ? x -= 65535L : x)
-#define REDUCE \
-  {l_util.l = sum; sum = l_util.s[0] + l_util.s[1];  ADDCARRY(sum);}
-
 int
 in_cksum(
 	struct mbuf *m,
-	uint32_t len )
+	int len )
 {
-	register u_short *w;
-	register int32_t sum = 0;
-	register int32_t mlen = 0;
-	int byte_swapped = 0;
-
-	union {
-		char	c[2];
-		u_short	s;
-	} s_util;
-	union {
-		u_short s[2];
-		long	l;
-	} l_util;
+	uint64_t sum = 0;
+	int off = 0;
+	int mlen;
 
 	for (;m && len; m = m->m_next) {
 		if (m->m_len == 0)
 			continue;
-		w = mtod(m, u_short *);
-		if (mlen == -1) {
-			/*
-			 * The first byte of this mbuf is the continuation
-			 * of a word spanning between this mbuf and the
-			 * last mbuf.
-			 *
-			 * s_util.c[0] is already saved when scanning previous
-			 * mbuf.
-			 */
-			s_util.c[1] = *(char *)w;
-			sum += s_util.s;
-			w = (u_short *)((char *)w + 1);
-			mlen = m->m_len - 1;
-			len--;
-		} else
-			mlen = m->m_len;
+		mlen = m->m_len;
 		if (len < mlen)
 			mlen = len;
+		sum += in_cksum_add(0, in_cksum_data(mtod(m, const u_char *),
+		    NULL, mlen), off);
+		off += mlen;
 		len -= mlen;
-		/*
-		 * Force to even boundary.
-		 */
-		if ((1 & (intptr_t) w) && (mlen > 0)) {
-			REDUCE;
-			sum <<= 8;
-			s_util.c[0] = *(u_char *)w;
-			w = (u_short *)((char *)w + 1);
-			mlen--;
-			byte_swapped = 1;
-		}
-		/*
-		 * Unroll the loop to make overhead from
-		 * branches &c small.
-		 */
-		while ((mlen -= 32) >= 0) {
-			sum += w[0]; sum += w[1]; sum += w[2]; sum += w[3];
-			sum += w[4]; sum += w[5]; sum += w[6]; sum += w[7];
-			sum += w[8]; sum += w[9]; sum += w[10]; sum += w[11];
-			sum += w[12]; sum += w[13]; sum += w[14]; sum += w[15];
-			w += 16;
-		}
-		mlen += 32;
-		while ((mlen -= 8) >= 0) {
-			sum += w[0]; sum += w[1]; sum += w[2]; sum += w[3];
-			w += 4;
-		}
-		mlen += 8;
-		if (mlen == 0 && byte_swapped == 0)
-			continue;
-		REDUCE;
-		while ((mlen -= 2) >= 0) {
-			sum += *w++;
-		}
-		if (byte_swapped) {
-			REDUCE;
-			sum <<= 8;
-			byte_swapped = 0;
-			if (mlen == -1) {
-				s_util.c[1] = *(char *)w;
-				sum += s_util.s;
-				mlen = 0;
-			} else
-				mlen = -1;
-		} else if (mlen == -1)
-			s_util.c[0] = *(char *)w;
 	}
 	if (len)
 		puts("cksum: out of data");
-	if (mlen == -1) {
-		/* The last mbuf has odd # of bytes. Follow the
-		   standard (the odd byte may be shifted left by 8 bits
-		   or not as determined by endian-ness of the machine) */
-		s_util.c[1] = 0;
-		sum += s_util.s;
-	}
-	REDUCE;
-	return (~sum & 0xffff);
+	return (~in_cksum_fold(sum) & 0xffff);
 }
 #endif
@@ -101,7 +101,7 @@ struct protosw inetsw[] = {
   ip_init,	0,		ip_slowtimo,	ip_drain,
   NULL
 },
-{ SOCK_DGRAM,	&inetdomain,	IPPROTO_UDP,	PR_ATOMIC|PR_ADDR,
+{ SOCK_DGRAM,	&inetdomain,	IPPROTO_UDP,	PR_ATOMIC|PR_ADDR|PR_CKSUMDATA,
   udp_input,	0,		udp_ctlinput,	ip_ctloutput,
   udp_usrreq,
   udp_init,	0,		0,		0,
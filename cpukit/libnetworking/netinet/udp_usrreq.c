@@ -364,6 +364,8 @@ udp_output(struct inpcb *inp, struct mbuf *m, struct mbuf *addr,
 	register int len = m->m_pkthdr.len;
 	struct in_addr laddr;
 	int s = 0, error = 0;
+	int csum_valid = (m->m_flags & M_CSUM_DATA) != 0;
+	u_int csum_data = m->m_pkthdr.csum_data;
 
 	laddr.s_addr = 0;
 	if (control)
@@ -429,8 +431,20 @@ udp_output(struct inpcb *inp, struct mbuf *m, struct mbuf *addr,
 	 * Stuff checksum and output datagram.
 	 */
 	ui->ui_sum = 0;
+	m->m_flags &= ~M_CSUM_DATA;
 	if (udpcksum) {
-	    if ((ui->ui_sum = in_cksum(m, sizeof (struct udpiphdr) + len)) == 0)
+	    if (csum_valid) {
+		/*
+		 * The data checksum was computed while copying the data
+		 * from the user, so only the header must be summed up.
+		 */
+		ui->ui_sum = ~in_cksum_add(
+		    ~in_cksum(m, sizeof (struct udpiphdr)) & 0xffff,
+		    csum_data, sizeof (struct udpiphdr));
+		if (ui->ui_sum == 0)
+		    ui->ui_sum = 0xffff;
+	    } else if ((ui->ui_sum =
+		in_cksum(m, sizeof (struct udpiphdr) + len)) == 0)
 		ui->ui_sum = 0xffff;
 	}
 	((struct ip *)ui)->ip_len = sizeof (struct udpiphdr) + len;
@@ -171,6 +171,15 @@ struct rtems_bsdnet_config {
 	const cpu_set_t		*network_task_cpuset;
 	size_t			network_task_cpuset_size;
 #endif
+
+	/*
+	 * Upper limits for the mbuf and cluster memory.  If the initial
+	 * pools run out, then additional memory is allocated from the heap
+	 * up to these limits and returned to the heap when it is no longer
+	 * used.  A value of zero disables the dynamic growth.
+	 */
+	unsigned long		mbuf_max_bytecount;
+	unsigned long		mbuf_cluster_max_bytecount;
 };
 
 /*
@@ -48,6 +48,9 @@ struct mdproc {
 struct socket;
 extern int soconnsleep (struct socket *so);
 extern void soconnwakeup (struct socket *so);
+struct sockbuf;
+extern void rtems_bsdnet_knote_wakeup (struct socket *so, struct sockbuf *sb);
+extern void rtems_bsdnet_knote_close (struct socket *so);
 #define splnet()	0
 #define splimp()	0
 #define splx(_s)	do { (_s) = 0; (void) (_s); } while(0)
@@ -262,6 +265,11 @@ struct rtentry;
 int	looutput(struct ifnet *,
 	   struct mbuf *, struct sockaddr *, struct rtentry *);
 
+struct uio;
+int	uiomove_cksum(void *, int, struct uio *, uint32_t *, int);
+
+void	rtems_bsdnet_mbpool_initialize(void *, void *);
+
 typedef u_long	tcp_cc;			/* connection count per rfc1644 */
 
 #define    TCPOPT_TSTAMP_HDR		\
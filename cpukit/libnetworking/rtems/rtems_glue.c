@@ -221,6 +221,7 @@ bsd_init (void)
 	}
 	mbstat.m_mbufs = nmbuf;
 	mbstat.m_mtypes[MT_FREE] = nmbuf;
+	rtems_bsdnet_mbpool_initialize(p - nmbuf * _SYS_MBUF_LEGACY_MSIZE, p);
 
 	/*
 	 * Set up domains
@@ -428,6 +429,9 @@ sowakeup(
 	if (sb->sb_wakeup) {
 		(*sb->sb_wakeup) (so, sb->sb_wakeuparg);
 	}
+	if (!LIST_EMPTY(&so->so_knotes)) {
+		rtems_bsdnet_knote_wakeup (so, sb);
+	}
 }
 
 /*
@@ -1190,75 +1194,3 @@ rtems_bsdnet_parse_driver_name (const struct rtems_bsdnet_ifconfig *config, char
 	return -1;
 }
 
-/*
- * Handle requests for more network memory
- * XXX: Another possibility would be to use a semaphore here with
- *      a release in the mbuf free macro.  I have chosen this `polling'
- *      approach because:
- *      1) It is simpler.
- *      2) It adds no complexity to the free macro.
- *      3) Running out of mbufs should be a rare
- *         condition -- predeployment testing of
- *         an application should indicate the
- *         required mbuf pool size.
- * XXX: Should there be a panic if a task is stuck in the loop for
- *      more than a minute or so?
- */
-int
-m_mballoc(int nmb, int nowait)
-{
-	if (nowait)
-		return 0;
-	m_reclaim ();
-	if (mmbfree == NULL) {
-		int try = 0;
-		int print_limit = 30 * rtems_bsdnet_ticks_per_second;
-
-		mbstat.m_wait++;
-		for (;;) {
-			uint32_t nest_count = rtems_bsdnet_semaphore_release_recursive ();
-			rtems_task_wake_after (1);
-			rtems_bsdnet_semaphore_obtain_recursive (nest_count);
-			if (mmbfree)
-				break;
-			if (++try >= print_limit) {
-				printf ("Still waiting for mbuf.\n");
-				try = 0;
-			}
-		}
-	}
-	else {
-		mbstat.m_drops++;
-	}
-	return 1;
-}
-
-int
-m_clalloc(int ncl, int nowait)
-{
-	if (nowait)
-		return 0;
-	m_reclaim ();
-	if (mclfree == NULL) {
-		int try = 0;
-		int print_limit = 30 * rtems_bsdnet_ticks_per_second;
-
-		mbstat.m_wait++;
-		for (;;) {
-			uint32_t nest_count = rtems_bsdnet_semaphore_release_recursive ();
-			rtems_task_wake_after (1);
-			rtems_bsdnet_semaphore_obtain_recursive (nest_count);
-			if (mclfree)
-				break;
-			if (++try >= print_limit) {
-				printf ("Still waiting for mbuf cluster.\n");
-				try = 0;
-			}
-		}
-	}
-	else {
-		mbstat.m_drops++;
-	}
-	return 1;
-}
-
@@ -0,0 +1,482 @@
+/**
+ * @file
+ *
+ * @brief RTEMS Implementation of kqueue() and kevent() for Sockets
+ */
+
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#include <machine/rtems-bsd-kernel-space.h>
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+#include <errno.h>
+
+#include <rtems.h>
+#include <rtems/libio_.h>
+#include <rtems/rtems_bsdnet.h>
+
+#include <sys/types.h>
+#include <sys/param.h>
+#include <sys/queue.h>
+#include <sys/malloc.h>
+#include <sys/mbuf.h>
+#include <sys/socket.h>
+#include <sys/socketvar.h>
+#include <sys/protosw.h>
+#include <sys/event.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+/*
+ *********************************************************************
+ *       RTEMS implementation of kqueue() and kevent() for sockets   *
+ *********************************************************************
+ */
+
+/*
+ * In contrast to select(), the interest in a socket is registered once.
+ * Each socket has a list of the notes registered for it.  A state change
+ * of a socket buffer is reported by sowakeup() and moves the ready notes
+ * of the socket to the ready queue of their kqueue.  A kevent() call only
+ * looks at the ready queue, so its cost is proportional to the count of
+ * ready events and not to the count of registered sockets.
+ *
+ * This implementation is restricted:
+ *	Only the EVFILT_READ and EVFILT_WRITE filters on sockets are
+ *		supported.
+ *	A given kqueue can be waited on by only one task at a time.
+ *
+ * Everything is protected by the network semaphore.
+ */
+
+/* Not visible in kernel space */
+int kqueue (void);
+int kevent (int kq, const struct kevent *changelist, int nchanges,
+    struct kevent *eventlist, int nevents, const struct timespec *timeout);
+
+struct socket *rtems_bsdnet_fdToSocket(int fd);
+
+struct rtems_bsdnet_kqueue {
+	TAILQ_HEAD(, rtems_bsdnet_knote) kq_head;	/* ready notes */
+	LIST_HEAD(, rtems_bsdnet_knote) kq_knotes;	/* all notes */
+	int		kq_count;	/* number of ready notes */
+	int		kq_state;
+#define	KQ_CLOSING	0x01		/* close while a task waits */
+	rtems_id	kq_waiter;	/* task waiting in kevent() */
+};
+
+struct rtems_bsdnet_knote {
+	TAILQ_ENTRY(rtems_bsdnet_knote) kn_tqe;		/* for kq_head */
+	LIST_ENTRY(rtems_bsdnet_knote) kn_kqlink;	/* for kq_knotes */
+	LIST_ENTRY(rtems_bsdnet_knote) kn_solink;	/* for so_knotes */
+	struct rtems_bsdnet_kqueue *kn_kq;
+	struct socket	*kn_so;
+	struct kevent	kn_kevent;
+	int		kn_status;
+#define	KN_QUEUED	0x01		/* note is on ready queue */
+#define	KN_DISABLED	0x02		/* note is disabled */
+};
+
+#define	kn_udata	kn_kevent.udata
+
+static const rtems_filesystem_file_handlers_r kqueue_handlers;
+
+/*
+ * Check the filter condition of a note and fill in the event to report.
+ */
+static int
+knote_ready (struct rtems_bsdnet_knote *kn, struct kevent *kev)
+{
+	struct socket *so = kn->kn_so;
+	int ready;
+
+	*kev = kn->kn_kevent;
+	kev->flags &= ~(EV_ADD | EV_ENABLE | EV_DISABLE | EV_RECEIPT);
+	kev->fflags = 0;
+
+	if (kn->kn_filter == EVFILT_READ) {
+		if (so->so_options & SO_ACCEPTCONN) {
+			kev->data = so->so_qlen - so->so_incqlen;
+			return (!TAILQ_EMPTY(&so->so_comp));
+		}
+		kev->data = so->so_rcv.sb_cc;
+		ready = soreadable(so);
+		if (so->so_state & SS_CANTRCVMORE) {
+			kev->flags |= EV_EOF;
+			kev->fflags = so->so_error;
+		}
+	} else {
+		kev->data = sbspace(&so->so_snd);
+		ready = sowriteable(so);
+		if (so->so_state & SS_CANTSENDMORE) {
+			kev->flags |= EV_EOF;
+			kev->fflags = so->so_error;
+		}
+	}
+	return (ready);
+}
+
+static void
+knote_enqueue (struct rtems_bsdnet_knote *kn)
+{
+	struct rtems_bsdnet_kqueue *kq = kn->kn_kq;
+
+	TAILQ_INSERT_TAIL(&kq->kq_head, kn, kn_tqe);
+	kn->kn_status |= KN_QUEUED;
+	++kq->kq_count;
+	if (kq->kq_waiter != 0)
+		rtems_event_system_send (kq->kq_waiter, SBWAIT_EVENT);
+}
+
+static void
+knote_dequeue (struct rtems_bsdnet_knote *kn)
+{
+	struct rtems_bsdnet_kqueue *kq = kn->kn_kq;
+
+	TAILQ_REMOVE(&kq->kq_head, kn, kn_tqe);
+	kn->kn_status &= ~KN_QUEUED;
+	--kq->kq_count;
+}
+
+static void
+knote_activate (struct rtems_bsdnet_knote *kn)
+{
+	struct kevent kev;
+
+	if ((kn->kn_status & (KN_QUEUED | KN_DISABLED)) == 0 &&
+	    knote_ready (kn, &kev))
+		knote_enqueue (kn);
+}
+
+static void
+knote_drop (struct rtems_bsdnet_knote *kn)
+{
+	if (kn->kn_status & KN_QUEUED)
+		knote_dequeue (kn);
+	LIST_REMOVE(kn, kn_kqlink);
+	LIST_REMOVE(kn, kn_solink);
+	FREE(kn, M_FILE);
+}
+
+/*
+ * Called by sowakeup() if notes are registered for the socket.
+ */
+void
+rtems_bsdnet_knote_wakeup (struct socket *so, struct sockbuf *sb)
+{
+	struct rtems_bsdnet_knote *kn;
+	short filter = (sb == &so->so_rcv) ? EVFILT_READ : EVFILT_WRITE;
+
+	LIST_FOREACH(kn, &so->so_knotes, kn_solink) {
+		if (kn->kn_filter == filter)
+			knote_activate (kn);
+	}
+}
+
+/*
+ * Called by soclose() to remove all notes of the socket.
+ */
+void
+rtems_bsdnet_knote_close (struct socket *so)
+{
+	struct rtems_bsdnet_knote *kn;
+
+	while ((kn = LIST_FIRST(&so->so_knotes)) != NULL)
+		knote_drop (kn);
+}
+
+static int
+kqueue_register (struct rtems_bsdnet_kqueue *kq, const struct kevent *kev)
+{
+	struct rtems_bsdnet_knote *kn;
+	struct socket *so;
+
+	if (kev->filter != EVFILT_READ && kev->filter != EVFILT_WRITE)
+		return (EINVAL);
+	if ((so = rtems_bsdnet_fdToSocket (kev->ident)) == NULL)
+		return (errno);
+
+	LIST_FOREACH(kn, &so->so_knotes, kn_solink) {
+		if (kn->kn_kq == kq && kn->kn_filter == kev->filter)
+			break;
+	}
+
+	if (kn == NULL) {
+		if ((kev->flags & EV_ADD) == 0)
+			return (ENOENT);
+		MALLOC(kn, struct rtems_bsdnet_knote *, sizeof(*kn), M_FILE,
+		    M_NOWAIT);
+		if (kn == NULL)
+			return (ENOMEM);
+		memset(kn, 0, sizeof(*kn));
+		kn->kn_kq = kq;
+		kn->kn_so = so;
+		kn->kn_id = kev->ident;
+		kn->kn_filter = kev->filter;
+		LIST_INSERT_HEAD(&kq->kq_knotes, kn, kn_kqlink);
+		LIST_INSERT_HEAD(&so->so_knotes, kn, kn_solink);
+	} else if (kev->flags & EV_DELETE) {
+		knote_drop (kn);
+		return (0);
+	}
+
+	if (kev->flags & EV_ADD) {
+		kn->kn_flags = kev->flags & (EV_ONESHOT | EV_CLEAR | EV_DISPATCH);
+		kn->kn_udata = kev->udata;
+	}
+
+	if (kev->flags & EV_DISABLE) {
+		kn->kn_status |= KN_DISABLED;
+		if (kn->kn_status & KN_QUEUED)
+			knote_dequeue (kn);
+	} else if (kev->flags & (EV_ADD | EV_ENABLE)) {
+		kn->kn_status &= ~KN_DISABLED;
+	}
+
+	knote_activate (kn);
+	return (0);
+}
+
+/*
+ * Move the ready events to the event list.  Level-triggered notes which are
+ * still ready go back to the end of the ready queue, so each note present at
+ * the start is looked at once.
+ */
+static int
+kqueue_scan (struct rtems_bsdnet_kqueue *kq, struct kevent *eventlist,
+    int nevents)
+{
+	struct rtems_bsdnet_knote *kn;
+	int count = kq->kq_count;
+	int n = 0;
+
+	while (count > 0 && n < nevents) {
+		--count;
+		kn = TAILQ_FIRST(&kq->kq_head);
+		knote_dequeue (kn);
+		if (!knote_ready (kn, &eventlist[n]))
+			continue;
+		++n;
+		if (kn->kn_flags & EV_ONESHOT)
+			knote_drop (kn);
+		else if (kn->kn_flags & EV_DISPATCH)
+			kn->kn_status |= KN_DISABLED;
+		else if ((kn->kn_flags & EV_CLEAR) == 0)
+			knote_enqueue (kn);
+	}
+	return (n);
+}
+
+static struct rtems_bsdnet_kqueue *
+rtems_bsdnet_fdToKqueue (int fd)
+{
+	rtems_libio_t *iop;
+
+	if ((uint32_t)fd >= rtems_libio_iop_get_table_size())
+		return NULL;
+	iop = rtems_libio_iop(fd);
+	if ((rtems_libio_iop_flags(iop) & LIBIO_FLAGS_OPEN) == 0 ||
+	    iop->pathinfo.handlers != &kqueue_handlers)
+		return NULL;
+	return iop->data1;
+}
+
+static void
+kqueue_free (struct rtems_bsdnet_kqueue *kq)
+{
+	struct rtems_bsdnet_knote *kn;
+
+	while ((kn = LIST_FIRST(&kq->kq_knotes)) != NULL)
+		knote_drop (kn);
+	FREE(kq, M_FILE);
+}
+
+/*
+ *********************************************************************
+ *                       BSD-style entry points                      *
+ *********************************************************************
+ */
+int
+kqueue (void)
+{
+	struct rtems_bsdnet_kqueue *kq;
+	rtems_libio_t *iop;
+	int fd;
+
+	MALLOC(kq, struct rtems_bsdnet_kqueue *, sizeof(*kq), M_FILE, M_NOWAIT);
+	if (kq == NULL) {
+		errno = ENOMEM;
+		return -1;
+	}
+	memset(kq, 0, sizeof(*kq));
+	TAILQ_INIT(&kq->kq_head);
+	LIST_INIT(&kq->kq_knotes);
+
+	iop = rtems_libio_allocate();
+	if (iop == 0) {
+		FREE(kq, M_FILE);
+		rtems_set_errno_and_return_minus_one( ENFILE );
+	}
+
+	fd = rtems_libio_iop_to_descriptor(iop);
+	iop->data0 = fd;
+	iop->data1 = kq;
+	iop->pathinfo.handlers = &kqueue_handlers;
+	iop->pathinfo.mt_entry = &rtems_filesystem_null_mt_entry;
+	rtems_filesystem_location_add_to_mt_entry(&iop->pathinfo);
+	rtems_libio_iop_flags_initialize(iop, LIBIO_FLAGS_READ_WRITE);
+	return fd;
+}
+
+int
+kevent (int fd, const struct kevent *changelist, int nchanges,
+    struct kevent *eventlist, int nevents, const struct timespec *timeout)
+{
+	struct rtems_bsdnet_kqueue *kq;
+	rtems_interval then = 0, now;
+	rtems_event_set in = SBWAIT_EVENT | RTEMS_EVENT_SYSTEM_NETWORK_CLOSE;
+	rtems_event_set out;
+	int timo = 0;
+	bool poll = false;
+	int error = 0;
+	int n = 0;
+	int i;
+
+	if (nchanges < 0 || nevents < 0) {
+		errno = EINVAL;
+		return -1;
+	}
+	if (timeout) {
+		if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+		    timeout->tv_nsec >= 1000000000) {
+			errno = EINVAL;
+			return -1;
+		}
+		if (timeout->tv_sec == 0 && timeout->tv_nsec == 0) {
+			poll = true;
+		} else {
+			timo = timeout->tv_sec * hz +
+			    timeout->tv_nsec / (tick * 1000);
+			if (timo == 0)
+				timo = 1;
+			then = rtems_clock_get_ticks_since_boot();
+		}
+	}
+
+	rtems_bsdnet_semaphore_obtain ();
+	if ((kq = rtems_bsdnet_fdToKqueue (fd)) == NULL) {
+		rtems_bsdnet_semaphore_release ();
+		errno = EBADF;
+		return -1;
+	}
+
+	for (i = 0; i < nchanges; ++i) {
+		struct kevent kev = changelist[i];
+
+		error = kqueue_register (kq, &kev);
+		if (error || (kev.flags & EV_RECEIPT)) {
+			if (n >= nevents)
+				break;
+			kev.flags = EV_ERROR;
+			kev.data = error;
+			eventlist[n] = kev;
+			++n;
+			error = 0;
+		}
+	}
+
+	if (error == 0 && n == 0) {
+		rtems_event_system_receive (in, RTEMS_EVENT_ANY | RTEMS_NO_WAIT, RTEMS_NO_TIMEOUT, &out);
+		for (;;) {
+			n = kqueue_scan (kq, eventlist, nevents);
+			if (n > 0 || nevents == 0 || poll)
+				break;
+			if (timo) {
+				now = rtems_clock_get_ticks_since_boot();
+				timo -= now - then;
+				if (timo <= 0)
+					break;
+				then = now;
+			}
+			kq->kq_waiter = rtems_task_self();
+			rtems_bsdnet_semaphore_release ();
+			rtems_event_system_receive (in, RTEMS_EVENT_ANY | RTEMS_WAIT, timo, &out);
+			rtems_bsdnet_semaphore_obtain ();
+			kq->kq_waiter = 0;
+			if (kq->kq_state & KQ_CLOSING) {
+				kqueue_free (kq);
+				error = EBADF;
+				break;
+			}
+		}
+	}
+	rtems_bsdnet_semaphore_release ();
+
+	if (error) {
+		errno = error;
+		return -1;
+	}
+	return n;
+}
+
+/*
+ ************************************************************************
+ *                      RTEMS I/O HANDLER ROUTINES                      *
+ ************************************************************************
+ */
+static int
+rtems_bsdnet_kqueue_close (rtems_libio_t *iop)
+{
+	struct rtems_bsdnet_kqueue *kq;
+
+	rtems_bsdnet_semaphore_obtain ();
+	kq = iop->data1;
+	iop->data1 = NULL;
+	if (kq->kq_waiter != 0) {
+		/* The waiting task frees the kqueue */
+		kq->kq_state |= KQ_CLOSING;
+		rtems_event_system_send (kq->kq_waiter,
+		    RTEMS_EVENT_SYSTEM_NETWORK_CLOSE);
+	} else {
+		kqueue_free (kq);
+	}
+	rtems_bsdnet_semaphore_release ();
+	return 0;
+}
+
+static int
+rtems_bsdnet_kqueue_fstat (const rtems_filesystem_location_info_t *loc,
+    struct stat *sp)
+{
+	sp->st_mode = S_IFIFO | S_IRUSR | S_IWUSR;
+	return 0;
+}
+
+static const rtems_filesystem_file_handlers_r kqueue_handlers = {
+	.open_h = rtems_filesystem_default_open,
+	.close_h = rtems_bsdnet_kqueue_close,
+	.read_h = rtems_filesystem_default_read,
+	.write_h = rtems_filesystem_default_write,
+	.ioctl_h = rtems_filesystem_default_ioctl,
+	.lseek_h = rtems_filesystem_default_lseek,
+	.fstat_h = rtems_bsdnet_kqueue_fstat,
+	.ftruncate_h = rtems_filesystem_default_ftruncate,
+	.fsync_h = rtems_filesystem_default_fsync_or_fdatasync,
+	.fdatasync_h = rtems_filesystem_default_fsync_or_fdatasync,
+	.fcntl_h = rtems_filesystem_default_fcntl,
+	.kqfilter_h = rtems_filesystem_default_kqfilter,
+	.mmap_h = rtems_filesystem_default_mmap,
+	.poll_h = rtems_filesystem_default_poll,
+	.readv_h = rtems_filesystem_default_readv,
+	.writev_h = rtems_filesystem_default_writev
+};
@@ -0,0 +1,368 @@
+#include <machine/rtems-bsd-kernel-space.h>
+
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rtems.h>
+#include <rtems/counter.h>
+#include <rtems/rtems_bsdnet.h>
+#include <sys/param.h>
+#include <sys/queue.h>
+#include <sys/systm.h>
+#include <sys/mbuf.h>
+
+/*
+ * The initial mbuf and cluster pools are allocated once during the network
+ * initialization.  If they run out, then additional chunks are allocated from
+ * the heap up to the configured maximum.  Chunks which are completely free
+ * are returned to the heap, if the pools did not grow for a trim interval.
+ *
+ * The first mbuf or cluster of a chunk contains the chunk header.  All
+ * allocations are protected by the network semaphore.
+ */
+
+#define	MB_CHUNK_SIZE		4096
+#define	MB_CHUNK_MBUFS		(MB_CHUNK_SIZE / _SYS_MBUF_LEGACY_MSIZE)
+
+#define	MCL_CHUNK_CLUSTERS	(MCL_CHUNK_SIZE / MCLBYTES)
+
+#define	MBPOOL_TRIM_INTERVAL	5	/* seconds */
+
+struct mb_chunk {
+	LIST_ENTRY(mb_chunk) mc_link;
+	u_int	mc_free;
+};
+
+struct mcl_chunk {
+	/* Must be the first member, see MCLREFCNT() */
+	char	mc_refcnt[MCL_CHUNK_CLUSTERS];
+	LIST_ENTRY(mcl_chunk) mc_link;
+	u_int	mc_free;
+};
+
+static LIST_HEAD(, mb_chunk) mb_chunks = LIST_HEAD_INITIALIZER(mb_chunks);
+static LIST_HEAD(, mcl_chunk) mcl_chunks = LIST_HEAD_INITIALIZER(mcl_chunks);
+
+static uintptr_t mb_begin;
+static uintptr_t mb_end;
+static int mbpool_grown;
+
+static void mbpool_trim(void *arg);
+
+static struct mb_chunk *
+mb_chunk_of(const struct mbuf *m)
+{
+	uintptr_t p = (uintptr_t)m;
+
+	if (p >= mb_begin && p < mb_end)
+		return NULL;
+	return (struct mb_chunk *)(p & ~(uintptr_t)(MB_CHUNK_SIZE - 1));
+}
+
+static struct mcl_chunk *
+mcl_chunk_of(const union mcluster *cl)
+{
+	if (mtocl(cl) < nmbclusters)
+		return NULL;
+	return (struct mcl_chunk *)
+	    ((uintptr_t)cl & ~(uintptr_t)(MCL_CHUNK_SIZE - 1));
+}
+
+/*
+ * Add a chunk of mbufs to the free list
+ */
+static int
+mb_grow(void)
+{
+	struct mb_chunk *c;
+	char *p;
+	int i;
+
+	if (mbstat.m_mbufs + MB_CHUNK_MBUFS - 1 > mbpoolstat.mp_mbmax)
+		return 0;
+	if (posix_memalign((void **)&c, MB_CHUNK_SIZE, MB_CHUNK_SIZE) != 0)
+		return 0;
+	LIST_INSERT_HEAD(&mb_chunks, c, mc_link);
+	p = (char *)c;
+	for (i = 1; i < MB_CHUNK_MBUFS; i++) {
+		p += _SYS_MBUF_LEGACY_MSIZE;
+		((struct mbuf *)p)->m_type = MT_FREE;
+		((struct mbuf *)p)->m_next = mmbfree;
+		mmbfree = (struct mbuf *)p;
+	}
+	mbstat.m_mbufs += MB_CHUNK_MBUFS - 1;
+	mbstat.m_mtypes[MT_FREE] += MB_CHUNK_MBUFS - 1;
+	mbpoolstat.mp_mbgrow++;
+	mbpool_grown = 1;
+	return 1;
+}
+
+/*
+ * Add a chunk of clusters to the free list
+ */
+static int
+mcl_grow(void)
+{
+	struct mcl_chunk *c;
+	char *p;
+	int i;
+
+	if (mbstat.m_clusters + MCL_CHUNK_CLUSTERS - 1 > mbpoolstat.mp_clmax)
+		return 0;
+	if (posix_memalign((void **)&c, MCL_CHUNK_SIZE, MCL_CHUNK_SIZE) != 0)
+		return 0;
+	memset(c->mc_refcnt, 0, sizeof(c->mc_refcnt));
+	LIST_INSERT_HEAD(&mcl_chunks, c, mc_link);
+	p = (char *)c;
+	for (i = 1; i < MCL_CHUNK_CLUSTERS; i++) {
+		p += MCLBYTES;
+		((union mcluster *)p)->mcl_next = mclfree;
+		mclfree = (union mcluster *)p;
+	}
+	mbstat.m_clusters += MCL_CHUNK_CLUSTERS - 1;
+	mbstat.m_clfree += MCL_CHUNK_CLUSTERS - 1;
+	mbpoolstat.mp_clgrow++;
+	mbpool_grown = 1;
+	return 1;
+}
+
+/*
+ * Free the mbuf chunks which contain only free mbufs
+ */
+static void
+mb_shrink(void)
+{
+	struct mb_chunk *c, *next;
+	struct mbuf **mp, *m;
+	int release = 0;
+
+	LIST_FOREACH(c, &mb_chunks, mc_link)
+		c->mc_free = 0;
+	for (m = mmbfree; m != NULL; m = m->m_next) {
+		c = mb_chunk_of(m);
+		if (c != NULL && ++c->mc_free == MB_CHUNK_MBUFS - 1)
+			release = 1;
+	}
+	if (!release)
+		return;
+	for (mp = &mmbfree; (m = *mp) != NULL; ) {
+		c = mb_chunk_of(m);
+		if (c != NULL && c->mc_free == MB_CHUNK_MBUFS - 1)
+			*mp = m->m_next;
+		else
+			mp = &m->m_next;
+	}
+	for (c = LIST_FIRST(&mb_chunks); c != NULL; c = next) {
+		next = LIST_NEXT(c, mc_link);
+		if (c->mc_free == MB_CHUNK_MBUFS - 1) {
+			LIST_REMOVE(c, mc_link);
+			free(c);
+			mbstat.m_mbufs -= MB_CHUNK_MBUFS - 1;
+			mbstat.m_mtypes[MT_FREE] -= MB_CHUNK_MBUFS - 1;
+			mbpoolstat.mp_mbshrink++;
+		}
+	}
+}
+
+/*
+ * Free the cluster chunks which contain only free clusters
+ */
+static void
+mcl_shrink(void)
+{
+	struct mcl_chunk *c, *next;
+	union mcluster **clp, *cl;
+	int release = 0;
+
+	LIST_FOREACH(c, &mcl_chunks, mc_link)
+		c->mc_free = 0;
+	for (cl = mclfree; cl != NULL; cl = cl->mcl_next) {
+		c = mcl_chunk_of(cl);
+		if (c != NULL && ++c->mc_free == MCL_CHUNK_CLUSTERS - 1)
+			release = 1;
+	}
+	if (!release)
+		return;
+	for (clp = &mclfree; (cl = *clp) != NULL; ) {
+		c = mcl_chunk_of(cl);
+		if (c != NULL && c->mc_free == MCL_CHUNK_CLUSTERS - 1)
+			*clp = cl->mcl_next;
+		else
+			clp = &cl->mcl_next;
+	}
+	for (c = LIST_FIRST(&mcl_chunks); c != NULL; c = next) {
+		next = LIST_NEXT(c, mc_link);
+		if (c->mc_free == MCL_CHUNK_CLUSTERS - 1) {
+			LIST_REMOVE(c, mc_link);
+			free(c);
+			mbstat.m_clusters -= MCL_CHUNK_CLUSTERS - 1;
+			mbstat.m_clfree -= MCL_CHUNK_CLUSTERS - 1;
+			mbpoolstat.mp_clshrink++;
+		}
+	}
+}
+
+/*
+ * Return the chunks to the heap if the pools did not grow during the last
+ * trim interval
+ */
+static void
+mbpool_trim(void *arg)
+{
+	(void)arg;
+
+	if (!mbpool_grown) {
+		mb_shrink();
+		mcl_shrink();
+	}
+	mbpool_grown = 0;
+	timeout(mbpool_trim, NULL,
+	    MBPOOL_TRIM_INTERVAL * rtems_bsdnet_ticks_per_second);
+}
+
+/*
+ * Set up the dynamic pools.  The initial mbufs are in [begin, end).
+ */
+void
+rtems_bsdnet_mbpool_initialize(void *begin, void *end)
+{
+	unsigned long max;
+
+	mb_begin = (uintptr_t)begin;
+	mb_end = (uintptr_t)end;
+
+	/* The free mbuf count must fit into mbstat.m_mtypes[MT_FREE] */
+	max = rtems_bsdnet_config.mbuf_max_bytecount / _SYS_MBUF_LEGACY_MSIZE;
+	if (max > USHRT_MAX)
+		max = USHRT_MAX;
+	if (max < mbstat.m_mbufs)
+		max = mbstat.m_mbufs;
+	mbpoolstat.mp_mbmax = max;
+
+	max = rtems_bsdnet_config.mbuf_cluster_max_bytecount / MCLBYTES;
+	if (max < mbstat.m_clusters)
+		max = mbstat.m_clusters;
+	mbpoolstat.mp_clmax = max;
+
+	if (mbpoolstat.mp_mbmax > mbstat.m_mbufs ||
+	    mbpoolstat.mp_clmax > mbstat.m_clusters)
+		timeout(mbpool_trim, NULL,
+		    MBPOOL_TRIM_INTERVAL * rtems_bsdnet_ticks_per_second);
+}
+
+static void
+mbpool_slow_done(rtems_counter_ticks start)
+{
+	uint32_t ns;
+
+	ns = (uint32_t)rtems_counter_ticks_to_nanoseconds(
+	    rtems_counter_difference(rtems_counter_read(), start));
+	mbpoolstat.mp_slow++;
+	mbpoolstat.mp_slowtotal += ns;
+	if (ns > mbpoolstat.mp_slowmax)
+		mbpoolstat.mp_slowmax = ns;
+}
+
+/*
+ * Handle requests for more network memory
+ * XXX: Another possibility would be to use a semaphore here with
+ *      a release in the mbuf free macro.  I have chosen this `polling'
+ *      approach because:
+ *      1) It is simpler.
+ *      2) It adds no complexity to the free macro.
+ *      3) Running out of mbufs should be a rare
+ *         condition -- predeployment testing of
+ *         an application should indicate the
+ *         required mbuf pool size.
+ * XXX: Should there be a panic if a task is stuck in the loop for
+ *      more than a minute or so?
+ */
+int
+m_mballoc(int nmb, int nowait)
+{
+	rtems_counter_ticks start = rtems_counter_read();
+
+	if (mb_grow()) {
+		mbpool_slow_done(start);
+		return 1;
+	}
+	if (nowait) {
+		mbpool_slow_done(start);
+		return 0;
+	}
+	m_reclaim ();
+	if (mmbfree == NULL) {
+		int try = 0;
+		int print_limit = 30 * rtems_bsdnet_ticks_per_second;
+
+		mbstat.m_wait++;
+		for (;;) {
+			uint32_t nest_count = rtems_bsdnet_semaphore_release_recursive ();
+			rtems_task_wake_after (1);
+			rtems_bsdnet_semaphore_obtain_recursive (nest_count);
+			if (mmbfree)
+				break;
+			if (++try >= print_limit) {
+				printf ("Still waiting for mbuf.\n");
+				try = 0;
+			}
+		}
+	}
+	else {
+		mbstat.m_drops++;
+	}
+	mbpool_slow_done(start);
+	return 1;
+}
+
+int
+m_clalloc(int ncl, int nowait)
+{
+	rtems_counter_ticks start = rtems_counter_read();
+
+	if (mcl_grow()) {
+		mbpool_slow_done(start);
+		return 1;
+	}
+	if (nowait) {
+		mbpool_slow_done(start);
+		return 0;
+	}
+	m_reclaim ();
+	if (mclfree == NULL) {
+		int try = 0;
+		int print_limit = 30 * rtems_bsdnet_ticks_per_second;
+
+		mbstat.m_wait++;
+		for (;;) {
+			uint32_t nest_count = rtems_bsdnet_semaphore_release_recursive ();
+			rtems_task_wake_after (1);
+			rtems_bsdnet_semaphore_obtain_recursive (nest_count);
+			if (mclfree)
+				break;
+			if (++try >= print_limit) {
+				printf ("Still waiting for mbuf cluster.\n");
+				try = 0;
+			}
+		}
+	}
+	else {
+		mbstat.m_drops++;
+	}
+	mbpool_slow_done(start);
+	return 1;
+}
@@ -49,6 +49,8 @@ extern "C" {
 #define IPCTL_RTMAXCACHE	7	/* trigger level for dynamic expire */
 
 int	 in_cksum(struct mbuf *, int);
+u_int	 in_cksum_add(u_int, u_int, int);
+u_int	 in_cksum_copy(const void *, void *, int);
 
 /* Firewall hooks */
 struct ip;
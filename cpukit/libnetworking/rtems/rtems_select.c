@@ -10,7 +10,7 @@
 #include <stdio.h>
 
 #include <rtems.h>
-#include <rtems/libio.h>
+#include <rtems/libio_.h>
 #include <rtems/error.h>
 #include <rtems/rtems_bsdnet.h>
 
@@ -117,7 +117,9 @@ select (int nfds, fd_set *__restrict readfds, fd_set *__restrict writefds,
         fd_set *__restrict exceptfds, struct timeval *__restrict tv)
 {
 	fd_mask *ibits[3], *obits[3];
-	fd_set ob[3];
+	fd_mask s_selbits[3 * howmany(FD_SETSIZE, NFDBITS)];
+	fd_mask *selbits;
+	u_int nfdbits, nbufbytes;
 	int error, timo;
 	int retval = 0;
 	rtems_id tid;
@@ -127,6 +129,8 @@ select (int nfds, fd_set *__restrict readfds, fd_set *__restrict writefds,
 
 	if (nfds < 0)
 		return (EINVAL);
+	if ((u_int)nfds > rtems_libio_iop_get_table_size())
+		nfds = rtems_libio_iop_get_table_size();
 	if (tv) {
 		timo = tv->tv_sec * hz + tv->tv_usec / tick;
 		if (timo == 0)
@@ -137,10 +141,27 @@ select (int nfds, fd_set *__restrict readfds, fd_set *__restrict writefds,
 		timo = 0;
 	}
 
+	/*
+	 * The caller may pass sets larger than an fd_set, so the result bits
+	 * are sized by nfds.  Use the stack for the common case.
+	 */
+	nfdbits = howmany(nfds, NFDBITS);
+	nbufbytes = 3 * nfdbits * sizeof(fd_mask);
+	if (nbufbytes <= sizeof(s_selbits)) {
+		selbits = &s_selbits[0];
+	}
+	else {
+		MALLOC(selbits, fd_mask *, nbufbytes, M_SELECT, M_NOWAIT);
+		if (selbits == NULL) {
+			errno = ENOMEM;
+			return (-1);
+		}
+	}
+
 #define getbits(name,i) if (name) { \
 		ibits[i] = &name->fds_bits[0]; \
-		obits[i] = &ob[i].fds_bits[0]; \
-		FD_ZERO(&ob[i]); \
+		obits[i] = &selbits[(i) * nfdbits]; \
+		memset(obits[i], 0, nfdbits * sizeof(fd_mask)); \
 	} \
 	else ibits[i] = NULL
 	getbits (readfds, 0);
@@ -166,11 +187,14 @@ select (int nfds, fd_set *__restrict readfds, fd_set *__restrict writefds,
 		rtems_event_system_receive (in, RTEMS_EVENT_ANY | RTEMS_WAIT, timo, &out);
 	}
 
-#define putbits(name,i) if (name) *name = ob[i]
+#define putbits(name,i) if (name) \
+		memcpy(&name->fds_bits[0], obits[i], nfdbits * sizeof(fd_mask))
 	putbits (readfds, 0);
 	putbits (writefds, 1);
 	putbits (exceptfds, 2);
 #undef putbits
+	if (selbits != &s_selbits[0])
+		FREE(selbits, M_SELECT);
 	if (error) {
 		errno = error;
 		retval = -1;
@@ -4,6 +4,8 @@
 #include "config.h"
 #endif
 
+#include <inttypes.h>
+
 #include <sys/param.h>
 #include <sys/queue.h>
 #include <sys/systm.h>
@@ -31,6 +33,17 @@ rtems_bsdnet_show_mbuf_stats (void)
 			mbstat.m_mbufs, mbstat.m_clusters, mbstat.m_clfree);
 	printf ("drops:%4lu       waits:%4lu  drains:%4lu\n",
 			mbstat.m_drops, mbstat.m_wait, mbstat.m_drain);
+	printf ("mbuf max:%4lu  high water:%4lu    grow:%4lu  shrink:%4lu\n",
+			mbpoolstat.mp_mbmax, mbpoolstat.mp_mbhiwat,
+			mbpoolstat.mp_mbgrow, mbpoolstat.mp_mbshrink);
+	printf ("cluster max:%4lu  high water:%4lu    grow:%4lu  shrink:%4lu\n",
+			mbpoolstat.mp_clmax, mbpoolstat.mp_clhiwat,
+			mbpoolstat.mp_clgrow, mbpoolstat.mp_clshrink);
+	printf ("slow allocations:%4lu  mean:%8" PRIu64 "ns  max:%8" PRIu32 "ns\n",
+			mbpoolstat.mp_slow,
+			mbpoolstat.mp_slow != 0 ?
+			    mbpoolstat.mp_slowtotal / mbpoolstat.mp_slow : 0,
+			mbpoolstat.mp_slowmax);
 	for (i = 0 ; i < 20 ; i++) {
 		switch (i) {
 		case MT_FREE:		cp = "free";		break;
@@ -9,6 +9,7 @@
 /* #include <stdlib.h> */
 #include <stdio.h>
 #include <errno.h>
+#include <unistd.h>
 
 #include <rtems.h>
 #include <rtems/libio_.h>
@@ -46,7 +47,7 @@ rtems_bsdnet_fdToSocket (int fd)
 {
   rtems_libio_t *iop;
 
-  if ((uint32_t)fd >= rtems_libio_number_iops) {
+  if ((uint32_t)fd >= rtems_libio_iop_get_table_size()) {
     errno = EBADF;
     return NULL;
   }
@@ -426,6 +427,189 @@ sendto (int s, const void *buf, size_t buflen, int flags, const struct sockaddr
 	return sendmsg (s, &msg, flags);
 }
 
+/*
+ * Send the headers or trailers of sendfile()
+ */
+static int
+sendfile_iov (int s, struct iovec *iov, int iovcnt, off_t *sent)
+{
+	struct msghdr msg;
+	ssize_t n;
+
+	if (iov == NULL || iovcnt <= 0)
+		return 0;
+	memset (&msg, 0, sizeof msg);
+	msg.msg_iov = iov;
+	msg.msg_iovlen = iovcnt;
+	n = sendmsg (s, &msg, 0);
+	if (n < 0)
+		return -1;
+	*sent += n;
+	return 0;
+}
+
+/*
+ * Get a chain of mbufs (preferably clusters) for up to len bytes of file
+ * data.  The caller must hold the network semaphore.
+ */
+static struct mbuf *
+sendfile_mbufs (long len)
+{
+	struct mbuf *top = NULL;
+	struct mbuf **mp = &top;
+	struct mbuf *m;
+	long mlen;
+
+	while (len > 0) {
+		if (top == NULL) {
+			MGETHDR(m, M_WAIT, MT_DATA);
+			mlen = MHLEN;
+			m->m_pkthdr.len = 0;
+			m->m_pkthdr.rcvif = (struct ifnet *)0;
+		} else {
+			MGET(m, M_WAIT, MT_DATA);
+			mlen = MLEN;
+		}
+		if (len >= MINCLSIZE) {
+			MCLGET(m, M_WAIT);
+			if (m->m_flags & M_EXT)
+				mlen = MCLBYTES;
+		}
+		m->m_len = min(mlen, len);
+		top->m_pkthdr.len += m->m_len;
+		len -= m->m_len;
+		*mp = m;
+		mp = &m->m_next;
+	}
+	return top;
+}
+
+/*
+ * Send a file to a stream socket.  The file data is read directly into the
+ * socket mbufs, so there is no intermediate user buffer.  A nbytes value of
+ * zero means send until the end of file.  The file offset is not changed.
+ */
+int
+sendfile (int fd, int s, off_t offset, size_t nbytes, struct sf_hdtr *hdtr,
+    off_t *sbytes, int flags)
+{
+	struct socket *so;
+	struct mbuf *top;
+	struct mbuf *m;
+	off_t sent = 0;
+	off_t remaining = nbytes;
+	long chunk;
+	long len;
+	ssize_t n;
+	int error = 0;
+
+	(void) flags;
+
+	if (sbytes != NULL)
+		*sbytes = 0;
+	if (offset < 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	rtems_bsdnet_semaphore_obtain ();
+	if ((so = rtems_bsdnet_fdToSocket (s)) == NULL) {
+		rtems_bsdnet_semaphore_release ();
+		return -1;
+	}
+	if (so->so_type != SOCK_STREAM) {
+		rtems_bsdnet_semaphore_release ();
+		errno = EINVAL;
+		return -1;
+	}
+	if ((so->so_state & SS_ISCONNECTED) == 0) {
+		rtems_bsdnet_semaphore_release ();
+		errno = ENOTCONN;
+		return -1;
+	}
+	rtems_bsdnet_semaphore_release ();
+
+	if (hdtr != NULL &&
+	    sendfile_iov (s, hdtr->headers, hdtr->hdr_cnt, &sent) != 0) {
+		error = errno;
+		goto done;
+	}
+
+	while (nbytes == 0 || remaining > 0) {
+		rtems_bsdnet_semaphore_obtain ();
+		if ((so = rtems_bsdnet_fdToSocket (s)) == NULL) {
+			rtems_bsdnet_semaphore_release ();
+			error = errno;
+			goto done;
+		}
+
+		/*
+		 * The mbuf chain is passed to sosend() as a whole, so it must
+		 * fit into the send buffer.
+		 */
+		chunk = so->so_snd.sb_hiwat;
+		if (nbytes != 0 && remaining < chunk)
+			chunk = (long) remaining;
+		top = sendfile_mbufs (chunk);
+		rtems_bsdnet_semaphore_release ();
+
+		/*
+		 * Read the file data without the network semaphore since this
+		 * may block for a long time.
+		 */
+		len = 0;
+		for (m = top; m != NULL; m = m->m_next) {
+			n = pread (fd, mtod(m, caddr_t), m->m_len, offset + len);
+			if (n < 0) {
+				error = errno;
+				break;
+			}
+			len += n;
+			if (n < m->m_len)
+				break;
+		}
+
+		rtems_bsdnet_semaphore_obtain ();
+		if (error != 0 || len == 0) {
+			m_freem (top);
+			rtems_bsdnet_semaphore_release ();
+			if (error != 0)
+				goto done;
+			break;
+		}
+		if (len < chunk)
+			m_adj (top, len - chunk);
+		if ((so = rtems_bsdnet_fdToSocket (s)) == NULL) {
+			m_freem (top);
+			rtems_bsdnet_semaphore_release ();
+			error = errno;
+			goto done;
+		}
+		error = sosend (so, NULL, NULL, top, NULL, 0);
+		rtems_bsdnet_semaphore_release ();
+		if (error != 0)
+			goto done;
+		sent += len;
+		offset += len;
+		remaining -= len;
+		if (len < chunk)
+			break;
+	}
+
+	if (hdtr != NULL &&
+	    sendfile_iov (s, hdtr->trailers, hdtr->trl_cnt, &sent) != 0)
+		error = errno;
+
+done:
+	if (sbytes != NULL)
+		*sbytes = sent;
+	if (error != 0) {
+		errno = error;
+		return -1;
+	}
+	return 0;
+}
+
 /*
  * All `receive' operations end up calling this routine.
  */
@@ -51,6 +51,8 @@ ssize_t	sendto(int, const void *, size_t, int, const struct sockaddr *, socklen_
 
 ssize_t	sendmsg(int, const struct msghdr *, int);
 
+int	sendfile(int, int, off_t, size_t, struct sf_hdtr *, off_t *, int);
+
 int	setsockopt(int, int, int, const void *, socklen_t);
 
 int	shutdown(int, int);
@@ -64,6 +64,20 @@
 #define	mtocl(x)	(((uintptr_t)(x) - (uintptr_t)mbutl) >> MCLSHIFT)
 #define	cltom(x)	((caddr_t)((u_long)mbutl + ((u_long)(x) << MCLSHIFT)))
 
+/*
+ * Clusters beyond the initial pool are allocated in chunks aligned to the
+ * chunk size.  The first cluster of a chunk starts with the reference counts
+ * of the chunk clusters.
+ *
+ * MCLREFCNT(x)	-- Reference count of the cluster containing x
+ */
+#define	MCL_CHUNK_SHIFT	15
+#define	MCL_CHUNK_SIZE	(1 << MCL_CHUNK_SHIFT)
+#define	MCLREFCNT(x) \
+	(*(mtocl(x) < nmbclusters ? &mclrefcnt[mtocl(x)] : \
+	    (char *)((uintptr_t)(x) & ~(uintptr_t)(MCL_CHUNK_SIZE - 1)) + \
+	    (((uintptr_t)(x) & (MCL_CHUNK_SIZE - 1)) >> MCLSHIFT)))
+
 /*
  * Header present at the beginning of every mbuf.
  */
@@ -82,6 +96,7 @@ struct m_hdr {
 struct	pkthdr {
 	struct	ifnet *rcvif;		/* rcv interface */
 	int32_t	len;			/* total packet length */
+	uint32_t csum_data;		/* partial data checksum */
 };
 
 /*
@@ -138,6 +153,7 @@ struct mbuf {
  */
 #define	M_BCAST		0x0100	/* send/received as link-level broadcast */
 #define	M_MCAST		0x0200	/* send/received as link-level multicast */
+#define	M_CSUM_DATA	0x0400	/* csum_data valid for the entire packet */
 
 /*
  * Flags copied when copying m_pkthdr.
@@ -177,6 +193,31 @@ struct mbstat {
 	u_short	m_mtypes[256];	/* type specific mbuf allocations */
 };
 
+/*
+ * Statistics of the dynamic mbuf and cluster pools.
+ */
+struct mbpoolstat {
+	u_long	mp_mbmax;	/* maximum number of mbufs */
+	u_long	mp_clmax;	/* maximum number of clusters */
+	u_long	mp_mbhiwat;	/* maximum number of mbufs in use */
+	u_long	mp_clhiwat;	/* maximum number of clusters in use */
+	u_long	mp_mbgrow;	/* mbuf chunks allocated */
+	u_long	mp_clgrow;	/* cluster chunks allocated */
+	u_long	mp_mbshrink;	/* mbuf chunks freed */
+	u_long	mp_clshrink;	/* cluster chunks freed */
+	u_long	mp_slow;	/* allocations which ran out of the pool */
+	uint32_t mp_slowmax;	/* maximum slow allocation time in ns */
+	uint64_t mp_slowtotal;	/* total slow allocation time in ns */
+};
+
+#define	MBPOOL_MBHIWAT() \
+	if (mbstat.m_mbufs - mbstat.m_mtypes[MT_FREE] > mbpoolstat.mp_mbhiwat) \
+		mbpoolstat.mp_mbhiwat = mbstat.m_mbufs - mbstat.m_mtypes[MT_FREE]
+
+#define	MBPOOL_CLHIWAT() \
+	if (mbstat.m_clusters - mbstat.m_clfree > mbpoolstat.mp_clhiwat) \
+		mbpoolstat.mp_clhiwat = mbstat.m_clusters - mbstat.m_clfree
+
 
 /* flags to m_get/MGET */
 #define	M_DONTWAIT	M_NOWAIT
@@ -223,6 +264,7 @@ union mcluster {
 	  if (((m) = mmbfree) != 0) { \
 		mmbfree = (m)->m_next; \
 		mbstat.m_mtypes[MT_FREE]--; \
+		MBPOOL_MBHIWAT(); \
 		(m)->m_type = (type); \
 		mbstat.m_mtypes[type]++; \
 		(m)->m_next = (struct mbuf *)NULL; \
@@ -243,6 +285,7 @@ union mcluster {
 	  if (((m) = mmbfree) != 0) { \
 		mmbfree = (m)->m_next; \
 		mbstat.m_mtypes[MT_FREE]--; \
+		MBPOOL_MBHIWAT(); \
 		(m)->m_type = (type); \
 		mbstat.m_mtypes[type]++; \
 		(m)->m_next = (struct mbuf *)NULL; \
@@ -269,8 +312,9 @@ union mcluster {
 	  if (mclfree == 0) \
 		(void)m_clalloc(1, (how)); \
 	  if (((p) = (caddr_t)mclfree) != 0) { \
-		++mclrefcnt[mtocl(p)]; \
+		++MCLREFCNT(p); \
 		mbstat.m_clfree--; \
+		MBPOOL_CLHIWAT(); \
 		mclfree = ((union mcluster *)(p))->mcl_next; \
 	  } \
 	)
@@ -288,7 +332,7 @@ union mcluster {
 
 #define	MCLFREE(p) \
 	MBUFLOCK ( \
-	  if (--mclrefcnt[mtocl(p)] == 0) { \
+	  if (--MCLREFCNT(p) == 0) { \
 		((union mcluster *)(p))->mcl_next = mclfree; \
 		mclfree = (union mcluster *)(p); \
 		mbstat.m_clfree++; \
@@ -309,7 +353,7 @@ union mcluster {
 			    (m)->m_ext.ext_size); \
 		else { \
 			char *p = (m)->m_ext.ext_buf; \
-			if (--mclrefcnt[mtocl(p)] == 0) { \
+			if (--MCLREFCNT(p) == 0) { \
 				((union mcluster *)(p))->mcl_next = mclfree; \
 				mclfree = (union mcluster *)(p); \
 				mbstat.m_clfree++; \
@@ -402,6 +446,7 @@ union mcluster {
 extern struct mbuf *mbutl;		/* virtual address of mclusters */
 extern char	*mclrefcnt;		/* cluster reference counts */
 extern struct mbstat mbstat;
+extern struct mbpoolstat mbpoolstat;
 extern uint32_t	nmbclusters;
 extern uint32_t	nmbufs;
 extern struct mbuf *mmbfree;
@@ -111,6 +111,7 @@ struct protosw {
 #define	PR_RIGHTS	0x10		/* passes capabilities */
 #define PR_IMPLOPCL	0x20		/* implied open/close */
 #define	PR_LASTHDR	0x40		/* enforce ipsec policy; last header */
+#define	PR_CKSUMDATA	0x80		/* wants data checksum on send copy */
 
 /*
  * The arguments to usrreq are:
@@ -45,6 +45,8 @@
  */
 typedef	u_quad_t so_gen_t;
 
+struct rtems_bsdnet_knote;
+
 struct socket {
 	short	so_type;		/* generic type, see socket.h */
 	short	so_options;		/* from socket call, see socket.h */
@@ -103,6 +105,7 @@ struct socket {
 	caddr_t	so_tpcb;		/* Wisc. protocol control block XXX */
 	void	(*so_upcall)(struct socket *, void *arg, int);
 	void 	*so_upcallarg;		/* Arg for above */
+	LIST_HEAD(, rtems_bsdnet_knote) so_knotes; /* kqueue notes (RTEMS) */
 };
 
 /*
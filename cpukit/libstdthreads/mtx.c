@@ -31,10 +31,13 @@
 #include <sys/lock.h>
 #include <errno.h>
 
+#include <rtems/thread.h>
+
 void
 mtx_destroy(mtx_t *mtx)
 {
 
+	_Mutex_Statistics_release_if_enabled(&mtx->_Mutex);
 	_Mutex_recursive_Destroy(mtx);
 }
 
@@ -29,6 +29,10 @@
 #define NO_POPEN
 #define NO_SSL
 #define USE_WEBSOCKET
+#ifdef MGHTTPD_USE_ZLIB
+#define USE_ZLIB
+#endif
+#define USE_KQUEUE
 #endif // __rtems__
 
 #if defined(_WIN32)
@@ -214,6 +218,9 @@ typedef struct DIR {
 #ifdef HAVE_POLL
 #include <sys/poll.h>
 #endif
+#ifdef USE_KQUEUE
+#include <sys/event.h>
+#endif
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <sys/time.h>
@@ -261,10 +268,15 @@ struct pollfd {
   short revents;
 };
 #define POLLIN 1
+#define POLLOUT 4
 #endif
 
 #include <mghttpd/mongoose.h>
 
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif
+
 #define MONGOOSE_VERSION "3.9"
 #define PASSWORDS_FILE_NAME ".htpasswd"
 #define CGI_ENVIRONMENT_SIZE 4096
@@ -469,7 +481,8 @@ enum {
   GLOBAL_PASSWORDS_FILE, INDEX_FILES, ENABLE_KEEP_ALIVE, ACCESS_CONTROL_LIST,
   EXTRA_MIME_TYPES, LISTENING_PORTS, DOCUMENT_ROOT, SSL_CERTIFICATE,
   NUM_THREADS, RUN_AS_USER, REWRITE, HIDE_FILES, REQUEST_TIMEOUT,
-  THREAD_STACK_SIZE, THREAD_PRIORITY, THREAD_POLICY,
+  THREAD_STACK_SIZE, THREAD_PRIORITY, THREAD_POLICY, EVENT_LOOP,
+  STATIC_CACHE_SIZE, STATIC_CACHE_FILE_SIZE, STATIC_CACHE_GZIP,
   NUM_OPTIONS
 };
 
@@ -502,6 +515,14 @@ static const char *config_options[] = {
   "thread_stack_size", NULL,
   "thread_priority", NULL,
   "thread_policy", NULL,
+  "event_loop", "no",
+  "static_cache_size", "0",
+  "static_cache_file_size", "65536",
+#ifdef USE_ZLIB
+  "static_cache_gzip", "yes",
+#else
+  "static_cache_gzip", "no",
+#endif
   NULL
 };
 
@@ -524,6 +545,27 @@ struct mg_context {
   volatile int sq_tail;      // Tail of the socket queue
   pthread_cond_t sq_full;    // Signaled when socket is produced
   pthread_cond_t sq_empty;   // Signaled when socket is consumed
+
+  // Event loop mode, see event_loop()
+  int event_loop;            // Non-zero if connections are multiplexed
+  SOCKET wakeup[2];          // Workers wake up the master via wakeup[1]
+  int kq;                    // Kernel event queue of the master thread
+  struct mg_connection **conns;  // Connections owned by the master thread
+  int num_conns;             // Number of connections in conns
+  int max_conns;             // Size of the conns array
+  struct mg_connection *ready;   // Connections with a complete request
+  struct mg_connection **ready_tail;
+  struct mg_connection *done;    // Connections returned by the workers
+
+  // Static file cache, see cache_lookup()
+  pthread_mutex_t cache_mutex;   // Protects the cache and its statistics
+  struct cache_entry **cache_hash;   // NULL if the cache is disabled
+  struct cache_entry *lru_head;  // Most recently used entry
+  struct cache_entry *lru_tail;  // Least recently used entry
+  int64_t cache_size;            // Memory limit of the cache
+  int64_t cache_file_size;       // Size limit of a cached file
+  int cache_gzip;                // Non-zero if gzip variants are built
+  struct mg_cache_stats cache_stats;
 };
 
 struct mg_connection {
@@ -546,6 +588,18 @@ struct mg_connection {
   int throttle;               // Throttling, bytes/sec. <= 0 means no throttle
   time_t last_throttle_time;  // Last time throttled data was sent
   int64_t last_throttle_bytes;// Bytes sent this second
+
+  // Event loop mode, see event_loop()
+  struct mg_connection *next; // Next in the ready or done list
+  int slot;                   // Index in the connection set of the master
+  int state;                  // CONN_READING or CONN_SENDING
+  time_t last_io;             // Time of the last activity
+  struct file file;           // Static file sent by the master thread
+  int64_t file_left;          // File bytes not yet read
+  char *out;                  // Chunk buffer or in-memory file data
+  int out_off;                // Bytes of the chunk already sent
+  int out_len;                // Bytes in the chunk buffer
+  struct cache_entry *cached; // Cache entry of the deferred data
 };
 
 // Directory entry
@@ -1363,6 +1417,11 @@ static int set_non_blocking_mode(SOCKET sock) {
   return ioctlsocket(sock, FIONBIO, &on);
 }
 
+static int set_blocking_mode(SOCKET sock) {
+  unsigned long off = 0;
+  return ioctlsocket(sock, FIONBIO, &off);
+}
+
 #else
 static int mg_stat(struct mg_connection *conn, const char *path,
                    struct file *filep) {
@@ -1511,21 +1570,36 @@ static int set_non_blocking_mode(SOCKET sock) {
 
   return 0;
 }
+
+static int set_blocking_mode(SOCKET sock) {
+  int flags;
+
+  flags = fcntl(sock, F_GETFL, 0);
+  (void) fcntl(sock, F_SETFL, flags & ~O_NONBLOCK);
+
+  return 0;
+}
 #endif // _WIN32
 
 #ifndef HAVE_POLL
 static int poll(struct pollfd *pfd, int n, int milliseconds) {
   struct timeval tv;
-  fd_set set;
+  fd_set rset, wset;
   int i, result;
   SOCKET maxfd = 0;
 
   tv.tv_sec = milliseconds / 1000;
   tv.tv_usec = (milliseconds % 1000) * 1000;
-  FD_ZERO(&set);
+  FD_ZERO(&rset);
+  FD_ZERO(&wset);
 
   for (i = 0; i < n; i++) {
-    FD_SET((SOCKET) pfd[i].fd, &set);
+    if (pfd[i].events & POLLIN) {
+      FD_SET((SOCKET) pfd[i].fd, &rset);
+    }
+    if (pfd[i].events & POLLOUT) {
+      FD_SET((SOCKET) pfd[i].fd, &wset);
+    }
     pfd[i].revents = 0;
 
     if (pfd[i].fd > maxfd) {
@@ -1533,10 +1607,13 @@ static int poll(struct pollfd *pfd, int n, int milliseconds) {
     }
   }
 
-  if ((result = select(maxfd + 1, &set, NULL, NULL, &tv)) > 0) {
+  if ((result = select(maxfd + 1, &rset, &wset, NULL, &tv)) > 0) {
     for (i = 0; i < n; i++) {
-      if (FD_ISSET(pfd[i].fd, &set)) {
-        pfd[i].revents = POLLIN;
+      if (FD_ISSET(pfd[i].fd, &rset)) {
+        pfd[i].revents |= POLLIN;
+      }
+      if (FD_ISSET(pfd[i].fd, &wset)) {
+        pfd[i].revents |= POLLOUT;
       }
     }
   }
@@ -1880,6 +1957,11 @@ int mg_get_cookie(const char *cookie_header, const char *var_name,
   return len;
 }
 
+static int accepts_gzip(const struct mg_connection *conn) {
+  const char *accept_encoding = mg_get_header(conn, "Accept-Encoding");
+  return accept_encoding != NULL && strstr(accept_encoding, "gzip") != NULL;
+}
+
 static void convert_uri_to_file_name(struct mg_connection *conn, char *buf,
                                      size_t buf_len, struct file *filep) {
   struct vec a, b;
@@ -1888,7 +1970,6 @@ static void convert_uri_to_file_name(struct mg_connection *conn, char *buf,
   char *p;
   int match_len;
   char gz_path[PATH_MAX];
-  char const* accept_encoding;
 
   // Using buf_len - 1 because memmove() for PATH_INFO may shift part
   // of the path one byte on the right.
@@ -1914,13 +1995,11 @@ static void convert_uri_to_file_name(struct mg_connection *conn, char *buf,
   // to indicate that the response need to have the content-
   // encoding: gzip header
   // we can only do this if the browser declares support
-  if ((accept_encoding = mg_get_header(conn, "Accept-Encoding")) != NULL) {
-    if (strstr(accept_encoding,"gzip") != NULL) {
-      snprintf(gz_path, sizeof(gz_path), "%s.gz", buf);
-      if (mg_stat(conn, gz_path, filep)) {
-        filep->gzipped = 1;
-        return;
-      }
+  if (accepts_gzip(conn)) {
+    snprintf(gz_path, sizeof(gz_path), "%s.gz", buf);
+    if (mg_stat(conn, gz_path, filep)) {
+      filep->gzipped = 1;
+      return;
     }
   }
 
@@ -2960,6 +3039,24 @@ static void send_file_data(struct mg_connection *conn, struct file *filep,
     }
     mg_write(conn, filep->membuf + offset, (size_t) len);
   } else if (len > 0 && filep->fp != NULL) {
+#if defined(__rtems__)
+    // Let the network stack read the file directly into the socket buffers
+    if (conn->ssl == NULL) {
+      off_t sent = 0;
+      int rv;
+
+      if (len > filep->size - offset) {
+        len = filep->size - offset;
+      }
+
+      rv = sendfile(fileno(filep->fp), conn->client.sock, offset,
+                    (size_t) len, NULL, &sent, 0);
+      conn->num_bytes_sent += sent;
+      if (rv == 0 || sent > 0 || (errno != EINVAL && errno != ENOSYS)) {
+        return;
+      }
+    }
+#endif // __rtems__
     fseeko(filep->fp, offset, SEEK_SET);
     while (len > 0) {
       // Calculate how much to read from the file in the buffer
@@ -2985,6 +3082,43 @@ static void send_file_data(struct mg_connection *conn, struct file *filep,
   }
 }
 
+// In event loop mode, leave the body of a static file to the master thread,
+// which sends it in chunks without blocking. Slow clients then do not tie
+// up a worker. Return 1 if the body was deferred.
+static int defer_file_data(struct mg_connection *conn, struct file *filep,
+                           int64_t offset, int64_t len) {
+  offset = offset < 0 ? 0 : offset > filep->size ? filep->size : offset;
+  if (len > filep->size - offset) {
+    len = filep->size - offset;
+  }
+
+  // Throttling sleeps, SSL connections are not multiplexed
+  if (!conn->ctx->event_loop || conn->ssl != NULL || conn->throttle > 0 ||
+      len <= 0) {
+    return 0;
+  }
+
+  if (filep->membuf != NULL) {
+    conn->out = (char *) filep->membuf + offset;
+    conn->out_len = (int) len;
+    conn->file_left = 0;
+  } else if (filep->fp != NULL &&
+             (conn->out = (char *) malloc(MG_BUF_LEN)) != NULL &&
+             fseeko(filep->fp, offset, SEEK_SET) == 0) {
+    conn->out_len = 0;
+    conn->file_left = len;
+  } else {
+    free(conn->out);
+    conn->out = NULL;
+    return 0;
+  }
+
+  conn->file = *filep;
+  conn->out_off = 0;
+  conn->num_bytes_sent += len;
+  return 1;
+}
+
 static int parse_range_header(const char *header, int64_t *a, int64_t *b) {
   return sscanf(header, "bytes=%" INT64_FMT "-%" INT64_FMT, a, b);
 }
@@ -3013,8 +3147,407 @@ static void fclose_on_exec(struct file *filep) {
   }
 }
 
+// Derive the entity tag of the gzip variant of a file from its tag
+static void gzip_etag(char *buf, size_t buf_len, const char *etag) {
+  size_t len = strlen(etag);
+
+  if (len > 0 && etag[len - 1] == '"') {
+    snprintf(buf, buf_len, "%.*s-gz\"", (int) len - 1, etag);
+  } else {
+    snprintf(buf, buf_len, "%s-gz", etag);
+  }
+}
+
+// Static file cache. Small files are kept in memory together with their
+// response headers, so cache hits neither open nor read the file. Entries
+// are keyed by the path, modification time and size of the file and evicted
+// in least recently used order. An entry is freed once the last connection
+// sending its data dropped the reference.
+#define CACHE_HASH_SIZE 256
+
+struct cache_entry {
+  struct cache_entry *next;      // Next entry in the hash bucket
+  struct cache_entry *lru_prev;  // More recently used entry
+  struct cache_entry *lru_next;  // Less recently used entry
+  int refs;                      // References of the cache and the senders
+  unsigned hash;                 // Hash of the path
+  char *path;
+  time_t modification_time;
+  int64_t size;                  // Size of the file
+  size_t mem_size;               // Memory used by the entry
+  int gzipped;                   // File is a pre-gzipped .gz file
+  char etag[64];                 // Entity tag of the file
+  char gz_etag[70];              // Entity tag of the gzip variant
+  char *headers;                 // Last-Modified, Etag, Content-Type, ...
+  char *data;                    // Contents of the file
+  char *gz_headers;              // Headers of the gzip variant
+  char *gz_data;                 // Gzip variant, NULL if there is none
+  size_t gz_size;
+};
+
+static unsigned cache_hash(const char *path) {
+  unsigned hash = 5381;
+
+  while (*path != '\0') {
+    hash = hash * 33 + (unsigned char) *path++;
+  }
+
+  return hash;
+}
+
+static void free_cache_entry(struct cache_entry *e) {
+  free(e->path);
+  free(e->headers);
+  free(e->data);
+  free(e->gz_headers);
+  free(e->gz_data);
+  free(e);
+}
+
+// All following cache functions expect the cache mutex to be held
+static void cache_put(struct cache_entry *e) {
+  if (--e->refs == 0) {
+    free_cache_entry(e);
+  }
+}
+
+static void lru_remove(struct mg_context *ctx, struct cache_entry *e) {
+  if (e->lru_prev != NULL) {
+    e->lru_prev->lru_next = e->lru_next;
+  } else {
+    ctx->lru_head = e->lru_next;
+  }
+  if (e->lru_next != NULL) {
+    e->lru_next->lru_prev = e->lru_prev;
+  } else {
+    ctx->lru_tail = e->lru_prev;
+  }
+}
+
+static void lru_push(struct mg_context *ctx, struct cache_entry *e) {
+  e->lru_prev = NULL;
+  e->lru_next = ctx->lru_head;
+  if (ctx->lru_head != NULL) {
+    ctx->lru_head->lru_prev = e;
+  } else {
+    ctx->lru_tail = e;
+  }
+  ctx->lru_head = e;
+}
+
+static void cache_remove(struct mg_context *ctx, struct cache_entry *e) {
+  struct cache_entry **pp = &ctx->cache_hash[e->hash % CACHE_HASH_SIZE];
+
+  while (*pp != e) {
+    pp = &(*pp)->next;
+  }
+  *pp = e->next;
+  lru_remove(ctx, e);
+  ctx->cache_stats.entries--;
+  ctx->cache_stats.bytes -= e->mem_size;
+  cache_put(e);
+}
+
+static struct cache_entry *cache_find(struct mg_context *ctx,
+                                      const char *path, unsigned hash) {
+  struct cache_entry *e;
+
+  for (e = ctx->cache_hash[hash % CACHE_HASH_SIZE]; e != NULL; e = e->next) {
+    if (e->hash == hash && !strcmp(e->path, path)) {
+      break;
+    }
+  }
+
+  return e;
+}
+
+static void cache_release(struct mg_context *ctx, struct cache_entry *e) {
+  (void) pthread_mutex_lock(&ctx->cache_mutex);
+  cache_put(e);
+  (void) pthread_mutex_unlock(&ctx->cache_mutex);
+}
+
+static int is_cacheable(const struct mg_connection *conn,
+                        const struct file *filep) {
+  return conn->ctx->cache_hash != NULL && filep->membuf == NULL &&
+    filep->size <= conn->ctx->cache_file_size &&
+    filep->size <= conn->ctx->cache_size;
+}
+
+// Return the cache entry of a file, or NULL if it is not cached or has
+// changed. The caller must release the returned entry.
+static struct cache_entry *cache_lookup(struct mg_connection *conn,
+                                        const char *path,
+                                        const struct file *filep,
+                                        int gzip) {
+  struct mg_context *ctx = conn->ctx;
+  struct cache_entry *e;
+
+  if (!is_cacheable(conn, filep)) {
+    return NULL;
+  }
+
+  (void) pthread_mutex_lock(&ctx->cache_mutex);
+  e = cache_find(ctx, path, cache_hash(path));
+  if (e != NULL && e->modification_time == filep->modification_time &&
+      e->size == filep->size) {
+    lru_remove(ctx, e);
+    lru_push(ctx, e);
+    e->refs++;
+    ctx->cache_stats.hits++;
+    if (gzip && e->gz_data != NULL) {
+      ctx->cache_stats.gzip_hits++;
+    }
+  } else {
+    if (e != NULL) {
+      cache_remove(ctx, e);
+      e = NULL;
+    }
+    ctx->cache_stats.misses++;
+  }
+  (void) pthread_mutex_unlock(&ctx->cache_mutex);
+
+  return e;
+}
+
+#ifdef USE_ZLIB
+static int is_compressible(const struct vec *mime_vec) {
+  char type[64];
+
+  mg_strlcpy(type, mime_vec->ptr, mime_vec->len < sizeof(type) ?
+             mime_vec->len + 1 : sizeof(type));
+  return !mg_strncasecmp(type, "text/", 5) ||
+    strstr(type, "javascript") != NULL || strstr(type, "json") != NULL ||
+    strstr(type, "xml") != NULL;
+}
+
+// Build the gzip variant of an entry. It is kept only if it saves at least
+// an eighth of the size.
+static void cache_gzip(struct cache_entry *e) {
+  z_stream zs;
+  uLong bound;
+  int bits = 9;
+
+  // A window larger than the file does not improve the compression
+  while (bits < 15 && ((int64_t) 1 << bits) < e->size) {
+    bits++;
+  }
+
+  memset(&zs, 0, sizeof(zs));
+  if (deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, bits + 16, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    return;
+  }
+
+  bound = deflateBound(&zs, (uLong) e->size);
+  if ((e->gz_data = (char *) malloc(bound)) != NULL) {
+    zs.next_in = (Bytef *) e->data;
+    zs.avail_in = (uInt) e->size;
+    zs.next_out = (Bytef *) e->gz_data;
+    zs.avail_out = (uInt) bound;
+    if (deflate(&zs, Z_FINISH) == Z_STREAM_END &&
+        (int64_t) zs.total_out < e->size - e->size / 8) {
+      e->gz_size = zs.total_out;
+    } else {
+      free(e->gz_data);
+      e->gz_data = NULL;
+    }
+  }
+
+  deflateEnd(&zs);
+}
+#endif // USE_ZLIB
+
+// Copy the entity tags of a file, if it is cached and did not change.
+// Return non-zero in this case.
+static int cache_get_etags(const struct mg_connection *conn, const char *path,
+                           const struct file *filep, char *etag,
+                           char *gz_etag) {
+  struct mg_context *ctx = conn->ctx;
+  struct cache_entry *e;
+  char gz_path[PATH_MAX];
+  int found = 0;
+
+  if (!is_cacheable(conn, filep)) {
+    return 0;
+  }
+
+  // Pre-gzipped files are cached by the path of the .gz file
+  if (filep->gzipped) {
+    snprintf(gz_path, sizeof(gz_path), "%s.gz", path);
+    path = gz_path;
+  }
+
+  (void) pthread_mutex_lock(&ctx->cache_mutex);
+  e = cache_find(ctx, path, cache_hash(path));
+  if (e != NULL && e->modification_time == filep->modification_time &&
+      e->size == filep->size) {
+    memcpy(etag, e->etag, sizeof(e->etag));
+    memcpy(gz_etag, e->gz_etag, sizeof(e->gz_etag));
+    found = 1;
+  }
+  (void) pthread_mutex_unlock(&ctx->cache_mutex);
+
+  return found;
+}
+
+// Read an opened file into a new cache entry and insert it. Return the
+// entry, or NULL if the file cannot be cached. The caller must release the
+// returned entry.
+static struct cache_entry *cache_insert(struct mg_connection *conn,
+                                        const char *path, struct file *filep,
+                                        const struct vec *mime_vec,
+                                        const char *encoding) {
+  struct mg_context *ctx = conn->ctx;
+  struct cache_entry *e, *old;
+  char lm[64], buf[512];
+  size_t size = (size_t) filep->size;
+
+  if (!is_cacheable(conn, filep) || filep->fp == NULL ||
+      (e = (struct cache_entry *) calloc(1, sizeof(*e))) == NULL) {
+    return NULL;
+  }
+
+  e->hash = cache_hash(path);
+  e->modification_time = filep->modification_time;
+  e->size = filep->size;
+  e->gzipped = filep->gzipped;
+  if ((e->path = mg_strdup(path)) == NULL ||
+      (e->data = (char *) malloc(size + 1)) == NULL ||
+      fread(e->data, 1, size, filep->fp) != size) {
+    free_cache_entry(e);
+    return NULL;
+  }
+
+#ifdef USE_ZLIB
+  if (ctx->cache_gzip && !e->gzipped && is_compressible(mime_vec)) {
+    cache_gzip(e);
+  }
+#endif
+
+  gmt_time_string(lm, sizeof(lm), &filep->modification_time);
+  construct_etag(conn, path, e->etag, sizeof(e->etag), filep);
+  gzip_etag(e->gz_etag, sizeof(e->gz_etag), e->etag);
+  mg_snprintf(conn, buf, sizeof(buf),
+              "Last-Modified: %s\r\n"
+              "Etag: %s\r\n"
+              "Content-Type: %.*s\r\n"
+              "Accept-Ranges: bytes\r\n"
+              "%s%s",
+              lm, e->etag, (int) mime_vec->len, mime_vec->ptr, encoding,
+              e->gz_data != NULL ? "Vary: Accept-Encoding\r\n" : "");
+  if ((e->headers = mg_strdup(buf)) == NULL) {
+    free_cache_entry(e);
+    return NULL;
+  }
+  e->mem_size = sizeof(*e) + strlen(e->path) + strlen(buf) + size + 3;
+
+  if (e->gz_data != NULL) {
+    mg_snprintf(conn, buf, sizeof(buf),
+                "Last-Modified: %s\r\n"
+                "Etag: %s\r\n"
+                "Content-Type: %.*s\r\n"
+                "Content-Encoding: gzip\r\n"
+                "Vary: Accept-Encoding\r\n",
+                lm, e->gz_etag, (int) mime_vec->len, mime_vec->ptr);
+    if ((e->gz_headers = mg_strdup(buf)) == NULL) {
+      free_cache_entry(e);
+      return NULL;
+    }
+    e->mem_size += strlen(buf) + 1 + e->gz_size;
+  }
+
+  e->refs = 1;
+
+  (void) pthread_mutex_lock(&ctx->cache_mutex);
+  if ((old = cache_find(ctx, path, e->hash)) != NULL) {
+    cache_remove(ctx, old);
+  }
+  if ((int64_t) e->mem_size <= ctx->cache_size) {
+    while ((int64_t) (ctx->cache_stats.bytes + e->mem_size) > ctx->cache_size) {
+      cache_remove(ctx, ctx->lru_tail);
+      ctx->cache_stats.evictions++;
+    }
+    e->next = ctx->cache_hash[e->hash % CACHE_HASH_SIZE];
+    ctx->cache_hash[e->hash % CACHE_HASH_SIZE] = e;
+    lru_push(ctx, e);
+    ctx->cache_stats.entries++;
+    ctx->cache_stats.bytes += e->mem_size;
+    e->refs++;
+  }
+  (void) pthread_mutex_unlock(&ctx->cache_mutex);
+
+  return e;
+}
+
+// Send a file from the cache. This releases the entry, unless the event
+// loop sends the data.
+static void send_cached_file(struct mg_connection *conn,
+                             struct cache_entry *e, int gzip, int may_defer) {
+  char date[64], range[64];
+  const char *msg = "OK", *hdr, *headers = e->headers;
+  time_t curtime = time(NULL);
+  struct file file = STRUCT_FILE_INITIALIZER;
+  int64_t cl, r1, r2;
+  int n;
+
+  file.membuf = e->data;
+  file.size = e->size;
+  if (gzip) {
+    headers = e->gz_headers;
+    file.membuf = e->gz_data;
+    file.size = (int64_t) e->gz_size;
+  }
+
+  cl = file.size;
+  conn->status_code = 200;
+  range[0] = '\0';
+
+  // If Range: header specified, act accordingly
+  r1 = r2 = 0;
+  hdr = mg_get_header(conn, "Range");
+  if (hdr != NULL && (n = parse_range_header(hdr, &r1, &r2)) > 0 &&
+      r1 >= 0 && r2 >= 0) {
+    // See handle_file_request()
+    if (e->gzipped) {
+      send_http_error(conn, 501, "Not Implemented", "range requests in gzipped files are not supported");
+      cache_release(conn->ctx, e);
+      return;
+    }
+    conn->status_code = 206;
+    cl = n == 2 ? (r2 > cl ? cl : r2) - r1 + 1: cl - r1;
+    mg_snprintf(conn, range, sizeof(range),
+                "Content-Range: bytes "
+                "%" INT64_FMT "-%"
+                INT64_FMT "/%" INT64_FMT "\r\n",
+                r1, r1 + cl - 1, file.size);
+    msg = "Partial Content";
+  }
+
+  gmt_time_string(date, sizeof(date), &curtime);
+
+  (void) mg_printf(conn,
+      "HTTP/1.1 %d %s\r\n"
+      "Date: %s\r\n"
+      "%s"
+      "Content-Length: %" INT64_FMT "\r\n"
+      "Connection: %s\r\n"
+      "%s\r\n",
+      conn->status_code, msg, date, headers, cl,
+      suggest_connection_header(conn), range);
+
+  if (strcmp(conn->request_info.request_method, "HEAD") != 0) {
+    if (may_defer && defer_file_data(conn, &file, r1, cl)) {
+      conn->cached = e;
+      return;
+    }
+    send_file_data(conn, &file, r1, cl);
+  }
+  cache_release(conn->ctx, e);
+}
+
 static void handle_file_request(struct mg_connection *conn, const char *path,
-                                struct file *filep) {
+                                struct file *filep, int may_defer) {
   char date[64], lm[64], etag[64], range[64];
   const char *msg = "OK", *hdr;
   time_t curtime = time(NULL);
@@ -3023,6 +3556,8 @@ static void handle_file_request(struct mg_connection *conn, const char *path,
   int n;
   char gz_path[PATH_MAX];
   char const* encoding = "";
+  struct cache_entry *entry;
+  int gzip;
 
   get_mime_type(conn->ctx, path, &mime_vec);
   cl = filep->size;
@@ -3038,6 +3573,15 @@ static void handle_file_request(struct mg_connection *conn, const char *path,
     encoding = "Content-Encoding: gzip\r\n";
   }
 
+  // Send the gzip variant of a cached file, if the client accepts it
+  gzip = !filep->gzipped && mg_get_header(conn, "Range") == NULL &&
+    accepts_gzip(conn);
+
+  if ((entry = cache_lookup(conn, path, filep, gzip)) != NULL) {
+    send_cached_file(conn, entry, gzip && entry->gz_data != NULL, may_defer);
+    return;
+  }
+
   if (!mg_fopen(conn, path, "rb", filep)) {
     send_http_error(conn, 500, http_500_error,
                     "fopen(%s): %s", path, strerror(ERRNO));
@@ -3046,6 +3590,12 @@ static void handle_file_request(struct mg_connection *conn, const char *path,
 
   fclose_on_exec(filep);
 
+  if ((entry = cache_insert(conn, path, filep, &mime_vec, encoding)) != NULL) {
+    mg_fclose(filep);
+    send_cached_file(conn, entry, gzip && entry->gz_data != NULL, may_defer);
+    return;
+  }
+
   // If Range: header specified, act accordingly
   r1 = r2 = 0;
   hdr = mg_get_header(conn, "Range");
@@ -3087,6 +3637,9 @@ static void handle_file_request(struct mg_connection *conn, const char *path,
       mime_vec.ptr, cl, suggest_connection_header(conn), range, encoding);
 
   if (strcmp(conn->request_info.request_method, "HEAD") != 0) {
+    if (may_defer && defer_file_data(conn, filep, r1, cl)) {
+      return;
+    }
     send_file_data(conn, filep, r1, cl);
   }
   mg_fclose(filep);
@@ -3095,7 +3648,7 @@ static void handle_file_request(struct mg_connection *conn, const char *path,
 void mg_send_file(struct mg_connection *conn, const char *path) {
   struct file file = STRUCT_FILE_INITIALIZER;
   if (mg_stat(conn, path, &file)) {
-    handle_file_request(conn, path, &file);
+    handle_file_request(conn, path, &file, 0);
   } else {
     send_http_error(conn, 404, "Not Found", "%s", "File not found");
   }
@@ -3233,11 +3786,15 @@ static int substitute_index_file(struct mg_connection *conn, char *path,
 static int is_not_modified(const struct mg_connection *conn,
                            const char *path,
                            const struct file *filep) {
-  char etag[64];
+  char etag[64], gz_etag[70];
   const char *ims = mg_get_header(conn, "If-Modified-Since");
   const char *inm = mg_get_header(conn, "If-None-Match");
-  construct_etag(conn, path, etag, sizeof(etag), filep);
-  return (inm != NULL && !mg_strcasecmp(etag, inm)) ||
+  if (inm != NULL && !cache_get_etags(conn, path, filep, etag, gz_etag)) {
+    construct_etag(conn, path, etag, sizeof(etag), filep);
+    gzip_etag(gz_etag, sizeof(gz_etag), etag);
+  }
+  return (inm != NULL && (!mg_strcasecmp(etag, inm) ||
+                          !mg_strcasecmp(gz_etag, inm))) ||
     (ims != NULL && filep->modification_time <= parse_date_string(ims));
 }
 
@@ -4605,7 +5162,7 @@ static void handle_request(struct mg_connection *conn) {
   } else if (is_not_modified(conn, path, &file)) {
     send_http_error(conn, 304, "Not Modified", "%s", "");
   } else {
-    handle_file_request(conn, path, &file);
+    handle_file_request(conn, path, &file, 1);
   }
 }
 
@@ -4965,6 +5522,39 @@ static int set_acl_option(struct mg_context *ctx) {
   return check_acl(ctx, (uint32_t) 0x7f000001UL) != -1;
 }
 
+static int set_cache_option(struct mg_context *ctx) {
+  ctx->cache_size = strtoll(ctx->config[STATIC_CACHE_SIZE], NULL, 10);
+  ctx->cache_file_size = strtoll(ctx->config[STATIC_CACHE_FILE_SIZE], NULL, 10);
+#ifdef USE_ZLIB
+  ctx->cache_gzip = mg_strcasecmp(ctx->config[STATIC_CACHE_GZIP], "no") != 0;
+#endif
+
+  if (ctx->cache_size > 0 &&
+      (ctx->cache_hash = (struct cache_entry **)
+       calloc(CACHE_HASH_SIZE, sizeof(ctx->cache_hash[0]))) == NULL) {
+    cry(fc(ctx), "%s", "Cannot allocate static file cache, OOM");
+    return 0;
+  }
+
+  return 1;
+}
+
+static void free_cache(struct mg_context *ctx) {
+  struct cache_entry *e, *next;
+
+  for (e = ctx->lru_head; e != NULL; e = next) {
+    next = e->lru_next;
+    free_cache_entry(e);
+  }
+  free(ctx->cache_hash);
+}
+
+void mg_get_cache_stats(struct mg_context *ctx, struct mg_cache_stats *stats) {
+  (void) pthread_mutex_lock(&ctx->cache_mutex);
+  *stats = ctx->cache_stats;
+  (void) pthread_mutex_unlock(&ctx->cache_mutex);
+}
+
 static void reset_per_request_attributes(struct mg_connection *conn) {
   conn->path_info = NULL;
   conn->num_bytes_sent = conn->consumed_content = 0;
@@ -5131,61 +5721,67 @@ struct mg_connection *mg_download(const char *host, int port, int use_ssl,
   return conn;
 }
 
-static void process_new_connection(struct mg_connection *conn) {
+// Read, handle and discard one request. Return non-zero if the connection
+// should be kept alive.
+static int process_request(struct mg_connection *conn) {
   struct mg_request_info *ri = &conn->request_info;
   int keep_alive_enabled, keep_alive, discard_len;
   char ebuf[100];
 
   keep_alive_enabled = !strcmp(conn->ctx->config[ENABLE_KEEP_ALIVE], "yes");
-  keep_alive = 0;
 
+  if (!getreq(conn, ebuf, sizeof(ebuf))) {
+    send_http_error(conn, 500, "Server Error", "%s", ebuf);
+    conn->must_close = 1;
+  } else if (!is_valid_uri(conn->request_info.uri)) {
+    snprintf(ebuf, sizeof(ebuf), "Invalid URI: [%s]", ri->uri);
+    send_http_error(conn, 400, "Bad Request", "%s", ebuf);
+  } else if (strcmp(ri->http_version, "1.0") &&
+             strcmp(ri->http_version, "1.1")) {
+    snprintf(ebuf, sizeof(ebuf), "Bad HTTP version: [%s]", ri->http_version);
+    send_http_error(conn, 505, "Bad HTTP version", "%s", ebuf);
+  }
+
+  if (ebuf[0] == '\0') {
+    handle_request(conn);
+    if (conn->ctx->callbacks.end_request != NULL) {
+      conn->ctx->callbacks.end_request(conn, conn->status_code);
+    }
+    log_access(conn);
+  }
+  if (ri->remote_user != NULL) {
+    free((void *) ri->remote_user);
+    // Important! When having connections with and without auth
+    // would cause double free and then crash
+    ri->remote_user = NULL;
+  }
+
+  // NOTE(lsm): order is important here. should_keep_alive() call
+  // is using parsed request, which will be invalid after memmove's below.
+  // Therefore, memorize should_keep_alive() result now for later use
+  // by the caller.
+  keep_alive = conn->ctx->stop_flag == 0 && keep_alive_enabled &&
+    conn->content_len >= 0 && should_keep_alive(conn);
+
+  // Discard all buffered data for this request
+  discard_len = conn->content_len >= 0 && conn->request_len > 0 &&
+    conn->request_len + conn->content_len < (int64_t) conn->data_len ?
+    (int) (conn->request_len + conn->content_len) : conn->data_len;
+  assert(discard_len >= 0);
+  memmove(conn->buf, conn->buf + discard_len, conn->data_len - discard_len);
+  conn->data_len -= discard_len;
+  assert(conn->data_len >= 0);
+  assert(conn->data_len <= conn->buf_size);
+
+  return keep_alive;
+}
+
+static void process_new_connection(struct mg_connection *conn) {
   // Important: on new connection, reset the receiving buffer. Credit goes
   // to crule42.
   conn->data_len = 0;
-  do {
-    if (!getreq(conn, ebuf, sizeof(ebuf))) {
-      send_http_error(conn, 500, "Server Error", "%s", ebuf);
-      conn->must_close = 1;
-    } else if (!is_valid_uri(conn->request_info.uri)) {
-      snprintf(ebuf, sizeof(ebuf), "Invalid URI: [%s]", ri->uri);
-      send_http_error(conn, 400, "Bad Request", "%s", ebuf);
-    } else if (strcmp(ri->http_version, "1.0") &&
-               strcmp(ri->http_version, "1.1")) {
-      snprintf(ebuf, sizeof(ebuf), "Bad HTTP version: [%s]", ri->http_version);
-      send_http_error(conn, 505, "Bad HTTP version", "%s", ebuf);
-    }
-
-    if (ebuf[0] == '\0') {
-      handle_request(conn);
-      if (conn->ctx->callbacks.end_request != NULL) {
-        conn->ctx->callbacks.end_request(conn, conn->status_code);
-      }
-      log_access(conn);
-    }
-    if (ri->remote_user != NULL) {
-      free((void *) ri->remote_user);
-      // Important! When having connections with and without auth
-      // would cause double free and then crash
-      ri->remote_user = NULL;
-    }
-
-    // NOTE(lsm): order is important here. should_keep_alive() call
-    // is using parsed request, which will be invalid after memmove's below.
-    // Therefore, memorize should_keep_alive() result now for later use
-    // in loop exit condition.
-    keep_alive = conn->ctx->stop_flag == 0 && keep_alive_enabled &&
-      conn->content_len >= 0 && should_keep_alive(conn);
-
-    // Discard all buffered data for this request
-    discard_len = conn->content_len >= 0 && conn->request_len > 0 &&
-      conn->request_len + conn->content_len < (int64_t) conn->data_len ?
-      (int) (conn->request_len + conn->content_len) : conn->data_len;
-    assert(discard_len >= 0);
-    memmove(conn->buf, conn->buf + discard_len, conn->data_len - discard_len);
-    conn->data_len -= discard_len;
-    assert(conn->data_len >= 0);
-    assert(conn->data_len <= conn->buf_size);
-  } while (keep_alive);
+  while (process_request(conn)) {
+  }
 }
 
 // Worker threads take accepted socket from the queue
@@ -5218,8 +5814,7 @@ static int consume_socket(struct mg_context *ctx, struct socket *sp) {
   return !ctx->stop_flag;
 }
 
-static void *worker_thread(void *thread_func_param) {
-  struct mg_context *ctx = (struct mg_context *) thread_func_param;
+static struct mg_connection *new_connection(struct mg_context *ctx) {
   struct mg_connection *conn;
 
   conn = (struct mg_connection *) calloc(1, sizeof(*conn) + MAX_REQUEST_SIZE);
@@ -5230,21 +5825,48 @@ static void *worker_thread(void *thread_func_param) {
     conn->buf = (char *) (conn + 1);
     conn->ctx = ctx;
     conn->request_info.user_data = ctx->user_data;
+  }
 
+  return conn;
+}
+
+static void set_client(struct mg_connection *conn, const struct socket *sp) {
+  conn->client = *sp;
+  conn->birth_time = time(NULL);
+
+  // Fill in IP, port info early so even if SSL setup below fails,
+  // error handler would have the corresponding info.
+  // Thanks to Johannes Winkelmann for the patch.
+  // TODO(lsm): Fix IPv6 case
+  conn->request_info.remote_port = ntohs(conn->client.rsa.sin.sin_port);
+  memcpy(&conn->request_info.remote_ip,
+         &conn->client.rsa.sin.sin_addr.s_addr, 4);
+  conn->request_info.remote_ip = ntohl(conn->request_info.remote_ip);
+  conn->request_info.is_ssl = conn->client.is_ssl;
+}
+
+// Signal master that a worker is done with connections and exiting
+static void worker_exiting(struct mg_context *ctx) {
+  (void) pthread_mutex_lock(&ctx->mutex);
+  ctx->num_threads--;
+  (void) pthread_cond_signal(&ctx->cond);
+  assert(ctx->num_threads >= 0);
+  (void) pthread_mutex_unlock(&ctx->mutex);
+
+  DEBUG_TRACE(("exiting"));
+}
+
+static void *worker_thread(void *thread_func_param) {
+  struct mg_context *ctx = (struct mg_context *) thread_func_param;
+  struct mg_connection *conn;
+  struct socket so;
+
+  conn = new_connection(ctx);
+  if (conn != NULL) {
     // Call consume_socket() even when ctx->stop_flag > 0, to let it signal
     // sq_empty condvar to wake up the master waiting in produce_socket()
-    while (consume_socket(ctx, &conn->client)) {
-      conn->birth_time = time(NULL);
-
-      // Fill in IP, port info early so even if SSL setup below fails,
-      // error handler would have the corresponding info.
-      // Thanks to Johannes Winkelmann for the patch.
-      // TODO(lsm): Fix IPv6 case
-      conn->request_info.remote_port = ntohs(conn->client.rsa.sin.sin_port);
-      memcpy(&conn->request_info.remote_ip,
-             &conn->client.rsa.sin.sin_addr.s_addr, 4);
-      conn->request_info.remote_ip = ntohl(conn->request_info.remote_ip);
-      conn->request_info.is_ssl = conn->client.is_ssl;
+    while (consume_socket(ctx, &so)) {
+      set_client(conn, &so);
 
       if (!conn->client.is_ssl
 #ifndef NO_SSL
@@ -5259,14 +5881,7 @@ static void *worker_thread(void *thread_func_param) {
     free(conn);
   }
 
-  // Signal master that we're done with connection and exiting
-  (void) pthread_mutex_lock(&ctx->mutex);
-  ctx->num_threads--;
-  (void) pthread_cond_signal(&ctx->cond);
-  assert(ctx->num_threads >= 0);
-  (void) pthread_mutex_unlock(&ctx->mutex);
-
-  DEBUG_TRACE(("exiting"));
+  worker_exiting(ctx);
   return NULL;
 }
 
@@ -5303,6 +5918,345 @@ static int set_sock_timeout(SOCKET sock, int milliseconds) {
     setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, (void *) &t, sizeof(t));
 }
 
+// Event loop mode (option "event_loop"). The master thread owns all
+// connections which wait for a request or send the body of a static file
+// and multiplexes them with kevent(). Each connection waits for one event
+// at a time, so the cost of a wait does not depend on the number of idle
+// connections and there is no FD_SETSIZE limit. A connection is handed to
+// a worker once a complete request is buffered. The worker processes the
+// request and returns the connection to the master thread. A few workers
+// thus serve many keep-alive clients and slow clients do not tie up a
+// worker.
+enum { CONN_READING, CONN_SENDING };
+
+#if defined(_WIN32)
+#define WOULD_BLOCK(e) ((e) == WSAEWOULDBLOCK)
+#else
+#define WOULD_BLOCK(e) ((e) == EWOULDBLOCK || (e) == EAGAIN || (e) == EINTR)
+#endif
+
+static void close_event_loop(struct mg_context *ctx) {
+  int i;
+
+  for (i = 0; i < 2; i++) {
+    if (ctx->wakeup[i] != INVALID_SOCKET) {
+      closesocket(ctx->wakeup[i]);
+      ctx->wakeup[i] = INVALID_SOCKET;
+    }
+  }
+
+  if (ctx->kq >= 0) {
+    (void) close(ctx->kq);
+    ctx->kq = -1;
+  }
+}
+
+#if defined(USE_KQUEUE)
+// Create the event queue and connect two UDP sockets over the loopback
+// interface, so that workers can wake up the master thread. On RTEMS,
+// kevent() supports sockets only, unlike pipes.
+static int open_event_loop(struct mg_context *ctx) {
+  union usa sa;
+  socklen_t len = sizeof(sa.sin);
+
+  memset(&sa, 0, sizeof(sa));
+  sa.sin.sin_family = AF_INET;
+  sa.sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  if ((ctx->kq = kqueue()) < 0 ||
+      (ctx->wakeup[0] = socket(AF_INET, SOCK_DGRAM, 0)) == INVALID_SOCKET ||
+      (ctx->wakeup[1] = socket(AF_INET, SOCK_DGRAM, 0)) == INVALID_SOCKET ||
+      bind(ctx->wakeup[0], &sa.sa, len) != 0 ||
+      getsockname(ctx->wakeup[0], &sa.sa, &len) != 0 ||
+      connect(ctx->wakeup[1], &sa.sa, len) != 0) {
+    cry(fc(ctx), "%s: %s", __func__, strerror(ERRNO));
+    close_event_loop(ctx);
+    return 0;
+  }
+
+  set_non_blocking_mode(ctx->wakeup[0]);
+  set_non_blocking_mode(ctx->wakeup[1]);
+  set_close_on_exec(ctx->wakeup[0]);
+  set_close_on_exec(ctx->wakeup[1]);
+  return 1;
+}
+
+// Register interest in the next event of a socket. A one-shot note is
+// removed once its event is reported, so a connection handed to a worker
+// has no note left.
+static int watch_socket(struct mg_context *ctx, SOCKET sock, int filter,
+                        int flags, void *udata) {
+  struct kevent kev;
+
+  EV_SET(&kev, sock, filter, EV_ADD | flags, 0, 0, udata);
+  return kevent(ctx->kq, &kev, 1, NULL, 0, NULL) == 0;
+}
+
+static int arm_connection(struct mg_connection *conn) {
+  return watch_socket(conn->ctx, conn->client.sock,
+                      conn->state == CONN_SENDING ? EVFILT_WRITE : EVFILT_READ,
+                      EV_ONESHOT, conn);
+}
+#else
+static int open_event_loop(struct mg_context *ctx) {
+  cry(fc(ctx), "%s", "event_loop is not supported on this platform");
+  return 0;
+}
+
+static int arm_connection(struct mg_connection *conn) {
+  (void) conn;
+  return 0;
+}
+#endif // USE_KQUEUE
+
+static void end_file_data(struct mg_connection *conn) {
+  if (conn->file.membuf == NULL) {
+    free(conn->out);
+  }
+  if (conn->cached != NULL) {
+    cache_release(conn->ctx, conn->cached);
+    conn->cached = NULL;
+  }
+  mg_fclose(&conn->file);
+  memset(&conn->file, 0, sizeof(conn->file));
+  conn->out = NULL;
+  conn->out_off = conn->out_len = 0;
+  conn->file_left = 0;
+}
+
+static void free_connection(struct mg_connection *conn) {
+  end_file_data(conn);
+  close_connection(conn);
+  free(conn);
+}
+
+static int is_request_buffered(const struct mg_connection *conn) {
+  // A full buffer is handed to the worker which reports the error
+  return get_request_len(conn->buf, conn->data_len) != 0 ||
+    conn->data_len == conn->buf_size;
+}
+
+// Master thread passes a connection with a complete request to the workers
+static void dispatch_connection(struct mg_connection *conn) {
+  struct mg_context *ctx = conn->ctx;
+
+  conn->next = NULL;
+  (void) pthread_mutex_lock(&ctx->mutex);
+  *ctx->ready_tail = conn;
+  ctx->ready_tail = &conn->next;
+  (void) pthread_cond_signal(&ctx->sq_full);
+  (void) pthread_mutex_unlock(&ctx->mutex);
+}
+
+// Worker threads take connections from the ready list. Return NULL if we're
+// stopping.
+static struct mg_connection *consume_connection(struct mg_context *ctx) {
+  struct mg_connection *conn = NULL;
+
+  (void) pthread_mutex_lock(&ctx->mutex);
+  while (ctx->ready == NULL && ctx->stop_flag == 0) {
+    pthread_cond_wait(&ctx->sq_full, &ctx->mutex);
+  }
+  if (ctx->stop_flag == 0) {
+    conn = ctx->ready;
+    if ((ctx->ready = conn->next) == NULL) {
+      ctx->ready_tail = &ctx->ready;
+    }
+  }
+  (void) pthread_mutex_unlock(&ctx->mutex);
+
+  return conn;
+}
+
+// Worker threads give connections back to the master thread
+static void return_connection(struct mg_connection *conn) {
+  struct mg_context *ctx = conn->ctx;
+
+  (void) pthread_mutex_lock(&ctx->mutex);
+  conn->next = ctx->done;
+  ctx->done = conn;
+  (void) pthread_mutex_unlock(&ctx->mutex);
+  (void) send(ctx->wakeup[1], "", 1, 0);
+}
+
+static void *event_worker_thread(void *thread_func_param) {
+  struct mg_context *ctx = (struct mg_context *) thread_func_param;
+  struct mg_connection *conn;
+  int keep_alive;
+
+  while ((conn = consume_connection(ctx)) != NULL) {
+    set_blocking_mode(conn->client.sock);
+
+    if (conn->client.is_ssl) {
+      // SSL connections are served from start to end by a worker
+#ifndef NO_SSL
+      if (sslize(conn, conn->ctx->ssl_ctx, SSL_accept)) {
+        process_new_connection(conn);
+      }
+#endif
+      free_connection(conn);
+      continue;
+    }
+
+    // Serve pipelined requests right away
+    do {
+      keep_alive = process_request(conn);
+    } while (keep_alive && conn->out == NULL && is_request_buffered(conn));
+
+    if (keep_alive || conn->out != NULL) {
+      conn->must_close = !keep_alive;
+      return_connection(conn);
+    } else {
+      free_connection(conn);
+    }
+  }
+
+  worker_exiting(ctx);
+  return NULL;
+}
+
+// Add a connection to the set of the master thread. Return 0 on failure.
+static int add_connection(struct mg_context *ctx, struct mg_connection *conn) {
+  struct mg_connection **conns;
+  int n;
+
+  if (ctx->num_conns == ctx->max_conns) {
+    n = ctx->max_conns * 2 + 16;
+    if ((conns = (struct mg_connection **)
+         realloc(ctx->conns, n * sizeof(conns[0]))) == NULL) {
+      cry(fc(ctx), "%s", "Cannot grow connection set, OOM");
+      return 0;
+    }
+    ctx->conns = conns;
+    ctx->max_conns = n;
+  }
+
+  set_non_blocking_mode(conn->client.sock);
+  conn->state = conn->out != NULL ? CONN_SENDING : CONN_READING;
+  conn->last_io = time(NULL);
+  if (!arm_connection(conn)) {
+    return 0;
+  }
+  conn->slot = ctx->num_conns;
+  ctx->conns[ctx->num_conns++] = conn;
+  return 1;
+}
+
+// Remove a connection from the set of the master thread. The last
+// connection takes its slot.
+static void remove_connection(struct mg_connection *conn) {
+  struct mg_context *ctx = conn->ctx;
+  struct mg_connection *last = ctx->conns[--ctx->num_conns];
+
+  ctx->conns[conn->slot] = last;
+  last->slot = conn->slot;
+}
+
+static void park_new_connection(struct mg_context *ctx,
+                                const struct socket *sp) {
+  struct mg_connection *conn;
+
+  if ((conn = new_connection(ctx)) == NULL) {
+    closesocket(sp->sock);
+  } else {
+    set_client(conn, sp);
+    if (conn->client.is_ssl) {
+      dispatch_connection(conn);
+    } else if (!add_connection(ctx, conn)) {
+      free_connection(conn);
+    }
+  }
+}
+
+// Receive request data without blocking. Return 0 on error or EOF.
+static int read_connection(struct mg_connection *conn) {
+  int n;
+
+  n = recv(conn->client.sock, conn->buf + conn->data_len,
+           (size_t) (conn->buf_size - conn->data_len), 0);
+  if (n > 0) {
+    conn->data_len += n;
+  }
+
+  return n > 0 || (n < 0 && WOULD_BLOCK(ERRNO));
+}
+
+// Send the deferred file data until the socket would block. Return 0 on
+// error.
+static int write_connection(struct mg_connection *conn) {
+  int n;
+
+  for (;;) {
+    if (conn->out_off == conn->out_len) {
+      if (conn->file_left == 0) {
+        return 1;
+      }
+      n = conn->file_left > MG_BUF_LEN ? MG_BUF_LEN : (int) conn->file_left;
+      if ((n = (int) fread(conn->out, 1, (size_t) n, conn->file.fp)) <= 0) {
+        return 0;
+      }
+      conn->out_off = 0;
+      conn->out_len = n;
+      conn->file_left -= n;
+    }
+
+    n = send(conn->client.sock, conn->out + conn->out_off,
+             (size_t) (conn->out_len - conn->out_off), MSG_NOSIGNAL);
+    if (n <= 0) {
+      return n < 0 && WOULD_BLOCK(ERRNO);
+    }
+    conn->out_off += n;
+  }
+}
+
+// Handle an event of a connection owned by the master thread. Afterwards,
+// the connection either waits for its next event or has left the master
+// thread.
+static void serve_connection(struct mg_connection *conn, time_t now) {
+  if (!(conn->state == CONN_SENDING ? write_connection(conn) :
+        read_connection(conn))) {
+    remove_connection(conn);
+    free_connection(conn);
+    return;
+  }
+  conn->last_io = now;
+
+  if (conn->state == CONN_SENDING && conn->file_left == 0 &&
+      conn->out_off == conn->out_len) {
+    end_file_data(conn);
+    if (conn->must_close) {
+      remove_connection(conn);
+      free_connection(conn);
+      return;
+    }
+    conn->state = CONN_READING;
+  }
+
+  if (conn->state == CONN_READING && is_request_buffered(conn)) {
+    remove_connection(conn);
+    dispatch_connection(conn);
+  } else if (!arm_connection(conn)) {
+    remove_connection(conn);
+    free_connection(conn);
+  }
+}
+
+// Close the connections without activity within the request timeout
+static void expire_connections(struct mg_context *ctx, time_t now,
+                               int timeout) {
+  struct mg_connection *conn;
+  int i;
+
+  // Walk backwards, a removed connection is replaced by the last one
+  for (i = ctx->num_conns - 1; i >= 0; i--) {
+    conn = ctx->conns[i];
+    if (now - conn->last_io > timeout) {
+      remove_connection(conn);
+      free_connection(conn);
+    }
+  }
+}
+
 static void accept_new_connection(const struct socket *listener,
                                   struct mg_context *ctx) {
   struct socket so;
@@ -5330,7 +6284,110 @@ static void accept_new_connection(const struct socket *listener,
     // Thanks to Igor Klopov who suggested the patch.
     setsockopt(so.sock, SOL_SOCKET, SO_KEEPALIVE, (void *) &on, sizeof(on));
     set_sock_timeout(so.sock, atoi(ctx->config[REQUEST_TIMEOUT]));
-    produce_socket(ctx, &so);
+    if (ctx->event_loop) {
+      park_new_connection(ctx, &so);
+    } else {
+      produce_socket(ctx, &so);
+    }
+  }
+}
+
+#if defined(USE_KQUEUE)
+static void event_loop(struct mg_context *ctx) {
+  struct kevent events[64];
+  struct timespec ts;
+  struct mg_connection *conn, *done;
+  int i, j, n, timeout;
+  time_t now, last_expire;
+  char buf[16];
+
+  if ((timeout = atoi(ctx->config[REQUEST_TIMEOUT]) / 1000) < 1) {
+    timeout = 1;
+  }
+
+  // The listening and wakeup sockets stay registered
+  for (i = 0; i < ctx->num_listening_sockets; i++) {
+    if (!watch_socket(ctx, ctx->listening_sockets[i].sock, EVFILT_READ, 0,
+                      NULL)) {
+      cry(fc(ctx), "%s: %s", __func__, strerror(ERRNO));
+    }
+  }
+  if (!watch_socket(ctx, ctx->wakeup[0], EVFILT_READ, 0, NULL)) {
+    cry(fc(ctx), "%s: %s", __func__, strerror(ERRNO));
+  }
+
+  ts.tv_sec = 0;
+  ts.tv_nsec = 200 * 1000 * 1000;
+  last_expire = time(NULL);
+
+  while (ctx->stop_flag == 0) {
+    // Take back the connections of the workers
+    (void) pthread_mutex_lock(&ctx->mutex);
+    done = ctx->done;
+    ctx->done = NULL;
+    (void) pthread_mutex_unlock(&ctx->mutex);
+    while ((conn = done) != NULL) {
+      done = conn->next;
+      if (!add_connection(ctx, conn)) {
+        free_connection(conn);
+      }
+    }
+
+    if ((n = kevent(ctx->kq, NULL, 0, events, ARRAY_SIZE(events), &ts)) < 0) {
+      n = 0;
+    }
+    now = time(NULL);
+
+    for (i = 0; i < n; i++) {
+      if ((conn = (struct mg_connection *) events[i].udata) != NULL) {
+        serve_connection(conn, now);
+      } else if ((SOCKET) events[i].ident == ctx->wakeup[0]) {
+        // Drain the wakeup datagrams
+        while (recv(ctx->wakeup[0], buf, sizeof(buf), 0) > 0) {
+        }
+      } else {
+        for (j = 0; j < ctx->num_listening_sockets; j++) {
+          if (ctx->stop_flag == 0 &&
+              (SOCKET) events[i].ident == ctx->listening_sockets[j].sock) {
+            accept_new_connection(&ctx->listening_sockets[j], ctx);
+          }
+        }
+      }
+    }
+
+    if (now != last_expire) {
+      expire_connections(ctx, now, timeout);
+      last_expire = now;
+    }
+  }
+
+  for (i = 0; i < ctx->num_conns; i++) {
+    free_connection(ctx->conns[i]);
+  }
+  free(ctx->conns);
+  ctx->conns = NULL;
+  ctx->num_conns = ctx->max_conns = 0;
+}
+#else
+static void event_loop(struct mg_context *ctx) {
+  (void) ctx;
+}
+#endif // USE_KQUEUE
+
+// Release the connections left in the ready and done lists after all
+// workers exited.
+static void free_event_loop_connections(struct mg_context *ctx) {
+  struct mg_connection *conn;
+
+  while ((conn = ctx->ready) != NULL) {
+    ctx->ready = conn->next;
+    free_connection(conn);
+  }
+  ctx->ready_tail = &ctx->ready;
+
+  while ((conn = ctx->done) != NULL) {
+    ctx->done = conn->next;
+    free_connection(conn);
   }
 }
 
@@ -5350,7 +6407,13 @@ static void *master_thread(void *thread_func_param) {
   pthread_setschedparam(pthread_self(), SCHED_RR, &sched_param);
 #endif
 
-  pfd = (struct pollfd *) calloc(ctx->num_listening_sockets, sizeof(pfd[0]));
+  if (ctx->event_loop) {
+    event_loop(ctx);
+    pfd = NULL;
+  } else {
+    pfd = (struct pollfd *) calloc(ctx->num_listening_sockets,
+                                   sizeof(pfd[0]));
+  }
   while (pfd != NULL && ctx->stop_flag == 0) {
     for (i = 0; i < ctx->num_listening_sockets; i++) {
       pfd[i].fd = ctx->listening_sockets[i].sock;
@@ -5385,8 +6448,13 @@ static void *master_thread(void *thread_func_param) {
   }
   (void) pthread_mutex_unlock(&ctx->mutex);
 
+  if (ctx->event_loop) {
+    free_event_loop_connections(ctx);
+  }
+
   // All threads exited, no sync is needed. Destroy mutex and condvars
   (void) pthread_mutex_destroy(&ctx->mutex);
+  (void) pthread_mutex_destroy(&ctx->cache_mutex);
   (void) pthread_cond_destroy(&ctx->cond);
   (void) pthread_cond_destroy(&ctx->sq_empty);
   (void) pthread_cond_destroy(&ctx->sq_full);
@@ -5412,6 +6480,9 @@ static void free_context(struct mg_context *ctx) {
       free(ctx->config[i]);
   }
 
+  close_event_loop(ctx);
+  free_cache(ctx);
+
 #ifndef NO_SSL
   // Deallocate SSL context
   if (ctx->ssl_ctx != NULL) {
@@ -5461,6 +6532,9 @@ struct mg_context *mg_start(const struct mg_callbacks *callbacks,
   }
   ctx->callbacks = *callbacks;
   ctx->user_data = user_data;
+  ctx->wakeup[0] = ctx->wakeup[1] = INVALID_SOCKET;
+  ctx->kq = -1;
+  ctx->ready_tail = &ctx->ready;
 
   while (options && (name = *options++) != NULL) {
     if ((i = get_option_index(name)) == -1) {
@@ -5488,9 +6562,12 @@ struct mg_context *mg_start(const struct mg_callbacks *callbacks,
     }
   }
 
+  ctx->event_loop = !mg_strcasecmp(ctx->config[EVENT_LOOP], "yes");
+
   // NOTE(lsm): order is important here. SSL certificates must
   // be initialized before listening ports. UID must be set last.
-  if (!set_gpass_option(ctx) ||
+  if ((ctx->event_loop && !open_event_loop(ctx)) ||
+      !set_gpass_option(ctx) ||
 #if !defined(NO_SSL)
       !set_ssl_option(ctx) ||
 #endif
@@ -5498,7 +6575,8 @@ struct mg_context *mg_start(const struct mg_callbacks *callbacks,
 #if !defined(_WIN32)
       !set_uid_option(ctx) ||
 #endif
-      !set_acl_option(ctx)) {
+      !set_acl_option(ctx) ||
+      !set_cache_option(ctx)) {
     free_context(ctx);
     return NULL;
   }
@@ -5512,6 +6590,7 @@ struct mg_context *mg_start(const struct mg_callbacks *callbacks,
 #endif // !_WIN32
 
   (void) pthread_mutex_init(&ctx->mutex, NULL);
+  (void) pthread_mutex_init(&ctx->cache_mutex, NULL);
   (void) pthread_cond_init(&ctx->cond, NULL);
   (void) pthread_cond_init(&ctx->sq_empty, NULL);
   (void) pthread_cond_init(&ctx->sq_full, NULL);
@@ -5521,7 +6600,8 @@ struct mg_context *mg_start(const struct mg_callbacks *callbacks,
 
   // Start worker threads
   for (i = 0; i < atoi(ctx->config[NUM_THREADS]); i++) {
-    if (mg_start_thread(worker_thread, ctx) != 0) {
+    if (mg_start_thread(ctx->event_loop ? event_worker_thread : worker_thread,
+                        ctx) != 0) {
       cry(fc(ctx), "Cannot start worker thread: %ld", (long) ERRNO);
     } else {
       ctx->num_threads++;
@@ -33,11 +33,11 @@ bool _POSIX_Mutex_Auto_initialization( POSIX_Mutex_Control *the_mutex )
   zero |= the_mutex->flags;
 #if defined(RTEMS_SMP)
   zero |= _Atomic_Load_uint(
-    &the_mutex->Recursive.Mutex.Queue.Queue.Lock.next_ticket,
+    &the_mutex->Recursive.Mutex.Queue.Queue.Lock.Ticket_lock.next_ticket,
     ATOMIC_ORDER_RELAXED
   );
   zero |= _Atomic_Load_uint(
-    &the_mutex->Recursive.Mutex.Queue.Queue.Lock.now_serving,
+    &the_mutex->Recursive.Mutex.Queue.Queue.Lock.Ticket_lock.now_serving,
     ATOMIC_ORDER_RELAXED
   );
 #else
@@ -71,7 +71,8 @@ int pthread_spin_lock( pthread_spinlock_t *spinlock )
   _SMP_ticket_lock_Acquire(
     &the_spinlock->Lock,
     &cpu_self->Lock_stats,
-    &cpu_self->Lock_stats_context
+    &cpu_self->Lock_stats_context,
+    RTEMS_RETURN_ADDRESS()
   );
 #endif
   the_spinlock->interrupt_state = level;
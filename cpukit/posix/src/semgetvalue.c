@@ -25,17 +25,11 @@ int sem_getvalue(
   int    *__restrict sval
 )
 {
-  Sem_Control          *sem;
-  ISR_Level             level;
-  Thread_queue_Context  queue_context;
+  Sem_Control *sem;
 
   POSIX_SEMAPHORE_VALIDATE_OBJECT( _sem );
 
   sem = _Sem_Get( &_sem->_Semaphore );
-  _Thread_queue_Context_initialize( &queue_context );
-  _Thread_queue_Context_ISR_disable( &queue_context, level );
-  _Sem_Queue_acquire_critical( sem, &queue_context );
-  *sval = (int) sem->count;
-  _Sem_Queue_release( sem, level, &queue_context );
+  *sval = (int) _Sem_Get_count( sem );
   return 0;
 }
@@ -38,10 +38,10 @@ int sem_post( sem_t *_sem )
   _Sem_Queue_acquire_critical( sem, &queue_context );
 
   heads = sem->Queue.Queue.heads;
-  count = sem->count;
+  count = _Sem_Get_count( sem );
 
   if ( RTEMS_PREDICT_TRUE( heads == NULL && count < SEM_VALUE_MAX ) ) {
-    sem->count = count + 1;
+    _Sem_Increment( sem );
     _Sem_Queue_release( sem, level, &queue_context );
     return 0;
   }
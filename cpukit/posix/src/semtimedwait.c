@@ -36,18 +36,20 @@ int sem_timedwait(
   Thread_queue_Context  queue_context;
   ISR_Level             level;
   Thread_Control       *executing;
-  unsigned int          count;
 
   POSIX_SEMAPHORE_VALIDATE_OBJECT( _sem );
 
   sem = _Sem_Get( &_sem->_Semaphore );
+
+  if ( RTEMS_PREDICT_TRUE( _Sem_Try_decrement( sem ) ) ) {
+    return 0;
+  }
+
   _Thread_queue_Context_initialize( &queue_context );
   _Thread_queue_Context_ISR_disable( &queue_context, level );
   executing = _Sem_Queue_acquire_critical( sem, &queue_context );
 
-  count = sem->count;
-  if ( RTEMS_PREDICT_TRUE( count > 0 ) ) {
-    sem->count = count - 1;
+  if ( _Sem_Try_decrement( sem ) ) {
     _Sem_Queue_release( sem, level, &queue_context );
     return 0;
   } else {
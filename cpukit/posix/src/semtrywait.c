@@ -22,25 +22,15 @@
 
 int sem_trywait( sem_t *_sem )
 {
-  Sem_Control          *sem;
-  Thread_queue_Context  queue_context;
-  ISR_Level             level;
-  unsigned int          count;
+  Sem_Control *sem;
 
   POSIX_SEMAPHORE_VALIDATE_OBJECT( _sem );
 
   sem = _Sem_Get( &_sem->_Semaphore );
-  _Thread_queue_Context_initialize( &queue_context );
-  _Thread_queue_Context_ISR_disable( &queue_context, level );
-  _Sem_Queue_acquire_critical( sem, &queue_context );
-
-  count = sem->count;
-  if ( RTEMS_PREDICT_TRUE( count > 0 ) ) {
-    sem->count = count - 1;
-    _Sem_Queue_release( sem, level, &queue_context );
+
+  if ( RTEMS_PREDICT_TRUE( _Sem_Try_decrement( sem ) ) ) {
     return 0;
-  } else {
-    _Sem_Queue_release( sem, level, &queue_context );
-    rtems_set_errno_and_return_minus_one( EAGAIN );
   }
+
+  rtems_set_errno_and_return_minus_one( EAGAIN );
 }
@@ -40,7 +40,7 @@ long sysconf(
     case _SC_CLK_TCK:
       return (long) rtems_clock_get_ticks_per_second();
     case _SC_OPEN_MAX:
-      return rtems_libio_number_iops;
+      return (long) rtems_libio_iop_get_table_size();
     case _SC_GETPW_R_SIZE_MAX:
       return 1024;
     case _SC_PAGESIZE:
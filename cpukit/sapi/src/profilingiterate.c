@@ -24,6 +24,13 @@
 
 #include <string.h>
 
+#ifdef RTEMS_PROFILING
+RTEMS_STATIC_ASSERT(
+  RTEMS_PROFILING_LATENCY_BUCKETS == PER_CPU_STATS_LATENCY_BUCKETS,
+  latency_buckets
+);
+#endif
+
 static void per_cpu_stats_iterate(
   rtems_profiling_visitor visitor,
   void *visitor_arg,
@@ -33,9 +40,18 @@ static void per_cpu_stats_iterate(
 #ifdef RTEMS_PROFILING
   uint32_t n = rtems_get_processor_count();
   uint32_t i;
+  CPU_Counter_ticks bound;
 
   memset(data, 0, sizeof(*data));
   data->header.type = RTEMS_PROFILING_PER_CPU;
+
+  bound = PER_CPU_STATS_LATENCY_FIRST_BOUND;
+  for (i = 1; i < RTEMS_PROFILING_LATENCY_BUCKETS; ++i) {
+    data->per_cpu.latency_lower_bounds[i] =
+      rtems_counter_ticks_to_nanoseconds(bound);
+    bound *= 4;
+  }
+
   for (i = 0; i < n; ++i) {
     const Per_CPU_Control *per_cpu = _Per_CPU_Get_by_index(i);
     const Per_CPU_Stats *stats = &per_cpu->Stats;
@@ -69,6 +85,24 @@ static void per_cpu_stats_iterate(
         stats->total_interrupt_time
       );
 
+    memcpy(
+      &per_cpu_data->interrupt_delay_histogram[0],
+      &stats->interrupt_delay_histogram[0],
+      sizeof(per_cpu_data->interrupt_delay_histogram)
+    );
+
+    memcpy(
+      &per_cpu_data->thread_dispatch_disabled_histogram[0],
+      &stats->thread_dispatch_disabled_histogram[0],
+      sizeof(per_cpu_data->thread_dispatch_disabled_histogram)
+    );
+
+    memcpy(
+      &per_cpu_data->unblock_to_run_histogram[0],
+      &stats->unblock_to_run_histogram[0],
+      sizeof(per_cpu_data->unblock_to_run_histogram)
+    );
+
     (*visitor)(visitor_arg, data);
   }
 #else
@@ -138,6 +172,82 @@ static void smp_lock_stats_iterate(
 #endif
 }
 
+#if defined(RTEMS_PROFILING) && defined(RTEMS_SMP)
+RTEMS_STATIC_ASSERT(
+  RTEMS_PROFILING_SMP_LOCK_WAIT_TIME_BUCKETS
+    == SMP_LOCK_STATS_WAIT_TIME_BUCKETS,
+  smp_lock_wait_time_buckets
+);
+#endif
+
+static void smp_lock_call_site_stats_iterate(
+  rtems_profiling_visitor visitor,
+  void *visitor_arg,
+  rtems_profiling_data *data
+)
+{
+#if defined(RTEMS_PROFILING) && defined(RTEMS_SMP)
+  uint32_t n = rtems_get_processor_count();
+  uint32_t cpu_index;
+  rtems_profiling_smp_lock_call_site *call_site_data;
+  CPU_Counter_ticks bound;
+  char name[64];
+  size_t i;
+
+  memset(data, 0, sizeof(*data));
+  data->header.type = RTEMS_PROFILING_SMP_LOCK_CALL_SITE;
+  call_site_data = &data->smp_lock_call_site;
+  call_site_data->name = name;
+
+  bound = SMP_LOCK_STATS_WAIT_TIME_FIRST_BOUND;
+  for (i = 1; i < RTEMS_PROFILING_SMP_LOCK_WAIT_TIME_BUCKETS; ++i) {
+    call_site_data->wait_time_lower_bounds[i] =
+      rtems_counter_ticks_to_nanoseconds(bound);
+    bound *= 8;
+  }
+
+  for (cpu_index = 0; cpu_index < n; ++cpu_index) {
+    SMP_lock_Call_site_stats snapshot;
+    size_t index = 0;
+
+    call_site_data->processor_index = cpu_index;
+
+    while (
+      _SMP_lock_Stats_call_site_next(
+        cpu_index,
+        &index,
+        &snapshot,
+        &name[0],
+        sizeof(name)
+      )
+    ) {
+      call_site_data->call_site = snapshot.call_site;
+      call_site_data->contention_count = snapshot.contention_count;
+      call_site_data->max_wait_time =
+        rtems_counter_ticks_to_nanoseconds(snapshot.max_wait_time);
+      call_site_data->max_hold_time =
+        rtems_counter_ticks_to_nanoseconds(snapshot.max_hold_time);
+      call_site_data->total_wait_time =
+        rtems_counter_ticks_to_nanoseconds(snapshot.total_wait_time);
+      call_site_data->total_hold_time =
+        rtems_counter_ticks_to_nanoseconds(snapshot.total_hold_time);
+
+      memcpy(
+        &call_site_data->wait_time_histogram[0],
+        &snapshot.wait_time_histogram[0],
+        sizeof(call_site_data->wait_time_histogram)
+      );
+
+      (*visitor)(visitor_arg, data);
+    }
+  }
+#else
+  (void) visitor;
+  (void) visitor_arg;
+  (void) data;
+#endif
+}
+
 void rtems_profiling_iterate(
   rtems_profiling_visitor visitor,
   void *visitor_arg
@@ -147,4 +257,5 @@ void rtems_profiling_iterate(
 
   per_cpu_stats_iterate(visitor, visitor_arg, &data);
   smp_lock_stats_iterate(visitor, visitor_arg, &data);
+  smp_lock_call_site_stats_iterate(visitor, visitor_arg, &data);
 }
@@ -53,6 +53,36 @@ static uint64_t arithmetic_mean(uint64_t total, uint64_t count)
   return count != 0 ? total / count : 0;
 }
 
+static void report_latency_histogram(
+  context *ctx,
+  const char *name,
+  const rtems_profiling_per_cpu *per_cpu,
+  const uint32_t *histogram
+)
+{
+  int rv;
+  uint32_t i;
+
+  indent(ctx, 2);
+  rv = rtems_printf(ctx->printer, "<%s>\n", name);
+  update_retval(ctx, rv);
+
+  for (i = 0; i < RTEMS_PROFILING_LATENCY_BUCKETS; ++i) {
+    indent(ctx, 3);
+    rv = rtems_printf(
+      ctx->printer,
+      "<Count lowerBound=\"%" PRIu32 "\" unit=\"ns\">%" PRIu32 "</Count>\n",
+      per_cpu->latency_lower_bounds[i],
+      histogram[i]
+    );
+    update_retval(ctx, rv);
+  }
+
+  indent(ctx, 2);
+  rv = rtems_printf(ctx->printer, "</%s>\n", name);
+  update_retval(ctx, rv);
+}
+
 static void report_per_cpu(context *ctx, const rtems_profiling_per_cpu *per_cpu)
 {
   int rv;
@@ -148,6 +178,27 @@ static void report_per_cpu(context *ctx, const rtems_profiling_per_cpu *per_cpu)
   );
   update_retval(ctx, rv);
 
+  report_latency_histogram(
+    ctx,
+    "InterruptDelayHistogram",
+    per_cpu,
+    per_cpu->interrupt_delay_histogram
+  );
+
+  report_latency_histogram(
+    ctx,
+    "ThreadDispatchDisabledTimeHistogram",
+    per_cpu,
+    per_cpu->thread_dispatch_disabled_histogram
+  );
+
+  report_latency_histogram(
+    ctx,
+    "UnblockToRunLatencyHistogram",
+    per_cpu,
+    per_cpu->unblock_to_run_histogram
+  );
+
   indent(ctx, 1);
   rv = rtems_printf(
     ctx->printer,
@@ -253,6 +304,107 @@ static void report_smp_lock(context *ctx, const rtems_profiling_smp_lock *smp_lo
   update_retval(ctx, rv);
 }
 
+static void report_smp_lock_call_site(
+  context *ctx,
+  const rtems_profiling_smp_lock_call_site *call_site
+)
+{
+  int rv;
+  uint32_t i;
+
+  indent(ctx, 1);
+  rv = rtems_printf(
+    ctx->printer,
+    "<SMPLockCallSiteProfilingReport name=\"%s\" callSite=\"%p\" "
+      "processorIndex=\"%" PRIu32 "\">\n",
+    call_site->name,
+    call_site->call_site,
+    call_site->processor_index
+  );
+  update_retval(ctx, rv);
+
+  indent(ctx, 2);
+  rv = rtems_printf(
+    ctx->printer,
+    "<MaxWaitTime unit=\"ns\">%" PRIu32 "</MaxWaitTime>\n",
+    call_site->max_wait_time
+  );
+  update_retval(ctx, rv);
+
+  indent(ctx, 2);
+  rv = rtems_printf(
+    ctx->printer,
+    "<MaxHoldTime unit=\"ns\">%" PRIu32 "</MaxHoldTime>\n",
+    call_site->max_hold_time
+  );
+  update_retval(ctx, rv);
+
+  indent(ctx, 2);
+  rv = rtems_printf(
+    ctx->printer,
+    "<MeanWaitTime unit=\"ns\">%" PRIu64 "</MeanWaitTime>\n",
+    arithmetic_mean(
+      call_site->total_wait_time,
+      call_site->contention_count
+    )
+  );
+  update_retval(ctx, rv);
+
+  indent(ctx, 2);
+  rv = rtems_printf(
+    ctx->printer,
+    "<MeanHoldTime unit=\"ns\">%" PRIu64 "</MeanHoldTime>\n",
+    arithmetic_mean(
+      call_site->total_hold_time,
+      call_site->contention_count
+    )
+  );
+  update_retval(ctx, rv);
+
+  indent(ctx, 2);
+  rv = rtems_printf(
+    ctx->printer,
+    "<TotalWaitTime unit=\"ns\">%" PRIu64 "</TotalWaitTime>\n",
+    call_site->total_wait_time
+  );
+  update_retval(ctx, rv);
+
+  indent(ctx, 2);
+  rv = rtems_printf(
+    ctx->printer,
+    "<TotalHoldTime unit=\"ns\">%" PRIu64 "</TotalHoldTime>\n",
+    call_site->total_hold_time
+  );
+  update_retval(ctx, rv);
+
+  indent(ctx, 2);
+  rv = rtems_printf(
+    ctx->printer,
+    "<ContentionCount>%" PRIu64 "</ContentionCount>\n",
+    call_site->contention_count
+  );
+  update_retval(ctx, rv);
+
+  for (i = 0; i < RTEMS_PROFILING_SMP_LOCK_WAIT_TIME_BUCKETS; ++i) {
+    indent(ctx, 2);
+    rv = rtems_printf(
+      ctx->printer,
+      "<WaitTimeCount lowerBound=\"%" PRIu32 "\" unit=\"ns\">%"
+        PRIu32 "</WaitTimeCount>\n",
+      call_site->wait_time_lower_bounds[i],
+      call_site->wait_time_histogram[i]
+    );
+    update_retval(ctx, rv);
+  }
+
+  indent(ctx, 1);
+  rv = rtems_printf(
+    ctx->printer,
+    "</SMPLockCallSiteProfilingReport>\n"
+  );
+  update_retval(ctx, rv);
+}
+
 static void report(void *arg, const rtems_profiling_data *data)
 {
   context *ctx = arg;
@@ -264,6 +416,9 @@ static void report(void *arg, const rtems_profiling_data *data)
     case RTEMS_PROFILING_SMP_LOCK:
       report_smp_lock(ctx, &data->smp_lock);
       break;
+    case RTEMS_PROFILING_SMP_LOCK_CALL_SITE:
+      report_smp_lock_call_site(ctx, &data->smp_lock_call_site);
+      break;
   }
 }
 
@@ -271,14 +271,29 @@ static void _Condition_Wake( struct _Condition_Control *_condition, int count )
   Condition_Flush_context  context;
 
   condition = _Condition_Get( _condition );
-  _Thread_queue_Context_initialize( &context.Base );
-  _ISR_lock_ISR_disable( &context.Base.Lock_context.Lock_context );
-  _Condition_Queue_acquire_critical( condition, &context.Base );
 
   /*
    * In common uses cases of condition variables there are normally no threads
-   * on the queue, so check this condition early.
+   * on the queue, so check this condition early and without the queue lock.
+   * A thread is enqueued before it releases the mutex in _Condition_Wait().
+   * A thread which changed the state protected by this mutex observes the
+   * enqueued thread through the acquire and release of the mutex.
    */
+  if (
+    RTEMS_PREDICT_TRUE(
+      _Atomic_Load_uintptr(
+        (Atomic_Uintptr *) &condition->Queue.Queue.heads,
+        ATOMIC_ORDER_RELAXED
+      ) == 0
+    )
+  ) {
+    return;
+  }
+
+  _Thread_queue_Context_initialize( &context.Base );
+  _ISR_lock_ISR_disable( &context.Base.Lock_context.Lock_context );
+  _Condition_Queue_acquire_critical( condition, &context.Base );
+
   if (
     RTEMS_PREDICT_TRUE( _Thread_queue_Is_empty( &condition->Queue.Queue ) )
   ) {
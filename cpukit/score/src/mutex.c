@@ -23,6 +23,7 @@
 #include <rtems/score/muteximpl.h>
 #include <rtems/score/threadimpl.h>
 #include <rtems/score/todimpl.h>
+#include <rtems/counter.h>
 
 #define MUTEX_TQ_OPERATIONS &_Thread_queue_Operations_priority_inherit
 
@@ -37,6 +38,11 @@ RTEMS_STATIC_ASSERT(
   MUTEX_CONTROL_SIZE
 );
 
+RTEMS_STATIC_ASSERT(
+  sizeof( Atomic_Uintptr ) == sizeof( Thread_Control * ),
+  MUTEX_CONTROL_OWNER
+);
+
 RTEMS_STATIC_ASSERT(
   offsetof( Mutex_recursive_Control, Mutex )
     == offsetof( struct _Mutex_recursive_Control, _Mutex ),
@@ -60,6 +66,49 @@ static Mutex_Control *_Mutex_Get( struct _Mutex_Control *_mutex )
   return (Mutex_Control *) _mutex;
 }
 
+/*
+ * The owner changes from NULL to a thread without the queue lock, see
+ * _Mutex_Claim().  All other owner changes are done with the queue lock
+ * acquired.  Thus, a non-NULL owner observed with the queue lock acquired
+ * stays the owner until the queue lock is released.  This is required by the
+ * priority inheritance and the deadlock detection of the thread queues.
+ */
+static Atomic_Uintptr *_Mutex_Owner( Mutex_Control *mutex )
+{
+  return (Atomic_Uintptr *) &mutex->Queue.Queue.owner;
+}
+
+/*
+ * Tries to obtain the mutex if it has no owner.  Returns NULL in case of
+ * success, otherwise the current owner.
+ */
+static Thread_Control *_Mutex_Claim(
+  Mutex_Control  *mutex,
+  Thread_Control *executing
+)
+{
+  uintptr_t owner;
+
+  owner = 0;
+
+  if (
+    RTEMS_PREDICT_TRUE(
+      _Atomic_Compare_exchange_uintptr(
+        _Mutex_Owner( mutex ),
+        &owner,
+        (uintptr_t) executing,
+        ATOMIC_ORDER_ACQUIRE,
+        ATOMIC_ORDER_RELAXED
+      )
+    )
+  ) {
+    _Thread_Resource_count_increment( executing );
+    return NULL;
+  }
+
+  return (Thread_Control *) owner;
+}
+
 static Thread_Control *_Mutex_Queue_acquire_critical(
   Mutex_Control        *mutex,
   Thread_queue_Context *queue_context
@@ -90,6 +139,151 @@ static void _Mutex_Queue_release(
   _ISR_Local_enable( level );
 }
 
+#if defined(RTEMS_SMP)
+static Thread_Control *_Mutex_Load_owner( Mutex_Control *mutex )
+{
+  return (Thread_Control *)
+    _Atomic_Load_uintptr( _Mutex_Owner( mutex ), ATOMIC_ORDER_RELAXED );
+}
+
+static bool _Mutex_Is_executing_on(
+  const Thread_Control  *the_thread,
+  const Per_CPU_Control *cpu
+)
+{
+  return *(Thread_Control * const volatile *) &cpu->executing == the_thread;
+}
+#endif
+
+/*
+ * Called with the queue lock acquired in case the mutex is owned by another
+ * thread.  In SMP configurations with a configured spin time, spin outside
+ * the queue lock while the owner executes on another processor and no other
+ * thread waits for the mutex.  Returns NULL, if the mutex was obtained while
+ * spinning, otherwise the owner with the queue lock acquired.
+ */
+static Thread_Control *_Mutex_Contend(
+  Mutex_Control        *mutex,
+  Thread_Control       *owner,
+  Thread_Control       *executing,
+  Mutex_Statistics     *statistics,
+  ISR_Level            *level,
+  Thread_queue_Context *queue_context
+)
+{
+#if defined(RTEMS_SMP)
+  uint32_t spin_time;
+
+  spin_time = _Mutex_Spin_time;
+
+  if ( spin_time > 0 ) {
+    rtems_counter_ticks spin_ticks;
+    rtems_counter_ticks start;
+
+    spin_ticks = rtems_counter_nanoseconds_to_ticks( spin_time );
+    start = rtems_counter_read();
+
+    while ( true ) {
+      const Per_CPU_Control *cpu;
+
+      cpu = _Thread_Get_CPU( owner );
+
+      if (
+        owner == executing
+          || mutex->Queue.Queue.heads != NULL
+          || cpu->executing != owner
+          || rtems_counter_difference( rtems_counter_read(), start )
+            >= spin_ticks
+      ) {
+        break;
+      }
+
+      _Mutex_Queue_release( mutex, *level, queue_context );
+
+      while (
+        _Mutex_Load_owner( mutex ) == owner
+          && _Mutex_Is_executing_on( owner, cpu )
+          && rtems_counter_difference( rtems_counter_read(), start )
+            < spin_ticks
+      ) {
+        /* Wait */
+      }
+
+      owner = _Mutex_Claim( mutex, executing );
+
+      if ( owner != NULL ) {
+        _Thread_queue_Context_ISR_disable( queue_context, *level );
+        _Mutex_Queue_acquire_critical( mutex, queue_context );
+        owner = _Mutex_Claim( mutex, executing );
+
+        if ( owner == NULL ) {
+          _Mutex_Queue_release( mutex, *level, queue_context );
+        }
+      }
+
+      if ( owner == NULL ) {
+        if ( statistics != NULL ) {
+          _Atomic_Fetch_add_ulong(
+            &statistics->spin_acquired,
+            1,
+            ATOMIC_ORDER_RELAXED
+          );
+        }
+
+        return NULL;
+      }
+    }
+  }
+#endif
+
+  if ( statistics != NULL ) {
+    _Atomic_Fetch_add_ulong( &statistics->blocked, 1, ATOMIC_ORDER_RELAXED );
+  }
+
+  return owner;
+}
+
+/*
+ * Called after _Mutex_Claim() failed.  Returns NULL, if the mutex was
+ * obtained, otherwise the owner with the queue lock acquired.
+ */
+static Thread_Control *_Mutex_Lock_contended(
+  Mutex_Control        *mutex,
+  Thread_Control       *executing,
+  ISR_Level            *level,
+  Thread_queue_Context *queue_context
+)
+{
+  Mutex_Statistics *statistics;
+  Thread_Control   *owner;
+
+  /* Look up the statistics before interrupts are disabled */
+  statistics = _Mutex_Statistics_get( (struct _Mutex_Control *) mutex, true );
+
+  if ( statistics != NULL ) {
+    _Atomic_Fetch_add_ulong( &statistics->contended, 1, ATOMIC_ORDER_RELAXED );
+  }
+
+  _Thread_queue_Context_ISR_disable( queue_context, *level );
+  _Mutex_Queue_acquire_critical( mutex, queue_context );
+
+  owner = _Mutex_Claim( mutex, executing );
+
+  if ( owner == NULL ) {
+    _Mutex_Queue_release( mutex, *level, queue_context );
+    return NULL;
+  }
+
+  return _Mutex_Contend(
+    mutex,
+    owner,
+    executing,
+    statistics,
+    level,
+    queue_context
+  );
+}
+
 static void _Mutex_Acquire_slow(
   Mutex_Control        *mutex,
   Thread_Control       *owner,
@@ -125,12 +319,16 @@ static void _Mutex_Release_critical(
   Thread_queue_Heads *heads;
 
   heads = mutex->Queue.Queue.heads;
-  mutex->Queue.Queue.owner = NULL;
   _Thread_Resource_count_decrement( executing );
 
   if ( RTEMS_PREDICT_TRUE( heads == NULL ) ) {
+    _Atomic_Store_uintptr( _Mutex_Owner( mutex ), 0, ATOMIC_ORDER_RELEASE );
     _Mutex_Queue_release( mutex, level, queue_context );
   } else {
+    /*
+     * The surrender hands over the mutex directly to the first waiter.  A
+     * temporary NULL owner would allow _Mutex_Claim() to overtake it.
+     */
     _Thread_queue_Context_set_ISR_level( queue_context, level );
     _Thread_queue_Surrender(
       &mutex->Queue.Queue,
@@ -151,17 +349,16 @@ void _Mutex_Acquire( struct _Mutex_Control *_mutex )
   Thread_Control       *owner;
 
   mutex = _Mutex_Get( _mutex );
-  _Thread_queue_Context_initialize( &queue_context );
-  _Thread_queue_Context_ISR_disable( &queue_context, level );
-  executing = _Mutex_Queue_acquire_critical( mutex, &queue_context );
+  executing = _Thread_Get_executing();
 
-  owner = mutex->Queue.Queue.owner;
+  if ( RTEMS_PREDICT_TRUE( _Mutex_Claim( mutex, executing ) == NULL ) ) {
+    return;
+  }
 
-  if ( RTEMS_PREDICT_TRUE( owner == NULL ) ) {
-    mutex->Queue.Queue.owner = executing;
-    _Thread_Resource_count_increment( executing );
-    _Mutex_Queue_release( mutex, level, &queue_context );
-  } else {
+  _Thread_queue_Context_initialize( &queue_context );
+  owner = _Mutex_Lock_contended( mutex, executing, &level, &queue_context );
+
+  if ( owner != NULL ) {
     _Thread_queue_Context_set_enqueue_do_nothing_extra( &queue_context );
     _Mutex_Acquire_slow( mutex, owner, executing, level, &queue_context );
   }
@@ -179,56 +376,41 @@ int _Mutex_Acquire_timed(
   Thread_Control       *owner;
 
   mutex = _Mutex_Get( _mutex );
-  _Thread_queue_Context_initialize( &queue_context );
-  _Thread_queue_Context_ISR_disable( &queue_context, level );
-  executing = _Mutex_Queue_acquire_critical( mutex, &queue_context );
+  executing = _Thread_Get_executing();
 
-  owner = mutex->Queue.Queue.owner;
+  if ( RTEMS_PREDICT_TRUE( _Mutex_Claim( mutex, executing ) == NULL ) ) {
+    return 0;
+  }
 
-  if ( RTEMS_PREDICT_TRUE( owner == NULL ) ) {
-    mutex->Queue.Queue.owner = executing;
-    _Thread_Resource_count_increment( executing );
-    _Mutex_Queue_release( mutex, level, &queue_context );
+  _Thread_queue_Context_initialize( &queue_context );
+  owner = _Mutex_Lock_contended( mutex, executing, &level, &queue_context );
 
+  if ( owner == NULL ) {
     return 0;
-  } else {
-    _Thread_queue_Context_set_enqueue_timeout_realtime_timespec(
-      &queue_context,
-      abstime
-    );
-    _Mutex_Acquire_slow( mutex, owner, executing, level, &queue_context );
-
-    return STATUS_GET_POSIX( _Thread_Wait_get_status( executing ) );
   }
+
+  _Thread_queue_Context_set_enqueue_timeout_realtime_timespec(
+    &queue_context,
+    abstime
+  );
+  _Mutex_Acquire_slow( mutex, owner, executing, level, &queue_context );
+
+  return STATUS_GET_POSIX( _Thread_Wait_get_status( executing ) );
 }
 
 int _Mutex_Try_acquire( struct _Mutex_Control *_mutex )
 {
-  Mutex_Control        *mutex;
-  Thread_queue_Context  queue_context;
-  ISR_Level             level;
-  Thread_Control       *executing;
-  Thread_Control       *owner;
-  int                   eno;
+  Mutex_Control  *mutex;
+  Thread_Control *owner;
 
   mutex = _Mutex_Get( _mutex );
-  _Thread_queue_Context_initialize( &queue_context );
-  _Thread_queue_Context_ISR_disable( &queue_context, level );
-  executing = _Mutex_Queue_acquire_critical( mutex, &queue_context );
-
-  owner = mutex->Queue.Queue.owner;
+  owner = _Mutex_Claim( mutex, _Thread_Get_executing() );
 
   if ( RTEMS_PREDICT_TRUE( owner == NULL ) ) {
-    mutex->Queue.Queue.owner = executing;
-    _Thread_Resource_count_increment( executing );
-    eno = 0;
-  } else {
-    eno = EBUSY;
+    return 0;
   }
 
-  _Mutex_Queue_release( mutex, level, &queue_context );
-
-  return eno;
+  return EBUSY;
 }
 
 void _Mutex_Release( struct _Mutex_Control *_mutex )
@@ -259,25 +441,32 @@ void _Mutex_recursive_Acquire( struct _Mutex_recursive_Control *_mutex )
 {
   Mutex_recursive_Control *mutex;
   Thread_queue_Context     queue_context;
-  ISR_Level             level;
+  ISR_Level                level;
   Thread_Control          *executing;
   Thread_Control          *owner;
 
   mutex = _Mutex_recursive_Get( _mutex );
-  _Thread_queue_Context_initialize( &queue_context );
-  _Thread_queue_Context_ISR_disable( &queue_context, level );
-  executing = _Mutex_Queue_acquire_critical( &mutex->Mutex, &queue_context );
-
-  owner = mutex->Mutex.Queue.Queue.owner;
+  executing = _Thread_Get_executing();
+  owner = _Mutex_Claim( &mutex->Mutex, executing );
 
   if ( RTEMS_PREDICT_TRUE( owner == NULL ) ) {
-    mutex->Mutex.Queue.Queue.owner = executing;
-    _Thread_Resource_count_increment( executing );
-    _Mutex_Queue_release( &mutex->Mutex, level, &queue_context );
-  } else if ( owner == executing ) {
+    return;
+  }
+
+  if ( owner == executing ) {
     ++mutex->nest_level;
-    _Mutex_Queue_release( &mutex->Mutex, level, &queue_context );
-  } else {
+    return;
+  }
+
+  _Thread_queue_Context_initialize( &queue_context );
+  owner = _Mutex_Lock_contended(
+    &mutex->Mutex,
+    executing,
+    &level,
+    &queue_context
+  );
+
+  if ( owner != NULL ) {
     _Thread_queue_Context_set_enqueue_do_nothing_extra( &queue_context );
     _Mutex_Acquire_slow( &mutex->Mutex, owner, executing, level, &queue_context );
   }
@@ -295,64 +484,59 @@ int _Mutex_recursive_Acquire_timed(
   Thread_Control          *owner;
 
   mutex = _Mutex_recursive_Get( _mutex );
-  _Thread_queue_Context_initialize( &queue_context );
-  _Thread_queue_Context_ISR_disable( &queue_context, level );
-  executing = _Mutex_Queue_acquire_critical( &mutex->Mutex, &queue_context );
-
-  owner = mutex->Mutex.Queue.Queue.owner;
+  executing = _Thread_Get_executing();
+  owner = _Mutex_Claim( &mutex->Mutex, executing );
 
   if ( RTEMS_PREDICT_TRUE( owner == NULL ) ) {
-    mutex->Mutex.Queue.Queue.owner = executing;
-    _Thread_Resource_count_increment( executing );
-    _Mutex_Queue_release( &mutex->Mutex, level, &queue_context );
-
     return 0;
-  } else if ( owner == executing ) {
-    ++mutex->nest_level;
-    _Mutex_Queue_release( &mutex->Mutex, level, &queue_context );
+  }
 
+  if ( owner == executing ) {
+    ++mutex->nest_level;
     return 0;
-  } else {
-    _Thread_queue_Context_set_enqueue_timeout_realtime_timespec(
-      &queue_context,
-      abstime
-    );
-    _Mutex_Acquire_slow( &mutex->Mutex, owner, executing, level, &queue_context );
+  }
+
+  _Thread_queue_Context_initialize( &queue_context );
+  owner = _Mutex_Lock_contended(
+    &mutex->Mutex,
+    executing,
+    &level,
+    &queue_context
+  );
 
-    return STATUS_GET_POSIX( _Thread_Wait_get_status( executing ) );
+  if ( owner == NULL ) {
+    return 0;
   }
+
+  _Thread_queue_Context_set_enqueue_timeout_realtime_timespec(
+    &queue_context,
+    abstime
+  );
+  _Mutex_Acquire_slow( &mutex->Mutex, owner, executing, level, &queue_context );
+
+  return STATUS_GET_POSIX( _Thread_Wait_get_status( executing ) );
 }
 
 int _Mutex_recursive_Try_acquire( struct _Mutex_recursive_Control *_mutex )
 {
   Mutex_recursive_Control *mutex;
-  Thread_queue_Context     queue_context;
-  ISR_Level                level;
   Thread_Control          *executing;
   Thread_Control          *owner;
-  int                      eno;
 
   mutex = _Mutex_recursive_Get( _mutex );
-  _Thread_queue_Context_initialize( &queue_context );
-  _Thread_queue_Context_ISR_disable( &queue_context, level );
-  executing = _Mutex_Queue_acquire_critical( &mutex->Mutex, &queue_context );
-
-  owner = mutex->Mutex.Queue.Queue.owner;
+  executing = _Thread_Get_executing();
+  owner = _Mutex_Claim( &mutex->Mutex, executing );
 
   if ( RTEMS_PREDICT_TRUE( owner == NULL ) ) {
-    mutex->Mutex.Queue.Queue.owner = executing;
-    _Thread_Resource_count_increment( executing );
-    eno = 0;
-  } else if ( owner == executing ) {
-    ++mutex->nest_level;
-    eno = 0;
-  } else {
-    eno = EBUSY;
+    return 0;
   }
 
-  _Mutex_Queue_release( &mutex->Mutex, level, &queue_context );
+  if ( owner == executing ) {
+    ++mutex->nest_level;
+    return 0;
+  }
 
-  return eno;
+  return EBUSY;
 }
 
 void _Mutex_recursive_Release( struct _Mutex_recursive_Control *_mutex )
@@ -364,19 +548,20 @@ void _Mutex_recursive_Release( struct _Mutex_recursive_Control *_mutex )
   unsigned int             nest_level;
 
   mutex = _Mutex_recursive_Get( _mutex );
+  nest_level = mutex->nest_level;
+
+  /* Only the owner accesses the nest level */
+  if ( RTEMS_PREDICT_FALSE( nest_level > 0 ) ) {
+    _Assert( mutex->Mutex.Queue.Queue.owner == _Thread_Get_executing() );
+    mutex->nest_level = nest_level - 1;
+    return;
+  }
+
   _Thread_queue_Context_initialize( &queue_context );
   _Thread_queue_Context_ISR_disable( &queue_context, level );
   executing = _Mutex_Queue_acquire_critical( &mutex->Mutex, &queue_context );
 
   _Assert( mutex->Mutex.Queue.Queue.owner == executing );
 
-  nest_level = mutex->nest_level;
-
-  if ( RTEMS_PREDICT_TRUE( nest_level == 0 ) ) {
-    _Mutex_Release_critical( &mutex->Mutex, executing, level, &queue_context );
-  } else {
-    mutex->nest_level = nest_level - 1;
-
-    _Mutex_Queue_release( &mutex->Mutex, level, &queue_context );
-  }
+  _Mutex_Release_critical( &mutex->Mutex, executing, level, &queue_context );
 }
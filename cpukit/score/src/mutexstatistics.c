@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <rtems/thread.h>
+#include <rtems/score/muteximpl.h>
+
+/*
+ * Only this count of consecutive entries starting at the hash index is
+ * examined for a mutex, so that a lookup has a bounded execution time.
+ */
+#define MUTEX_STATISTICS_PROBES 4
+
+Mutex_Statistics_table _Mutex_Statistics_table;
+
+/*
+ * Lookups are lock-free.  Claims and releases of entries are serialized by
+ * this lock, so that a mutex has at most one entry.
+ */
+ISR_LOCK_DEFINE( static, _Mutex_Statistics_lock, "Mutex Statistics" )
+
+static Mutex_Statistics *_Mutex_Statistics_find(
+  uintptr_t          key,
+  Mutex_Statistics **free_entry
+)
+{
+  Mutex_Statistics *entries;
+  size_t            n;
+  size_t            index;
+  size_t            i;
+
+  entries = _Mutex_Statistics_table.entries;
+  n = _Mutex_Statistics_table.count;
+  index = (size_t) ( ( (uint32_t) ( key >> 2 ) * 2654435761U ) % n );
+
+  for ( i = 0; i < n && i < MUTEX_STATISTICS_PROBES; ++i ) {
+    Mutex_Statistics *entry;
+    uintptr_t         current;
+
+    entry = &entries[ index ];
+    current = _Atomic_Load_uintptr( &entry->mutex, ATOMIC_ORDER_RELAXED );
+
+    if ( current == key ) {
+      return entry;
+    }
+
+    if ( current == 0 && free_entry != NULL && *free_entry == NULL ) {
+      *free_entry = entry;
+    }
+
+    index = ( index + 1 ) % n;
+  }
+
+  return NULL;
+}
+
+Mutex_Statistics *_Mutex_Statistics_lookup(
+  const struct _Mutex_Control *mutex,
+  bool                         claim
+)
+{
+  uintptr_t         key;
+  Mutex_Statistics *entry;
+  Mutex_Statistics *free_entry;
+  ISR_lock_Context  lock_context;
+
+  key = (uintptr_t) mutex;
+  entry = _Mutex_Statistics_find( key, NULL );
+
+  if ( entry != NULL || !claim ) {
+    return entry;
+  }
+
+  free_entry = NULL;
+  _ISR_lock_ISR_disable_and_acquire( &_Mutex_Statistics_lock, &lock_context );
+
+  entry = _Mutex_Statistics_find( key, &free_entry );
+
+  if ( entry == NULL && free_entry != NULL ) {
+    entry = free_entry;
+    _Atomic_Store_uintptr( &entry->mutex, key, ATOMIC_ORDER_RELAXED );
+  }
+
+  _ISR_lock_Release_and_ISR_enable( &_Mutex_Statistics_lock, &lock_context );
+  return entry;
+}
+
+void _Mutex_Statistics_release( const struct _Mutex_Control *mutex )
+{
+  Mutex_Statistics *entry;
+  ISR_lock_Context  lock_context;
+
+  if ( _Mutex_Statistics_table.count == 0 ) {
+    return;
+  }
+
+  _ISR_lock_ISR_disable_and_acquire( &_Mutex_Statistics_lock, &lock_context );
+
+  entry = _Mutex_Statistics_find( (uintptr_t) mutex, NULL );
+
+  if ( entry != NULL ) {
+    _Atomic_Store_ulong( &entry->contended, 0, ATOMIC_ORDER_RELAXED );
+    _Atomic_Store_ulong( &entry->spin_acquired, 0, ATOMIC_ORDER_RELAXED );
+    _Atomic_Store_ulong( &entry->blocked, 0, ATOMIC_ORDER_RELAXED );
+    _Atomic_Store_uintptr( &entry->mutex, 0, ATOMIC_ORDER_RELAXED );
+  }
+
+  _ISR_lock_Release_and_ISR_enable( &_Mutex_Statistics_lock, &lock_context );
+}
+
+int rtems_mutex_get_statistics(
+  const rtems_mutex      *mutex,
+  rtems_mutex_statistics *statistics
+)
+{
+  Mutex_Statistics *entry;
+
+  entry = _Mutex_Statistics_get( mutex, false );
+
+  if ( entry == NULL ) {
+    return ENOENT;
+  }
+
+  statistics->contended =
+    _Atomic_Load_ulong( &entry->contended, ATOMIC_ORDER_RELAXED );
+  statistics->spin_acquired =
+    _Atomic_Load_ulong( &entry->spin_acquired, ATOMIC_ORDER_RELAXED );
+  statistics->blocked =
+    _Atomic_Load_ulong( &entry->blocked, ATOMIC_ORDER_RELAXED );
+
+  return 0;
+}
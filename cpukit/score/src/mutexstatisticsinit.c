@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <rtems/score/muteximpl.h>
+
+void _Mutex_Statistics_initialize( void )
+{
+  _Mutex_Statistics_table.entries = &_Mutex_Statistics[ 0 ];
+  _Mutex_Statistics_table.count = _Mutex_Statistics_count;
+}
@@ -18,6 +18,7 @@
 
 #include <rtems/score/smplock.h>
 #include <rtems/score/chainimpl.h>
+#include <rtems/score/smp.h>
 
 #include <string.h>
 
@@ -31,10 +32,14 @@ typedef struct {
 
 static SMP_lock_Stats_control _SMP_lock_Stats_control = {
   .Lock = {
+#if defined(RTEMS_SMP_LOCK_MCS)
+    .MCS_lock = SMP_MCS_LOCK_INITIALIZER,
+#else
     .Ticket_lock = {
       .next_ticket = ATOMIC_INITIALIZER_UINT( 0U ),
       .now_serving = ATOMIC_INITIALIZER_UINT( 0U )
     },
+#endif
     .Stats = {
       .Node = CHAIN_NODE_INITIALIZER_ONE_NODE_CHAIN(
         &_SMP_lock_Stats_control.Stats_chain
@@ -50,8 +55,234 @@ static SMP_lock_Stats_control _SMP_lock_Stats_control = {
   )
 };
 
+typedef struct {
+  Atomic_Flag lock;
+  SMP_lock_Call_site_stats Call_sites[ SMP_LOCK_STATS_CALL_SITES ];
+} SMP_lock_Call_site_table;
+
+static SMP_lock_Call_site_table
+_SMP_lock_Call_site_tables[ CPU_MAXIMUM_PROCESSORS ];
+
+static SMP_lock_Call_site_table *_SMP_lock_Call_site_table_acquire(
+  uint32_t   cpu_index,
+  ISR_Level *level
+)
+{
+  SMP_lock_Call_site_table *table;
+
+  table = &_SMP_lock_Call_site_tables[ cpu_index ];
+
+  /*
+   * Do not use an SMP lock here, since this would lead to a recursion in case
+   * of a lock contention.  The table is owned by one processor, so the lock is
+   * only contended by the iteration and lock destruction.
+   */
+  _ISR_Local_disable( *level );
+
+  while ( _Atomic_Flag_test_and_set( &table->lock, ATOMIC_ORDER_ACQUIRE ) ) {
+    /* Wait */
+  }
+
+  return table;
+}
+
+static void _SMP_lock_Call_site_table_release(
+  SMP_lock_Call_site_table *table,
+  ISR_Level                 level
+)
+{
+  _Atomic_Flag_clear( &table->lock, ATOMIC_ORDER_RELEASE );
+  _ISR_Local_enable( level );
+}
+
+static void _SMP_lock_Stats_copy_name(
+  char       *name,
+  size_t      name_size,
+  const char *source
+)
+{
+  size_t name_len = source != NULL ? strlen( source ) : 0;
+
+  if ( name_len >= name_size ) {
+    name_len = name_size - 1;
+  }
+
+  name[name_len] = '\0';
+  memcpy(name, source, name_len);
+}
+
+static void _SMP_lock_Stats_call_site_purge( const SMP_lock_Stats *stats )
+{
+  uint32_t cpu_max;
+  uint32_t cpu_index;
+
+  cpu_max = _SMP_Get_processor_count();
+
+  for ( cpu_index = 0 ; cpu_index < cpu_max ; ++cpu_index ) {
+    SMP_lock_Call_site_table *table;
+    ISR_Level                 level;
+    size_t                    i;
+
+    table = _SMP_lock_Call_site_table_acquire( cpu_index, &level );
+
+    for ( i = 0; i < SMP_LOCK_STATS_CALL_SITES; ++i ) {
+      SMP_lock_Call_site_stats *entry;
+
+      entry = &table->Call_sites[ i ];
+
+      if ( entry->stats == stats ) {
+        memset( entry, 0, sizeof( *entry ) );
+      }
+    }
+
+    _SMP_lock_Call_site_table_release( table, level );
+  }
+}
+
+void _SMP_lock_Stats_call_site_acquire(
+  SMP_lock_Stats         *stats,
+  SMP_lock_Stats_context *stats_context,
+  const void             *call_site,
+  CPU_Counter_ticks       wait_time
+)
+{
+  SMP_lock_Call_site_table *table;
+  SMP_lock_Call_site_stats *entry;
+  SMP_lock_Call_site_stats *free_entry;
+  ISR_Level                 level;
+  size_t                    i;
+
+  table = _SMP_lock_Call_site_table_acquire(
+    _SMP_Get_current_processor(),
+    &level
+  );
+
+  entry = NULL;
+  free_entry = NULL;
+
+  for ( i = 0; i < SMP_LOCK_STATS_CALL_SITES; ++i ) {
+    SMP_lock_Call_site_stats *current;
+
+    current = &table->Call_sites[ i ];
+
+    if ( current->stats == stats && current->call_site == call_site ) {
+      entry = current;
+      break;
+    }
+
+    if ( current->stats == NULL && free_entry == NULL ) {
+      free_entry = current;
+    }
+  }
+
+  if ( entry == NULL && free_entry != NULL ) {
+    entry = free_entry;
+    entry->stats = stats;
+    entry->call_site = call_site;
+    stats->has_call_sites = true;
+  }
+
+  /*
+   * In case the table is full, then the contention is only visible in the
+   * lock statistics.
+   */
+  if ( entry != NULL ) {
+    CPU_Counter_ticks bound;
+
+    ++entry->contention_count;
+    entry->total_wait_time += wait_time;
+
+    if ( entry->max_wait_time < wait_time ) {
+      entry->max_wait_time = wait_time;
+    }
+
+    bound = SMP_LOCK_STATS_WAIT_TIME_FIRST_BOUND;
+    i = 0;
+
+    while ( i < SMP_LOCK_STATS_WAIT_TIME_BUCKETS - 1 && wait_time >= bound ) {
+      bound *= 8;
+      ++i;
+    }
+
+    ++entry->wait_time_histogram[ i ];
+  }
+
+  stats_context->call_site = entry;
+  _SMP_lock_Call_site_table_release( table, level );
+}
+
+void _SMP_lock_Stats_call_site_release(
+  const SMP_lock_Stats_context *stats_context,
+  CPU_Counter_ticks             hold_time
+)
+{
+  SMP_lock_Call_site_stats *entry;
+  SMP_lock_Call_site_table *table;
+  ISR_Level                 level;
+  uint32_t                  cpu_index;
+
+  entry = stats_context->call_site;
+  cpu_index = (uint32_t) (
+    ( (uintptr_t) entry - (uintptr_t) &_SMP_lock_Call_site_tables[ 0 ] )
+      / sizeof( _SMP_lock_Call_site_tables[ 0 ] )
+  );
+  table = _SMP_lock_Call_site_table_acquire( cpu_index, &level );
+
+  /* The entry cannot be purged while the lock is owned */
+  entry->total_hold_time += hold_time;
+
+  if ( entry->max_hold_time < hold_time ) {
+    entry->max_hold_time = hold_time;
+  }
+
+  _SMP_lock_Call_site_table_release( table, level );
+}
+
+bool _SMP_lock_Stats_call_site_next(
+  uint32_t                  cpu_index,
+  size_t                   *index,
+  SMP_lock_Call_site_stats *snapshot,
+  char                     *name,
+  size_t                    name_size
+)
+{
+  SMP_lock_Call_site_table *table;
+  ISR_Level                 level;
+  size_t                    i;
+  bool                      valid;
+
+  table = _SMP_lock_Call_site_table_acquire( cpu_index, &level );
+
+  i = *index;
+  valid = false;
+
+  while ( i < SMP_LOCK_STATS_CALL_SITES ) {
+    const SMP_lock_Call_site_stats *entry;
+
+    entry = &table->Call_sites[ i ];
+    ++i;
+
+    if ( entry->stats != NULL ) {
+      valid = true;
+      *snapshot = *entry;
+      snapshot->stats = NULL;
+      _SMP_lock_Stats_copy_name( name, name_size, entry->stats->name );
+      break;
+    }
+  }
+
+  *index = i;
+  _SMP_lock_Call_site_table_release( table, level );
+
+  return valid;
+}
+
 void _SMP_lock_Stats_destroy( SMP_lock_Stats *stats )
 {
+  if ( stats->has_call_sites ) {
+    _SMP_lock_Stats_call_site_purge( stats );
+  }
+
   if ( !_Chain_Is_node_off_chain( &stats->Node ) ) {
     SMP_lock_Stats_control *control = &_SMP_lock_Stats_control;
     SMP_lock_Context lock_context;
@@ -136,8 +367,6 @@ bool _SMP_lock_Stats_iteration_next(
 
   current = iteration_context->current;
   if ( !_Chain_Is_tail( &control->Stats_chain, &current->Node ) ) {
-    size_t name_len = current->name != NULL ? strlen(current->name) : 0;
-
     valid = true;
 
     iteration_context->current = (SMP_lock_Stats *)
@@ -145,13 +374,7 @@ bool _SMP_lock_Stats_iteration_next(
 
     *snapshot = *current;
     snapshot->name = name;
-
-    if ( name_len >= name_size ) {
-      name_len = name_size - 1;
-    }
-
-    name[name_len] = '\0';
-    memcpy(name, current->name, name_len);
+    _SMP_lock_Stats_copy_name( name, name_size, current->name );
   } else {
     valid = false;
   }
@@ -0,0 +1,830 @@
+/**
+ * @file
+ *
+ * @brief Work Stealing SMP Scheduler Implementation
+ *
+ * @ingroup ScoreSchedulerSMPWorkStealing
+ */
+
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <rtems/score/schedulerworkstealingsmp.h>
+#include <rtems/score/schedulersmpimpl.h>
+
+static inline Scheduler_work_stealing_SMP_Context *
+_Scheduler_work_stealing_SMP_Get_context( const Scheduler_Control *scheduler )
+{
+  return (Scheduler_work_stealing_SMP_Context *)
+    _Scheduler_Get_context( scheduler );
+}
+
+static inline Scheduler_work_stealing_SMP_Context *
+_Scheduler_work_stealing_SMP_Get_self( Scheduler_Context *context )
+{
+  return (Scheduler_work_stealing_SMP_Context *) context;
+}
+
+static inline Scheduler_work_stealing_SMP_Node *
+_Scheduler_work_stealing_SMP_Node_downcast( Scheduler_Node *node )
+{
+  return (Scheduler_work_stealing_SMP_Node *) node;
+}
+
+static inline bool _Scheduler_work_stealing_SMP_Priority_less_equal(
+  const void        *left,
+  const RBTree_Node *right
+)
+{
+  const Priority_Control   *the_left;
+  const Scheduler_SMP_Node *the_right;
+  Priority_Control          prio_left;
+  Priority_Control          prio_right;
+
+  the_left = left;
+  the_right = RTEMS_CONTAINER_OF( right, Scheduler_SMP_Node, Base.Node.RBTree );
+
+  prio_left = *the_left;
+  prio_right = the_right->priority;
+
+  return prio_left <= prio_right;
+}
+
+/*
+ * The get lowest scheduled operation may return NULL in case the processor of
+ * a bound node is not owned by this scheduler instance.
+ */
+static inline bool _Scheduler_work_stealing_SMP_Order(
+  const void       *to_insert,
+  const Chain_Node *next
+)
+{
+  return next != NULL
+    && _Scheduler_SMP_Priority_less_equal( to_insert, next );
+}
+
+static inline bool _Scheduler_work_stealing_SMP_Is_idle(
+  Scheduler_work_stealing_SMP_Node *node
+)
+{
+  return _Scheduler_Node_get_owner( &node->Base.Base )->is_idle;
+}
+
+static inline uint32_t _Scheduler_work_stealing_SMP_Get_CPU_index(
+  Scheduler_Node *node
+)
+{
+  return _Per_CPU_Get_index(
+    _Thread_Get_CPU( _Scheduler_Node_get_user( node ) )
+  );
+}
+
+void _Scheduler_work_stealing_SMP_Initialize(
+  const Scheduler_Control *scheduler
+)
+{
+  Scheduler_work_stealing_SMP_Context *self =
+    _Scheduler_work_stealing_SMP_Get_context( scheduler );
+
+  _Scheduler_SMP_Initialize( &self->Base );
+  /* The ready queues are zero initialized and thus empty */
+}
+
+void _Scheduler_work_stealing_SMP_Node_initialize(
+  const Scheduler_Control *scheduler,
+  Scheduler_Node          *node_base,
+  Thread_Control          *the_thread,
+  Priority_Control         priority
+)
+{
+  Scheduler_work_stealing_SMP_Node *node;
+  Scheduler_Context                *context;
+  uint32_t                          last;
+
+  node = _Scheduler_work_stealing_SMP_Node_downcast( node_base );
+  _Scheduler_SMP_Node_initialize(
+    scheduler,
+    &node->Base,
+    the_thread,
+    priority
+  );
+
+  /*
+   * Start with the last processor of the scheduler instance.  The home
+   * processor is updated each time a processor is allocated to the node.
+   */
+  context = _Scheduler_Get_context( scheduler );
+  last = _Processor_mask_Find_last_set( &context->Processors );
+  node->home = last > 0 ? last - 1 : 0;
+
+  node->ready_queue = NULL;
+  node->bound = 0;
+  node->affinity_bound = 0;
+  node->pinning_bound = 0;
+}
+
+static inline void _Scheduler_work_stealing_SMP_Do_update(
+  Scheduler_Context *context,
+  Scheduler_Node    *node,
+  Priority_Control   new_priority
+)
+{
+  Scheduler_SMP_Node *smp_node;
+
+  (void) context;
+
+  smp_node = _Scheduler_SMP_Node_downcast( node );
+  _Scheduler_SMP_Node_update_priority( smp_node, new_priority );
+}
+
+static inline bool _Scheduler_work_stealing_SMP_Has_ready(
+  Scheduler_Context *context
+)
+{
+  Scheduler_work_stealing_SMP_Context *self;
+  uint32_t                             cpu_count;
+  uint32_t                             cpu_index;
+
+  self = _Scheduler_work_stealing_SMP_Get_self( context );
+  cpu_count = _SMP_Get_processor_count();
+
+  for ( cpu_index = 0 ; cpu_index < cpu_count ; ++cpu_index ) {
+    if ( !_RBTree_Is_empty( &self->Ready[ cpu_index ].Migratable ) ) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static inline Scheduler_work_stealing_SMP_Node *
+_Scheduler_work_stealing_SMP_Challenge_highest_ready(
+  Scheduler_work_stealing_SMP_Node *highest_ready,
+  RBTree_Control                   *ready_queue
+)
+{
+  Scheduler_work_stealing_SMP_Node *other;
+
+  other = (Scheduler_work_stealing_SMP_Node *) _RBTree_Minimum( ready_queue );
+  _Assert( other != NULL );
+
+  if (
+    highest_ready == NULL
+      || other->Base.priority < highest_ready->Base.priority
+  ) {
+    return other;
+  }
+
+  return highest_ready;
+}
+
+static inline Scheduler_work_stealing_SMP_Node *
+_Scheduler_work_stealing_SMP_Steal(
+  Scheduler_work_stealing_SMP_Context *self,
+  Scheduler_work_stealing_SMP_Node    *highest_ready,
+  uint32_t                             thief_index
+)
+{
+  uint32_t cpu_count;
+  uint32_t i;
+
+  cpu_count = _SMP_Get_processor_count();
+
+  for ( i = 1 ; i < cpu_count ; ++i ) {
+    uint32_t        victim_index;
+    RBTree_Control *ready_queue;
+
+    victim_index = thief_index + i;
+
+    if ( victim_index >= cpu_count ) {
+      victim_index -= cpu_count;
+    }
+
+    ready_queue = &self->Ready[ victim_index ].Migratable;
+
+    if ( !_RBTree_Is_empty( ready_queue ) ) {
+      highest_ready = _Scheduler_work_stealing_SMP_Challenge_highest_ready(
+        highest_ready,
+        ready_queue
+      );
+    }
+  }
+
+  return highest_ready;
+}
+
+static inline Scheduler_Node *_Scheduler_work_stealing_SMP_Get_highest_ready(
+  Scheduler_Context *context,
+  Scheduler_Node    *victim
+)
+{
+  Scheduler_work_stealing_SMP_Context     *self;
+  Scheduler_work_stealing_SMP_Ready_queue *ready_queue;
+  Scheduler_work_stealing_SMP_Node        *highest_ready;
+  uint32_t                                 cpu_index;
+
+  self = _Scheduler_work_stealing_SMP_Get_self( context );
+
+  /*
+   * The victim node is a scheduled node which is no longer on the scheduled
+   * chain.  Its user still owns the processor which needs a new node.
+   */
+  cpu_index = _Scheduler_work_stealing_SMP_Get_CPU_index( victim );
+  ready_queue = &self->Ready[ cpu_index ];
+  highest_ready = NULL;
+
+  if ( !_RBTree_Is_empty( &ready_queue->Bound ) ) {
+    highest_ready = _Scheduler_work_stealing_SMP_Challenge_highest_ready(
+      highest_ready,
+      &ready_queue->Bound
+    );
+  }
+
+  if ( !_RBTree_Is_empty( &ready_queue->Migratable ) ) {
+    highest_ready = _Scheduler_work_stealing_SMP_Challenge_highest_ready(
+      highest_ready,
+      &ready_queue->Migratable
+    );
+  }
+
+  if (
+    highest_ready == NULL
+      || _Scheduler_work_stealing_SMP_Is_idle( highest_ready )
+  ) {
+    highest_ready = _Scheduler_work_stealing_SMP_Steal(
+      self,
+      highest_ready,
+      cpu_index
+    );
+  }
+
+  _Assert( highest_ready != NULL );
+  return &highest_ready->Base.Base;
+}
+
+/*
+ * Returns the node scheduled on the processor with the specified index or NULL
+ * in case this processor is not owned by the scheduler instance.  The ready
+ * queue scheduled member is a cache which may be out of date after an idle
+ * thread exchange or the removal of a processor.
+ */
+static inline Scheduler_work_stealing_SMP_Node *
+_Scheduler_work_stealing_SMP_Get_scheduled(
+  Scheduler_work_stealing_SMP_Context *self,
+  uint32_t                             cpu_index
+)
+{
+  Scheduler_work_stealing_SMP_Node *node;
+  const Chain_Node                 *tail;
+  Chain_Node                       *next;
+
+  node = self->Ready[ cpu_index ].scheduled;
+
+  if (
+    node != NULL
+      && _Scheduler_SMP_Node_state( &node->Base.Base )
+        == SCHEDULER_SMP_NODE_SCHEDULED
+      && _Scheduler_work_stealing_SMP_Get_CPU_index( &node->Base.Base )
+        == cpu_index
+  ) {
+    return node;
+  }
+
+  tail = _Chain_Immutable_tail( &self->Base.Scheduled );
+  next = _Chain_First( &self->Base.Scheduled );
+
+  while ( next != tail ) {
+    node = (Scheduler_work_stealing_SMP_Node *) next;
+
+    if (
+      _Scheduler_work_stealing_SMP_Get_CPU_index( &node->Base.Base )
+        == cpu_index
+    ) {
+      self->Ready[ cpu_index ].scheduled = node;
+      return node;
+    }
+
+    next = _Chain_Next( next );
+  }
+
+  return NULL;
+}
+
+static inline Scheduler_Node *
+_Scheduler_work_stealing_SMP_Get_lowest_scheduled(
+  Scheduler_Context *context,
+  Scheduler_Node    *filter_base
+)
+{
+  Scheduler_work_stealing_SMP_Context *self;
+  Scheduler_work_stealing_SMP_Node    *filter;
+  Scheduler_work_stealing_SMP_Node    *node;
+  Scheduler_Node                      *lowest_scheduled;
+
+  self = _Scheduler_work_stealing_SMP_Get_self( context );
+  filter = _Scheduler_work_stealing_SMP_Node_downcast( filter_base );
+
+  if ( filter->bound != 0 ) {
+    node = _Scheduler_work_stealing_SMP_Get_scheduled(
+      self,
+      filter->bound - 1
+    );
+
+    return node != NULL ? &node->Base.Base : NULL;
+  }
+
+  /*
+   * The idle threads have the lowest priority, so in case a processor of this
+   * scheduler instance executes an idle thread, then the last scheduled node
+   * is an idle node.  Use this processor instead of the home processor.
+   */
+  lowest_scheduled = _Scheduler_SMP_Get_lowest_scheduled(
+    context,
+    filter_base
+  );
+
+  if (
+    _Scheduler_work_stealing_SMP_Is_idle(
+      _Scheduler_work_stealing_SMP_Node_downcast( lowest_scheduled )
+    )
+  ) {
+    return lowest_scheduled;
+  }
+
+  node = _Scheduler_work_stealing_SMP_Get_scheduled( self, filter->home );
+
+  return node != NULL ? &node->Base.Base : lowest_scheduled;
+}
+
+static inline void _Scheduler_work_stealing_SMP_Insert_ready(
+  Scheduler_Context *context,
+  Scheduler_Node    *node_base,
+  Priority_Control   insert_priority
+)
+{
+  Scheduler_work_stealing_SMP_Context *self;
+  Scheduler_work_stealing_SMP_Node    *node;
+  RBTree_Control                      *ready_queue;
+
+  self = _Scheduler_work_stealing_SMP_Get_self( context );
+  node = _Scheduler_work_stealing_SMP_Node_downcast( node_base );
+
+  if ( node->bound != 0 ) {
+    ready_queue = &self->Ready[ node->bound - 1 ].Bound;
+  } else {
+    ready_queue = &self->Ready[ node->home ].Migratable;
+  }
+
+  node->ready_queue = ready_queue;
+  _RBTree_Initialize_node( &node->Base.Base.Node.RBTree );
+  _RBTree_Insert_inline(
+    ready_queue,
+    &node->Base.Base.Node.RBTree,
+    &insert_priority,
+    _Scheduler_work_stealing_SMP_Priority_less_equal
+  );
+}
+
+static inline void _Scheduler_work_stealing_SMP_Extract_from_ready(
+  Scheduler_Context *context,
+  Scheduler_Node    *node_to_extract
+)
+{
+  Scheduler_work_stealing_SMP_Node *node;
+
+  (void) context;
+  node = _Scheduler_work_stealing_SMP_Node_downcast( node_to_extract );
+
+  _Assert( node->ready_queue != NULL );
+  _RBTree_Extract( node->ready_queue, &node->Base.Base.Node.RBTree );
+  _Chain_Initialize_node( &node->Base.Base.Node.Chain );
+  node->ready_queue = NULL;
+}
+
+static inline void _Scheduler_work_stealing_SMP_Move_from_scheduled_to_ready(
+  Scheduler_Context *context,
+  Scheduler_Node    *scheduled_to_ready
+)
+{
+  Priority_Control insert_priority;
+
+  _Scheduler_SMP_Extract_from_scheduled( context, scheduled_to_ready );
+  insert_priority = _Scheduler_SMP_Node_priority( scheduled_to_ready );
+  _Scheduler_work_stealing_SMP_Insert_ready(
+    context,
+    scheduled_to_ready,
+    insert_priority
+  );
+}
+
+static inline void _Scheduler_work_stealing_SMP_Move_from_ready_to_scheduled(
+  Scheduler_Context *context,
+  Scheduler_Node    *ready_to_scheduled
+)
+{
+  Priority_Control insert_priority;
+
+  _Scheduler_work_stealing_SMP_Extract_from_ready(
+    context,
+    ready_to_scheduled
+  );
+  insert_priority = _Scheduler_SMP_Node_priority( ready_to_scheduled );
+  insert_priority = SCHEDULER_PRIORITY_APPEND( insert_priority );
+  _Scheduler_SMP_Insert_scheduled(
+    context,
+    ready_to_scheduled,
+    insert_priority
+  );
+}
+
+static inline void _Scheduler_work_stealing_SMP_Allocate_processor(
+  Scheduler_Context *context,
+  Scheduler_Node    *scheduled_base,
+  Scheduler_Node    *victim_base,
+  Per_CPU_Control   *victim_cpu
+)
+{
+  Scheduler_work_stealing_SMP_Context *self;
+  Scheduler_work_stealing_SMP_Node    *scheduled;
+  uint32_t                             cpu_index;
+
+  (void) victim_base;
+  self = _Scheduler_work_stealing_SMP_Get_self( context );
+  scheduled = _Scheduler_work_stealing_SMP_Node_downcast( scheduled_base );
+  cpu_index = _Per_CPU_Get_index( victim_cpu );
+
+  _Assert( scheduled->bound == 0 || scheduled->bound == cpu_index + 1 );
+  scheduled->home = cpu_index;
+  self->Ready[ cpu_index ].scheduled = scheduled;
+
+  _Scheduler_SMP_Allocate_processor_exact(
+    context,
+    &scheduled->Base.Base,
+    NULL,
+    victim_cpu
+  );
+}
+
+void _Scheduler_work_stealing_SMP_Block(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *thread,
+  Scheduler_Node          *node
+)
+{
+  Scheduler_Context *context = _Scheduler_Get_context( scheduler );
+
+  _Scheduler_SMP_Block(
+    context,
+    thread,
+    node,
+    _Scheduler_SMP_Extract_from_scheduled,
+    _Scheduler_work_stealing_SMP_Extract_from_ready,
+    _Scheduler_work_stealing_SMP_Get_highest_ready,
+    _Scheduler_work_stealing_SMP_Move_from_ready_to_scheduled,
+    _Scheduler_work_stealing_SMP_Allocate_processor
+  );
+}
+
+static inline bool _Scheduler_work_stealing_SMP_Enqueue(
+  Scheduler_Context *context,
+  Scheduler_Node    *node,
+  Priority_Control   insert_priority
+)
+{
+  return _Scheduler_SMP_Enqueue(
+    context,
+    node,
+    insert_priority,
+    _Scheduler_work_stealing_SMP_Order,
+    _Scheduler_work_stealing_SMP_Insert_ready,
+    _Scheduler_SMP_Insert_scheduled,
+    _Scheduler_work_stealing_SMP_Move_from_scheduled_to_ready,
+    _Scheduler_work_stealing_SMP_Get_lowest_scheduled,
+    _Scheduler_work_stealing_SMP_Allocate_processor
+  );
+}
+
+static inline bool _Scheduler_work_stealing_SMP_Enqueue_scheduled(
+  Scheduler_Context *context,
+  Scheduler_Node    *node,
+  Priority_Control   insert_priority
+)
+{
+  return _Scheduler_SMP_Enqueue_scheduled(
+    context,
+    node,
+    insert_priority,
+    _Scheduler_SMP_Priority_less_equal,
+    _Scheduler_work_stealing_SMP_Extract_from_ready,
+    _Scheduler_work_stealing_SMP_Get_highest_ready,
+    _Scheduler_work_stealing_SMP_Insert_ready,
+    _Scheduler_SMP_Insert_scheduled,
+    _Scheduler_work_stealing_SMP_Move_from_ready_to_scheduled,
+    _Scheduler_work_stealing_SMP_Allocate_processor
+  );
+}
+
+void _Scheduler_work_stealing_SMP_Unblock(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *thread,
+  Scheduler_Node          *node
+)
+{
+  Scheduler_Context *context = _Scheduler_Get_context( scheduler );
+
+  _Scheduler_SMP_Unblock(
+    context,
+    thread,
+    node,
+    _Scheduler_work_stealing_SMP_Do_update,
+    _Scheduler_work_stealing_SMP_Enqueue
+  );
+}
+
+static inline bool _Scheduler_work_stealing_SMP_Do_ask_for_help(
+  Scheduler_Context *context,
+  Thread_Control    *the_thread,
+  Scheduler_Node    *node
+)
+{
+  return _Scheduler_SMP_Ask_for_help(
+    context,
+    the_thread,
+    node,
+    _Scheduler_work_stealing_SMP_Order,
+    _Scheduler_work_stealing_SMP_Insert_ready,
+    _Scheduler_SMP_Insert_scheduled,
+    _Scheduler_work_stealing_SMP_Move_from_scheduled_to_ready,
+    _Scheduler_work_stealing_SMP_Get_lowest_scheduled,
+    _Scheduler_work_stealing_SMP_Allocate_processor
+  );
+}
+
+void _Scheduler_work_stealing_SMP_Update_priority(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *thread,
+  Scheduler_Node          *node
+)
+{
+  Scheduler_Context *context = _Scheduler_Get_context( scheduler );
+
+  _Scheduler_SMP_Update_priority(
+    context,
+    thread,
+    node,
+    _Scheduler_work_stealing_SMP_Extract_from_ready,
+    _Scheduler_work_stealing_SMP_Do_update,
+    _Scheduler_work_stealing_SMP_Enqueue,
+    _Scheduler_work_stealing_SMP_Enqueue_scheduled,
+    _Scheduler_work_stealing_SMP_Do_ask_for_help
+  );
+}
+
+bool _Scheduler_work_stealing_SMP_Ask_for_help(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *the_thread,
+  Scheduler_Node          *node
+)
+{
+  Scheduler_Context *context = _Scheduler_Get_context( scheduler );
+
+  return _Scheduler_work_stealing_SMP_Do_ask_for_help(
+    context,
+    the_thread,
+    node
+  );
+}
+
+void _Scheduler_work_stealing_SMP_Reconsider_help_request(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *the_thread,
+  Scheduler_Node          *node
+)
+{
+  Scheduler_Context *context = _Scheduler_Get_context( scheduler );
+
+  _Scheduler_SMP_Reconsider_help_request(
+    context,
+    the_thread,
+    node,
+    _Scheduler_work_stealing_SMP_Extract_from_ready
+  );
+}
+
+void _Scheduler_work_stealing_SMP_Withdraw_node(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *the_thread,
+  Scheduler_Node          *node,
+  Thread_Scheduler_state   next_state
+)
+{
+  Scheduler_Context *context = _Scheduler_Get_context( scheduler );
+
+  _Scheduler_SMP_Withdraw_node(
+    context,
+    the_thread,
+    node,
+    next_state,
+    _Scheduler_work_stealing_SMP_Extract_from_ready,
+    _Scheduler_work_stealing_SMP_Get_highest_ready,
+    _Scheduler_work_stealing_SMP_Move_from_ready_to_scheduled,
+    _Scheduler_work_stealing_SMP_Allocate_processor
+  );
+}
+
+static inline void _Scheduler_work_stealing_SMP_Register_idle(
+  Scheduler_Context *context,
+  Scheduler_Node    *idle_base,
+  Per_CPU_Control   *cpu
+)
+{
+  Scheduler_work_stealing_SMP_Context *self;
+  Scheduler_work_stealing_SMP_Node    *idle;
+  uint32_t                             cpu_index;
+
+  self = _Scheduler_work_stealing_SMP_Get_self( context );
+  idle = _Scheduler_work_stealing_SMP_Node_downcast( idle_base );
+  cpu_index = _Per_CPU_Get_index( cpu );
+  idle->home = cpu_index;
+  self->Ready[ cpu_index ].scheduled = idle;
+}
+
+void _Scheduler_work_stealing_SMP_Add_processor(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *idle
+)
+{
+  Scheduler_Context *context = _Scheduler_Get_context( scheduler );
+
+  _Scheduler_SMP_Add_processor(
+    context,
+    idle,
+    _Scheduler_work_stealing_SMP_Has_ready,
+    _Scheduler_work_stealing_SMP_Enqueue_scheduled,
+    _Scheduler_work_stealing_SMP_Register_idle
+  );
+}
+
+Thread_Control *_Scheduler_work_stealing_SMP_Remove_processor(
+  const Scheduler_Control *scheduler,
+  Per_CPU_Control         *cpu
+)
+{
+  Scheduler_Context *context = _Scheduler_Get_context( scheduler );
+
+  return _Scheduler_SMP_Remove_processor(
+    context,
+    cpu,
+    _Scheduler_work_stealing_SMP_Extract_from_ready,
+    _Scheduler_work_stealing_SMP_Enqueue
+  );
+}
+
+void _Scheduler_work_stealing_SMP_Yield(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *thread,
+  Scheduler_Node          *node
+)
+{
+  Scheduler_Context *context = _Scheduler_Get_context( scheduler );
+
+  _Scheduler_SMP_Yield(
+    context,
+    thread,
+    node,
+    _Scheduler_work_stealing_SMP_Extract_from_ready,
+    _Scheduler_work_stealing_SMP_Enqueue,
+    _Scheduler_work_stealing_SMP_Enqueue_scheduled
+  );
+}
+
+void _Scheduler_work_stealing_SMP_Start_idle(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *idle,
+  Per_CPU_Control         *cpu
+)
+{
+  Scheduler_Context *context;
+
+  context = _Scheduler_Get_context( scheduler );
+
+  _Scheduler_SMP_Do_start_idle(
+    context,
+    idle,
+    cpu,
+    _Scheduler_work_stealing_SMP_Register_idle
+  );
+}
+
+void _Scheduler_work_stealing_SMP_Pin(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *thread,
+  Scheduler_Node          *node_base,
+  struct Per_CPU_Control  *cpu
+)
+{
+  Scheduler_work_stealing_SMP_Node *node;
+  uint32_t                          bound;
+
+  (void) scheduler;
+  node = _Scheduler_work_stealing_SMP_Node_downcast( node_base );
+  bound = _Per_CPU_Get_index( cpu ) + 1;
+
+  _Assert(
+    _Scheduler_SMP_Node_state( &node->Base.Base ) == SCHEDULER_SMP_NODE_BLOCKED
+  );
+
+  node->bound = bound;
+  node->pinning_bound = bound;
+}
+
+void _Scheduler_work_stealing_SMP_Unpin(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *thread,
+  Scheduler_Node          *node_base,
+  struct Per_CPU_Control  *cpu
+)
+{
+  Scheduler_work_stealing_SMP_Node *node;
+
+  (void) scheduler;
+  (void) cpu;
+  node = _Scheduler_work_stealing_SMP_Node_downcast( node_base );
+
+  _Assert(
+    _Scheduler_SMP_Node_state( &node->Base.Base ) == SCHEDULER_SMP_NODE_BLOCKED
+  );
+
+  node->bound = node->affinity_bound;
+  node->pinning_bound = 0;
+}
+
+static inline void _Scheduler_work_stealing_SMP_Do_set_affinity(
+  Scheduler_Context *context,
+  Scheduler_Node    *node_base,
+  void              *arg
+)
+{
+  Scheduler_work_stealing_SMP_Node *node;
+  const uint32_t                   *bound;
+
+  (void) context;
+  node = _Scheduler_work_stealing_SMP_Node_downcast( node_base );
+  bound = arg;
+  node->bound = *bound;
+}
+
+bool _Scheduler_work_stealing_SMP_Set_affinity(
+  const Scheduler_Control *scheduler,
+  Thread_Control          *thread,
+  Scheduler_Node          *node_base,
+  const Processor_mask    *affinity
+)
+{
+  Scheduler_Context                *context;
+  Scheduler_work_stealing_SMP_Node *node;
+  Processor_mask                    local_affinity;
+  uint32_t                          bound;
+
+  context = _Scheduler_Get_context( scheduler );
+  _Processor_mask_And( &local_affinity, &context->Processors, affinity );
+
+  if ( _Processor_mask_Is_zero( &local_affinity ) ) {
+    return false;
+  }
+
+  if ( _Processor_mask_Is_subset( affinity, &context->Processors ) ) {
+    bound = 0;
+  } else {
+    bound = _Processor_mask_Find_last_set( &local_affinity );
+  }
+
+  node = _Scheduler_work_stealing_SMP_Node_downcast( node_base );
+  node->affinity_bound = bound;
+
+  if ( node->pinning_bound == 0 ) {
+    _Scheduler_SMP_Set_affinity(
+      context,
+      thread,
+      node_base,
+      &bound,
+      _Scheduler_work_stealing_SMP_Do_set_affinity,
+      _Scheduler_work_stealing_SMP_Extract_from_ready,
+      _Scheduler_work_stealing_SMP_Get_highest_ready,
+      _Scheduler_work_stealing_SMP_Move_from_ready_to_scheduled,
+      _Scheduler_work_stealing_SMP_Enqueue,
+      _Scheduler_work_stealing_SMP_Allocate_processor
+    );
+  }
+
+  return true;
+}
@@ -45,16 +45,18 @@ void _Semaphore_Wait( struct _Semaphore_Control *_sem )
   ISR_Level             level;
   Thread_queue_Context  queue_context;
   Thread_Control       *executing;
-  unsigned int          count;
 
   sem = _Sem_Get( _sem );
+
+  if ( RTEMS_PREDICT_TRUE( _Sem_Try_decrement( sem ) ) ) {
+    return;
+  }
+
   _Thread_queue_Context_initialize( &queue_context );
   _Thread_queue_Context_ISR_disable( &queue_context, level );
   executing = _Sem_Queue_acquire_critical( sem, &queue_context );
 
-  count = sem->count;
-  if ( RTEMS_PREDICT_TRUE( count > 0 ) ) {
-    sem->count = count - 1;
+  if ( _Sem_Try_decrement( sem ) ) {
     _Sem_Queue_release( sem, level, &queue_context );
   } else {
     _Thread_queue_Context_set_thread_state(
@@ -78,16 +80,18 @@ int _Semaphore_Wait_timed_ticks( struct _Semaphore_Control *_sem, uint32_t ticks
   ISR_Level             level;
   Thread_queue_Context  queue_context;
   Thread_Control       *executing;
-  unsigned int          count;
 
   sem = _Sem_Get( _sem );
+
+  if ( RTEMS_PREDICT_TRUE( _Sem_Try_decrement( sem ) ) ) {
+    return 0;
+  }
+
   _Thread_queue_Context_initialize( &queue_context );
   _Thread_queue_Context_ISR_disable( &queue_context, level );
   executing = _Sem_Queue_acquire_critical( sem, &queue_context );
 
-  count = sem->count;
-  if ( RTEMS_PREDICT_TRUE( count > 0 ) ) {
-    sem->count = count - 1;
+  if ( _Sem_Try_decrement( sem ) ) {
     _Sem_Queue_release( sem, level, &queue_context );
     return 0;
   } else {
@@ -109,27 +113,15 @@ int _Semaphore_Wait_timed_ticks( struct _Semaphore_Control *_sem, uint32_t ticks
 
 int _Semaphore_Try_wait( struct _Semaphore_Control *_sem )
 {
-  Sem_Control          *sem;
-  ISR_Level             level;
-  Thread_queue_Context  queue_context;
-  unsigned int          count;
-  int                   eno;
+  Sem_Control *sem;
 
   sem = _Sem_Get( _sem );
-  _Thread_queue_Context_initialize( &queue_context );
-  _Thread_queue_Context_ISR_disable( &queue_context, level );
-  _Sem_Queue_acquire_critical( sem, &queue_context );
 
-  count = sem->count;
-  if ( RTEMS_PREDICT_TRUE( count > 0 ) ) {
-    sem->count = count - 1;
-    eno = 0;
-  } else {
-    eno = EAGAIN;
+  if ( RTEMS_PREDICT_TRUE( _Sem_Try_decrement( sem ) ) ) {
+    return 0;
   }
 
-  _Sem_Queue_release( sem, level, &queue_context );
-  return eno;
+  return EAGAIN;
 }
 
 void _Semaphore_Post( struct _Semaphore_Control *_sem )
@@ -146,7 +138,7 @@ void _Semaphore_Post( struct _Semaphore_Control *_sem )
 
   heads = sem->Queue.Queue.heads;
   if ( RTEMS_PREDICT_TRUE( heads == NULL ) ) {
-    ++sem->count;
+    _Sem_Increment( sem );
     _Sem_Queue_release( sem, level, &queue_context );
   } else {
     const Thread_queue_Operations *operations;
@@ -179,7 +171,7 @@ void _Semaphore_Post_binary( struct _Semaphore_Control *_sem )
 
   heads = sem->Queue.Queue.heads;
   if ( RTEMS_PREDICT_TRUE( heads == NULL ) ) {
-    sem->count = 1;
+    _Atomic_Store_uint( &sem->count, 1, ATOMIC_ORDER_RELEASE );
     _Sem_Queue_release( sem, level, &queue_context );
   } else {
     const Thread_queue_Operations *operations;
@@ -38,7 +38,11 @@ void _SMP_lock_Acquire(
   SMP_lock_Context *context
 )
 {
+#if defined(RTEMS_PROFILING)
+  _SMP_lock_Do_acquire( lock, context, RTEMS_RETURN_ADDRESS() );
+#else
   _SMP_lock_Acquire_inline( lock, context );
+#endif
 }
 
 #if defined(RTEMS_SMP_LOCK_DO_NOT_INLINE)
@@ -56,7 +60,12 @@ void _SMP_lock_ISR_disable_and_acquire(
   SMP_lock_Context *context
 )
 {
+#if defined(RTEMS_PROFILING)
+  _ISR_Local_disable( context->isr_level );
+  _SMP_lock_Do_acquire( lock, context, RTEMS_RETURN_ADDRESS() );
+#else
   _SMP_lock_ISR_disable_and_acquire_inline( lock, context );
+#endif
 }
 
 #if defined(RTEMS_SMP_LOCK_DO_NOT_INLINE)
@@ -41,6 +41,10 @@ States_Control _Thread_Clear_state_locked(
     the_thread->current_state = next_state;
 
     if ( _States_Is_ready( next_state ) ) {
+#if defined(RTEMS_PROFILING)
+      the_thread->unblock_instant = _CPU_Counter_read();
+      the_thread->unblock_pending = true;
+#endif
       _Scheduler_Unblock( the_thread );
     }
   }
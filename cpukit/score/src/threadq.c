@@ -26,7 +26,7 @@
 
 RTEMS_STATIC_ASSERT(
 #if defined(RTEMS_SMP)
-  offsetof( Thread_queue_Syslock_queue, Queue.Lock.next_ticket )
+  offsetof( Thread_queue_Syslock_queue, Queue.Lock.Ticket_lock.next_ticket )
 #else
   offsetof( Thread_queue_Syslock_queue, reserved[ 0 ] )
 #endif
@@ -36,7 +36,7 @@ RTEMS_STATIC_ASSERT(
 
 RTEMS_STATIC_ASSERT(
 #if defined(RTEMS_SMP)
-  offsetof( Thread_queue_Syslock_queue, Queue.Lock.now_serving )
+  offsetof( Thread_queue_Syslock_queue, Queue.Lock.Ticket_lock.now_serving )
 #else
   offsetof( Thread_queue_Syslock_queue, reserved[ 1 ] )
 #endif
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems.h>
+#include <rtems/imfs.h>
+#include <rtems/libcsupport.h>
+#include <rtems/libio.h>
+
+const char rtems_test_name[] = "FSIMFSEXTENT 1";
+
+#define FILE_SIZE (2 * 1024 * 1024)
+
+#define CHUNK_SIZE 4096
+
+static unsigned char chunk[CHUNK_SIZE];
+
+static unsigned char other[CHUNK_SIZE];
+
+typedef struct {
+  uint64_t write_ns;
+  uint64_t read_ns;
+  uint32_t allocs;
+  uintptr_t used;
+} measurement;
+
+static void fill(unsigned char *buf, size_t n, unsigned char seed)
+{
+  size_t i;
+
+  for (i = 0; i < n; ++i) {
+    buf[i] = (unsigned char) (seed + i);
+  }
+}
+
+static void check_zero(int fd, off_t offset, size_t n)
+{
+  ssize_t m;
+  size_t i;
+
+  m = pread(fd, other, n, offset);
+  rtems_test_assert(m == (ssize_t) n);
+
+  for (i = 0; i < n; ++i) {
+    rtems_test_assert(other[i] == 0);
+  }
+}
+
+static void test_extfile(const char *path)
+{
+  rtems_resource_snapshot snapshot;
+  struct stat st;
+  ssize_t n;
+  int fd;
+  int rv;
+
+  rtems_resource_snapshot_take(&snapshot);
+
+  fd = open(path, O_RDWR | O_CREAT | O_TRUNC, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+
+  /* Nothing to read from an empty file */
+  n = read(fd, other, sizeof(other));
+  rtems_test_assert(n == 0);
+
+  /* Write across extent boundaries */
+  fill(chunk, sizeof(chunk), 1);
+  n = pwrite(fd, chunk, 100, 0);
+  rtems_test_assert(n == 100);
+  n = pwrite(fd, chunk, sizeof(chunk), 100);
+  rtems_test_assert(n == (ssize_t) sizeof(chunk));
+  n = pread(fd, other, sizeof(chunk), 100);
+  rtems_test_assert(n == (ssize_t) sizeof(chunk));
+  rtems_test_assert(memcmp(chunk, other, sizeof(chunk)) == 0);
+
+  /* A gap after the end of file reads as zeros */
+  n = pwrite(fd, chunk, 10, 3 * CHUNK_SIZE);
+  rtems_test_assert(n == 10);
+  check_zero(fd, CHUNK_SIZE + 100, 2 * CHUNK_SIZE - 100);
+
+  rv = fstat(fd, &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st.st_size == 3 * CHUNK_SIZE + 10);
+
+  /* Truncate and extend again */
+  rv = ftruncate(fd, 50);
+  rtems_test_assert(rv == 0);
+  rv = ftruncate(fd, 2 * CHUNK_SIZE);
+  rtems_test_assert(rv == 0);
+  n = pread(fd, other, 50, 0);
+  rtems_test_assert(n == 50);
+  rtems_test_assert(memcmp(chunk, other, 50) == 0);
+  check_zero(fd, 50, 2 * CHUNK_SIZE - 50);
+
+  /* Read beyond the end of file */
+  n = pread(fd, other, sizeof(other), 2 * CHUNK_SIZE - 10);
+  rtems_test_assert(n == 10);
+  n = pread(fd, other, sizeof(other), 3 * CHUNK_SIZE);
+  rtems_test_assert(n == 0);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  /* Append */
+  fd = open(path, O_WRONLY | O_APPEND);
+  rtems_test_assert(fd >= 0);
+  n = write(fd, chunk, 1);
+  rtems_test_assert(n == 1);
+  rv = fstat(fd, &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st.st_size == 2 * CHUNK_SIZE + 1);
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  rv = unlink(path);
+  rtems_test_assert(rv == 0);
+
+  rtems_test_assert(rtems_resource_snapshot_check(&snapshot));
+}
+
+static void measure(const char *path, measurement *m)
+{
+  Heap_Information_block before;
+  Heap_Information_block after;
+  uint64_t start;
+  off_t offset;
+  ssize_t n;
+  int fd;
+  int rv;
+
+  fill(chunk, sizeof(chunk), 7);
+
+  fd = open(path, O_RDWR | O_CREAT | O_TRUNC, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+
+  rv = malloc_info(&before);
+  rtems_test_assert(rv == 0);
+
+  start = rtems_clock_get_uptime_nanoseconds();
+
+  for (offset = 0; offset < FILE_SIZE; offset += CHUNK_SIZE) {
+    n = write(fd, chunk, sizeof(chunk));
+    rtems_test_assert(n == (ssize_t) sizeof(chunk));
+  }
+
+  m->write_ns = rtems_clock_get_uptime_nanoseconds() - start;
+
+  rv = malloc_info(&after);
+  rtems_test_assert(rv == 0);
+
+  m->allocs = after.Stats.allocs - before.Stats.allocs;
+  m->used = after.Used.total - before.Used.total;
+
+  rv = lseek(fd, 0, SEEK_SET);
+  rtems_test_assert(rv == 0);
+
+  start = rtems_clock_get_uptime_nanoseconds();
+
+  for (offset = 0; offset < FILE_SIZE; offset += CHUNK_SIZE) {
+    n = read(fd, other, sizeof(other));
+    rtems_test_assert(n == (ssize_t) sizeof(other));
+  }
+
+  m->read_ns = rtems_clock_get_uptime_nanoseconds() - start;
+
+  rtems_test_assert(memcmp(chunk, other, sizeof(chunk)) == 0);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  rv = unlink(path);
+  rtems_test_assert(rv == 0);
+}
+
+static uint64_t kib_per_second(uint64_t ns)
+{
+  if (ns == 0) {
+    ns = 1;
+  }
+
+  return (UINT64_C(1000000000) * (FILE_SIZE / 1024)) / ns;
+}
+
+static void print(const char *name, const measurement *m)
+{
+  printf(
+    "  <%s>\n"
+    "    <Write unit=\"KiB/s\">%" PRIu64 "</Write>\n"
+    "    <Read unit=\"KiB/s\">%" PRIu64 "</Read>\n"
+    "    <Allocations>%" PRIu32 "</Allocations>\n"
+    "    <Memory unit=\"B\">%" PRIuPTR "</Memory>\n"
+    "  </%s>\n",
+    name,
+    kib_per_second(m->write_ns),
+    kib_per_second(m->read_ns),
+    m->allocs,
+    m->used,
+    name
+  );
+}
+
+static void Init(rtems_task_argument arg)
+{
+  measurement memfile;
+  measurement extfile;
+  int rv;
+
+  TEST_BEGIN();
+
+  rv = mkdir("/block", S_IRWXU);
+  rtems_test_assert(rv == 0);
+
+  /* The mounted file system uses the default memfiles */
+  rv = mount(
+    NULL,
+    "/block",
+    RTEMS_FILESYSTEM_TYPE_IMFS,
+    RTEMS_FILESYSTEM_READ_WRITE,
+    NULL
+  );
+  rtems_test_assert(rv == 0);
+
+  test_extfile("/file");
+
+  measure("/block/file", &memfile);
+  measure("/file", &extfile);
+
+  printf(
+    "<FSIMFSEXTENT01 size=\"%i\" chunk=\"%i\">\n",
+    FILE_SIZE,
+    CHUNK_SIZE
+  );
+  print("Memfile", &memfile);
+  print("Extfile", &extfile);
+  printf("</FSIMFSEXTENT01>\n");
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_FILESYSTEM_IMFS
+
+/* The base file system uses extent files */
+#define CONFIGURE_IMFS_ENABLE_EXTENT_FILES
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 4
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <rtems.h>
+#include <rtems/cpuuse.h>
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "CPUUSE 2";
+
+#define THREAD_COUNT 4
+
+static rtems_cpu_usage_thread_sample threads[THREAD_COUNT];
+
+static void busy(rtems_interval ticks)
+{
+  rtems_interval end;
+
+  end = rtems_clock_get_ticks_since_boot() + ticks;
+
+  while ((int32_t) (end - rtems_clock_get_ticks_since_boot()) > 0) {
+    /* Wait */
+  }
+}
+
+static size_t sample(
+  rtems_cpu_usage_sampler *sampler,
+  rtems_cpu_usage_summary *summary
+)
+{
+  rtems_status_code sc;
+  size_t count;
+
+  count = THREAD_COUNT;
+  sc = rtems_cpu_usage_sample(
+    sampler,
+    RTEMS_CPU_USAGE_SORT_ID,
+    threads,
+    &count,
+    summary
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  /* The Init and IDLE tasks */
+  rtems_test_assert(count == 2);
+  rtems_test_assert(summary->thread_count == 2);
+
+  return count;
+}
+
+static const rtems_cpu_usage_thread_sample *find_self(size_t count)
+{
+  rtems_id self;
+  size_t i;
+
+  self = rtems_task_self();
+
+  for (i = 0; i < count; ++i) {
+    if (threads[i].id == self) {
+      return &threads[i];
+    }
+  }
+
+  rtems_test_assert(0);
+  return NULL;
+}
+
+static void test(void)
+{
+  rtems_cpu_usage_sampler sampler;
+  rtems_cpu_usage_summary first;
+  rtems_cpu_usage_summary second;
+  rtems_cpu_usage_summary third;
+  const rtems_cpu_usage_thread_sample *self;
+  size_t count;
+  size_t i;
+
+  rtems_cpu_usage_sampler_initialize(&sampler);
+
+  /* The first sample period starts at the last CPU usage reset */
+  count = sample(&sampler, &first);
+  rtems_test_assert(first.period == first.uptime);
+  rtems_test_assert(first.current_time == 0);
+
+  for (i = 0; i < count; ++i) {
+    rtems_test_assert(threads[i].current_time == 0);
+  }
+
+  /* The second sample period starts at the first sample */
+  busy(10);
+  count = sample(&sampler, &second);
+  rtems_test_assert(second.uptime > first.uptime);
+  rtems_test_assert(second.period == second.uptime - first.uptime);
+  rtems_test_assert(second.total_time >= first.total_time);
+  self = find_self(count);
+  rtems_test_assert(self->current_time > 0);
+  rtems_test_assert(self->current_time <= self->total_time);
+
+  /*
+   * The reset lowers the uptime below the uptime of the second sample, so the
+   * third sample period starts at the reset.
+   */
+  rtems_cpu_usage_reset();
+  busy(2);
+  count = sample(&sampler, &third);
+  rtems_test_assert(third.uptime < second.uptime);
+  rtems_test_assert(third.period == third.uptime);
+  rtems_test_assert(third.current_time == third.total_time);
+  rtems_test_assert(third.current_idle_time == third.idle_time);
+
+  for (i = 0; i < count; ++i) {
+    rtems_test_assert(threads[i].current_time == threads[i].total_time);
+  }
+
+  self = find_self(count);
+  rtems_test_assert(self->current_time > 0);
+
+  rtems_cpu_usage_sampler_destroy(&sampler);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
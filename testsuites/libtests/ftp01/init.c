@@ -36,7 +36,8 @@ struct rtems_bsdnet_config rtems_bsdnet_config;
 
 #define FTP_WORKER_TASK_COUNT 2
 
-#define FTP_WORKER_TASK_EXTRA_STACK (FTP_WORKER_TASK_COUNT * FTPD_STACKSIZE)
+/* Each session has a transfer task */
+#define FTP_WORKER_TASK_EXTRA_STACK (2 * FTP_WORKER_TASK_COUNT * FTPD_STACKSIZE)
 
 static bool login_check(const char *user, const char *pass)
 {
@@ -65,7 +66,9 @@ struct rtems_ftpd_configuration rtems_ftpd_configuration = {
   .tasks_count = FTP_WORKER_TASK_COUNT,
   .idle = 0,
   .login = login_check,
-  .access = 0
+  .access = 0,
+  /* Cycle through the transfer buffers several times */
+  .transfer_size = 256
 };
 
 static const char content [] =
@@ -255,7 +258,7 @@ static rtems_task Init(rtems_task_argument argument)
 
 #define CONFIGURE_FILESYSTEM_FTPFS
 
-#define CONFIGURE_MAXIMUM_TASKS (3 + FTP_WORKER_TASK_COUNT)
+#define CONFIGURE_MAXIMUM_TASKS (3 + 2 * FTP_WORKER_TASK_COUNT)
 #define CONFIGURE_MAXIMUM_SEMAPHORES 2
 
 #define CONFIGURE_EXTRA_TASK_STACKS FTP_WORKER_TASK_EXTRA_STACK
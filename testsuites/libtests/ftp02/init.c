@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems.h>
+#include <rtems/ftpd.h>
+#include <rtems/ftpfs.h>
+#include <rtems/rtems_bsdnet.h>
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "FTP 2";
+
+struct rtems_bsdnet_config rtems_bsdnet_config;
+
+#define FILE_SIZE (256 * 1024)
+
+#define CHUNK_SIZE (16 * 1024)
+
+/*
+ * Zero selects the default count of transfer buffers, one disables the
+ * transfer tasks.  Change this to compare the throughput of both variants.
+ */
+#define TRANSFER_BUFFERS 0
+
+#define FILE_PATH "/FTP/127.0.0.1/file.bin"
+
+struct rtems_ftpd_configuration rtems_ftpd_configuration = {
+  .priority = 90,
+  .port = 21,
+  .tasks_count = 1,
+  .transfer_buffers = TRANSFER_BUFFERS
+};
+
+static char data[FILE_SIZE];
+
+static char buf[FILE_SIZE];
+
+static uint64_t bytes_per_second(uint64_t ns)
+{
+  if (ns == 0) {
+    ns = 1;
+  }
+
+  return (UINT64_C(1000000000) * FILE_SIZE) / ns;
+}
+
+static uint64_t store(void)
+{
+  uint64_t t0;
+  uint64_t t1;
+  size_t done;
+  ssize_t n;
+  int fd;
+  int rv;
+
+  t0 = rtems_clock_get_uptime_nanoseconds();
+
+  fd = open(FILE_PATH, O_WRONLY);
+  rtems_test_assert(fd >= 0);
+
+  for (done = 0; done < FILE_SIZE; done += CHUNK_SIZE) {
+    n = write(fd, &data[done], CHUNK_SIZE);
+    rtems_test_assert(n == CHUNK_SIZE);
+  }
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  t1 = rtems_clock_get_uptime_nanoseconds();
+
+  return t1 - t0;
+}
+
+static uint64_t retrieve(void)
+{
+  uint64_t t0;
+  uint64_t t1;
+  size_t done;
+  ssize_t n;
+  int fd;
+  int rv;
+
+  memset(buf, 0, sizeof(buf));
+
+  t0 = rtems_clock_get_uptime_nanoseconds();
+
+  fd = open(FILE_PATH, O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  done = 0;
+  while ((n = read(fd, &buf[done], sizeof(buf) - done)) > 0) {
+    done += (size_t) n;
+  }
+  rtems_test_assert(n == 0);
+  rtems_test_assert(done == FILE_SIZE);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  t1 = rtems_clock_get_uptime_nanoseconds();
+
+  rtems_test_assert(memcmp(buf, data, sizeof(data)) == 0);
+
+  return t1 - t0;
+}
+
+static void test(void)
+{
+  uint64_t store_ns;
+  uint64_t retrieve_ns;
+  size_t i;
+  int rv;
+
+  for (i = 0; i < sizeof(data); ++i) {
+    data[i] = (char) (i * 7);
+  }
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  rv = rtems_initialize_ftpd();
+  rtems_test_assert(rv == 0);
+
+  rv = mount_and_make_target_path(
+    NULL,
+    RTEMS_FTPFS_MOUNT_POINT_DEFAULT,
+    RTEMS_FILESYSTEM_TYPE_FTPFS,
+    RTEMS_FILESYSTEM_READ_WRITE,
+    NULL
+  );
+  rtems_test_assert(rv == 0);
+
+  store_ns = store();
+  retrieve_ns = retrieve();
+
+  printf(
+    "<FTP02 fileSize=\"%i\" transferBuffers=\"%i\">\n"
+    "  <Store>\n"
+    "    <Duration unit=\"ns\">%" PRIu64 "</Duration>\n"
+    "    <Throughput unit=\"B/s\">%" PRIu64 "</Throughput>\n"
+    "  </Store>\n"
+    "  <Retrieve>\n"
+    "    <Duration unit=\"ns\">%" PRIu64 "</Duration>\n"
+    "    <Throughput unit=\"B/s\">%" PRIu64 "</Throughput>\n"
+    "  </Retrieve>\n"
+    "</FTP02>\n",
+    FILE_SIZE,
+    rtems_ftpd_configuration.transfer_buffers,
+    store_ns,
+    bytes_per_second(store_ns),
+    retrieve_ns,
+    bytes_per_second(retrieve_ns)
+  );
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+  test();
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 14
+
+#define CONFIGURE_FILESYSTEM_FTPFS
+
+#define CONFIGURE_IMFS_MEMFILE_BYTES_PER_BLOCK 512
+
+#define CONFIGURE_UNLIMITED_OBJECTS
+
+#define CONFIGURE_UNIFIED_WORK_AREAS
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT_TASK_PRIORITY 110
+#define CONFIGURE_INIT_TASK_ATTRIBUTES RTEMS_FLOATING_POINT
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <mghttpd/mongoose.h>
+
+#include <rtems.h>
+#include <rtems/rtems_bsdnet.h>
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "MGHTTPD 2";
+
+struct rtems_bsdnet_config rtems_bsdnet_config = {
+  .mbuf_bytecount = 64 * 1024,
+  .mbuf_cluster_bytecount = 128 * 1024,
+  .mbuf_max_bytecount = 256 * 1024,
+  .mbuf_cluster_max_bytecount = 1024 * 1024
+};
+
+#define PORT 8080
+
+#define CLIENT_COUNT 100
+
+#define ROUNDS 10
+
+/* Larger than the socket buffers, so the server must wait for the client */
+#define BIG_SIZE (256 * 1024)
+
+#define SMALL_TXT "This is a small file.\r\n"
+
+#define BUF_SIZE 1024
+
+static char big[BIG_SIZE];
+
+static int clients[CLIENT_COUNT];
+
+static char buf[BUF_SIZE];
+
+static const char *open_file(
+  const struct mg_connection *conn,
+  const char *path,
+  size_t *size
+)
+{
+  if (strcmp(path, "/www/small.txt") == 0) {
+    *size = sizeof(SMALL_TXT) - 1;
+    return SMALL_TXT;
+  }
+
+  if (strcmp(path, "/www/big.bin") == 0) {
+    *size = sizeof(big);
+    return big;
+  }
+
+  return NULL;
+}
+
+static int connect_client(void)
+{
+  struct sockaddr_in addr;
+  int fd;
+  int rv;
+
+  fd = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(fd >= 0);
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_len = sizeof(addr);
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(PORT);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  rv = connect(fd, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  return fd;
+}
+
+static void send_request(int fd, const char *uri)
+{
+  ssize_t n;
+  int len;
+
+  len = snprintf(
+    buf,
+    sizeof(buf),
+    "GET %s HTTP/1.1\r\n"
+    "Host: localhost\r\n"
+    "Connection: keep-alive\r\n"
+    "\r\n",
+    uri
+  );
+  n = write(fd, buf, (size_t) len);
+  rtems_test_assert(n == len);
+}
+
+/* Receive the header and return the content length */
+static size_t recv_header(int fd)
+{
+  size_t len = 0;
+  const char *cl;
+  ssize_t n;
+
+  while (len < 4 || memcmp(&buf[len - 4], "\r\n\r\n", 4) != 0) {
+    rtems_test_assert(len < sizeof(buf) - 1);
+    n = read(fd, &buf[len], 1);
+    rtems_test_assert(n == 1);
+    ++len;
+  }
+
+  buf[len] = '\0';
+  rtems_test_assert(strncmp(buf, "HTTP/1.1 200 OK\r\n", 17) == 0);
+  rtems_test_assert(strstr(buf, "Connection: keep-alive\r\n") != NULL);
+
+  cl = strstr(buf, "Content-Length: ");
+  rtems_test_assert(cl != NULL);
+
+  return (size_t) strtoul(cl + 16, NULL, 10);
+}
+
+static void recv_body(int fd, char *body, size_t size)
+{
+  ssize_t n;
+
+  while (size > 0) {
+    n = read(fd, body, size);
+    rtems_test_assert(n > 0);
+    body += n;
+    size -= (size_t) n;
+  }
+}
+
+static void recv_small(int fd)
+{
+  char body[sizeof(SMALL_TXT) - 1];
+  size_t size;
+
+  size = recv_header(fd);
+  rtems_test_assert(size == sizeof(body));
+  recv_body(fd, body, size);
+  rtems_test_assert(memcmp(body, SMALL_TXT, size) == 0);
+}
+
+static void recv_big(int fd)
+{
+  char chunk[BUF_SIZE];
+  size_t size;
+  size_t offset;
+  size_t i;
+
+  size = recv_header(fd);
+  rtems_test_assert(size == sizeof(big));
+
+  for (offset = 0; offset < size; offset += sizeof(chunk)) {
+    recv_body(fd, chunk, sizeof(chunk));
+
+    for (i = 0; i < sizeof(chunk); ++i) {
+      rtems_test_assert(chunk[i] == big[offset + i]);
+    }
+  }
+}
+
+static void test(void)
+{
+  const struct mg_callbacks callbacks = {
+    .open_file = open_file
+  };
+  const char *options[] = {
+    "listening_ports", "8080",
+    "document_root", "/www",
+    "enable_keep_alive", "yes",
+    "event_loop", "yes",
+    "num_threads", "1",
+    "thread_stack_size", "16384",
+    NULL
+  };
+  struct mg_context *mg;
+  rtems_interval start;
+  rtems_interval ticks;
+  int slow;
+  int round;
+  int i;
+  int rv;
+
+  for (i = 0; i < BIG_SIZE; ++i) {
+    big[i] = (char) (i * 7);
+  }
+
+  mg = mg_start(&callbacks, NULL, options);
+  rtems_test_assert(mg != NULL);
+
+  /* This client does not read the response for a while */
+  slow = connect_client();
+  send_request(slow, "/big.bin");
+
+  for (i = 0; i < CLIENT_COUNT; ++i) {
+    clients[i] = connect_client();
+  }
+
+  /* All clients keep their connection, a single worker serves them */
+  start = rtems_clock_get_ticks_since_boot();
+
+  for (round = 0; round < ROUNDS; ++round) {
+    for (i = 0; i < CLIENT_COUNT; ++i) {
+      send_request(clients[i], "/small.txt");
+    }
+
+    for (i = 0; i < CLIENT_COUNT; ++i) {
+      recv_small(clients[i]);
+    }
+  }
+
+  ticks = rtems_clock_get_ticks_since_boot() - start;
+
+  recv_big(slow);
+
+  /* The slow client continues with the next request */
+  send_request(slow, "/small.txt");
+  recv_small(slow);
+
+  for (i = 0; i < CLIENT_COUNT; ++i) {
+    rv = close(clients[i]);
+    rtems_test_assert(rv == 0);
+  }
+
+  rv = close(slow);
+  rtems_test_assert(rv == 0);
+
+  mg_stop(mg);
+
+  if (ticks == 0) {
+    ticks = 1;
+  }
+
+  printf(
+    "<MGHTTPD02 clients=\"%i\" requests=\"%i\">\n"
+    "  <Requests unit=\"1/s\">%" PRIu32 "</Requests>\n"
+    "</MGHTTPD02>\n",
+    CLIENT_COUNT,
+    CLIENT_COUNT * ROUNDS,
+    (uint32_t) (CLIENT_COUNT * ROUNDS *
+      rtems_clock_get_ticks_per_second() / ticks)
+  );
+}
+
+static void Init(rtems_task_argument arg)
+{
+  int rv;
+
+  TEST_BEGIN();
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  test();
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS (2 * CLIENT_COUNT + 16)
+
+#define CONFIGURE_UNLIMITED_OBJECTS
+
+#define CONFIGURE_UNIFIED_WORK_AREAS
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT_TASK_STACK_SIZE (16 * 1024)
+#define CONFIGURE_INIT_TASK_ATTRIBUTES RTEMS_FLOATING_POINT
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <netinet/in.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <mghttpd/mongoose.h>
+
+#include <rtems.h>
+#include <rtems/rtems_bsdnet.h>
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "MGHTTPD 3";
+
+struct rtems_bsdnet_config rtems_bsdnet_config;
+
+#define PORT 8080
+
+#define JS_SIZE 4096
+
+#define BUF_SIZE (2 * JS_SIZE)
+
+static char js[JS_SIZE];
+
+static char buf[BUF_SIZE];
+
+static char body[BUF_SIZE];
+
+static void create_file(const char *path, const char *data, size_t size)
+{
+  FILE *file;
+  size_t n;
+  int rv;
+
+  file = fopen(path, "w");
+  rtems_test_assert(file != NULL);
+
+  n = fwrite(data, 1, size, file);
+  rtems_test_assert(n == size);
+
+  rv = fclose(file);
+  rtems_test_assert(rv == 0);
+}
+
+static void create_files(void)
+{
+  size_t i;
+  int rv;
+
+  for (i = 0; i < sizeof(js); ++i) {
+    js[i] = "var x = 1;\n"[i % 11];
+  }
+
+  rv = mkdir("/www", S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(rv == 0);
+}
+
+/*
+ * Send a request and return the length of the body in the body buffer.  The
+ * response headers are in the buffer.
+ */
+static size_t get(const char *uri, const char *extra_header, int status)
+{
+  struct sockaddr_in addr;
+  const char *end;
+  char status_line[32];
+  size_t len;
+  ssize_t n;
+  int fd;
+  int rv;
+
+  fd = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(fd >= 0);
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_len = sizeof(addr);
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(PORT);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  rv = connect(fd, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  len = (size_t) snprintf(
+    buf,
+    sizeof(buf),
+    "GET %s HTTP/1.1\r\n"
+    "Host: localhost\r\n"
+    "Connection: close\r\n"
+    "%s"
+    "\r\n",
+    uri,
+    extra_header
+  );
+  n = write(fd, buf, len);
+  rtems_test_assert(n == (ssize_t) len);
+
+  len = 0;
+  while ((n = read(fd, &buf[len], sizeof(buf) - 1 - len)) > 0) {
+    len += (size_t) n;
+  }
+  rtems_test_assert(n == 0);
+  buf[len] = '\0';
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  n = snprintf(status_line, sizeof(status_line), "HTTP/1.1 %i ", status);
+  rtems_test_assert(strncmp(buf, status_line, (size_t) n) == 0);
+  end = strstr(buf, "\r\n\r\n");
+  rtems_test_assert(end != NULL);
+  end += 4;
+
+  len -= (size_t) (end - buf);
+  memcpy(body, end, len);
+  buf[end - buf] = '\0';
+
+  return len;
+}
+
+/* Copy the value of the Etag header of the last response */
+static void get_etag(char *etag, size_t size)
+{
+  const char *begin;
+  const char *end;
+
+  begin = strstr(buf, "Etag: ");
+  rtems_test_assert(begin != NULL);
+  begin += 6;
+
+  end = strstr(begin, "\r\n");
+  rtems_test_assert(end != NULL);
+  rtems_test_assert((size_t) (end - begin) < size);
+
+  memcpy(etag, begin, (size_t) (end - begin));
+  etag[end - begin] = '\0';
+}
+
+static void check_stats(
+  struct mg_context *mg,
+  unsigned long hits,
+  unsigned long gzip_hits,
+  unsigned long misses
+)
+{
+  struct mg_cache_stats stats;
+
+  mg_get_cache_stats(mg, &stats);
+  rtems_test_assert(stats.hits == hits);
+  rtems_test_assert(stats.gzip_hits == gzip_hits);
+  rtems_test_assert(stats.misses == misses);
+  rtems_test_assert(stats.entries == 1);
+  rtems_test_assert(stats.bytes > sizeof(js));
+}
+
+static void check_gzip_body(size_t len)
+{
+  char out[JS_SIZE];
+  z_stream zs;
+  int rv;
+
+  rtems_test_assert(len < sizeof(js) / 2);
+  rtems_test_assert(strstr(buf, "Content-Encoding: gzip\r\n") != NULL);
+
+  memset(&zs, 0, sizeof(zs));
+  rv = inflateInit2(&zs, 16 + MAX_WBITS);
+  rtems_test_assert(rv == Z_OK);
+  zs.next_in = (Bytef *) body;
+  zs.avail_in = (uInt) len;
+  zs.next_out = (Bytef *) out;
+  zs.avail_out = sizeof(out);
+  rv = inflate(&zs, Z_FINISH);
+  rtems_test_assert(rv == Z_STREAM_END);
+  rtems_test_assert(zs.total_out == sizeof(js));
+  rtems_test_assert(memcmp(out, js, sizeof(js)) == 0);
+  rv = inflateEnd(&zs);
+  rtems_test_assert(rv == Z_OK);
+}
+
+static void test(const char *event_loop)
+{
+  const struct mg_callbacks callbacks = { NULL };
+  const char *options[] = {
+    "listening_ports", "8080",
+    "document_root", "/www",
+    "num_threads", "1",
+    "thread_stack_size", "16384",
+    "static_cache_size", "65536",
+    "event_loop", event_loop,
+    NULL
+  };
+  struct mg_cache_stats stats;
+  struct mg_context *mg;
+  char etag[64];
+  char header[96];
+  unsigned long gzip_hits;
+  bool gzip;
+  size_t len;
+
+  create_file("/www/ui.js", js, sizeof(js));
+
+  mg = mg_start(&callbacks, NULL, options);
+  rtems_test_assert(mg != NULL);
+
+  /* The gzip variant is only available if the library uses zlib */
+  gzip = strcmp(mg_get_option(mg, "static_cache_gzip"), "yes") == 0;
+  gzip_hits = gzip ? 1 : 0;
+
+  /* The first request reads the file, the second one is a cache hit */
+  len = get("/ui.js", "", 200);
+  rtems_test_assert(len == sizeof(js));
+  rtems_test_assert(memcmp(body, js, len) == 0);
+  rtems_test_assert(
+    (strstr(buf, "Vary: Accept-Encoding\r\n") != NULL) == gzip
+  );
+  check_stats(mg, 0, 0, 1);
+
+  len = get("/ui.js", "", 200);
+  rtems_test_assert(len == sizeof(js));
+  rtems_test_assert(memcmp(body, js, len) == 0);
+  check_stats(mg, 1, 0, 1);
+
+  /* The entity tag of the cache entry matches */
+  get_etag(etag, sizeof(etag));
+  snprintf(header, sizeof(header), "If-None-Match: %s\r\n", etag);
+  len = get("/ui.js", header, 304);
+  rtems_test_assert(len == 0);
+  check_stats(mg, 1, 0, 1);
+
+  /* The gzip variant is much smaller */
+  len = get("/ui.js", "Accept-Encoding: gzip, deflate\r\n", 200);
+  check_stats(mg, 2, gzip_hits, 1);
+
+  if (gzip) {
+    check_gzip_body(len);
+
+    get_etag(etag, sizeof(etag));
+    snprintf(header, sizeof(header), "If-None-Match: %s\r\n", etag);
+    len = get("/ui.js", header, 304);
+    rtems_test_assert(len == 0);
+  } else {
+    rtems_test_assert(len == sizeof(js));
+    rtems_test_assert(memcmp(body, js, len) == 0);
+  }
+
+  /* A changed file replaces the cache entry */
+  create_file("/www/ui.js", js, sizeof(js) / 2);
+  len = get("/ui.js", "", 200);
+  rtems_test_assert(len == sizeof(js) / 2);
+  rtems_test_assert(memcmp(body, js, len) == 0);
+  check_stats(mg, 2, gzip_hits, 2);
+
+  mg_get_cache_stats(mg, &stats);
+  printf(
+    "event_loop=%s: hits=%lu misses=%lu entries=%lu\n",
+    event_loop,
+    stats.hits,
+    stats.misses,
+    stats.entries
+  );
+
+  mg_stop(mg);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  int rv;
+
+  TEST_BEGIN();
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  create_files();
+
+  /* A worker sends the response */
+  test("no");
+
+  /* The event loop sends the cached data */
+  test("yes");
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 32
+
+#define CONFIGURE_UNLIMITED_OBJECTS
+
+#define CONFIGURE_UNIFIED_WORK_AREAS
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT_TASK_STACK_SIZE (32 * 1024)
+#define CONFIGURE_INIT_TASK_ATTRIBUTES RTEMS_FLOATING_POINT
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#define FD_SETSIZE 128
+
+#include <sys/event.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems.h>
+#include <rtems/rtems_bsdnet.h>
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "NETWORKING 2";
+
+struct rtems_bsdnet_config rtems_bsdnet_config;
+
+#define SOCKET_COUNT 100
+
+#define PORT_BASE 5000
+
+typedef struct {
+  int sender;
+  int receivers[SOCKET_COUNT];
+  struct sockaddr_in addrs[SOCKET_COUNT];
+  char buf[32];
+} test_context;
+
+static test_context test_instance;
+
+static void init_addr(struct sockaddr_in *addr, in_port_t port)
+{
+  memset(addr, 0, sizeof(*addr));
+  addr->sin_len = sizeof(*addr);
+  addr->sin_family = AF_INET;
+  addr->sin_port = htons(port);
+  addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+}
+
+static int udp_socket(struct sockaddr_in *addr, in_port_t port)
+{
+  int fd;
+  int rv;
+
+  fd = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(fd >= 0);
+
+  init_addr(addr, port);
+  rv = bind(fd, (struct sockaddr *) addr, sizeof(*addr));
+  rtems_test_assert(rv == 0);
+
+  return fd;
+}
+
+static void send_to(test_context *ctx, size_t i)
+{
+  ssize_t n;
+
+  n = sendto(
+    ctx->sender,
+    ctx->buf,
+    sizeof(ctx->buf),
+    0,
+    (const struct sockaddr *) &ctx->addrs[i],
+    sizeof(ctx->addrs[i])
+  );
+  rtems_test_assert(n == (ssize_t) sizeof(ctx->buf));
+}
+
+static void receive(test_context *ctx, int fd)
+{
+  ssize_t n;
+
+  n = recv(fd, ctx->buf, sizeof(ctx->buf), 0);
+  rtems_test_assert(n == (ssize_t) sizeof(ctx->buf));
+}
+
+static int wait_events(int kq, struct kevent *ev, int nevents)
+{
+  static const struct timespec timeout = { .tv_sec = 1 };
+
+  return kevent(kq, NULL, 0, ev, nevents, &timeout);
+}
+
+static int poll_events(int kq, struct kevent *ev, int nevents)
+{
+  static const struct timespec timeout;
+
+  return kevent(kq, NULL, 0, ev, nevents, &timeout);
+}
+
+static void change(int kq, int fd, short filter, unsigned short flags)
+{
+  struct kevent ev;
+  int rv;
+
+  EV_SET(&ev, fd, filter, flags, 0, 0, &test_instance);
+  rv = kevent(kq, &ev, 1, NULL, 0, NULL);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_kevent(test_context *ctx)
+{
+  struct kevent ev[2];
+  int kq;
+  int fd;
+  int rv;
+
+  kq = kqueue();
+  rtems_test_assert(kq >= 0);
+
+  fd = ctx->receivers[0];
+
+  /* Invalid changes */
+  EV_SET(&ev[0], fd, EVFILT_TIMER, EV_ADD, 0, 0, NULL);
+  rv = kevent(kq, &ev[0], 1, &ev[1], 1, NULL);
+  rtems_test_assert(rv == 1);
+  rtems_test_assert(ev[1].flags == EV_ERROR);
+  rtems_test_assert(ev[1].data == EINVAL);
+
+  EV_SET(&ev[0], fd, EVFILT_READ, EV_DELETE, 0, 0, NULL);
+  errno = 0;
+  rv = kevent(kq, &ev[0], 1, NULL, 0, NULL);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == ENOENT);
+
+  errno = 0;
+  rv = kevent(fd, NULL, 0, NULL, 0, NULL);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EBADF);
+
+  /* Level-triggered read and write events */
+  change(kq, fd, EVFILT_READ, EV_ADD);
+  rv = poll_events(kq, &ev[0], 2);
+  rtems_test_assert(rv == 0);
+
+  change(kq, ctx->sender, EVFILT_WRITE, EV_ADD);
+  rv = poll_events(kq, &ev[0], 2);
+  rtems_test_assert(rv == 1);
+  rtems_test_assert(ev[0].ident == (uintptr_t) ctx->sender);
+  rtems_test_assert(ev[0].filter == EVFILT_WRITE);
+  rtems_test_assert(ev[0].udata == &test_instance);
+  change(kq, ctx->sender, EVFILT_WRITE, EV_DELETE);
+
+  send_to(ctx, 0);
+  rv = wait_events(kq, &ev[0], 2);
+  rtems_test_assert(rv == 1);
+  rtems_test_assert(ev[0].ident == (uintptr_t) fd);
+  rtems_test_assert(ev[0].filter == EVFILT_READ);
+  rtems_test_assert(ev[0].data == (int64_t) sizeof(ctx->buf));
+
+  rv = poll_events(kq, &ev[0], 2);
+  rtems_test_assert(rv == 1);
+
+  receive(ctx, fd);
+  rv = poll_events(kq, &ev[0], 2);
+  rtems_test_assert(rv == 0);
+
+  /* Edge-triggered event */
+  change(kq, fd, EVFILT_READ, EV_ADD | EV_CLEAR);
+  send_to(ctx, 0);
+  rv = wait_events(kq, &ev[0], 2);
+  rtems_test_assert(rv == 1);
+  rv = poll_events(kq, &ev[0], 2);
+  rtems_test_assert(rv == 0);
+  receive(ctx, fd);
+
+  /* Disabled event */
+  change(kq, fd, EVFILT_READ, EV_DISABLE);
+  send_to(ctx, 0);
+  rv = wait_events(kq, &ev[0], 2);
+  rtems_test_assert(rv == 0);
+  change(kq, fd, EVFILT_READ, EV_ENABLE);
+  rv = poll_events(kq, &ev[0], 2);
+  rtems_test_assert(rv == 1);
+  receive(ctx, fd);
+
+  /* One-shot event */
+  change(kq, fd, EVFILT_READ, EV_ADD | EV_ONESHOT);
+  send_to(ctx, 0);
+  rv = wait_events(kq, &ev[0], 2);
+  rtems_test_assert(rv == 1);
+  receive(ctx, fd);
+  EV_SET(&ev[0], fd, EVFILT_READ, EV_DELETE, 0, 0, NULL);
+  errno = 0;
+  rv = kevent(kq, &ev[0], 1, NULL, 0, NULL);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == ENOENT);
+
+  /* Close of a registered socket */
+  fd = udp_socket(&ctx->addrs[SOCKET_COUNT - 1], PORT_BASE + SOCKET_COUNT);
+  change(kq, fd, EVFILT_READ, EV_ADD);
+  send_to(ctx, SOCKET_COUNT - 1);
+  rv = wait_events(kq, &ev[0], 2);
+  rtems_test_assert(rv == 1);
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+  rv = poll_events(kq, &ev[0], 2);
+  rtems_test_assert(rv == 0);
+  init_addr(&ctx->addrs[SOCKET_COUNT - 1], PORT_BASE + SOCKET_COUNT - 1);
+
+  rv = close(kq);
+  rtems_test_assert(rv == 0);
+}
+
+static rtems_interval test_duration(void)
+{
+  return rtems_clock_get_ticks_per_second();
+}
+
+static uint32_t benchmark_select(test_context *ctx)
+{
+  rtems_interval start;
+  uint32_t count;
+  int nfds;
+  size_t i;
+
+  nfds = 0;
+
+  for (i = 0; i < SOCKET_COUNT; ++i) {
+    if (ctx->receivers[i] >= nfds) {
+      nfds = ctx->receivers[i] + 1;
+    }
+  }
+
+  count = 0;
+  start = rtems_clock_get_ticks_since_boot();
+
+  do {
+    fd_set set;
+    int rv;
+
+    i = count % SOCKET_COUNT;
+    send_to(ctx, i);
+
+    FD_ZERO(&set);
+
+    for (i = 0; i < SOCKET_COUNT; ++i) {
+      FD_SET(ctx->receivers[i], &set);
+    }
+
+    rv = select(nfds, &set, NULL, NULL, NULL);
+    rtems_test_assert(rv == 1);
+
+    for (i = 0; i < SOCKET_COUNT; ++i) {
+      if (FD_ISSET(ctx->receivers[i], &set)) {
+        receive(ctx, ctx->receivers[i]);
+      }
+    }
+
+    ++count;
+  } while (rtems_clock_get_ticks_since_boot() - start < test_duration());
+
+  return count;
+}
+
+static uint32_t benchmark_kevent(test_context *ctx)
+{
+  rtems_interval start;
+  uint32_t count;
+  int kq;
+  int rv;
+  size_t i;
+
+  kq = kqueue();
+  rtems_test_assert(kq >= 0);
+
+  for (i = 0; i < SOCKET_COUNT; ++i) {
+    change(kq, ctx->receivers[i], EVFILT_READ, EV_ADD);
+  }
+
+  count = 0;
+  start = rtems_clock_get_ticks_since_boot();
+
+  do {
+    struct kevent ev;
+
+    send_to(ctx, count % SOCKET_COUNT);
+
+    rv = kevent(kq, NULL, 0, &ev, 1, NULL);
+    rtems_test_assert(rv == 1);
+    receive(ctx, (int) ev.ident);
+
+    ++count;
+  } while (rtems_clock_get_ticks_since_boot() - start < test_duration());
+
+  rv = close(kq);
+  rtems_test_assert(rv == 0);
+
+  return count;
+}
+
+static void test(test_context *ctx)
+{
+  struct sockaddr_in addr;
+  uint32_t select_count;
+  uint32_t kevent_count;
+  size_t i;
+
+  ctx->sender = udp_socket(&addr, PORT_BASE - 1);
+
+  for (i = 0; i < SOCKET_COUNT; ++i) {
+    ctx->receivers[i] = udp_socket(&ctx->addrs[i], PORT_BASE + i);
+  }
+
+  test_kevent(ctx);
+
+  select_count = benchmark_select(ctx);
+  kevent_count = benchmark_kevent(ctx);
+
+  printf(
+    "<Networking02 sockets=\"%i\">\n"
+    "  <Select>%" PRIu32 "</Select>\n"
+    "  <KEvent>%" PRIu32 "</KEvent>\n"
+    "</Networking02>\n",
+    SOCKET_COUNT,
+    select_count,
+    kevent_count
+  );
+}
+
+static void Init(rtems_task_argument arg)
+{
+  int rv;
+
+  TEST_BEGIN();
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  test(&test_instance);
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS (SOCKET_COUNT + 8)
+
+#define CONFIGURE_MAXIMUM_TASKS 2
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT_TASK_ATTRIBUTES RTEMS_FLOATING_POINT
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
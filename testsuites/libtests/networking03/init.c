@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <sys/param.h>
+#include <sys/mbuf.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <inttypes.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems.h>
+#include <rtems/counter.h>
+#include <rtems/rtems_bsdnet.h>
+#include <rtems/rtems_netinet_in.h>
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "NETWORKING 3";
+
+struct rtems_bsdnet_config rtems_bsdnet_config;
+
+#define BUF_SIZE 1500
+
+#define MBUF_COUNT 3
+
+#define BENCHMARK_RUNS 1000
+
+#define PORT 5000
+
+typedef struct {
+  uint8_t src[BUF_SIZE + 8];
+  uint8_t dst[BUF_SIZE + 8];
+  struct mbuf mbufs[MBUF_COUNT];
+  uint32_t seed;
+} test_context;
+
+static test_context test_instance;
+
+static uint32_t next_random(test_context *ctx)
+{
+  ctx->seed = ctx->seed * 1103515245 + 12345;
+  return ctx->seed >> 16;
+}
+
+/*
+ * This is the 16-bit checksum routine of RFC 1071 in network byte order and
+ * serves as a reference.
+ */
+static uint16_t reference_cksum(const uint8_t *p, size_t len)
+{
+  uint32_t sum;
+  size_t i;
+
+  sum = 0;
+
+  for (i = 0; i + 1 < len; i += 2) {
+    sum += ((uint32_t) p[i] << 8) | p[i + 1];
+  }
+
+  if ((len & 1) != 0) {
+    sum += (uint32_t) p[len - 1] << 8;
+  }
+
+  while ((sum >> 16) != 0) {
+    sum = (sum & 0xffff) + (sum >> 16);
+  }
+
+  return (uint16_t) ~sum;
+}
+
+static uint16_t partial_to_cksum(u_int partial)
+{
+  return ntohs((uint16_t) ~partial);
+}
+
+static void fill(test_context *ctx, uint8_t *p, size_t len)
+{
+  size_t i;
+
+  for (i = 0; i < len; ++i) {
+    p[i] = (uint8_t) next_random(ctx);
+  }
+}
+
+static int mbuf_cksum(test_context *ctx, uint8_t *p, int len)
+{
+  int split[MBUF_COUNT - 1];
+  int begin;
+  size_t i;
+
+  split[0] = (int) (next_random(ctx) % (len + 1));
+  split[1] = split[0] + (int) (next_random(ctx) % (len - split[0] + 1));
+  begin = 0;
+
+  for (i = 0; i < MBUF_COUNT; ++i) {
+    struct mbuf *m = &ctx->mbufs[i];
+    int end = i < MBUF_COUNT - 1 ? split[i] : len;
+
+    memset(m, 0, sizeof(*m));
+    m->m_data = (caddr_t) &p[begin];
+    m->m_len = end - begin;
+    m->m_next = i < MBUF_COUNT - 1 ? &ctx->mbufs[i + 1] : NULL;
+    begin = end;
+  }
+
+  return in_cksum(&ctx->mbufs[0], len);
+}
+
+static void test_cksum(test_context *ctx)
+{
+  size_t i;
+
+  for (i = 0; i < 10000; ++i) {
+    size_t src_off = next_random(ctx) % 8;
+    size_t dst_off = next_random(ctx) % 8;
+    int len = (int) (next_random(ctx) % (BUF_SIZE + 1));
+    uint8_t *src = &ctx->src[src_off];
+    uint8_t *dst = &ctx->dst[dst_off];
+    uint16_t expected;
+    u_int partial;
+
+    fill(ctx, src, (size_t) len);
+    expected = reference_cksum(src, (size_t) len);
+
+    rtems_test_assert(ntohs(mbuf_cksum(ctx, src, len)) == expected);
+
+    partial = in_cksum_copy(src, dst, len);
+    rtems_test_assert(memcmp(src, dst, (size_t) len) == 0);
+    rtems_test_assert(partial_to_cksum(partial) == expected);
+  }
+}
+
+static void test_udp(test_context *ctx)
+{
+  struct sockaddr_in addr;
+  int sender;
+  int receiver;
+  int rv;
+  size_t len;
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_len = sizeof(addr);
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(PORT);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  receiver = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(receiver >= 0);
+
+  rv = bind(receiver, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  sender = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(sender >= 0);
+
+  /*
+   * The UDP input verifies the checksum computed during the copy from the
+   * user buffer and drops datagrams with a bad checksum.
+   */
+  for (len = 1; len <= BUF_SIZE; len += 37) {
+    ssize_t n;
+
+    fill(ctx, ctx->src, len + 1);
+
+    n = sendto(
+      sender,
+      &ctx->src[len & 1],
+      len,
+      0,
+      (const struct sockaddr *) &addr,
+      sizeof(addr)
+    );
+    rtems_test_assert(n == (ssize_t) len);
+
+    n = recv(receiver, ctx->dst, sizeof(ctx->dst), 0);
+    rtems_test_assert(n == (ssize_t) len);
+    rtems_test_assert(memcmp(&ctx->src[len & 1], ctx->dst, len) == 0);
+  }
+
+  rv = close(sender);
+  rtems_test_assert(rv == 0);
+
+  rv = close(receiver);
+  rtems_test_assert(rv == 0);
+}
+
+/*
+ * Returns the bytes processed per counter tick in units of 1/1000.  On most
+ * targets the CPU counter runs at the processor clock, so this is the count
+ * of bytes per processor cycle.
+ */
+static uint64_t benchmark(
+  test_context *ctx,
+  uint32_t (*cksum)(test_context *, size_t),
+  size_t off
+)
+{
+  rtems_counter_ticks d;
+  uint32_t dummy;
+  size_t i;
+
+  dummy = 0;
+  d = rtems_counter_read();
+
+  for (i = 0; i < BENCHMARK_RUNS; ++i) {
+    dummy += (*cksum)(ctx, off);
+  }
+
+  d = rtems_counter_difference(rtems_counter_read(), d);
+  rtems_test_assert(dummy != 1);
+
+  if (d == 0) {
+    d = 1;
+  }
+
+  return (UINT64_C(1000) * BUF_SIZE * BENCHMARK_RUNS) / d;
+}
+
+static void print_bytes_per_tick(const char *name, uint64_t milli)
+{
+  printf(
+    "    <%s unit=\"B/tick\">%" PRIu64 ".%03" PRIu64 "</%s>\n",
+    name,
+    milli / 1000,
+    milli % 1000,
+    name
+  );
+}
+
+static uint32_t run_reference(test_context *ctx, size_t off)
+{
+  return reference_cksum(&ctx->src[off], BUF_SIZE);
+}
+
+static uint32_t run_in_cksum(test_context *ctx, size_t off)
+{
+  struct mbuf *m = &ctx->mbufs[0];
+
+  memset(m, 0, sizeof(*m));
+  m->m_data = (caddr_t) &ctx->src[off];
+  m->m_len = BUF_SIZE;
+
+  return (uint32_t) in_cksum(m, BUF_SIZE);
+}
+
+static uint32_t run_cksum_copy(test_context *ctx, size_t off)
+{
+  return in_cksum_copy(&ctx->src[off], &ctx->dst[off], BUF_SIZE);
+}
+
+static uint32_t run_copy(test_context *ctx, size_t off)
+{
+  memcpy(&ctx->dst[off], &ctx->src[off], BUF_SIZE);
+  return ctx->dst[off];
+}
+
+static void test_benchmark(test_context *ctx)
+{
+  size_t off;
+
+  fill(ctx, ctx->src, sizeof(ctx->src));
+
+  printf(
+    "<Networking03 bytes=\"%i\">\n"
+    "  <CounterFrequency unit=\"Hz\">%" PRIu32 "</CounterFrequency>\n",
+    BUF_SIZE,
+    rtems_counter_frequency()
+  );
+
+  for (off = 0; off < 2; ++off) {
+    printf("  <Aligned offset=\"%zu\">\n", off);
+    print_bytes_per_tick("Reference", benchmark(ctx, run_reference, off));
+    print_bytes_per_tick("InCksum", benchmark(ctx, run_in_cksum, off));
+    print_bytes_per_tick("Copy", benchmark(ctx, run_copy, off));
+    print_bytes_per_tick("CksumCopy", benchmark(ctx, run_cksum_copy, off));
+    printf("  </Aligned>\n");
+  }
+
+  printf("</Networking03>\n");
+}
+
+static void Init(rtems_task_argument arg)
+{
+  int rv;
+
+  TEST_BEGIN();
+
+  test_cksum(&test_instance);
+  test_benchmark(&test_instance);
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  test_udp(&test_instance);
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 8
+
+#define CONFIGURE_MAXIMUM_TASKS 2
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT_TASK_ATTRIBUTES RTEMS_FLOATING_POINT
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
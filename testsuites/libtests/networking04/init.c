@@ -0,0 +1,369 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems.h>
+#include <rtems/counter.h>
+#include <rtems/rtems_bsdnet.h>
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "NETWORKING 4";
+
+struct rtems_bsdnet_config rtems_bsdnet_config;
+
+#define FILE_SIZE (256 * 1024)
+
+#define BUF_SIZE 1024
+
+#define PORT 5000
+
+#define EVENT_DONE RTEMS_EVENT_0
+
+static const char file[] = "/file";
+
+typedef struct {
+  rtems_id main_task;
+  rtems_id recv_task;
+  int listen_fd;
+  size_t expected;
+  size_t received;
+  bool verify;
+  char buf[BUF_SIZE];
+  char recv_buf[BUF_SIZE];
+} test_context;
+
+static test_context test_instance;
+
+static char file_byte(size_t i)
+{
+  return (char) (i * 7 + (i >> 8));
+}
+
+static void create_file(test_context *ctx)
+{
+  int fd;
+  size_t i;
+
+  fd = open(file, O_CREAT | O_WRONLY, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+
+  for (i = 0; i < FILE_SIZE; i += sizeof(ctx->buf)) {
+    size_t j;
+    ssize_t n;
+
+    for (j = 0; j < sizeof(ctx->buf); ++j) {
+      ctx->buf[j] = file_byte(i + j);
+    }
+
+    n = write(fd, ctx->buf, sizeof(ctx->buf));
+    rtems_test_assert(n == (ssize_t) sizeof(ctx->buf));
+  }
+
+  close(fd);
+}
+
+static void recv_task(rtems_task_argument arg)
+{
+  test_context *ctx;
+
+  ctx = (test_context *) arg;
+
+  while (true) {
+    rtems_event_set events;
+    int fd;
+
+    rtems_event_receive(
+      EVENT_DONE,
+      RTEMS_EVENT_ALL | RTEMS_WAIT,
+      RTEMS_NO_TIMEOUT,
+      &events
+    );
+
+    fd = accept(ctx->listen_fd, NULL, NULL);
+    rtems_test_assert(fd >= 0);
+
+    while (true) {
+      ssize_t n;
+
+      n = recv(fd, ctx->recv_buf, sizeof(ctx->recv_buf), 0);
+      rtems_test_assert(n >= 0);
+
+      if (n == 0) {
+        break;
+      }
+
+      if (ctx->verify) {
+        ssize_t j;
+
+        for (j = 0; j < n; ++j) {
+          rtems_test_assert(
+            ctx->recv_buf[j] == file_byte(ctx->received + (size_t) j)
+          );
+        }
+      }
+
+      ctx->received += (size_t) n;
+    }
+
+    close(fd);
+    rtems_event_send(ctx->main_task, EVENT_DONE);
+  }
+}
+
+static int connect_to_receiver(test_context *ctx)
+{
+  struct sockaddr_in addr;
+  rtems_status_code sc;
+  int fd;
+  int rv;
+
+  ctx->received = 0;
+  sc = rtems_event_send(ctx->recv_task, EVENT_DONE);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_len = sizeof(addr);
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(PORT);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  fd = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(fd >= 0);
+
+  rv = connect(fd, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  return fd;
+}
+
+static void wait_for_receiver(test_context *ctx, int fd, size_t expected)
+{
+  rtems_event_set events;
+  int rv;
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  rtems_event_receive(
+    EVENT_DONE,
+    RTEMS_EVENT_ALL | RTEMS_WAIT,
+    RTEMS_NO_TIMEOUT,
+    &events
+  );
+  rtems_test_assert(ctx->received == expected);
+}
+
+static void test_sendfile(test_context *ctx)
+{
+  struct iovec hdr;
+  struct sf_hdtr hdtr;
+  off_t sbytes;
+  int file_fd;
+  int fd;
+  int rv;
+
+  file_fd = open(file, O_RDONLY);
+  rtems_test_assert(file_fd >= 0);
+
+  ctx->verify = true;
+
+  /* Entire file */
+  fd = connect_to_receiver(ctx);
+  rv = sendfile(file_fd, fd, 0, 0, NULL, &sbytes, 0);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(sbytes == FILE_SIZE);
+  rtems_test_assert(lseek(file_fd, 0, SEEK_CUR) == 0);
+  wait_for_receiver(ctx, fd, FILE_SIZE);
+
+  /* Header and a range which extends beyond the end of file */
+  memset(&hdtr, 0, sizeof(hdtr));
+  hdr.iov_base = ctx->buf;
+  hdr.iov_len = 123;
+  hdtr.headers = &hdr;
+  hdtr.hdr_cnt = 1;
+
+  ctx->verify = false;
+  fd = connect_to_receiver(ctx);
+  rv = sendfile(file_fd, fd, FILE_SIZE - 1000, 5000, &hdtr, &sbytes, 0);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(sbytes == 123 + 1000);
+  wait_for_receiver(ctx, fd, 123 + 1000);
+
+  /* Errors */
+  errno = 0;
+  rv = sendfile(file_fd, file_fd, 0, 0, NULL, NULL, 0);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == ENOTSOCK);
+
+  fd = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(fd >= 0);
+  errno = 0;
+  rv = sendfile(file_fd, fd, 0, 0, NULL, NULL, 0);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == ENOTCONN);
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  rv = close(file_fd);
+  rtems_test_assert(rv == 0);
+}
+
+static uint64_t benchmark_read_send(test_context *ctx)
+{
+  rtems_counter_ticks t;
+  int file_fd;
+  int fd;
+  ssize_t n;
+
+  ctx->verify = false;
+  file_fd = open(file, O_RDONLY);
+  rtems_test_assert(file_fd >= 0);
+  fd = connect_to_receiver(ctx);
+
+  t = rtems_counter_read();
+
+  while ((n = read(file_fd, ctx->buf, sizeof(ctx->buf))) > 0) {
+    ssize_t m;
+
+    m = send(fd, ctx->buf, (size_t) n, 0);
+    rtems_test_assert(m == n);
+  }
+
+  wait_for_receiver(ctx, fd, FILE_SIZE);
+  t = rtems_counter_difference(rtems_counter_read(), t);
+  close(file_fd);
+
+  return rtems_counter_ticks_to_nanoseconds(t);
+}
+
+static uint64_t benchmark_sendfile(test_context *ctx)
+{
+  rtems_counter_ticks t;
+  off_t sbytes;
+  int file_fd;
+  int fd;
+  int rv;
+
+  ctx->verify = false;
+  file_fd = open(file, O_RDONLY);
+  rtems_test_assert(file_fd >= 0);
+  fd = connect_to_receiver(ctx);
+
+  t = rtems_counter_read();
+
+  rv = sendfile(file_fd, fd, 0, 0, NULL, &sbytes, 0);
+  rtems_test_assert(rv == 0);
+
+  wait_for_receiver(ctx, fd, FILE_SIZE);
+  t = rtems_counter_difference(rtems_counter_read(), t);
+  close(file_fd);
+
+  return rtems_counter_ticks_to_nanoseconds(t);
+}
+
+static uint64_t kib_per_second(uint64_t ns)
+{
+  return (UINT64_C(1000000000) * (FILE_SIZE / 1024)) / ns;
+}
+
+static void test(test_context *ctx)
+{
+  struct sockaddr_in addr;
+  rtems_status_code sc;
+  int rv;
+
+  ctx->main_task = rtems_task_self();
+
+  create_file(ctx);
+
+  ctx->listen_fd = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(ctx->listen_fd >= 0);
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_len = sizeof(addr);
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(PORT);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  rv = bind(ctx->listen_fd, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  rv = listen(ctx->listen_fd, 1);
+  rtems_test_assert(rv == 0);
+
+  sc = rtems_task_create(
+    rtems_build_name('R', 'E', 'C', 'V'),
+    2,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &ctx->recv_task
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_task_start(ctx->recv_task, recv_task, (rtems_task_argument) ctx);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  test_sendfile(ctx);
+
+  printf(
+    "<Networking04 bytes=\"%i\">\n"
+    "  <ReadSend unit=\"KiB/s\">%" PRIu64 "</ReadSend>\n"
+    "  <SendFile unit=\"KiB/s\">%" PRIu64 "</SendFile>\n"
+    "</Networking04>\n",
+    FILE_SIZE,
+    kib_per_second(benchmark_read_send(ctx)),
+    kib_per_second(benchmark_sendfile(ctx))
+  );
+}
+
+static void Init(rtems_task_argument arg)
+{
+  int rv;
+
+  TEST_BEGIN();
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  test(&test_instance);
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 8
+
+#define CONFIGURE_MAXIMUM_TASKS 3
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT_TASK_ATTRIBUTES RTEMS_FLOATING_POINT
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
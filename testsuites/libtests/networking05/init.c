@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <inttypes.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems.h>
+#include <rtems/counter.h>
+#include <rtems/rtems_bsdnet.h>
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "NETWORKING 5";
+
+struct rtems_bsdnet_config rtems_bsdnet_config;
+
+#define CPU_COUNT 4
+
+#define CONNECTION_COUNT 4
+
+#define TRANSFER_SIZE (512 * 1024)
+
+#define BUF_SIZE 8192
+
+#define PORT 5000
+
+#define EVENT_START RTEMS_EVENT_0
+
+typedef struct {
+  int send_fd;
+  int recv_fd;
+  rtems_id sender;
+  rtems_id receiver;
+  size_t received;
+  char send_buf[BUF_SIZE];
+  char recv_buf[BUF_SIZE];
+} connection;
+
+typedef struct {
+  rtems_id main_task;
+  int listen_fd;
+  connection connections[CONNECTION_COUNT];
+} test_context;
+
+static test_context test_instance;
+
+static void wait_for_start(void)
+{
+  rtems_event_set events;
+
+  rtems_event_receive(
+    EVENT_START,
+    RTEMS_EVENT_ALL | RTEMS_WAIT,
+    RTEMS_NO_TIMEOUT,
+    &events
+  );
+}
+
+static void sender(rtems_task_argument arg)
+{
+  connection *conn;
+
+  conn = (connection *) arg;
+  memset(conn->send_buf, 0xa5, sizeof(conn->send_buf));
+
+  while (true) {
+    size_t sent;
+
+    wait_for_start();
+
+    for (sent = 0; sent < TRANSFER_SIZE; sent += sizeof(conn->send_buf)) {
+      ssize_t n;
+
+      n = send(conn->send_fd, conn->send_buf, sizeof(conn->send_buf), 0);
+      rtems_test_assert(n == (ssize_t) sizeof(conn->send_buf));
+    }
+  }
+}
+
+static void receiver(rtems_task_argument arg)
+{
+  test_context *ctx;
+  connection *conn;
+  size_t i;
+
+  ctx = &test_instance;
+  i = (size_t) arg;
+  conn = &ctx->connections[i];
+
+  while (true) {
+    rtems_status_code sc;
+
+    wait_for_start();
+
+    conn->received = 0;
+
+    while (conn->received < TRANSFER_SIZE) {
+      ssize_t n;
+
+      n = recv(conn->recv_fd, conn->recv_buf, sizeof(conn->recv_buf), 0);
+      rtems_test_assert(n > 0);
+      conn->received += (size_t) n;
+    }
+
+    rtems_test_assert(conn->received == TRANSFER_SIZE);
+
+    sc = rtems_event_send(ctx->main_task, RTEMS_EVENT_0 << i);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+}
+
+static rtems_id start_task(
+  rtems_name name,
+  rtems_task_entry entry,
+  rtems_task_argument arg
+)
+{
+  rtems_status_code sc;
+  rtems_id id;
+
+  sc = rtems_task_create(
+    name,
+    2,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &id
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_task_start(id, entry, arg);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  return id;
+}
+
+static void setup(test_context *ctx)
+{
+  struct sockaddr_in addr;
+  size_t i;
+  int rv;
+
+  ctx->main_task = rtems_task_self();
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_len = sizeof(addr);
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(PORT);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  ctx->listen_fd = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(ctx->listen_fd >= 0);
+
+  rv = bind(ctx->listen_fd, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  rv = listen(ctx->listen_fd, CONNECTION_COUNT);
+  rtems_test_assert(rv == 0);
+
+  for (i = 0; i < CONNECTION_COUNT; ++i) {
+    connection *conn = &ctx->connections[i];
+
+    conn->send_fd = socket(PF_INET, SOCK_STREAM, 0);
+    rtems_test_assert(conn->send_fd >= 0);
+
+    rv = connect(conn->send_fd, (struct sockaddr *) &addr, sizeof(addr));
+    rtems_test_assert(rv == 0);
+
+    conn->recv_fd = accept(ctx->listen_fd, NULL, NULL);
+    rtems_test_assert(conn->recv_fd >= 0);
+
+    conn->sender = start_task(
+      rtems_build_name('S', 'N', 'D', '0' + i),
+      sender,
+      (rtems_task_argument) conn
+    );
+    conn->receiver = start_task(
+      rtems_build_name('R', 'C', 'V', '0' + i),
+      receiver,
+      (rtems_task_argument) i
+    );
+  }
+}
+
+static uint64_t run(test_context *ctx, size_t active)
+{
+  rtems_counter_ticks t;
+  rtems_event_set all;
+  rtems_event_set events;
+  rtems_status_code sc;
+  size_t i;
+
+  all = 0;
+  t = rtems_counter_read();
+
+  for (i = 0; i < active; ++i) {
+    connection *conn = &ctx->connections[i];
+
+    all |= RTEMS_EVENT_0 << i;
+
+    sc = rtems_event_send(conn->receiver, EVENT_START);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    sc = rtems_event_send(conn->sender, EVENT_START);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  sc = rtems_event_receive(
+    all,
+    RTEMS_EVENT_ALL | RTEMS_WAIT,
+    RTEMS_NO_TIMEOUT,
+    &events
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  t = rtems_counter_difference(rtems_counter_read(), t);
+
+  return (UINT64_C(1000000000) * (active * TRANSFER_SIZE / 1024))
+    / rtems_counter_ticks_to_nanoseconds(t);
+}
+
+static void test(test_context *ctx)
+{
+  size_t active;
+
+  setup(ctx);
+
+  printf(
+    "<Networking05 processors=\"%" PRIu32 "\" bytes=\"%i\">\n",
+    rtems_get_processor_count(),
+    TRANSFER_SIZE
+  );
+
+  for (active = 1; active <= CONNECTION_COUNT; active *= 2) {
+    printf(
+      "  <Throughput connections=\"%zu\" unit=\"KiB/s\">%" PRIu64
+        "</Throughput>\n",
+      active,
+      run(ctx, active)
+    );
+  }
+
+  printf("</Networking05>\n");
+}
+
+static void Init(rtems_task_argument arg)
+{
+  int rv;
+
+  TEST_BEGIN();
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  test(&test_instance);
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS (2 * CONNECTION_COUNT + 8)
+
+#define CONFIGURE_MAXIMUM_TASKS (2 * CONNECTION_COUNT + 2)
+
+#define CONFIGURE_MAXIMUM_PROCESSORS CPU_COUNT
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT_TASK_ATTRIBUTES RTEMS_FLOATING_POINT
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
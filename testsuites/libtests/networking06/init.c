@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <sys/param.h>
+#include <sys/mbuf.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems.h>
+#include <rtems/rtems_bsdnet.h>
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "NETWORKING 6";
+
+#define DATAGRAM_COUNT 100
+
+#define DATAGRAM_SIZE 1400
+
+#define PORT 5000
+
+/*
+ * The initial pools are too small to hold all datagrams in the receive
+ * buffer.  Without a dynamic growth of the pools, the sender would wait
+ * forever for a cluster.
+ */
+struct rtems_bsdnet_config rtems_bsdnet_config = {
+  .mbuf_bytecount = 16 * 1024,
+  .mbuf_cluster_bytecount = 32 * 1024,
+  .mbuf_max_bytecount = 128 * 1024,
+  .mbuf_cluster_max_bytecount = 512 * 1024
+};
+
+/* The pools are trimmed every five seconds if they did not grow */
+#define TRIM_WAIT_SECONDS 11
+
+/* These are declared in <sys/mbuf.h> only for the kernel */
+extern struct mbstat mbstat;
+extern struct mbpoolstat mbpoolstat;
+
+static char buf[DATAGRAM_SIZE];
+
+static void test(void)
+{
+  struct sockaddr_in addr;
+  rtems_status_code sc;
+  u_long clusters;
+  int sender;
+  int receiver;
+  int rcvbuf;
+  int rv;
+  size_t i;
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_len = sizeof(addr);
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(PORT);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  receiver = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(receiver >= 0);
+
+  /*
+   * Each datagram needs its data and the sender address in the buffer.  Stay
+   * below the limit of sbreserve() for the default maximum socket buffer size.
+   */
+  rcvbuf = DATAGRAM_COUNT * (DATAGRAM_SIZE + 256);
+  rv = setsockopt(receiver, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+  rtems_test_assert(rv == 0);
+
+  rv = bind(receiver, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  sender = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(sender >= 0);
+
+  for (i = 0; i < DATAGRAM_COUNT; ++i) {
+    ssize_t n;
+
+    memset(buf, (int) i, sizeof(buf));
+    n = sendto(
+      sender,
+      buf,
+      sizeof(buf),
+      0,
+      (const struct sockaddr *) &addr,
+      sizeof(addr)
+    );
+    rtems_test_assert(n == (ssize_t) sizeof(buf));
+  }
+
+  for (i = 0; i < DATAGRAM_COUNT; ++i) {
+    ssize_t n;
+
+    n = recv(receiver, buf, sizeof(buf), 0);
+    rtems_test_assert(n == (ssize_t) sizeof(buf));
+    rtems_test_assert(buf[0] == (char) i);
+    rtems_test_assert(buf[sizeof(buf) - 1] == (char) i);
+  }
+
+  rv = close(sender);
+  rtems_test_assert(rv == 0);
+
+  rv = close(receiver);
+  rtems_test_assert(rv == 0);
+
+  /* The cluster pool had to grow beyond the initial pool */
+  rtems_test_assert(mbpoolstat.mp_clgrow > 0);
+  rtems_test_assert(
+    mbpoolstat.mp_clhiwat
+      > rtems_bsdnet_config.mbuf_cluster_bytecount / MCLBYTES
+  );
+  rtems_test_assert(
+    mbpoolstat.mp_clmax
+      == rtems_bsdnet_config.mbuf_cluster_max_bytecount / MCLBYTES
+  );
+  clusters = mbstat.m_clusters;
+  rtems_test_assert(
+    clusters > rtems_bsdnet_config.mbuf_cluster_bytecount / MCLBYTES
+  );
+
+  /* All sockets are closed, so the trim returns the grown chunks */
+  sc = rtems_task_wake_after(
+    TRIM_WAIT_SECONDS * rtems_clock_get_ticks_per_second()
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  rtems_test_assert(mbpoolstat.mp_clshrink == mbpoolstat.mp_clgrow);
+  rtems_test_assert(mbstat.m_clusters < clusters);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  int rv;
+
+  TEST_BEGIN();
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  test();
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 8
+
+#define CONFIGURE_MAXIMUM_TASKS 2
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,353 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <sys/stat.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems.h>
+#include <rtems/libio.h>
+#include <rtems/rtems_bsdnet.h>
+
+#include <librtemsNfs.h>
+
+#include "nfs_prot.h"
+#include "nfsserver.h"
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "NFSCLIENT 1";
+
+/* Provide buffer space for the RPCs of a full window */
+struct rtems_bsdnet_config rtems_bsdnet_config = {
+  .mbuf_bytecount = 256 * 1024,
+  .mbuf_cluster_bytecount = 1024 * 1024,
+  .udp_rx_buf_size = 128 * 1024
+};
+
+#define MOUNT_POINT "/nfs"
+
+#define CHUNK_SIZE NFS_MAXDATA
+
+#define CHUNK_COUNT 8
+
+#define FILE_SIZE (CHUNK_COUNT * CHUNK_SIZE)
+
+static char data[FILE_SIZE];
+
+static char buf[FILE_SIZE];
+
+static void init_data(void)
+{
+  size_t i;
+
+  for (i = 0; i < sizeof(data); ++i) {
+    data[i] = (char) (i * 13 + i / 251);
+  }
+}
+
+static void write_all(int fd, const char *p, size_t n)
+{
+  while (n > 0) {
+    ssize_t done = write(fd, p, n);
+
+    rtems_test_assert(done > 0);
+    p += done;
+    n -= (size_t) done;
+  }
+}
+
+static void read_all(int fd, char *p, size_t n)
+{
+  while (n > 0) {
+    ssize_t done = read(fd, p, n);
+
+    rtems_test_assert(done > 0);
+    p += done;
+    n -= (size_t) done;
+  }
+}
+
+static void check_write_offsets(void)
+{
+  const uint32_t *offsets;
+  size_t n;
+  size_t i;
+
+  n = nfs_server_get_write_offsets(&offsets);
+  rtems_test_assert(n == CHUNK_COUNT);
+
+  for (i = 0; i < n; ++i) {
+    rtems_test_assert(offsets[i] == i * CHUNK_SIZE);
+  }
+}
+
+static void check_server_file(const char *name)
+{
+  ssize_t size;
+
+  memset(buf, 0, sizeof(buf));
+  size = nfs_server_get_file(name, buf, sizeof(buf));
+  rtems_test_assert(size == FILE_SIZE);
+  rtems_test_assert(memcmp(buf, data, FILE_SIZE) == 0);
+}
+
+static void test_mount(void)
+{
+  int rv;
+
+  rv = mkdir(MOUNT_POINT, S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(rv == 0);
+
+  rv = mount(
+    NFS_SERVER_EXPORT,
+    MOUNT_POINT,
+    RTEMS_FILESYSTEM_TYPE_NFS,
+    RTEMS_FILESYSTEM_READ_WRITE,
+    NULL
+  );
+  rtems_test_assert(rv == 0);
+}
+
+static void test_ordering(void)
+{
+  ssize_t n;
+  int fd;
+  int rv;
+
+  nfsRpcWindow = 4;
+  nfs_server_hold_replies(false);
+
+  fd = open(MOUNT_POINT "/order", O_RDWR | O_CREAT | O_TRUNC, 0644);
+  rtems_test_assert(fd >= 0);
+
+  /* One write() results in a WRITE for each chunk, in order */
+  n = write(fd, data, FILE_SIZE);
+  rtems_test_assert(n == FILE_SIZE);
+
+  rv = fsync(fd);
+  rtems_test_assert(rv == 0);
+
+  check_write_offsets();
+  check_server_file("order");
+
+  memset(buf, 0, sizeof(buf));
+  n = pread(fd, buf, FILE_SIZE, 0);
+  rtems_test_assert(n == FILE_SIZE);
+  rtems_test_assert(memcmp(buf, data, FILE_SIZE) == 0);
+
+  /* End of file */
+  n = read(fd, buf, FILE_SIZE);
+  rtems_test_assert(n == 0);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_write_error(void)
+{
+  ssize_t size;
+  ssize_t n;
+  int fd;
+  int rv;
+
+  nfsRpcWindow = 4;
+
+  fd = open(MOUNT_POINT "/write", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  rtems_test_assert(fd >= 0);
+
+  nfs_server_fail_write(CHUNK_SIZE);
+
+  n = write(fd, &data[0], CHUNK_SIZE);
+  rtems_test_assert(n == CHUNK_SIZE);
+
+  /* The write is only queued, the error is not known yet */
+  n = write(fd, &data[CHUNK_SIZE], CHUNK_SIZE);
+  rtems_test_assert(n == CHUNK_SIZE);
+
+  errno = 0;
+  rv = fsync(fd);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == ENOSPC);
+
+  /* The error is reported once */
+  rv = fsync(fd);
+  rtems_test_assert(rv == 0);
+
+  nfs_server_fail_write(2 * CHUNK_SIZE);
+
+  n = write(fd, &data[2 * CHUNK_SIZE], CHUNK_SIZE);
+  rtems_test_assert(n == CHUNK_SIZE);
+
+  errno = 0;
+  rv = close(fd);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == ENOSPC);
+
+  nfs_server_fail_write(NFS_SERVER_NO_FAILURE);
+
+  /* Only the first chunk made it to the server */
+  memset(buf, 0, sizeof(buf));
+  size = nfs_server_get_file("write", buf, sizeof(buf));
+  rtems_test_assert(size == CHUNK_SIZE);
+  rtems_test_assert(memcmp(buf, data, CHUNK_SIZE) == 0);
+}
+
+static void test_read_error(void)
+{
+  ssize_t n;
+  int fd;
+  int rv;
+
+  nfsRpcWindow = 4;
+  nfs_server_create_file("read", data, FILE_SIZE);
+
+  fd = open(MOUNT_POINT "/read", O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  nfs_server_fail_read(2 * CHUNK_SIZE);
+
+  /* The data before the failed READ is returned */
+  memset(buf, 0, sizeof(buf));
+  n = read(fd, buf, FILE_SIZE);
+  rtems_test_assert(n == 2 * CHUNK_SIZE);
+  rtems_test_assert(memcmp(buf, data, 2 * CHUNK_SIZE) == 0);
+
+  errno = 0;
+  n = read(fd, buf, FILE_SIZE);
+  rtems_test_assert(n == -1);
+  rtems_test_assert(errno == EIO);
+
+  nfs_server_fail_read(NFS_SERVER_NO_FAILURE);
+
+  n = read(fd, buf, FILE_SIZE);
+  rtems_test_assert(n == FILE_SIZE - 2 * CHUNK_SIZE);
+  rtems_test_assert(
+    memcmp(buf, &data[2 * CHUNK_SIZE], FILE_SIZE - 2 * CHUNK_SIZE) == 0
+  );
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_window(int window)
+{
+  char path[32];
+  size_t expected;
+  off_t off;
+  int fd;
+  int rv;
+
+  expected = window > 1 ? (size_t) window : 1;
+
+  if (expected > CHUNK_COUNT) {
+    expected = CHUNK_COUNT;
+  }
+
+  snprintf(path, sizeof(path), "%s/window%i", MOUNT_POINT, window);
+  nfsRpcWindow = window;
+
+  fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  rtems_test_assert(fd >= 0);
+
+  nfs_server_hold_replies(true);
+  write_all(fd, data, FILE_SIZE);
+
+  rv = fsync(fd);
+  rtems_test_assert(rv == 0);
+
+  rtems_test_assert(nfs_server_get_max_batch() == expected);
+  check_write_offsets();
+
+  off = lseek(fd, 0, SEEK_SET);
+  rtems_test_assert(off == 0);
+
+  nfs_server_hold_replies(true);
+  memset(buf, 0, sizeof(buf));
+  read_all(fd, buf, FILE_SIZE);
+  rtems_test_assert(nfs_server_get_max_batch() == expected);
+  rtems_test_assert(memcmp(buf, data, FILE_SIZE) == 0);
+
+  nfs_server_hold_replies(false);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_unmount(void)
+{
+  int rv;
+
+  rv = unmount(MOUNT_POINT);
+  rtems_test_assert(rv == 0);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  int rv;
+
+  TEST_BEGIN();
+
+  init_data();
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  nfs_server_start(2);
+
+  test_mount();
+  test_ordering();
+  test_write_error();
+  test_read_error();
+  test_window(1);
+  test_window(2);
+  test_window(4);
+  test_window(8);
+  test_unmount();
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_MICROSECONDS_PER_TICK 10000
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_DRIVERS 4
+
+#define CONFIGURE_FILESYSTEM_NFS
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 16
+
+/* Init, network daemon, RPC daemon and NFS server */
+#define CONFIGURE_MAXIMUM_TASKS 4
+
+#define CONFIGURE_EXTRA_TASK_STACKS (32 * 1024)
+
+#define CONFIGURE_MAXIMUM_MESSAGE_QUEUES 1
+
+#define CONFIGURE_MESSAGE_BUFFER_MEMORY \
+  CONFIGURE_MESSAGE_BUFFERS_FOR_QUEUE(20, sizeof(void *))
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT_TASK_ATTRIBUTES RTEMS_FLOATING_POINT
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
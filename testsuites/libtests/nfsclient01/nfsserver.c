@@ -0,0 +1,998 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "nfsserver.h"
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rpc/rpc.h>
+#include <rpc/pmap_prot.h>
+
+#include <rtems/thread.h>
+
+#include "mount_prot.h"
+#include "nfs_prot.h"
+
+#include "tmacros.h"
+
+#define SERVER_PORT PMAPPORT
+
+#define ROOT_FILEID 1
+
+#define FILE_COUNT 16
+
+#define NAME_SIZE 32
+
+#define MSG_SIZE (NFS_MAXDATA + 1024)
+
+#define BATCH_MAX 10
+
+#define XID_HISTORY 64
+
+#define WRITE_LOG_MAX 64
+
+#define POLL_MS 10
+
+#define HOLD_MS 50
+
+#define PROC_COUNT (NFSPROC_STATFS + 1)
+
+#define FIXED_TIME 1000000000
+
+typedef struct {
+  bool used;
+  char name[NAME_SIZE];
+  uint32_t fileid;
+  uint32_t mode;
+  uint32_t size;
+  uint32_t capacity;
+  char *data;
+} server_file;
+
+typedef struct {
+  struct sockaddr_in addr;
+  uint32_t xid;
+  size_t len;
+  char buf[MSG_SIZE];
+} server_msg;
+
+typedef union {
+  nfs_fh fh;
+  sattrargs sattr;
+  diropargs dirop;
+  readargs read;
+  writeargs write;
+  createargs create;
+  renameargs rename;
+  dirpath path;
+  struct pmap pmap;
+} server_args;
+
+typedef union {
+  attrstat attr;
+  diropres dirop;
+  readres read;
+  nfsstat stat;
+  fhstatus fhs;
+  u_long port;
+} server_res;
+
+typedef struct {
+  rtems_mutex mutex;
+  int fd;
+  uint32_t next_fileid;
+  server_file files[FILE_COUNT];
+  uint32_t calls[PROC_COUNT];
+  uint32_t fail_write;
+  uint32_t fail_read;
+  bool hold;
+  size_t max_batch;
+  rtems_interval last_arrival;
+  size_t batch_count;
+  server_msg batch[BATCH_MAX];
+  uint32_t answered[XID_HISTORY];
+  size_t answered_count;
+  uint32_t write_log[WRITE_LOG_MAX];
+  size_t write_count;
+  server_args args;
+  server_res res;
+  char cred[MAX_AUTH_BYTES];
+  char verf[MAX_AUTH_BYTES];
+  char names[2][NFS_MAXNAMLEN + 1];
+  char path[MNTPATHLEN + 1];
+  char data[NFS_MAXDATA];
+  char reply[MSG_SIZE];
+} server_context;
+
+typedef struct {
+  xdrproc_t xargs;
+  xdrproc_t xres;
+  void (*handler)(server_context *ctx);
+} server_proc;
+
+static server_context server_instance;
+
+static void make_fh(nfs_fh *fh, uint32_t fileid)
+{
+  memset(fh, 0, sizeof(*fh));
+  memcpy(&fh->data[0], &fileid, sizeof(fileid));
+}
+
+static uint32_t get_fileid(const nfs_fh *fh)
+{
+  uint32_t fileid;
+
+  memcpy(&fileid, &fh->data[0], sizeof(fileid));
+  return fileid;
+}
+
+static server_file *find_by_name(server_context *ctx, const char *name)
+{
+  size_t i;
+
+  for (i = 0; i < FILE_COUNT; ++i) {
+    server_file *file = &ctx->files[i];
+
+    if (file->used && strcmp(file->name, name) == 0) {
+      return file;
+    }
+  }
+
+  return NULL;
+}
+
+static server_file *find_by_fileid(server_context *ctx, uint32_t fileid)
+{
+  size_t i;
+
+  for (i = 0; i < FILE_COUNT; ++i) {
+    server_file *file = &ctx->files[i];
+
+    if (file->used && file->fileid == fileid) {
+      return file;
+    }
+  }
+
+  return NULL;
+}
+
+static server_file *add_file(
+  server_context *ctx,
+  const char *name,
+  uint32_t mode
+)
+{
+  size_t i;
+
+  for (i = 0; i < FILE_COUNT; ++i) {
+    server_file *file = &ctx->files[i];
+
+    if (!file->used) {
+      memset(file, 0, sizeof(*file));
+      file->used = true;
+      strlcpy(file->name, name, sizeof(file->name));
+      file->fileid = ctx->next_fileid;
+      file->mode = mode;
+      ++ctx->next_fileid;
+      return file;
+    }
+  }
+
+  return NULL;
+}
+
+static void remove_file(server_file *file)
+{
+  free(file->data);
+  memset(file, 0, sizeof(*file));
+}
+
+static bool resize_file(server_file *file, uint32_t size)
+{
+  if (size > file->capacity) {
+    char *data = realloc(file->data, size);
+
+    if (data == NULL) {
+      return false;
+    }
+
+    file->data = data;
+    file->capacity = size;
+  }
+
+  if (size > file->size) {
+    memset(&file->data[file->size], 0, size - file->size);
+  }
+
+  file->size = size;
+  return true;
+}
+
+/* A NULL file denotes the exported directory */
+static void fill_attr(fattr *fa, const server_file *file)
+{
+  memset(fa, 0, sizeof(*fa));
+
+  if (file == NULL) {
+    fa->type = NFDIR;
+    fa->mode = NFSMODE_DIR | 0777;
+    fa->nlink = 2;
+    fa->size = 512;
+    fa->fileid = ROOT_FILEID;
+  } else {
+    fa->type = NFREG;
+    fa->mode = NFSMODE_REG | file->mode;
+    fa->nlink = 1;
+    fa->size = file->size;
+    fa->fileid = file->fileid;
+  }
+
+  fa->blocksize = 512;
+  fa->blocks = (fa->size + 511) / 512;
+  fa->fsid = 1;
+  fa->atime.seconds = FIXED_TIME;
+  fa->mtime.seconds = FIXED_TIME;
+  fa->ctime.seconds = FIXED_TIME;
+}
+
+static nfsstat get_node(
+  server_context *ctx,
+  const nfs_fh *fh,
+  server_file **file
+)
+{
+  uint32_t fileid = get_fileid(fh);
+
+  if (fileid == ROOT_FILEID) {
+    *file = NULL;
+    return NFS_OK;
+  }
+
+  *file = find_by_fileid(ctx, fileid);
+  return *file != NULL ? NFS_OK : NFSERR_STALE;
+}
+
+static nfsstat get_file(
+  server_context *ctx,
+  const nfs_fh *fh,
+  server_file **file
+)
+{
+  nfsstat status = get_node(ctx, fh, file);
+
+  if (status == NFS_OK && *file == NULL) {
+    status = NFSERR_ISDIR;
+  }
+
+  return status;
+}
+
+static nfsstat check_dir(server_context *ctx, const diropargs *dirop)
+{
+  uint32_t fileid = get_fileid(&dirop->dir);
+
+  if (fileid != ROOT_FILEID) {
+    return find_by_fileid(ctx, fileid) != NULL ? NFSERR_NOTDIR : NFSERR_STALE;
+  }
+
+  if (strlen(dirop->name) >= NAME_SIZE) {
+    return NFSERR_NAMETOOLONG;
+  }
+
+  return NFS_OK;
+}
+
+static void set_dirop_res(diropres *res, server_file *file)
+{
+  res->status = NFS_OK;
+  make_fh(&res->diropres_u.diropres.file, file->fileid);
+  fill_attr(&res->diropres_u.diropres.attributes, file);
+}
+
+static void nfs_getattr(server_context *ctx)
+{
+  attrstat *res = &ctx->res.attr;
+  server_file *file;
+
+  res->status = get_node(ctx, &ctx->args.fh, &file);
+
+  if (res->status == NFS_OK) {
+    fill_attr(&res->attrstat_u.attributes, file);
+  }
+}
+
+static void nfs_setattr(server_context *ctx)
+{
+  const sattr *attr = &ctx->args.sattr.attributes;
+  attrstat *res = &ctx->res.attr;
+  server_file *file;
+
+  res->status = get_node(ctx, &ctx->args.sattr.file, &file);
+
+  if (res->status == NFS_OK && file != NULL) {
+    if (attr->mode != (u_int) -1) {
+      file->mode = attr->mode & 07777;
+    }
+
+    if (attr->size != (u_int) -1 && !resize_file(file, attr->size)) {
+      res->status = NFSERR_NOSPC;
+    }
+  }
+
+  if (res->status == NFS_OK) {
+    fill_attr(&res->attrstat_u.attributes, file);
+  }
+}
+
+static void nfs_lookup(server_context *ctx)
+{
+  const diropargs *dirop = &ctx->args.dirop;
+  diropres *res = &ctx->res.dirop;
+  server_file *file;
+
+  res->status = check_dir(ctx, dirop);
+
+  if (res->status == NFS_OK) {
+    file = find_by_name(ctx, dirop->name);
+
+    if (file != NULL) {
+      set_dirop_res(res, file);
+    } else {
+      res->status = NFSERR_NOENT;
+    }
+  }
+}
+
+static void nfs_read(server_context *ctx)
+{
+  const readargs *args = &ctx->args.read;
+  readres *res = &ctx->res.read;
+  readokres *ok = &res->readres_u.reply;
+  server_file *file;
+
+  res->status = get_file(ctx, &args->file, &file);
+
+  if (res->status == NFS_OK && args->offset == ctx->fail_read) {
+    res->status = NFSERR_IO;
+  }
+
+  if (res->status == NFS_OK) {
+    uint32_t count = 0;
+
+    if (args->offset < file->size) {
+      count = file->size - args->offset;
+    }
+
+    if (count > args->count) {
+      count = args->count;
+    }
+
+    fill_attr(&ok->attributes, file);
+    ok->data.data_len = count;
+    ok->data.data_val = count > 0 ? &file->data[args->offset] : ctx->data;
+  }
+}
+
+static void nfs_write(server_context *ctx)
+{
+  const writeargs *args = &ctx->args.write;
+  attrstat *res = &ctx->res.attr;
+  server_file *file;
+
+  if (ctx->write_count < WRITE_LOG_MAX) {
+    ctx->write_log[ctx->write_count] = args->offset;
+    ++ctx->write_count;
+  }
+
+  res->status = get_file(ctx, &args->file, &file);
+
+  if (res->status == NFS_OK && args->offset == ctx->fail_write) {
+    res->status = NFSERR_NOSPC;
+  }
+
+  if (res->status == NFS_OK) {
+    uint32_t end = args->offset + args->data.data_len;
+
+    if (end > file->size && !resize_file(file, end)) {
+      res->status = NFSERR_NOSPC;
+    } else {
+      memcpy(
+        &file->data[args->offset],
+        args->data.data_val,
+        args->data.data_len
+      );
+      fill_attr(&res->attrstat_u.attributes, file);
+    }
+  }
+}
+
+static void nfs_create(server_context *ctx)
+{
+  const createargs *args = &ctx->args.create;
+  diropres *res = &ctx->res.dirop;
+  server_file *file;
+
+  res->status = check_dir(ctx, &args->where);
+
+  if (res->status == NFS_OK) {
+    file = find_by_name(ctx, args->where.name);
+
+    if (file == NULL) {
+      file = add_file(ctx, args->where.name, args->attributes.mode & 07777);
+    }
+
+    if (file == NULL) {
+      res->status = NFSERR_NOSPC;
+    } else if (
+      args->attributes.size != (u_int) -1
+        && !resize_file(file, args->attributes.size)
+    ) {
+      res->status = NFSERR_NOSPC;
+    } else {
+      set_dirop_res(res, file);
+    }
+  }
+}
+
+static void nfs_remove(server_context *ctx)
+{
+  const diropargs *dirop = &ctx->args.dirop;
+  nfsstat *res = &ctx->res.stat;
+
+  *res = check_dir(ctx, dirop);
+
+  if (*res == NFS_OK) {
+    server_file *file = find_by_name(ctx, dirop->name);
+
+    if (file != NULL) {
+      remove_file(file);
+    } else {
+      *res = NFSERR_NOENT;
+    }
+  }
+}
+
+static void nfs_rename(server_context *ctx)
+{
+  const renameargs *args = &ctx->args.rename;
+  nfsstat *res = &ctx->res.stat;
+
+  *res = check_dir(ctx, &args->from);
+
+  if (*res == NFS_OK) {
+    *res = check_dir(ctx, &args->to);
+  }
+
+  if (*res == NFS_OK) {
+    server_file *from = find_by_name(ctx, args->from.name);
+    server_file *to = find_by_name(ctx, args->to.name);
+
+    if (from == NULL) {
+      *res = NFSERR_NOENT;
+    } else if (from != to) {
+      if (to != NULL) {
+        remove_file(to);
+      }
+
+      strlcpy(from->name, args->to.name, sizeof(from->name));
+    }
+  }
+}
+
+static void mount_mnt(server_context *ctx)
+{
+  fhstatus *res = &ctx->res.fhs;
+  nfs_fh fh;
+
+  make_fh(&fh, ROOT_FILEID);
+  res->fhs_status = NFS_OK;
+  memcpy(res->fhstatus_u.fhs_fhandle, &fh, sizeof(fh));
+}
+
+static void pmap_getport(server_context *ctx)
+{
+  /* All programs use the same port */
+  ctx->res.port = SERVER_PORT;
+}
+
+static const server_proc nfs_procs[PROC_COUNT] = {
+  [NFSPROC_NULL] = {
+    (xdrproc_t) xdr_void,
+    (xdrproc_t) xdr_void,
+    NULL
+  },
+  [NFSPROC_GETATTR] = {
+    (xdrproc_t) xdr_nfs_fh,
+    (xdrproc_t) xdr_attrstat,
+    nfs_getattr
+  },
+  [NFSPROC_SETATTR] = {
+    (xdrproc_t) xdr_sattrargs,
+    (xdrproc_t) xdr_attrstat,
+    nfs_setattr
+  },
+  [NFSPROC_LOOKUP] = {
+    (xdrproc_t) xdr_diropargs,
+    (xdrproc_t) xdr_diropres,
+    nfs_lookup
+  },
+  [NFSPROC_READ] = {
+    (xdrproc_t) xdr_readargs,
+    (xdrproc_t) xdr_readres,
+    nfs_read
+  },
+  [NFSPROC_WRITE] = {
+    (xdrproc_t) xdr_writeargs,
+    (xdrproc_t) xdr_attrstat,
+    nfs_write
+  },
+  [NFSPROC_CREATE] = {
+    (xdrproc_t) xdr_createargs,
+    (xdrproc_t) xdr_diropres,
+    nfs_create
+  },
+  [NFSPROC_REMOVE] = {
+    (xdrproc_t) xdr_diropargs,
+    (xdrproc_t) xdr_nfsstat,
+    nfs_remove
+  },
+  [NFSPROC_RENAME] = {
+    (xdrproc_t) xdr_renameargs,
+    (xdrproc_t) xdr_nfsstat,
+    nfs_rename
+  }
+};
+
+static const server_proc mount_procs[MOUNTPROC_UMNT + 1] = {
+  [MOUNTPROC_NULL] = {
+    (xdrproc_t) xdr_void,
+    (xdrproc_t) xdr_void,
+    NULL
+  },
+  [MOUNTPROC_MNT] = {
+    (xdrproc_t) xdr_dirpath,
+    (xdrproc_t) xdr_fhstatus,
+    mount_mnt
+  },
+  [MOUNTPROC_UMNT] = {
+    (xdrproc_t) xdr_dirpath,
+    (xdrproc_t) xdr_void,
+    NULL
+  }
+};
+
+static const server_proc pmap_procs[PMAPPROC_GETPORT + 1] = {
+  [PMAPPROC_NULL] = {
+    (xdrproc_t) xdr_void,
+    (xdrproc_t) xdr_void,
+    NULL
+  },
+  [PMAPPROC_GETPORT] = {
+    (xdrproc_t) xdr_pmap,
+    (xdrproc_t) xdr_u_long,
+    pmap_getport
+  }
+};
+
+/* Let the strings and opaque data decode into the buffers of the context */
+static void prepare_args(server_context *ctx, xdrproc_t xargs)
+{
+  server_args *args = &ctx->args;
+
+  memset(args, 0, sizeof(*args));
+  memset(&ctx->res, 0, sizeof(ctx->res));
+
+  if (xargs == (xdrproc_t) xdr_diropargs) {
+    args->dirop.name = ctx->names[0];
+  } else if (xargs == (xdrproc_t) xdr_createargs) {
+    args->create.where.name = ctx->names[0];
+  } else if (xargs == (xdrproc_t) xdr_renameargs) {
+    args->rename.from.name = ctx->names[0];
+    args->rename.to.name = ctx->names[1];
+  } else if (xargs == (xdrproc_t) xdr_writeargs) {
+    args->write.data.data_val = ctx->data;
+  } else if (xargs == (xdrproc_t) xdr_dirpath) {
+    args->path = ctx->path;
+  }
+}
+
+/* Returns the length of the reply or zero if there is nothing to send */
+static size_t handle_request(server_context *ctx, server_msg *msg)
+{
+  struct rpc_msg call;
+  struct rpc_msg reply;
+  XDR in;
+  XDR out;
+  const server_proc *procs;
+  size_t proc_count;
+  rpcproc_t proc;
+  bool_t ok;
+
+  memset(&call, 0, sizeof(call));
+  call.rm_call.cb_cred.oa_base = ctx->cred;
+  call.rm_call.cb_verf.oa_base = ctx->verf;
+
+  xdrmem_create(&in, msg->buf, msg->len, XDR_DECODE);
+
+  if (!xdr_callmsg(&in, &call) || call.rm_direction != CALL) {
+    return 0;
+  }
+
+  memset(&reply, 0, sizeof(reply));
+  reply.rm_xid = call.rm_xid;
+  reply.rm_direction = REPLY;
+  reply.rm_reply.rp_stat = MSG_ACCEPTED;
+  reply.acpted_rply.ar_verf = _null_auth;
+  reply.acpted_rply.ar_stat = SUCCESS;
+  reply.acpted_rply.ar_results.where = (caddr_t) &ctx->res;
+  reply.acpted_rply.ar_results.proc = (xdrproc_t) xdr_void;
+
+  proc = call.rm_call.cb_proc;
+
+  switch (call.rm_call.cb_prog) {
+    case NFS_PROGRAM:
+      procs = nfs_procs;
+      proc_count = RTEMS_ARRAY_SIZE(nfs_procs);
+
+      if (proc < PROC_COUNT) {
+        ++ctx->calls[proc];
+      }
+
+      break;
+    case MOUNTPROG:
+      procs = mount_procs;
+      proc_count = RTEMS_ARRAY_SIZE(mount_procs);
+      break;
+    case PMAPPROG:
+      procs = pmap_procs;
+      proc_count = RTEMS_ARRAY_SIZE(pmap_procs);
+      break;
+    default:
+      procs = NULL;
+      proc_count = 0;
+      break;
+  }
+
+  if (procs == NULL) {
+    reply.acpted_rply.ar_stat = PROG_UNAVAIL;
+  } else if (proc >= proc_count || procs[proc].xargs == NULL) {
+    reply.acpted_rply.ar_stat = PROC_UNAVAIL;
+  } else {
+    prepare_args(ctx, procs[proc].xargs);
+
+    if ((*procs[proc].xargs)(&in, &ctx->args)) {
+      if (procs[proc].handler != NULL) {
+        (*procs[proc].handler)(ctx);
+      }
+
+      reply.acpted_rply.ar_results.proc = procs[proc].xres;
+    } else {
+      reply.acpted_rply.ar_stat = GARBAGE_ARGS;
+    }
+  }
+
+  xdrmem_create(&out, ctx->reply, sizeof(ctx->reply), XDR_ENCODE);
+  ok = xdr_replymsg(&out, &reply);
+  rtems_test_assert(ok);
+
+  return xdr_getpos(&out);
+}
+
+static bool is_known_request(const server_context *ctx, uint32_t xid)
+{
+  size_t n;
+  size_t i;
+
+  for (i = 0; i < ctx->batch_count; ++i) {
+    if (ctx->batch[i].xid == xid) {
+      return true;
+    }
+  }
+
+  n = ctx->answered_count < XID_HISTORY ? ctx->answered_count : XID_HISTORY;
+
+  for (i = 0; i < n; ++i) {
+    if (ctx->answered[i] == xid) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static void answer_batch(server_context *ctx)
+{
+  size_t i;
+
+  if (ctx->batch_count > ctx->max_batch) {
+    ctx->max_batch = ctx->batch_count;
+  }
+
+  for (i = 0; i < ctx->batch_count; ++i) {
+    server_msg *msg = &ctx->batch[i];
+    size_t len = handle_request(ctx, msg);
+
+    if (len > 0) {
+      ssize_t n = sendto(
+        ctx->fd,
+        ctx->reply,
+        len,
+        0,
+        (const struct sockaddr *) &msg->addr,
+        sizeof(msg->addr)
+      );
+      rtems_test_assert(n == (ssize_t) len);
+    }
+
+    /* Retransmissions of answered requests are ignored */
+    ctx->answered[ctx->answered_count % XID_HISTORY] = msg->xid;
+    ++ctx->answered_count;
+  }
+
+  ctx->batch_count = 0;
+}
+
+static void server_task(rtems_task_argument arg)
+{
+  server_context *ctx = (server_context *) arg;
+  rtems_interval hold_ticks = RTEMS_MILLISECONDS_TO_TICKS(HOLD_MS);
+
+  while (true) {
+    server_msg *msg = &ctx->batch[ctx->batch_count];
+    socklen_t addr_len = sizeof(msg->addr);
+    rtems_interval now;
+    ssize_t n;
+
+    n = recvfrom(
+      ctx->fd,
+      msg->buf,
+      sizeof(msg->buf),
+      0,
+      (struct sockaddr *) &msg->addr,
+      &addr_len
+    );
+    now = rtems_clock_get_ticks_since_boot();
+
+    rtems_mutex_lock(&ctx->mutex);
+
+    if (n >= (ssize_t) sizeof(msg->xid)) {
+      memcpy(&msg->xid, &msg->buf[0], sizeof(msg->xid));
+      msg->len = (size_t) n;
+
+      if (!is_known_request(ctx, msg->xid)) {
+        ++ctx->batch_count;
+        ctx->last_arrival = now;
+      }
+    }
+
+    if (
+      ctx->batch_count > 0
+        && (
+          !ctx->hold
+            || ctx->batch_count == BATCH_MAX
+            || now - ctx->last_arrival >= hold_ticks
+        )
+    ) {
+      answer_batch(ctx);
+    }
+
+    rtems_mutex_unlock(&ctx->mutex);
+  }
+}
+
+void nfs_server_start(rtems_task_priority priority)
+{
+  server_context *ctx = &server_instance;
+  struct timeval timeout = { .tv_usec = POLL_MS * 1000 };
+  struct sockaddr_in addr;
+  rtems_status_code sc;
+  rtems_id id;
+  int size;
+  int rv;
+
+  rtems_mutex_init(&ctx->mutex, "NFS Server");
+  ctx->next_fileid = ROOT_FILEID + 1;
+  ctx->fail_write = NFS_SERVER_NO_FAILURE;
+  ctx->fail_read = NFS_SERVER_NO_FAILURE;
+
+  ctx->fd = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(ctx->fd >= 0);
+
+  /* Hold the requests of a full batch */
+  size = BATCH_MAX * (MSG_SIZE + 256);
+  rv = setsockopt(ctx->fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+  rtems_test_assert(rv == 0);
+
+  size = 2 * MSG_SIZE;
+  rv = setsockopt(ctx->fd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+  rtems_test_assert(rv == 0);
+
+  rv = setsockopt(ctx->fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  rtems_test_assert(rv == 0);
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_len = sizeof(addr);
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(SERVER_PORT);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  rv = bind(ctx->fd, (const struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  sc = rtems_task_create(
+    rtems_build_name('N', 'F', 'S', 'S'),
+    priority,
+    2 * RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &id
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_task_start(id, server_task, (rtems_task_argument) ctx);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+void nfs_server_create_file(const char *name, const void *data, size_t size)
+{
+  server_context *ctx = &server_instance;
+  server_file *file;
+  bool ok;
+
+  rtems_mutex_lock(&ctx->mutex);
+
+  rtems_test_assert(strlen(name) < NAME_SIZE);
+  rtems_test_assert(find_by_name(ctx, name) == NULL);
+
+  file = add_file(ctx, name, 0644);
+  rtems_test_assert(file != NULL);
+
+  ok = resize_file(file, (uint32_t) size);
+  rtems_test_assert(ok);
+
+  if (data != NULL) {
+    memcpy(file->data, data, size);
+  }
+
+  rtems_mutex_unlock(&ctx->mutex);
+}
+
+ssize_t nfs_server_get_file(const char *name, void *buf, size_t size)
+{
+  server_context *ctx = &server_instance;
+  server_file *file;
+  ssize_t rv;
+
+  rtems_mutex_lock(&ctx->mutex);
+
+  file = find_by_name(ctx, name);
+
+  if (file != NULL) {
+    if (size > file->size) {
+      size = file->size;
+    }
+
+    memcpy(buf, file->data, size);
+    rv = (ssize_t) file->size;
+  } else {
+    rv = -1;
+  }
+
+  rtems_mutex_unlock(&ctx->mutex);
+  return rv;
+}
+
+void nfs_server_set_size(const char *name, uint32_t size)
+{
+  server_context *ctx = &server_instance;
+  server_file *file;
+  bool ok;
+
+  rtems_mutex_lock(&ctx->mutex);
+
+  file = find_by_name(ctx, name);
+  rtems_test_assert(file != NULL);
+
+  ok = resize_file(file, size);
+  rtems_test_assert(ok);
+
+  rtems_mutex_unlock(&ctx->mutex);
+}
+
+uint32_t nfs_server_replace_handle(const char *name)
+{
+  server_context *ctx = &server_instance;
+  server_file *file;
+  uint32_t fileid;
+
+  rtems_mutex_lock(&ctx->mutex);
+
+  file = find_by_name(ctx, name);
+  rtems_test_assert(file != NULL);
+
+  fileid = ctx->next_fileid;
+  ++ctx->next_fileid;
+  file->fileid = fileid;
+
+  rtems_mutex_unlock(&ctx->mutex);
+  return fileid;
+}
+
+uint32_t nfs_server_get_calls(uint32_t proc)
+{
+  server_context *ctx = &server_instance;
+  uint32_t calls;
+
+  rtems_test_assert(proc < PROC_COUNT);
+
+  rtems_mutex_lock(&ctx->mutex);
+  calls = ctx->calls[proc];
+  rtems_mutex_unlock(&ctx->mutex);
+
+  return calls;
+}
+
+void nfs_server_fail_write(uint32_t offset)
+{
+  server_context *ctx = &server_instance;
+
+  rtems_mutex_lock(&ctx->mutex);
+  ctx->fail_write = offset;
+  rtems_mutex_unlock(&ctx->mutex);
+}
+
+void nfs_server_fail_read(uint32_t offset)
+{
+  server_context *ctx = &server_instance;
+
+  rtems_mutex_lock(&ctx->mutex);
+  ctx->fail_read = offset;
+  rtems_mutex_unlock(&ctx->mutex);
+}
+
+void nfs_server_hold_replies(bool hold)
+{
+  server_context *ctx = &server_instance;
+
+  rtems_mutex_lock(&ctx->mutex);
+  ctx->hold = hold;
+  ctx->max_batch = 0;
+  ctx->write_count = 0;
+  rtems_mutex_unlock(&ctx->mutex);
+}
+
+size_t nfs_server_get_max_batch(void)
+{
+  server_context *ctx = &server_instance;
+  size_t max_batch;
+
+  rtems_mutex_lock(&ctx->mutex);
+  max_batch = ctx->max_batch;
+  rtems_mutex_unlock(&ctx->mutex);
+
+  return max_batch;
+}
+
+size_t nfs_server_get_write_offsets(const uint32_t **offsets)
+{
+  server_context *ctx = &server_instance;
+  size_t write_count;
+
+  rtems_mutex_lock(&ctx->mutex);
+  *offsets = &ctx->write_log[0];
+  write_count = ctx->write_count;
+  rtems_mutex_unlock(&ctx->mutex);
+
+  return write_count;
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifndef NFSSERVER_H
+#define NFSSERVER_H
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <rtems.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*
+ * A minimal NFS version 2 server for the NFS client tests.  It answers the
+ * portmapper, MOUNT and NFS requests on the loopback port 111 and exports a
+ * single directory with regular files held in memory.  The modification time
+ * of the directory never changes, so the client can observe changes made
+ * through this interface only through expired cache entries.
+ */
+
+#define NFS_SERVER_EXPORT "127.0.0.1:/export"
+
+#define NFS_SERVER_NO_FAILURE UINT32_MAX
+
+void nfs_server_start(rtems_task_priority priority);
+
+void nfs_server_create_file(const char *name, const void *data, size_t size);
+
+/*
+ * Returns the size of the file and copies at most size bytes of its content
+ * to buf, or returns -1 if there is no such file.
+ */
+ssize_t nfs_server_get_file(const char *name, void *buf, size_t size);
+
+void nfs_server_set_size(const char *name, uint32_t size);
+
+/*
+ * Gives the file a new file handle and file identifier, the old file handle
+ * is stale afterwards.  Returns the new file identifier.
+ */
+uint32_t nfs_server_replace_handle(const char *name);
+
+uint32_t nfs_server_get_calls(uint32_t proc);
+
+/* Fail the WRITE requests to this offset with NFSERR_NOSPC */
+void nfs_server_fail_write(uint32_t offset);
+
+/* Fail the READ requests from this offset with NFSERR_IO */
+void nfs_server_fail_read(uint32_t offset);
+
+/*
+ * In hold mode the requests are answered only once no new request arrived
+ * for some time.  This reveals the count of requests the client keeps in
+ * flight.  Changing the mode resets the batch statistics and the write log.
+ */
+void nfs_server_hold_replies(bool hold);
+
+size_t nfs_server_get_max_batch(void);
+
+/* Returns the count of logged offsets of the WRITE requests in order */
+size_t nfs_server_get_write_offsets(const uint32_t **offsets);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* NFSSERVER_H */
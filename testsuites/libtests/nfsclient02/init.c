@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <sys/stat.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems.h>
+#include <rtems/libio.h>
+#include <rtems/rtems_bsdnet.h>
+
+#include <librtemsNfs.h>
+
+#include "nfs_prot.h"
+#include "nfsserver.h"
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "NFSCLIENT 2";
+
+/* The server stand-in needs the buffer space of NFSCLIENT 1 */
+struct rtems_bsdnet_config rtems_bsdnet_config = {
+  .mbuf_bytecount = 256 * 1024,
+  .mbuf_cluster_bytecount = 1024 * 1024,
+  .udp_rx_buf_size = 128 * 1024
+};
+
+#define EXPIRE_MOUNT_POINT "/expire"
+
+#define INVALIDATE_MOUNT_POINT "/invalidate"
+
+#define STALE_MOUNT_POINT "/stale"
+
+#define TTL 2
+
+typedef struct {
+  NfsCacheStatsRec stats;
+  uint32_t lookups;
+  uint32_t getattrs;
+} test_counters;
+
+static void mount_nfs(
+  const char *mount_point,
+  int attr_ttl,
+  int dentry_ttl,
+  int neg_dentry_ttl
+)
+{
+  int rv;
+
+  /* The lifetimes are sampled by the mount */
+  nfsAttrCacheTtl = attr_ttl;
+  nfsDentryCacheTtl = dentry_ttl;
+  nfsNegDentryCacheTtl = neg_dentry_ttl;
+
+  rv = mkdir(mount_point, S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(rv == 0);
+
+  rv = mount(
+    NFS_SERVER_EXPORT,
+    mount_point,
+    RTEMS_FILESYSTEM_TYPE_NFS,
+    RTEMS_FILESYSTEM_READ_WRITE,
+    NULL
+  );
+  rtems_test_assert(rv == 0);
+}
+
+static void unmount_nfs(const char *mount_point)
+{
+  int rv;
+
+  rv = unmount(mount_point);
+  rtems_test_assert(rv == 0);
+}
+
+static void get_counters(const char *mount_point, test_counters *counters)
+{
+  int rv;
+
+  rv = nfsCacheStatsGet(mount_point, &counters->stats);
+  rtems_test_assert(rv == 0);
+
+  counters->lookups = nfs_server_get_calls(NFSPROC_LOOKUP);
+  counters->getattrs = nfs_server_get_calls(NFSPROC_GETATTR);
+}
+
+static off_t get_size(const char *path)
+{
+  struct stat st;
+  int rv;
+
+  rv = stat(path, &st);
+  rtems_test_assert(rv == 0);
+
+  return st.st_size;
+}
+
+static void check_no_entry(const char *path)
+{
+  struct stat st;
+  int rv;
+
+  errno = 0;
+  rv = stat(path, &st);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == ENOENT);
+}
+
+static void test_expiry(void)
+{
+  rtems_status_code sc;
+
+  mount_nfs(EXPIRE_MOUNT_POINT, TTL, TTL, TTL);
+
+  nfs_server_create_file("expire", NULL, 100);
+  rtems_test_assert(get_size(EXPIRE_MOUNT_POINT "/expire") == 100);
+  check_no_entry(EXPIRE_MOUNT_POINT "/late");
+
+  /* The changes on the server are hidden by the caches */
+  nfs_server_set_size("expire", 200);
+  nfs_server_create_file("late", NULL, 300);
+  rtems_test_assert(get_size(EXPIRE_MOUNT_POINT "/expire") == 100);
+  check_no_entry(EXPIRE_MOUNT_POINT "/late");
+
+  sc = rtems_task_wake_after(2 * TTL * rtems_clock_get_ticks_per_second());
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  /* The cache entries expired */
+  rtems_test_assert(get_size(EXPIRE_MOUNT_POINT "/expire") == 200);
+  rtems_test_assert(get_size(EXPIRE_MOUNT_POINT "/late") == 300);
+
+  unmount_nfs(EXPIRE_MOUNT_POINT);
+}
+
+static void test_invalidate(void)
+{
+  test_counters before;
+  test_counters after;
+  struct stat st;
+  int fd;
+  int rv;
+
+  /* The cache entries never expire */
+  mount_nfs(INVALIDATE_MOUNT_POINT, -1, -1, -1);
+
+  nfs_server_create_file("a", NULL, 100);
+  rtems_test_assert(get_size(INVALIDATE_MOUNT_POINT "/a") == 100);
+
+  get_counters(INVALIDATE_MOUNT_POINT, &before);
+  rtems_test_assert(get_size(INVALIDATE_MOUNT_POINT "/a") == 100);
+  get_counters(INVALIDATE_MOUNT_POINT, &after);
+  rtems_test_assert(after.lookups == before.lookups);
+  rtems_test_assert(after.getattrs == before.getattrs);
+  rtems_test_assert(after.stats.lookupHits == before.stats.lookupHits + 1);
+
+  /* A local SETATTR updates the cached attributes */
+  nfs_server_set_size("a", 200);
+  rtems_test_assert(get_size(INVALIDATE_MOUNT_POINT "/a") == 100);
+
+  rv = chmod(INVALIDATE_MOUNT_POINT "/a", 0600);
+  rtems_test_assert(rv == 0);
+
+  rv = stat(INVALIDATE_MOUNT_POINT "/a", &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st.st_size == 200);
+  rtems_test_assert((st.st_mode & 0777) == 0600);
+
+  /* A local rename invalidates both names */
+  check_no_entry(INVALIDATE_MOUNT_POINT "/b");
+
+  rv = rename(INVALIDATE_MOUNT_POINT "/a", INVALIDATE_MOUNT_POINT "/b");
+  rtems_test_assert(rv == 0);
+
+  check_no_entry(INVALIDATE_MOUNT_POINT "/a");
+  rtems_test_assert(get_size(INVALIDATE_MOUNT_POINT "/b") == 200);
+
+  /* A local unlink invalidates the name */
+  rv = unlink(INVALIDATE_MOUNT_POINT "/b");
+  rtems_test_assert(rv == 0);
+
+  check_no_entry(INVALIDATE_MOUNT_POINT "/b");
+
+  get_counters(INVALIDATE_MOUNT_POINT, &before);
+  check_no_entry(INVALIDATE_MOUNT_POINT "/b");
+  get_counters(INVALIDATE_MOUNT_POINT, &after);
+  rtems_test_assert(after.lookups == before.lookups);
+  rtems_test_assert(
+    after.stats.lookupNegHits == before.stats.lookupNegHits + 1
+  );
+
+  /* A local create invalidates the negative entry */
+  fd = open(INVALIDATE_MOUNT_POINT "/b", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  rtems_test_assert(fd >= 0);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  rtems_test_assert(get_size(INVALIDATE_MOUNT_POINT "/b") == 0);
+
+  unmount_nfs(INVALIDATE_MOUNT_POINT);
+}
+
+static void test_stale_handle(void)
+{
+  test_counters before;
+  test_counters after;
+  struct stat st;
+  uint32_t fileid;
+  int rv;
+
+  /* Without an attribute cache every use of a cached handle is checked */
+  mount_nfs(STALE_MOUNT_POINT, 0, -1, -1);
+
+  nfs_server_create_file("stale", NULL, 100);
+
+  rv = stat(STALE_MOUNT_POINT "/stale", &st);
+  rtems_test_assert(rv == 0);
+
+  fileid = nfs_server_replace_handle("stale");
+  rtems_test_assert(st.st_ino != fileid);
+
+  /* The cached handle is stale, so the name is looked up again */
+  get_counters(STALE_MOUNT_POINT, &before);
+  rv = stat(STALE_MOUNT_POINT "/stale", &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st.st_ino == fileid);
+  get_counters(STALE_MOUNT_POINT, &after);
+  rtems_test_assert(after.stats.lookupHits == before.stats.lookupHits + 1);
+  rtems_test_assert(after.stats.lookupRpcs == before.stats.lookupRpcs + 1);
+  rtems_test_assert(after.lookups == before.lookups + 1);
+
+  /* The new handle is cached */
+  get_counters(STALE_MOUNT_POINT, &before);
+  rv = stat(STALE_MOUNT_POINT "/stale", &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st.st_ino == fileid);
+  get_counters(STALE_MOUNT_POINT, &after);
+  rtems_test_assert(after.stats.lookupHits == before.stats.lookupHits + 1);
+  rtems_test_assert(after.lookups == before.lookups);
+
+  unmount_nfs(STALE_MOUNT_POINT);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  int rv;
+
+  TEST_BEGIN();
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  nfs_server_start(2);
+
+  test_expiry();
+  test_invalidate();
+  test_stale_handle();
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_MICROSECONDS_PER_TICK 10000
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_DRIVERS 4
+
+#define CONFIGURE_FILESYSTEM_NFS
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 16
+
+/* Init, network daemon, RPC daemon and NFS server */
+#define CONFIGURE_MAXIMUM_TASKS 4
+
+#define CONFIGURE_EXTRA_TASK_STACKS (32 * 1024)
+
+#define CONFIGURE_MAXIMUM_MESSAGE_QUEUES 1
+
+#define CONFIGURE_MESSAGE_BUFFER_MEMORY \
+  CONFIGURE_MESSAGE_BUFFERS_FOR_QUEUE(20, sizeof(void *))
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT_TASK_ATTRIBUTES RTEMS_FLOATING_POINT
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <sys/types.h>
+#include <string.h>
+
+#include "nfsclient-private.h"
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "RPCIO 1";
+
+#define RETX_MIN 2
+
+#define RETX_MAX 1000
+
+#define HASH_MSK 0xffUL
+
+static void test_rtt_steady(void)
+{
+  static const long expected[] = { 24, 20, 17, 15 };
+  RpcRttEstimator est;
+  size_t i;
+  long rto;
+
+  memset(&est, 0, sizeof(est));
+
+  /* The first sample initializes the variation to half the round trip */
+  for (i = 0; i < RTEMS_ARRAY_SIZE(expected); ++i) {
+    rto = rpcRttUpdate(&est, 8, RETX_MIN, RETX_MAX);
+    rtems_test_assert(rto == expected[i]);
+    rtems_test_assert(est.srtt == 8 << 3);
+  }
+
+  rtems_test_assert(est.rttvar == 7);
+
+  /* The variation decays to the rounding remainder */
+  for (i = 0; i < 50; ++i) {
+    rto = rpcRttUpdate(&est, 8, RETX_MIN, RETX_MAX);
+  }
+
+  rtems_test_assert(est.srtt == 8 << 3);
+  rtems_test_assert(est.rttvar == 3);
+  rtems_test_assert(rto == 11);
+}
+
+static void test_rtt_spike(void)
+{
+  RpcRttEstimator est;
+  long rto;
+  int i;
+
+  memset(&est, 0, sizeof(est));
+
+  for (i = 0; i < 4; ++i) {
+    rto = rpcRttUpdate(&est, 8, RETX_MIN, RETX_MAX);
+  }
+
+  rtems_test_assert(rto == 15);
+
+  /* A spike moves the average by 1/8 and the variation by 1/4 */
+  rto = rpcRttUpdate(&est, 40, RETX_MIN, RETX_MAX);
+  rtems_test_assert(est.srtt == 96);
+  rtems_test_assert(est.rttvar == 38);
+  rtems_test_assert(rto == 50);
+
+  rto = rpcRttUpdate(&est, 8, RETX_MIN, RETX_MAX);
+  rtems_test_assert(est.srtt == 92);
+  rtems_test_assert(est.rttvar == 33);
+  rtems_test_assert(rto == 44);
+}
+
+static void test_rtt_clamp(void)
+{
+  RpcRttEstimator est;
+  long rto;
+
+  /* A zero round trip counts as one tick */
+  memset(&est, 0, sizeof(est));
+  rto = rpcRttUpdate(&est, 0, RETX_MIN, RETX_MAX);
+  rtems_test_assert(est.srtt == 1 << 3);
+  rtems_test_assert(est.rttvar == 1 << 1);
+  rtems_test_assert(rto == 3);
+
+  memset(&est, 0, sizeof(est));
+  rto = rpcRttUpdate(&est, 0, 5, RETX_MAX);
+  rtems_test_assert(rto == 5);
+
+  memset(&est, 0, sizeof(est));
+  rto = rpcRttUpdate(&est, 1000, RETX_MIN, 100);
+  rtems_test_assert(est.srtt == 1000 << 3);
+  rtems_test_assert(rto == 100);
+}
+
+static void test_daemon_selection(void)
+{
+  int count[3];
+  unsigned long xid;
+  int i;
+
+  /* A single daemon owns all transactions */
+  for (xid = 0; xid <= HASH_MSK; ++xid) {
+    rtems_test_assert(rpcXidToIod(xid, HASH_MSK, 1) == 0);
+  }
+
+  /* The upper XID part changes with each send and must not matter */
+  rtems_test_assert(
+    rpcXidToIod(0x00000005UL, HASH_MSK, 3)
+      == rpcXidToIod(0x12345605UL, HASH_MSK, 3)
+  );
+  rtems_test_assert(rpcXidToIod(0x12345605UL, HASH_MSK, 3) == 2);
+
+  /* The hash table slots are spread evenly */
+  memset(count, 0, sizeof(count));
+
+  for (xid = 0; xid <= HASH_MSK; ++xid) {
+    i = rpcXidToIod(xid, HASH_MSK, 3);
+    rtems_test_assert(i >= 0 && i < 3);
+    ++count[i];
+  }
+
+  rtems_test_assert(count[0] == 86);
+  rtems_test_assert(count[1] == 85);
+  rtems_test_assert(count[2] == 85);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test_rtt_steady();
+  test_rtt_spike();
+  test_rtt_clamp();
+  test_daemon_selection();
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
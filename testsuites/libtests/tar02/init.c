@@ -16,9 +16,11 @@
 #include <rtems/imfs.h>
 #include <rtems/error.h>
 
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/types.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
@@ -91,6 +93,121 @@ static void write_file(
   rtems_test_assert(rv == 0);
 }
 
+static void *map_file(int fd, size_t len, int flags)
+{
+  return mmap(NULL, len, PROT_READ | PROT_WRITE, flags, fd, 0);
+}
+
+static const char *find_in_image(const char *data, size_t len)
+{
+  const char *image_begin;
+  size_t i;
+
+  image_begin = (const char *) TARFILE_START;
+
+  for (i = 0; i + len <= TARFILE_SIZE; ++i) {
+    if (memcmp(&image_begin[i], data, len) == 0) {
+      return &image_begin[i];
+    }
+  }
+
+  return NULL;
+}
+
+static void test_copy_on_write(const char *file)
+{
+  const char *image_begin;
+  const char *image_end;
+  const char *data;
+  struct stat st;
+  size_t len;
+  char *map;
+  char c;
+  ssize_t n;
+  int fd_ro;
+  int fd_rw;
+  int rv;
+
+  image_begin = (const char *) TARFILE_START;
+  image_end = image_begin + TARFILE_SIZE;
+
+  fd_ro = open(file, O_RDONLY);
+  rtems_test_assert(fd_ro >= 0);
+
+  rv = fstat(fd_ro, &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st.st_size > 1);
+  len = (size_t) st.st_size - 1;
+
+  /* Shared mappings would allow writes to the tar image */
+  errno = 0;
+  map = map_file(fd_ro, len, MAP_SHARED);
+  rtems_test_assert(map == MAP_FAILED);
+  rtems_test_assert(errno == ENOTSUP);
+
+  /* Private mappings are copies */
+  map = map_file(fd_ro, len, MAP_PRIVATE);
+  rtems_test_assert(map != MAP_FAILED);
+  rtems_test_assert(map < image_begin || map >= image_end);
+  rtems_test_assert(map[0] == '#');
+
+  data = find_in_image(map, len);
+  rtems_test_assert(data != NULL);
+
+  map[0] = '!';
+  rtems_test_assert(data[0] == '#');
+
+  n = pread(fd_ro, &c, 1, 0);
+  rtems_test_assert(n == 1);
+  rtems_test_assert(c == '#');
+
+  rv = munmap(map, len);
+  rtems_test_assert(rv == 0);
+
+  /* An open for writing does not copy the file */
+  fd_rw = open(file, O_RDWR);
+  rtems_test_assert(fd_rw >= 0);
+  n = read(fd_rw, &c, 1);
+  rtems_test_assert(n == 1);
+  rtems_test_assert(c == '#');
+
+  errno = 0;
+  map = map_file(fd_rw, len, MAP_SHARED);
+  rtems_test_assert(map == MAP_FAILED);
+  rtems_test_assert(errno == ENOTSUP);
+
+  map = map_file(fd_rw, len, MAP_PRIVATE);
+  rtems_test_assert(map != MAP_FAILED);
+
+  /* The first write copies the file, the tar image stays unchanged */
+  c = '*';
+  n = pwrite(fd_rw, &c, 1, 0);
+  rtems_test_assert(n == 1);
+  rtems_test_assert(data[0] == '#');
+  rtems_test_assert(map[0] == '#');
+
+  n = pread(fd_ro, &c, 1, 0);
+  rtems_test_assert(n == 1);
+  rtems_test_assert(c == '*');
+
+  rv = munmap(map, len);
+  rtems_test_assert(rv == 0);
+
+  /* Memfiles do not support shared mappings */
+  map = map_file(fd_ro, len, MAP_SHARED);
+  rtems_test_assert(map == MAP_FAILED);
+
+  rv = fstat(fd_ro, &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert((size_t) st.st_size == len + 1);
+
+  rv = close(fd_rw);
+  rtems_test_assert(rv == 0);
+
+  rv = close(fd_ro);
+  rtems_test_assert(rv == 0);
+}
+
 /* FIXME */
 void test_cat(
   const char *file,
@@ -120,6 +237,10 @@ void test_tarfs_load(void)
   /******************/
   printf( "========= /symlink =========\n" );
   test_cat( "/symlink", 0, 0 );
+
+  /******************/
+  printf( "========= /home/test_script =========\n" );
+  test_copy_on_write( "/home/test_script" );
 }
 
 rtems_task Init(
@@ -140,7 +261,7 @@ rtems_task Init(
 #define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
 
 #define CONFIGURE_MAXIMUM_TASKS            1
-#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 5
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 6
 
 #define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
 
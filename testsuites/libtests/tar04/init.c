@@ -0,0 +1,412 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/param.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems.h>
+#include <rtems/untar.h>
+
+const char rtems_test_name[] = "TAR 4";
+
+#define FILE_COUNT 32
+
+#define FILE_SIZE_MAX (16 * 1024)
+
+#define WRITER_COUNT 4
+
+#define TAR_SIZE_MAX ((FILE_COUNT + 8) * (FILE_SIZE_MAX + 1024))
+
+static char tar[TAR_SIZE_MAX];
+
+static size_t tar_size;
+
+static unsigned char tgz[TAR_SIZE_MAX];
+
+static size_t tgz_size;
+
+static unsigned char data[FILE_SIZE_MAX];
+
+static unsigned long progress_calls;
+
+static size_t file_size(size_t i)
+{
+  return (i * 997) % FILE_SIZE_MAX;
+}
+
+static void fill(unsigned char *buf, size_t n, unsigned char seed)
+{
+  size_t i;
+
+  for (i = 0; i < n; ++i) {
+    buf[i] = (unsigned char) (seed + i * 7);
+  }
+}
+
+static void add_member(
+  const char *name,
+  char type,
+  const char *linkname,
+  const void *content,
+  size_t size
+)
+{
+  char *h;
+  size_t i;
+  int sum;
+
+  rtems_test_assert(tar_size + 512 + size + 511 <= sizeof(tar));
+
+  h = &tar[tar_size];
+  memset(h, 0, 512);
+  strncpy(&h[0], name, 99);
+  snprintf(&h[100], 8, "%07o", type == DIRTYPE ? 0755 : 0644);
+  snprintf(&h[108], 8, "%07o", 0);
+  snprintf(&h[116], 8, "%07o", 0);
+  snprintf(&h[124], 12, "%011lo", (unsigned long) size);
+  snprintf(&h[136], 12, "%011o", 0);
+  h[156] = type;
+
+  if (linkname != NULL) {
+    strncpy(&h[157], linkname, 99);
+  }
+
+  memcpy(&h[257], "ustar", 6);
+  memcpy(&h[263], "00", 2);
+  memset(&h[148], ' ', 8);
+
+  sum = 0;
+
+  for (i = 0; i < 512; ++i) {
+    sum += 0xff & h[i];
+  }
+
+  snprintf(&h[148], 8, "%06o", sum);
+  tar_size += 512;
+
+  if (size > 0) {
+    memcpy(&tar[tar_size], content, size);
+  }
+
+  tar_size += (size + 511) & ~(size_t) 511;
+}
+
+static void add_file(size_t i)
+{
+  char name[32];
+
+  snprintf(name, sizeof(name), "dir/f%02zu", i);
+  fill(data, file_size(i), (unsigned char) i);
+  add_member(name, REGTYPE, NULL, data, file_size(i));
+}
+
+static void create_archive(void)
+{
+  z_stream strm;
+  size_t i;
+  int rv;
+
+  add_member("dir/", DIRTYPE, NULL, NULL, 0);
+
+  for (i = 0; i < FILE_COUNT; ++i) {
+    add_file(i);
+  }
+
+  /* A later member replaces an earlier file in flight */
+  fill(data, 100, 0xaa);
+  add_member("dir/f01", REGTYPE, NULL, data, 100);
+
+  /* A directory replaces a file in flight */
+  add_member("x", REGTYPE, NULL, data, 100);
+  add_member("x/", DIRTYPE, NULL, NULL, 0);
+  add_member("x/y", REGTYPE, NULL, data, 100);
+
+  /* The path to a file is created for it */
+  add_member("a/b/c", REGTYPE, NULL, data, 100);
+
+  add_member("link", SYMTYPE, "dir/f02", NULL, 0);
+
+  /* End of archive */
+  rtems_test_assert(tar_size + 1024 <= sizeof(tar));
+  memset(&tar[tar_size], 0, 1024);
+  tar_size += 1024;
+
+  memset(&strm, 0, sizeof(strm));
+  rv = deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS,
+                    8, Z_DEFAULT_STRATEGY);
+  rtems_test_assert(rv == Z_OK);
+  strm.next_in = (Bytef *) tar;
+  strm.avail_in = tar_size;
+  strm.next_out = tgz;
+  strm.avail_out = sizeof(tgz);
+  rv = deflate(&strm, Z_FINISH);
+  rtems_test_assert(rv == Z_STREAM_END);
+  tgz_size = sizeof(tgz) - strm.avail_out;
+  rv = deflateEnd(&strm);
+  rtems_test_assert(rv == Z_OK);
+}
+
+static void check_file(
+  const char *dir,
+  const char *name,
+  size_t size,
+  unsigned char seed
+)
+{
+  static unsigned char other[FILE_SIZE_MAX];
+  char path[64];
+  struct stat st;
+  ssize_t n;
+  int fd;
+  int rv;
+
+  snprintf(path, sizeof(path), "%s/%s", dir, name);
+
+  rv = stat(path, &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(S_ISREG(st.st_mode));
+  rtems_test_assert(st.st_size == (off_t) size);
+
+  fd = open(path, O_RDONLY);
+  rtems_test_assert(fd >= 0);
+  n = read(fd, other, sizeof(other));
+  rtems_test_assert(n == (ssize_t) size);
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  fill(data, size, seed);
+  rtems_test_assert(memcmp(data, other, size) == 0);
+}
+
+static void check_tree(const char *dir)
+{
+  char path[64];
+  struct stat st;
+  size_t i;
+  int rv;
+
+  for (i = 0; i < FILE_COUNT; ++i) {
+    char name[32];
+
+    snprintf(name, sizeof(name), "dir/f%02zu", i);
+
+    if (i == 1) {
+      check_file(dir, name, 100, 0xaa);
+    } else {
+      check_file(dir, name, file_size(i), (unsigned char) i);
+    }
+  }
+
+  snprintf(path, sizeof(path), "%s/x", dir);
+  rv = stat(path, &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(S_ISDIR(st.st_mode));
+  check_file(dir, "x/y", 100, 0xaa);
+  check_file(dir, "a/b/c", 100, 0xaa);
+
+  snprintf(path, sizeof(path), "%s/link", dir);
+  rv = lstat(path, &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(S_ISLNK(st.st_mode));
+  check_file(dir, "link", file_size(2), 2);
+}
+
+static void enter(const char *dir)
+{
+  int rv;
+
+  rv = mkdir(dir, S_IRWXU);
+  rtems_test_assert(rv == 0);
+  rv = chdir(dir);
+  rtems_test_assert(rv == 0);
+}
+
+static void progress(const Untar_ParallelStatistics *stats, void *arg)
+{
+  rtems_test_assert(arg == &progress_calls);
+  rtems_test_assert(stats->archive_bytes <= tar_size);
+  ++progress_calls;
+}
+
+static uint64_t test_serial(void)
+{
+  uint64_t start;
+  int rv;
+
+  enter("/serial");
+
+  start = rtems_clock_get_uptime_nanoseconds();
+  rv = Untar_FromMemory(tar, tar_size);
+  rtems_test_assert(rv == UNTAR_SUCCESSFUL);
+
+  return rtems_clock_get_uptime_nanoseconds() - start;
+}
+
+static uint64_t test_parallel_memory(void)
+{
+  Untar_ParallelConfig config;
+  Untar_ParallelStatistics stats;
+  int rv;
+
+  enter("/memory");
+
+  memset(&config, 0, sizeof(config));
+  config.writer_count = WRITER_COUNT;
+  config.progress = progress;
+  config.progress_arg = &progress_calls;
+
+  rv = Untar_FromMemory_Parallel(tar, tar_size, &config, &stats);
+  rtems_test_assert(rv == UNTAR_SUCCESSFUL);
+  rtems_test_assert(stats.files == FILE_COUNT + 4);
+  rtems_test_assert(stats.directories == 2);
+  rtems_test_assert(stats.links == 1);
+  rtems_test_assert(stats.archive_bytes == tar_size);
+  rtems_test_assert(progress_calls == FILE_COUNT + 7);
+
+  check_tree("/memory");
+
+  return stats.elapsed_ns;
+}
+
+static uint64_t test_parallel_gz(void)
+{
+  Untar_ParallelConfig config;
+  Untar_ParallelContext *ctx;
+  Untar_ParallelStatistics stats;
+  size_t i;
+  int rv;
+
+  enter("/gz");
+
+  memset(&config, 0, sizeof(config));
+  config.format = UNTAR_PARALLEL_GZ;
+  config.writer_count = WRITER_COUNT;
+  config.buffer_size = 1024;
+
+  rv = Untar_ParallelContext_Create(&ctx, &config);
+  rtems_test_assert(rv == UNTAR_SUCCESSFUL);
+
+  /* Feed odd sized chunks */
+  for (i = 0; i < tgz_size; i += 333) {
+    rv = Untar_FromChunk_Parallel(ctx, &tgz[i], MIN(333, tgz_size - i));
+    rtems_test_assert(rv == UNTAR_SUCCESSFUL);
+  }
+
+  rv = Untar_ParallelContext_Finish(ctx, &stats);
+  rtems_test_assert(rv == UNTAR_SUCCESSFUL);
+  rtems_test_assert(stats.files == FILE_COUNT + 4);
+  rtems_test_assert(stats.archive_bytes == tar_size);
+
+  check_tree("/gz");
+
+  return stats.elapsed_ns;
+}
+
+static void test_parallel_file(void)
+{
+  Untar_ParallelConfig config;
+  ssize_t n;
+  int fd;
+  int rv;
+
+  fd = open("/test.tar", O_CREAT | O_TRUNC | O_WRONLY, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+  n = write(fd, tar, tar_size);
+  rtems_test_assert(n == (ssize_t) tar_size);
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  enter("/file");
+
+  /* A single buffer makes the parsing stage wait for each segment */
+  memset(&config, 0, sizeof(config));
+  config.writer_count = 1;
+  config.writer_priority = 1;
+  config.buffer_size = 512;
+  config.buffer_count = 1;
+
+  rv = Untar_FromFile_Parallel("/test.tar", &config, NULL);
+  rtems_test_assert(rv == UNTAR_SUCCESSFUL);
+
+  check_tree("/file");
+
+  rv = Untar_FromFile_Parallel("/nix.tar", &config, NULL);
+  rtems_test_assert(rv == UNTAR_FAIL);
+}
+
+static uint64_t kib_per_second(uint64_t ns)
+{
+  if (ns == 0) {
+    ns = 1;
+  }
+
+  return (UINT64_C(1000000000) * tar_size / 1024) / ns;
+}
+
+static void Init(rtems_task_argument arg)
+{
+  uint64_t serial;
+  uint64_t memory;
+  uint64_t gz;
+
+  TEST_BEGIN();
+
+  create_archive();
+
+  serial = test_serial();
+  check_tree("/serial");
+  memory = test_parallel_memory();
+  gz = test_parallel_gz();
+  test_parallel_file();
+
+  printf(
+    "<TAR04 size=\"%zu\" writers=\"%i\">\n"
+    "  <Serial unit=\"KiB/s\">%" PRIu64 "</Serial>\n"
+    "  <ParallelMemory unit=\"KiB/s\">%" PRIu64 "</ParallelMemory>\n"
+    "  <ParallelGz unit=\"KiB/s\">%" PRIu64 "</ParallelGz>\n"
+    "</TAR04>\n",
+    tar_size,
+    WRITER_COUNT,
+    kib_per_second(serial),
+    kib_per_second(memory),
+    kib_per_second(gz)
+  );
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS (4 + WRITER_COUNT)
+
+#define CONFIGURE_MAXIMUM_TASKS (1 + WRITER_COUNT)
+
+#define CONFIGURE_EXTRA_TASK_STACKS \
+  (WRITER_COUNT * 4 * RTEMS_MINIMUM_STACK_SIZE)
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,548 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <rtems/counter.h>
+#include <rtems/termiostypes.h>
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "TERMIOS 10";
+
+#define LOOPBACK 0
+
+#define POLLED 1
+
+#define TASK 2
+
+#define DEVICE_COUNT 3
+
+#define BUFFER_SIZE 1024
+
+#define CHUNK_SIZE 512
+
+#define TRANSFER_SIZE (256 * 1024)
+
+#define TASK_INPUT_SIZE 200
+
+static const char * const paths[DEVICE_COUNT] = {
+  "/loopback",
+  "/polled",
+  "/task"
+};
+
+typedef struct {
+  rtems_termios_device_context base;
+  rtems_termios_tty *tty;
+  size_t output_pending;
+  char output_buf[BUFFER_SIZE];
+  size_t input_head;
+  size_t input_tail;
+  char input_buf[BUFFER_SIZE];
+  int poll_read_counter;
+  int poll_read_block_counter;
+} device_context;
+
+typedef struct {
+  device_context devices[DEVICE_COUNT];
+  int fds[DEVICE_COUNT];
+  struct termios term[DEVICE_COUNT];
+  char tx_buf[CHUNK_SIZE];
+  char rx_buf[CHUNK_SIZE];
+} test_context;
+
+static test_context test_instance = {
+  .devices = {
+    {
+      .base = RTEMS_TERMIOS_DEVICE_CONTEXT_INITIALIZER("Loopback")
+    }, {
+      .base = RTEMS_TERMIOS_DEVICE_CONTEXT_INITIALIZER("Polled")
+    }, {
+      .base = RTEMS_TERMIOS_DEVICE_CONTEXT_INITIALIZER("Task")
+    }
+  }
+};
+
+static bool first_open(
+  rtems_termios_tty *tty,
+  rtems_termios_device_context *base,
+  struct termios *term,
+  rtems_libio_open_close_args_t *args
+)
+{
+  device_context *dev = (device_context *) base;
+
+  dev->tty = tty;
+
+  return true;
+}
+
+static void write_loopback(
+  rtems_termios_device_context *base,
+  const char *buf,
+  size_t len
+)
+{
+  device_context *dev = (device_context *) base;
+
+  rtems_test_assert(dev->output_pending == 0);
+  rtems_test_assert(len <= BUFFER_SIZE);
+
+  if (len > 0) {
+    memcpy(dev->output_buf, buf, len);
+  }
+
+  dev->output_pending = len;
+}
+
+static void write_polled(
+  rtems_termios_device_context *base,
+  const char *buf,
+  size_t len
+)
+{
+  /* Output is discarded */
+}
+
+static int read_polled(rtems_termios_device_context *base)
+{
+  device_context *dev = (device_context *) base;
+  int c;
+
+  ++dev->poll_read_counter;
+
+  if (dev->input_head != dev->input_tail) {
+    c = (unsigned char) dev->input_buf[dev->input_head];
+    dev->input_head = (dev->input_head + 1) % BUFFER_SIZE;
+  } else {
+    c = -1;
+  }
+
+  return c;
+}
+
+static size_t read_polled_block(
+  rtems_termios_device_context *base,
+  char *buf,
+  size_t len
+)
+{
+  device_context *dev = (device_context *) base;
+  size_t n;
+
+  ++dev->poll_read_block_counter;
+
+  n = 0;
+  while (n < len && dev->input_head != dev->input_tail) {
+    buf[n] = dev->input_buf[dev->input_head];
+    dev->input_head = (dev->input_head + 1) % BUFFER_SIZE;
+    ++n;
+  }
+
+  return n;
+}
+
+static const rtems_termios_device_handler handlers[DEVICE_COUNT] = {
+  {
+    .first_open = first_open,
+    .write = write_loopback,
+    .mode = TERMIOS_IRQ_DRIVEN
+  }, {
+    .first_open = first_open,
+    .write = write_polled,
+    .poll_read = read_polled,
+    .poll_read_block = read_polled_block,
+    .mode = TERMIOS_POLLED
+  }, {
+    .first_open = first_open,
+    .write = write_polled,
+    .poll_read = read_polled,
+    .poll_read_block = read_polled_block,
+    .mode = TERMIOS_TASK_DRIVEN
+  }
+};
+
+/*
+ * Simulates the transmit interrupt of the loopback device.  The transmitted
+ * characters are received by the same device.
+ */
+static void loopback_interrupt(test_context *ctx)
+{
+  device_context *dev = &ctx->devices[LOOPBACK];
+
+  while (dev->output_pending > 0) {
+    size_t n;
+    int dropped;
+
+    n = dev->output_pending;
+    dropped = rtems_termios_enqueue_raw_characters(
+      dev->tty,
+      dev->output_buf,
+      (int) n
+    );
+    rtems_test_assert(dropped == 0);
+    dev->output_pending = 0;
+    rtems_termios_dequeue_characters(dev->tty, (int) n);
+  }
+}
+
+static void set_term(test_context *ctx, size_t i)
+{
+  int rv;
+
+  rv = tcsetattr(ctx->fds[i], TCSANOW, &ctx->term[i]);
+  rtems_test_assert(rv == 0);
+}
+
+static void init_term(test_context *ctx, size_t i)
+{
+  int rv;
+
+  rv = tcgetattr(ctx->fds[i], &ctx->term[i]);
+  rtems_test_assert(rv == 0);
+
+  ctx->term[i].c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP
+    | INLCR | IGNCR | ICRNL | IXON);
+  ctx->term[i].c_lflag &= ~(ECHO | ECHOE | ECHOK | ECHONL | ECHOPRT
+    | ECHOCTL | ECHOKE | ICANON | ISIG | IEXTEN);
+  ctx->term[i].c_cflag &= ~(CSIZE | PARENB);
+  ctx->term[i].c_cflag |= CS8;
+  ctx->term[i].c_oflag &= ~(OPOST | ONLRET | ONLCR | OCRNL | ONLRET
+    | TABDLY | OLCUC);
+
+  ctx->term[i].c_cc[VMIN] = 0;
+  ctx->term[i].c_cc[VTIME] = 0;
+
+  set_term(ctx, i);
+}
+
+static void clear_set_iflag(
+  test_context *ctx,
+  size_t i,
+  tcflag_t clear,
+  tcflag_t set
+)
+{
+  ctx->term[i].c_iflag &= ~clear;
+  ctx->term[i].c_iflag |= set;
+  set_term(ctx, i);
+}
+
+static void set_vmin_vtime(
+  test_context *ctx,
+  size_t i,
+  cc_t vmin,
+  cc_t vtime
+)
+{
+  ctx->term[i].c_cc[VMIN] = vmin;
+  ctx->term[i].c_cc[VTIME] = vtime;
+  set_term(ctx, i);
+}
+
+static void setup(test_context *ctx)
+{
+  rtems_status_code sc;
+  size_t i;
+
+  rtems_termios_initialize();
+
+  sc = rtems_termios_bufsize(BUFFER_SIZE, BUFFER_SIZE, BUFFER_SIZE);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  for (i = 0; i < DEVICE_COUNT; ++i) {
+    sc = rtems_termios_device_install(
+      paths[i],
+      &handlers[i],
+      NULL,
+      &ctx->devices[i].base
+    );
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    ctx->fds[i] = open(paths[i], O_RDWR);
+    rtems_test_assert(ctx->fds[i] >= 0);
+
+    init_term(ctx, i);
+  }
+}
+
+static void receive_chunk(test_context *ctx)
+{
+  size_t done;
+
+  done = 0;
+  while (done < CHUNK_SIZE) {
+    ssize_t n;
+
+    n = read(ctx->fds[LOOPBACK], &ctx->rx_buf[done], CHUNK_SIZE - done);
+    rtems_test_assert(n > 0);
+    done += (size_t) n;
+  }
+
+  rtems_test_assert(memcmp(ctx->rx_buf, ctx->tx_buf, CHUNK_SIZE) == 0);
+}
+
+static uint64_t transfer(test_context *ctx)
+{
+  rtems_counter_ticks t;
+  uint32_t offset;
+
+  t = rtems_counter_read();
+
+  for (offset = 0; offset < TRANSFER_SIZE; offset += CHUNK_SIZE) {
+    ssize_t n;
+
+    n = write(ctx->fds[LOOPBACK], ctx->tx_buf, CHUNK_SIZE);
+    rtems_test_assert(n == CHUNK_SIZE);
+
+    loopback_interrupt(ctx);
+    receive_chunk(ctx);
+  }
+
+  t = rtems_counter_difference(rtems_counter_read(), t);
+
+  return rtems_counter_ticks_to_nanoseconds(t);
+}
+
+static uint64_t kib_per_second(uint64_t ns)
+{
+  return (UINT64_C(1000000000) * (TRANSFER_SIZE / 1024)) / ns;
+}
+
+static void test_loopback_throughput(test_context *ctx)
+{
+  uint64_t raw;
+  uint64_t icrnl;
+  size_t i;
+
+  /* Avoid characters subject to input translations */
+  for (i = 0; i < CHUNK_SIZE; ++i) {
+    ctx->tx_buf[i] = (char) (' ' + i % 64);
+  }
+
+  raw = transfer(ctx);
+
+  clear_set_iflag(ctx, LOOPBACK, 0, ICRNL);
+  icrnl = transfer(ctx);
+  clear_set_iflag(ctx, LOOPBACK, ICRNL, 0);
+
+  printf(
+    "<Termios10 bytes=\"%i\">\n"
+    "  <Raw unit=\"KiB/s\">%" PRIu64 "</Raw>\n"
+    "  <ICRNL unit=\"KiB/s\">%" PRIu64 "</ICRNL>\n"
+    "</Termios10>\n",
+    TRANSFER_SIZE,
+    kib_per_second(raw),
+    kib_per_second(icrnl)
+  );
+}
+
+static void test_overflow(test_context *ctx)
+{
+  device_context *dev = &ctx->devices[LOOPBACK];
+  unsigned int dropped_before;
+  size_t total;
+  size_t i;
+  int dropped;
+
+  for (i = 0; i < CHUNK_SIZE; ++i) {
+    ctx->tx_buf[i] = (char) i;
+  }
+
+  dropped_before = dev->tty->rawInBufDropped;
+
+  total = 0;
+  while (total < BUFFER_SIZE) {
+    dropped = rtems_termios_enqueue_raw_characters(
+      dev->tty,
+      ctx->tx_buf,
+      CHUNK_SIZE
+    );
+    total += CHUNK_SIZE - (size_t) dropped;
+
+    if (dropped > 0) {
+      break;
+    }
+  }
+
+  rtems_test_assert(total == BUFFER_SIZE - 1);
+  rtems_test_assert(dev->tty->rawInBufDropped - dropped_before == 1);
+
+  for (i = 0; i < total; ++i) {
+    ssize_t n;
+    char c;
+
+    n = read(ctx->fds[LOOPBACK], &c, sizeof(c));
+    rtems_test_assert(n == 1);
+    rtems_test_assert(c == ctx->tx_buf[i % CHUNK_SIZE]);
+  }
+
+  dropped = rtems_termios_enqueue_raw_characters(
+    dev->tty,
+    ctx->tx_buf,
+    CHUNK_SIZE
+  );
+  rtems_test_assert(dropped == 0);
+
+  tcflush(ctx->fds[LOOPBACK], TCIFLUSH);
+  rtems_test_assert(read(ctx->fds[LOOPBACK], ctx->rx_buf, CHUNK_SIZE) == 0);
+}
+
+static void test_translation(test_context *ctx)
+{
+  static const char in[] = { 'a', '\r', 'b', '\r' };
+  char buf[sizeof(in)];
+  device_context *dev = &ctx->devices[LOOPBACK];
+  ssize_t n;
+  int dropped;
+
+  dropped = rtems_termios_enqueue_raw_characters(dev->tty, in, sizeof(in));
+  rtems_test_assert(dropped == 0);
+
+  clear_set_iflag(ctx, LOOPBACK, 0, ICRNL);
+
+  dropped = rtems_termios_enqueue_raw_characters(dev->tty, in, sizeof(in));
+  rtems_test_assert(dropped == 0);
+
+  n = read(ctx->fds[LOOPBACK], buf, sizeof(buf));
+  rtems_test_assert(n == (ssize_t) sizeof(buf));
+  rtems_test_assert(memcmp(buf, in, sizeof(in)) == 0);
+
+  n = read(ctx->fds[LOOPBACK], buf, sizeof(buf));
+  rtems_test_assert(n == (ssize_t) sizeof(buf));
+  rtems_test_assert(memcmp(buf, "a\nb\n", sizeof(buf)) == 0);
+
+  clear_set_iflag(ctx, LOOPBACK, ICRNL, 0);
+}
+
+static void input(
+  test_context *ctx,
+  size_t device,
+  const char *buf,
+  size_t len
+)
+{
+  device_context *dev = &ctx->devices[device];
+  size_t i;
+
+  for (i = 0; i < len; ++i) {
+    dev->input_buf[dev->input_tail] = buf[i];
+    dev->input_tail = (dev->input_tail + 1) % BUFFER_SIZE;
+    rtems_test_assert(dev->input_head != dev->input_tail);
+  }
+}
+
+static void test_polled_block(test_context *ctx)
+{
+  device_context *dev = &ctx->devices[POLLED];
+  char buf[8];
+  ssize_t n;
+
+  dev->poll_read_counter = 0;
+  dev->poll_read_block_counter = 0;
+
+  input(ctx, POLLED, "ab\rcd\rxy", 8);
+  set_vmin_vtime(ctx, POLLED, 6, 0);
+
+  n = read(ctx->fds[POLLED], buf, 6);
+  rtems_test_assert(n == 6);
+  rtems_test_assert(memcmp(buf, "ab\rcd\r", 6) == 0);
+  rtems_test_assert(dev->poll_read_counter == 0);
+  rtems_test_assert(dev->poll_read_block_counter == 1);
+
+  /* The remaining characters are already in the cooked buffer */
+  n = read(ctx->fds[POLLED], buf, sizeof(buf));
+  rtems_test_assert(n == 2);
+  rtems_test_assert(memcmp(buf, "xy", 2) == 0);
+  rtems_test_assert(dev->poll_read_block_counter == 1);
+
+  clear_set_iflag(ctx, POLLED, 0, ICRNL);
+  set_vmin_vtime(ctx, POLLED, 3, 0);
+
+  input(ctx, POLLED, "ab\r", 3);
+  n = read(ctx->fds[POLLED], buf, sizeof(buf));
+  rtems_test_assert(n == 3);
+  rtems_test_assert(memcmp(buf, "ab\n", 3) == 0);
+  rtems_test_assert(dev->poll_read_counter == 3);
+  rtems_test_assert(dev->poll_read_block_counter == 1);
+
+  clear_set_iflag(ctx, POLLED, ICRNL, 0);
+  set_vmin_vtime(ctx, POLLED, 0, 0);
+}
+
+static void test_task_block(test_context *ctx)
+{
+  device_context *dev = &ctx->devices[TASK];
+  size_t i;
+  ssize_t n;
+
+  dev->poll_read_counter = 0;
+  dev->poll_read_block_counter = 0;
+
+  for (i = 0; i < TASK_INPUT_SIZE; ++i) {
+    ctx->tx_buf[i] = (char) i;
+  }
+
+  input(ctx, TASK, ctx->tx_buf, TASK_INPUT_SIZE);
+  set_vmin_vtime(ctx, TASK, TASK_INPUT_SIZE, 0);
+
+  rtems_termios_rxirq_occured(dev->tty);
+
+  n = read(ctx->fds[TASK], ctx->rx_buf, TASK_INPUT_SIZE);
+  rtems_test_assert(n == TASK_INPUT_SIZE);
+  rtems_test_assert(memcmp(ctx->rx_buf, ctx->tx_buf, TASK_INPUT_SIZE) == 0);
+  rtems_test_assert(dev->poll_read_counter == 0);
+
+  /* The receive task fetches at most 64 characters at once */
+  rtems_test_assert(dev->poll_read_block_counter == 4);
+
+  set_vmin_vtime(ctx, TASK, 0, 0);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  test_context *ctx = &test_instance;
+
+  TEST_BEGIN();
+
+  setup(ctx);
+  test_translation(ctx);
+  test_overflow(ctx);
+  test_polled_block(ctx);
+  test_task_block(ctx);
+  test_loopback_throughput(ctx);
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 6
+
+#define CONFIGURE_MAXIMUM_TASKS 3
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <sys/stat.h>
+#include <dirent.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems.h>
+#include <rtems/imfs.h>
+#include <rtems/libio.h>
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "PSXIMFS 3";
+
+#define ENTRY_COUNT_MAX 4096
+
+#define LOOKUP_COUNT 4096
+
+static char path[64];
+
+static const char *entry_path(const char *dir, size_t i)
+{
+  int n;
+
+  n = snprintf(path, sizeof(path), "%s/f%04zu", dir, i);
+  rtems_test_assert(n > 0 && (size_t) n < sizeof(path));
+
+  return path;
+}
+
+static void create_entries(const char *dir, size_t count)
+{
+  size_t i;
+  int rv;
+
+  rv = mkdir(dir, S_IRWXU);
+  rtems_test_assert(rv == 0);
+
+  for (i = 0; i < count; ++i) {
+    rv = mknod(entry_path(dir, i), S_IFREG | S_IRWXU, 0);
+    rtems_test_assert(rv == 0);
+  }
+}
+
+static void remove_entries(const char *dir, size_t count)
+{
+  size_t i;
+  int rv;
+
+  for (i = 0; i < count; ++i) {
+    rv = unlink(entry_path(dir, i));
+    rtems_test_assert(rv == 0);
+  }
+
+  rv = rmdir(dir);
+  rtems_test_assert(rv == 0);
+}
+
+static void check_readdir_order(const char *dir, size_t count, size_t last)
+{
+  DIR *d;
+  struct dirent *de;
+  size_t i;
+  int rv;
+
+  d = opendir(dir);
+  rtems_test_assert(d != NULL);
+
+  i = 0;
+
+  while ((de = readdir(d)) != NULL) {
+    char name[8];
+
+    if (i == last) {
+      ++i;
+    }
+
+    if (i < count) {
+      snprintf(name, sizeof(name), "f%04zu", i);
+    } else {
+      snprintf(name, sizeof(name), "g%04zu", last);
+    }
+
+    rtems_test_assert(strcmp(de->d_name, name) == 0);
+    ++i;
+  }
+
+  rtems_test_assert(i == count + (last < count ? 1 : 0));
+
+  rv = closedir(d);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_hashed_directory(void)
+{
+  static const char dir[] = "/hashed/dir";
+  static const char other[] = "/hashed/other";
+  struct stat st;
+  size_t count;
+  size_t i;
+  int rv;
+
+  count = 1000;
+  create_entries(dir, count);
+
+  rv = stat(dir, &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st.st_size == (off_t) (count * sizeof(struct dirent)));
+
+  for (i = 0; i < count; ++i) {
+    rv = stat(entry_path(dir, i), &st);
+    rtems_test_assert(rv == 0);
+    rtems_test_assert(S_ISREG(st.st_mode));
+  }
+
+  errno = 0;
+  rv = stat(entry_path(dir, count), &st);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == ENOENT);
+
+  check_readdir_order(dir, count, SIZE_MAX);
+
+  /* A renamed entry moves to the end of the directory */
+  rv = rename("/hashed/dir/f0010", "/hashed/dir/g0010");
+  rtems_test_assert(rv == 0);
+  errno = 0;
+  rv = stat("/hashed/dir/f0010", &st);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == ENOENT);
+  rv = stat("/hashed/dir/g0010", &st);
+  rtems_test_assert(rv == 0);
+  check_readdir_order(dir, count, 10);
+
+  /* Move the entry to another directory and back */
+  rv = mkdir(other, S_IRWXU);
+  rtems_test_assert(rv == 0);
+  rv = rename("/hashed/dir/g0010", "/hashed/other/g0010");
+  rtems_test_assert(rv == 0);
+  errno = 0;
+  rv = stat("/hashed/dir/g0010", &st);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == ENOENT);
+  rv = stat("/hashed/other/g0010", &st);
+  rtems_test_assert(rv == 0);
+  rv = rename("/hashed/other/g0010", "/hashed/dir/f0010");
+  rtems_test_assert(rv == 0);
+  rv = rmdir(other);
+  rtems_test_assert(rv == 0);
+
+  /* Removal of every second entry must keep the others reachable */
+  for (i = 0; i < count; i += 2) {
+    rv = unlink(entry_path(dir, i));
+    rtems_test_assert(rv == 0);
+  }
+
+  for (i = 0; i < count; ++i) {
+    rv = stat(entry_path(dir, i), &st);
+
+    if (i % 2 == 0) {
+      rtems_test_assert(rv == -1);
+    } else {
+      rtems_test_assert(rv == 0);
+    }
+  }
+
+  for (i = 1; i < count; i += 2) {
+    rv = unlink(entry_path(dir, i));
+    rtems_test_assert(rv == 0);
+  }
+
+  rv = rmdir(dir);
+  rtems_test_assert(rv == 0);
+}
+
+static uint64_t measure_lookup(const char *dir, size_t count)
+{
+  uint64_t start;
+  uint64_t delta;
+  size_t i;
+
+  create_entries(dir, count);
+
+  start = rtems_clock_get_uptime_nanoseconds();
+
+  for (i = 0; i < LOOKUP_COUNT; ++i) {
+    struct stat st;
+    int rv;
+
+    rv = stat(entry_path(dir, (i * 7919) % count), &st);
+    rtems_test_assert(rv == 0);
+  }
+
+  delta = rtems_clock_get_uptime_nanoseconds() - start;
+
+  remove_entries(dir, count);
+
+  return delta / LOOKUP_COUNT;
+}
+
+static void benchmark_lookup(void)
+{
+  size_t count;
+
+  printf("<PSXIMFS03>\n");
+
+  for (count = 16; count <= ENTRY_COUNT_MAX; count *= 4) {
+    uint64_t linear;
+    uint64_t hashed;
+
+    linear = measure_lookup("/linear/dir", count);
+    hashed = measure_lookup("/hashed/dir", count);
+
+    printf(
+      "  <Lookup entries=\"%zu\" unit=\"ns\">\n"
+      "    <Linear>%" PRIu64 "</Linear>\n"
+      "    <Hashed>%" PRIu64 "</Hashed>\n"
+      "  </Lookup>\n",
+      count,
+      linear,
+      hashed
+    );
+  }
+
+  printf("</PSXIMFS03>\n");
+}
+
+static void Init(rtems_task_argument arg)
+{
+  int rv;
+
+  TEST_BEGIN();
+
+  rv = mkdir("/linear", S_IRWXU);
+  rtems_test_assert(rv == 0);
+
+  rv = mkdir("/hashed", S_IRWXU);
+  rtems_test_assert(rv == 0);
+
+  rv = mount(
+    NULL,
+    "/hashed",
+    RTEMS_FILESYSTEM_TYPE_IMFS,
+    RTEMS_FILESYSTEM_READ_WRITE,
+    NULL
+  );
+  rtems_test_assert(rv == 0);
+
+  test_hashed_directory();
+  benchmark_lookup();
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_FILESYSTEM_IMFS
+
+/* The base file system uses linear directory searches for comparison */
+#define CONFIGURE_IMFS_DIRECTORY_HASH_THRESHOLD IMFS_DIRECTORY_HASH_DISABLED
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 4
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
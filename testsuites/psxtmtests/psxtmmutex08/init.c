@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rtems.h>
+#include <rtems/counter.h>
+#include <rtems/test.h>
+#include <rtems/thread.h>
+
+const char rtems_test_name[] = "PSXTMMUTEX 8";
+
+#if defined(RTEMS_SMP)
+#define CPU_COUNT 8
+#else
+#define CPU_COUNT 1
+#endif
+
+#define SPIN_TIME_NS 20000
+
+#define SHORT_SECTION_NS 200
+
+#define LONG_SECTION_NS 50000
+
+typedef struct {
+  uint32_t ops;
+  uint64_t latency_sum;
+  rtems_counter_ticks latency_max;
+} test_worker_stats;
+
+typedef struct {
+  rtems_test_parallel_context base;
+  rtems_mutex short_mtx;
+  rtems_mutex long_mtx;
+  rtems_id sema;
+  rtems_mutex_statistics previous;
+  test_worker_stats stats[CPU_COUNT];
+} test_context;
+
+static test_context test_instance;
+
+static rtems_interval test_duration(void)
+{
+  return rtems_clock_get_ticks_per_second();
+}
+
+static rtems_interval test_init(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  memset(&ctx->stats, 0, sizeof(ctx->stats));
+
+  return test_duration();
+}
+
+static void update_stats(
+  test_worker_stats *stats,
+  rtems_counter_ticks t0,
+  rtems_counter_ticks t1
+)
+{
+  rtems_counter_ticks delta = rtems_counter_difference(t1, t0);
+
+  ++stats->ops;
+  stats->latency_sum += delta;
+
+  if (delta > stats->latency_max) {
+    stats->latency_max = delta;
+  }
+}
+
+static void mutex_body(
+  test_context *ctx,
+  rtems_mutex *mtx,
+  uint32_t section_ns,
+  size_t worker_index
+)
+{
+  test_worker_stats stats = { 0, 0, 0 };
+
+  while (!rtems_test_parallel_stop_job(&ctx->base)) {
+    rtems_counter_ticks t0 = rtems_counter_read();
+
+    rtems_mutex_lock(mtx);
+    update_stats(&stats, t0, rtems_counter_read());
+    rtems_counter_delay_nanoseconds(section_ns);
+    rtems_mutex_unlock(mtx);
+  }
+
+  ctx->stats[worker_index] = stats;
+}
+
+static void print_stats(
+  const char *name,
+  const test_context *ctx,
+  size_t active_workers
+)
+{
+  size_t i;
+
+  printf("  <%s activeWorker=\"%zu\">\n", name, active_workers);
+
+  for (i = 0; i < active_workers; ++i) {
+    const test_worker_stats *stats = &ctx->stats[i];
+    uint64_t avg = 0;
+
+    if (stats->ops > 0) {
+      avg = stats->latency_sum / stats->ops;
+    }
+
+    printf(
+      "    <Worker index=\"%zu\" ops=\"%" PRIu32 "\""
+        " avgLatency=\"%" PRIu64 "\" maxLatency=\"%" PRIu64 "\"/>\n",
+      i,
+      stats->ops,
+      rtems_counter_ticks_to_nanoseconds((rtems_counter_ticks) avg),
+      rtems_counter_ticks_to_nanoseconds(stats->latency_max)
+    );
+  }
+}
+
+static void print_mutex_stats(test_context *ctx, const rtems_mutex *mtx)
+{
+  rtems_mutex_statistics current;
+  int eno;
+
+  eno = rtems_mutex_get_statistics(mtx, &current);
+  rtems_test_assert(eno == 0 || eno == ENOENT);
+
+  if (eno == 0) {
+    printf(
+      "    <MutexStatistics contended=\"%lu\" spinAcquired=\"%lu\""
+        " blocked=\"%lu\"/>\n",
+      current.contended - ctx->previous.contended,
+      current.spin_acquired - ctx->previous.spin_acquired,
+      current.blocked - ctx->previous.blocked
+    );
+    ctx->previous = current;
+  }
+}
+
+static void test_short_mutex_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  mutex_body(ctx, &ctx->short_mtx, SHORT_SECTION_NS, worker_index);
+}
+
+static void test_short_mutex_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  if (active_workers == 1) {
+    memset(&ctx->previous, 0, sizeof(ctx->previous));
+  }
+
+  print_stats("ShortSectionMutex", ctx, active_workers);
+  print_mutex_stats(ctx, &ctx->short_mtx);
+  printf("  </ShortSectionMutex>\n");
+}
+
+static void test_long_mutex_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  mutex_body(ctx, &ctx->long_mtx, LONG_SECTION_NS, worker_index);
+}
+
+static void test_long_mutex_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  if (active_workers == 1) {
+    memset(&ctx->previous, 0, sizeof(ctx->previous));
+  }
+
+  print_stats("LongSectionMutex", ctx, active_workers);
+  print_mutex_stats(ctx, &ctx->long_mtx);
+  printf("  </LongSectionMutex>\n");
+}
+
+static void test_short_sema_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+  test_worker_stats stats = { 0, 0, 0 };
+
+  while (!rtems_test_parallel_stop_job(&ctx->base)) {
+    rtems_counter_ticks t0 = rtems_counter_read();
+    rtems_status_code sc;
+
+    sc = rtems_semaphore_obtain(ctx->sema, RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    update_stats(&stats, t0, rtems_counter_read());
+    rtems_counter_delay_nanoseconds(SHORT_SECTION_NS);
+
+    sc = rtems_semaphore_release(ctx->sema);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  ctx->stats[worker_index] = stats;
+}
+
+static void test_short_sema_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  print_stats("ShortSectionSemaphore", ctx, active_workers);
+  printf("  </ShortSectionSemaphore>\n");
+}
+
+static const rtems_test_parallel_job test_jobs[] = {
+  {
+    .init = test_init,
+    .body = test_short_mutex_body,
+    .fini = test_short_mutex_fini,
+    .cascade = true
+  }, {
+    .init = test_init,
+    .body = test_long_mutex_body,
+    .fini = test_long_mutex_fini,
+    .cascade = true
+  }, {
+    .init = test_init,
+    .body = test_short_sema_body,
+    .fini = test_short_sema_fini,
+    .cascade = true
+  }
+};
+
+static void Init(rtems_task_argument arg)
+{
+  test_context *ctx = &test_instance;
+  const char *test = "PSXTMMutex08";
+  rtems_status_code sc;
+
+  TEST_BEGIN();
+
+  rtems_mutex_init(&ctx->short_mtx, "Short");
+  rtems_mutex_init(&ctx->long_mtx, "Long");
+
+  sc = rtems_semaphore_create(
+    rtems_build_name('T', 'E', 'S', 'T'),
+    1,
+    RTEMS_BINARY_SEMAPHORE | RTEMS_INHERIT_PRIORITY | RTEMS_PRIORITY,
+    0,
+    &ctx->sema
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  printf("<%s spinTime=\"%i\">\n", test, SPIN_TIME_NS);
+
+  rtems_test_parallel(
+    &ctx->base,
+    NULL,
+    &test_jobs[0],
+    RTEMS_ARRAY_SIZE(test_jobs)
+  );
+
+  printf("</%s>\n", test);
+
+  rtems_mutex_destroy(&ctx->short_mtx);
+  rtems_mutex_destroy(&ctx->long_mtx);
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_TASKS CPU_COUNT
+
+#define CONFIGURE_MAXIMUM_TIMERS 1
+
+#define CONFIGURE_MAXIMUM_SEMAPHORES 1
+
+#define CONFIGURE_SELF_CONTAINED_MUTEX_SPIN_TIME SPIN_TIME_NS
+
+#define CONFIGURE_SELF_CONTAINED_MUTEX_STATISTICS 4
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT_TASK_PRIORITY 2
+
+#define CONFIGURE_MAXIMUM_PROCESSORS CPU_COUNT
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <rtems.h>
+#include <rtems/captureimpl.h>
+#include <rtems/counter.h>
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "SMPCAPTURE 3";
+
+#define CPU_COUNT 4
+
+#define MASTER_PRIORITY 1
+
+#define WORKER_PRIORITY 2
+
+#define SWITCH_ITERATIONS 500
+
+#define RECORD_BUFFER_SIZE (64 * 1024)
+
+#define START_EVENT RTEMS_EVENT_0
+
+typedef enum {
+  CAPTURE_OFF,
+  CAPTURE_ON,
+  RUN_COUNT
+} run_kind;
+
+typedef struct {
+  rtems_id ping;
+  rtems_id pong;
+  rtems_counter_ticks duration[RUN_COUNT];
+  uint32_t switch_events;
+  uint32_t drained;
+} per_cpu_context;
+
+typedef struct {
+  rtems_id done;
+  run_kind run;
+  per_cpu_context per_cpu[CPU_COUNT];
+} test_context;
+
+static test_context test_instance;
+
+static void pong_task(rtems_task_argument arg)
+{
+  per_cpu_context *pc = &test_instance.per_cpu[arg];
+
+  while (true) {
+    rtems_status_code sc;
+
+    sc = rtems_event_transient_receive(RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    sc = rtems_event_transient_send(pc->ping);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+}
+
+static void ping_task(rtems_task_argument arg)
+{
+  test_context *ctx = &test_instance;
+  per_cpu_context *pc = &ctx->per_cpu[arg];
+
+  while (true) {
+    rtems_status_code sc;
+    rtems_event_set events;
+    rtems_counter_ticks t0;
+    rtems_counter_ticks t1;
+    int i;
+
+    sc = rtems_event_receive(
+      START_EVENT,
+      RTEMS_EVENT_ALL | RTEMS_WAIT,
+      RTEMS_NO_TIMEOUT,
+      &events
+    );
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    /* Each iteration performs two context switches */
+    t0 = rtems_counter_read();
+
+    for (i = 0; i < SWITCH_ITERATIONS; ++i) {
+      sc = rtems_event_transient_send(pc->pong);
+      rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+      sc = rtems_event_transient_receive(RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+      rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+    }
+
+    t1 = rtems_counter_read();
+    pc->duration[ctx->run] = rtems_counter_difference(t1, t0);
+
+    sc = rtems_semaphore_release(ctx->done);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+}
+
+static void create_task(
+  rtems_name name,
+  rtems_task_entry entry,
+  uint32_t cpu_index,
+  rtems_id *id
+)
+{
+  rtems_status_code sc;
+  cpu_set_t cpuset;
+
+  sc = rtems_task_create(
+    name,
+    WORKER_PRIORITY,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    id
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  CPU_ZERO(&cpuset);
+  CPU_SET((int) cpu_index, &cpuset);
+
+  sc = rtems_task_set_affinity(*id, sizeof(cpuset), &cpuset);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_task_start(*id, entry, cpu_index);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void run(test_context *ctx, uint32_t cpu_count, run_kind kind)
+{
+  uint32_t cpu_index;
+
+  ctx->run = kind;
+
+  for (cpu_index = 0; cpu_index < cpu_count; ++cpu_index) {
+    rtems_status_code sc;
+
+    sc = rtems_event_send(ctx->per_cpu[cpu_index].ping, START_EVENT);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  for (cpu_index = 0; cpu_index < cpu_count; ++cpu_index) {
+    rtems_status_code sc;
+
+    sc = rtems_semaphore_obtain(ctx->done, RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+}
+
+static void count_switch_event(
+  uint32_t cpu,
+  const rtems_capture_record *rec,
+  void *arg
+)
+{
+  per_cpu_context *pc = arg;
+  rtems_capture_record in;
+
+  /* The record may be mis-aligned */
+  memcpy(&in, rec, sizeof(in));
+
+  if (
+    (in.events & (RTEMS_CAPTURE_SWITCHED_OUT | RTEMS_CAPTURE_SWITCHED_IN)) != 0
+  ) {
+    ++pc->switch_events;
+  }
+}
+
+static void drain(test_context *ctx, uint32_t cpu_count)
+{
+  uint32_t cpu_index;
+
+  for (cpu_index = 0; cpu_index < cpu_count; ++cpu_index) {
+    per_cpu_context *pc = &ctx->per_cpu[cpu_index];
+    rtems_status_code sc;
+
+    sc = rtems_capture_drain(
+      cpu_index,
+      UINT32_MAX,
+      count_switch_event,
+      pc,
+      &pc->drained
+    );
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+}
+
+static void report(test_context *ctx, uint32_t cpu_count)
+{
+  uint32_t cpu_index;
+
+  printf("<SMPCapture03 switchCount=\"%i\">\n", 2 * SWITCH_ITERATIONS);
+
+  for (cpu_index = 0; cpu_index < cpu_count; ++cpu_index) {
+    per_cpu_context *pc = &ctx->per_cpu[cpu_index];
+    uint64_t off;
+    uint64_t on;
+    uint64_t overhead;
+
+    off = rtems_counter_ticks_to_nanoseconds(pc->duration[CAPTURE_OFF]);
+    on = rtems_counter_ticks_to_nanoseconds(pc->duration[CAPTURE_ON]);
+    overhead = on > off ? (on - off) / (2 * SWITCH_ITERATIONS) : 0;
+
+    printf(
+      "  <Processor index=\"%" PRIu32 "\">\n"
+      "    <DurationCaptureOff unit=\"ns\">%" PRIu64 "</DurationCaptureOff>\n"
+      "    <DurationCaptureOn unit=\"ns\">%" PRIu64 "</DurationCaptureOn>\n"
+      "    <OverheadPerSwitch unit=\"ns\">%" PRIu64 "</OverheadPerSwitch>\n"
+      "    <DrainedRecords>%" PRIu32 "</DrainedRecords>\n"
+      "    <SwitchEvents>%" PRIu32 "</SwitchEvents>\n"
+      "  </Processor>\n",
+      cpu_index,
+      off,
+      on,
+      overhead,
+      pc->drained,
+      pc->switch_events
+    );
+  }
+
+  printf("</SMPCapture03>\n");
+}
+
+static void test(void)
+{
+  test_context *ctx = &test_instance;
+  rtems_status_code sc;
+  uint32_t cpu_count;
+  uint32_t cpu_index;
+
+  cpu_count = rtems_get_processor_count();
+  if (cpu_count > CPU_COUNT) {
+    cpu_count = CPU_COUNT;
+  }
+
+  sc = rtems_semaphore_create(
+    rtems_build_name('D', 'O', 'N', 'E'),
+    0,
+    RTEMS_COUNTING_SEMAPHORE,
+    0,
+    &ctx->done
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  for (cpu_index = 0; cpu_index < cpu_count; ++cpu_index) {
+    per_cpu_context *pc = &ctx->per_cpu[cpu_index];
+
+    create_task(
+      rtems_build_name('P', 'I', 'N', 'G'),
+      ping_task,
+      cpu_index,
+      &pc->ping
+    );
+    create_task(
+      rtems_build_name('P', 'O', 'N', 'G'),
+      pong_task,
+      cpu_index,
+      &pc->pong
+    );
+  }
+
+  sc = rtems_capture_open(RECORD_BUFFER_SIZE, NULL);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_watch_ceiling(0);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_watch_floor(255);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_watch_global(true);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_set_trigger(
+    0,
+    0,
+    rtems_build_name('P', 'I', 'N', 'G'),
+    0,
+    rtems_capture_from_any,
+    rtems_capture_switch
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  run(ctx, cpu_count, CAPTURE_OFF);
+
+  sc = rtems_capture_set_control(true);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  run(ctx, cpu_count, CAPTURE_ON);
+
+  /* Draining is possible while capture control is enabled */
+  drain(ctx, cpu_count);
+
+  sc = rtems_capture_set_control(false);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  report(ctx, cpu_count);
+
+  for (cpu_index = 0; cpu_index < cpu_count; ++cpu_index) {
+    per_cpu_context *pc = &ctx->per_cpu[cpu_index];
+
+    rtems_test_assert(pc->switch_events >= 2 * SWITCH_ITERATIONS);
+
+    sc = rtems_task_delete(pc->ping);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    sc = rtems_task_delete(pc->pong);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  sc = rtems_capture_flush(false);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_close();
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_SCHEDULER_PRIORITY_AFFINITY_SMP
+
+#define CONFIGURE_MAXIMUM_PROCESSORS CPU_COUNT
+
+#define CONFIGURE_MAXIMUM_TASKS (1 + 2 * CPU_COUNT)
+
+#define CONFIGURE_MAXIMUM_SEMAPHORES 1
+
+#define CONFIGURE_MAXIMUM_USER_EXTENSIONS 1
+
+#define CONFIGURE_INIT_TASK_PRIORITY MASTER_PRIORITY
+#define CONFIGURE_INIT_TASK_INITIAL_MODES RTEMS_DEFAULT_MODES
+#define CONFIGURE_INIT_TASK_ATTRIBUTES RTEMS_DEFAULT_ATTRIBUTES
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
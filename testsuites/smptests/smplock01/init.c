@@ -157,7 +157,12 @@ static void test_1_body(
   SMP_MCS_lock_Context lock_context;
 
   while (!rtems_test_parallel_stop_job(&ctx->base)) {
-    _SMP_MCS_lock_Acquire(&ctx->mcs_lock, &lock_context, &ctx->mcs_stats);
+    _SMP_MCS_lock_Acquire(
+      &ctx->mcs_lock,
+      &lock_context,
+      &ctx->mcs_stats,
+      NULL
+    );
     _SMP_MCS_lock_Release(&ctx->mcs_lock, &lock_context);
     ++counter;
   }
@@ -232,7 +237,12 @@ static void test_3_body(
   SMP_MCS_lock_Context lock_context;
 
   while (!rtems_test_parallel_stop_job(&ctx->base)) {
-    _SMP_MCS_lock_Acquire(&ctx->mcs_lock, &lock_context, &ctx->mcs_stats);
+    _SMP_MCS_lock_Acquire(
+      &ctx->mcs_lock,
+      &lock_context,
+      &ctx->mcs_stats,
+      NULL
+    );
     ++ctx->counter[test];
     _SMP_MCS_lock_Release(&ctx->mcs_lock, &lock_context);
     ++counter;
@@ -319,7 +329,7 @@ static void test_5_body(
   _SMP_MCS_lock_Initialize(&lock);
 
   while (!rtems_test_parallel_stop_job(&ctx->base)) {
-    _SMP_MCS_lock_Acquire(&lock, &lock_context, &stats);
+    _SMP_MCS_lock_Acquire(&lock, &lock_context, &stats, NULL);
     _SMP_MCS_lock_Release(&lock, &lock_context);
     ++counter;
   }
@@ -412,7 +422,7 @@ static void test_7_body(
   _SMP_MCS_lock_Initialize(&lock);
 
   while (!rtems_test_parallel_stop_job(&ctx->base)) {
-    _SMP_MCS_lock_Acquire(&lock, &lock_context, &stats);
+    _SMP_MCS_lock_Acquire(&lock, &lock_context, &stats, NULL);
 
     /* The counter value is not interesting, only the access to it */
     ++ctx->counter[test];
@@ -503,7 +513,12 @@ static void test_9_body(
   SMP_MCS_lock_Context lock_context;
 
   while (!rtems_test_parallel_stop_job(&ctx->base)) {
-    _SMP_MCS_lock_Acquire(&ctx->mcs_lock, &lock_context, &ctx->mcs_stats);
+    _SMP_MCS_lock_Acquire(
+      &ctx->mcs_lock,
+      &lock_context,
+      &ctx->mcs_stats,
+      NULL
+    );
     busy_section();
     _SMP_MCS_lock_Release(&ctx->mcs_lock, &lock_context);
     ++counter;
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <limits.h>
+
+#include <rtems/thread.h>
+#include <rtems/test.h>
+#include <rtems.h>
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "SMPLOCK 2";
+
+#define TASK_PRIORITY 1
+
+#define CPU_COUNT 32
+
+#define TEST_COUNT 3
+
+typedef struct {
+  rtems_test_parallel_context base;
+  unsigned long local_counter[CPU_COUNT][TEST_COUNT][CPU_COUNT];
+  rtems_interrupt_lock lock RTEMS_ALIGNED(CPU_CACHE_LINE_BYTES);
+  unsigned long counter RTEMS_ALIGNED(CPU_CACHE_LINE_BYTES);
+  rtems_binary_semaphore sem RTEMS_ALIGNED(CPU_CACHE_LINE_BYTES);
+} test_context;
+
+static test_context test_instance = {
+  .lock = RTEMS_INTERRUPT_LOCK_INITIALIZER("global"),
+  .sem = RTEMS_BINARY_SEMAPHORE_INITIALIZER("global")
+};
+
+static const char *lock_implementation(void)
+{
+#if defined(RTEMS_SMP_LOCK_MCS)
+  return "MCS";
+#else
+  return "Ticket";
+#endif
+}
+
+static rtems_interval test_duration(void)
+{
+  return rtems_clock_get_ticks_per_second();
+}
+
+static rtems_interval test_init(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  return test_duration();
+}
+
+static void test_fini(
+  test_context *ctx,
+  const char *name,
+  size_t test,
+  size_t active_workers
+)
+{
+  unsigned long sum = 0;
+  unsigned long min = ULONG_MAX;
+  unsigned long max = 0;
+  unsigned long n = active_workers;
+  unsigned long i;
+
+  printf("  <%s activeWorker=\"%lu\">\n", name, n);
+
+  for (i = 0; i < n; ++i) {
+    unsigned long local_counter =
+      ctx->local_counter[active_workers - 1][test][i];
+
+    sum += local_counter;
+
+    if (local_counter < min) {
+      min = local_counter;
+    }
+
+    if (local_counter > max) {
+      max = local_counter;
+    }
+
+    printf(
+      "    <LocalCounter worker=\"%lu\">%lu</LocalCounter>\n",
+      i,
+      local_counter
+    );
+  }
+
+  printf(
+    "    <SumOfLocalCounter>%lu</SumOfLocalCounter>\n"
+    "    <MinOfLocalCounter>%lu</MinOfLocalCounter>\n"
+    "    <MaxOfLocalCounter>%lu</MaxOfLocalCounter>\n"
+    "  </%s>\n",
+    sum,
+    min,
+    max,
+    name
+  );
+}
+
+static void test_0_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+  size_t test = 0;
+  unsigned long counter = 0;
+  rtems_interrupt_lock_context lock_context;
+
+  while (!rtems_test_parallel_stop_job(&ctx->base)) {
+    rtems_interrupt_lock_acquire(&ctx->lock, &lock_context);
+    rtems_interrupt_lock_release(&ctx->lock, &lock_context);
+    ++counter;
+  }
+
+  ctx->local_counter[active_workers - 1][test][worker_index] = counter;
+}
+
+static void test_0_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  test_fini(ctx, "InterruptLock", 0, active_workers);
+}
+
+static void test_1_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+  size_t test = 1;
+  unsigned long counter = 0;
+  rtems_interrupt_lock_context lock_context;
+
+  while (!rtems_test_parallel_stop_job(&ctx->base)) {
+    rtems_interrupt_lock_acquire(&ctx->lock, &lock_context);
+    ++ctx->counter;
+    rtems_interrupt_lock_release(&ctx->lock, &lock_context);
+    ++counter;
+  }
+
+  ctx->local_counter[active_workers - 1][test][worker_index] = counter;
+}
+
+static void test_1_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  test_fini(ctx, "InterruptLockWithGlobalCounter", 1, active_workers);
+}
+
+static void test_2_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+  size_t test = 2;
+  unsigned long counter = 0;
+
+  /*
+   * Each try wait and post operation acquires and releases the thread queue
+   * lock of the binary semaphore.  The try wait does not block, so the lock
+   * is the only point of contention.
+   */
+  while (!rtems_test_parallel_stop_job(&ctx->base)) {
+    if (rtems_binary_semaphore_try_wait(&ctx->sem) == 0) {
+      rtems_binary_semaphore_post(&ctx->sem);
+    }
+
+    ++counter;
+  }
+
+  ctx->local_counter[active_workers - 1][test][worker_index] = counter;
+}
+
+static void test_2_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  test_fini(ctx, "ThreadQueueLock", 2, active_workers);
+}
+
+static const rtems_test_parallel_job test_jobs[TEST_COUNT] = {
+  {
+    .init = test_init,
+    .body = test_0_body,
+    .fini = test_0_fini,
+    .cascade = true
+  }, {
+    .init = test_init,
+    .body = test_1_body,
+    .fini = test_1_fini,
+    .cascade = true
+  }, {
+    .init = test_init,
+    .body = test_2_body,
+    .fini = test_2_fini,
+    .cascade = true
+  }
+};
+
+static void test(void)
+{
+  test_context *ctx = &test_instance;
+  const char *test = "SMPLock02";
+
+  rtems_binary_semaphore_post(&ctx->sem);
+
+  printf("<%s lockImplementation=\"%s\">\n", test, lock_implementation());
+  rtems_test_parallel(&ctx->base, NULL, &test_jobs[0], TEST_COUNT);
+  printf("</%s>\n", test);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_PROCESSORS CPU_COUNT
+
+#define CONFIGURE_MAXIMUM_TASKS CPU_COUNT
+
+#define CONFIGURE_MAXIMUM_TIMERS 1
+
+#define CONFIGURE_INIT_TASK_PRIORITY TASK_PRIORITY
+#define CONFIGURE_INIT_TASK_INITIAL_MODES RTEMS_DEFAULT_MODES
+#define CONFIGURE_INIT_TASK_ATTRIBUTES RTEMS_DEFAULT_ATTRIBUTES
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
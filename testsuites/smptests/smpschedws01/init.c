@@ -0,0 +1,528 @@
+/*
+ * Copyright (c) 2026 RTEMS Project contributors.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <rtems.h>
+#include <rtems/test.h>
+
+#include "tmacros.h"
+
+const char rtems_test_name[] = "SMPSCHEDWS 1";
+
+#define CPU_COUNT 4
+
+#define TASK_PRIORITY 2
+
+#define PARTNER_PRIORITY 2
+
+#define SCHED_WS rtems_build_name('W', 'S', ' ', ' ')
+
+#define SCHED_PRIO rtems_build_name('P', 'R', 'I', 'O')
+
+#define EVENT_PING RTEMS_EVENT_0
+
+#define EVENT_PONG RTEMS_EVENT_1
+
+typedef struct {
+  rtems_test_parallel_context base;
+  rtems_id partner[CPU_COUNT];
+  unsigned long counter[CPU_COUNT];
+  Atomic_Ulong migrations;
+  rtems_id main_task;
+  volatile uint32_t hog_cpu_index[CPU_COUNT];
+  volatile bool hog_stop[CPU_COUNT];
+  volatile uint32_t stolen_cpu_index;
+} test_context;
+
+static test_context test_instance;
+
+static void partner_task(rtems_task_argument arg)
+{
+  test_context *ctx = &test_instance;
+  size_t worker_index = arg;
+
+  while (true) {
+    rtems_status_code sc;
+    rtems_event_set events;
+
+    sc = rtems_event_receive(
+      EVENT_PING,
+      RTEMS_EVENT_ALL | RTEMS_WAIT,
+      RTEMS_NO_TIMEOUT,
+      &events
+    );
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    sc = rtems_event_send(ctx->base.worker_ids[worker_index], EVENT_PONG);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+}
+
+static rtems_interval ping_pong_init(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+  size_t i;
+
+  for (i = 0; i < active_workers; ++i) {
+    rtems_status_code sc;
+
+    sc = rtems_task_create(
+      rtems_build_name('P', 'A', 'R', 'T'),
+      PARTNER_PRIORITY,
+      RTEMS_MINIMUM_STACK_SIZE,
+      RTEMS_DEFAULT_MODES,
+      RTEMS_DEFAULT_ATTRIBUTES,
+      &ctx->partner[i]
+    );
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    sc = rtems_task_start(ctx->partner[i], partner_task, i);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  return rtems_clock_get_ticks_per_second();
+}
+
+static void ping_pong_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+  rtems_id partner = ctx->partner[worker_index];
+  uint32_t cpu_index = rtems_get_current_processor();
+  unsigned long counter = 0;
+  unsigned long migrations = 0;
+
+  while (!rtems_test_parallel_stop_job(&ctx->base)) {
+    rtems_status_code sc;
+    rtems_event_set events;
+    uint32_t other_cpu_index;
+
+    sc = rtems_event_send(partner, EVENT_PING);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    sc = rtems_event_receive(
+      EVENT_PONG,
+      RTEMS_EVENT_ALL | RTEMS_WAIT,
+      RTEMS_NO_TIMEOUT,
+      &events
+    );
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    other_cpu_index = rtems_get_current_processor();
+
+    if (other_cpu_index != cpu_index) {
+      cpu_index = other_cpu_index;
+      ++migrations;
+    }
+
+    ++counter;
+  }
+
+  ctx->counter[worker_index] = counter;
+
+  if (migrations > 0) {
+    _Atomic_Fetch_add_ulong(
+      &ctx->migrations,
+      migrations,
+      ATOMIC_ORDER_RELAXED
+    );
+  }
+}
+
+static void ping_pong_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+  const char *scheduler = arg;
+  unsigned long sum = 0;
+  size_t i;
+
+  printf(
+    "  <PingPong scheduler=\"%s\" activeWorker=\"%zu\">\n",
+    scheduler,
+    active_workers
+  );
+
+  for (i = 0; i < active_workers; ++i) {
+    rtems_status_code sc;
+
+    sum += ctx->counter[i];
+    printf(
+      "    <Counter worker=\"%zu\">%lu</Counter>\n",
+      i,
+      ctx->counter[i]
+    );
+
+    sc = rtems_task_delete(ctx->partner[i]);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  printf(
+    "    <SumOfCounter>%lu</SumOfCounter>\n"
+    "    <Migrations>%lu</Migrations>\n"
+    "  </PingPong>\n",
+    sum,
+    _Atomic_Load_ulong(&ctx->migrations, ATOMIC_ORDER_RELAXED)
+  );
+
+  _Atomic_Store_ulong(&ctx->migrations, 0, ATOMIC_ORDER_RELAXED);
+}
+
+static const rtems_test_parallel_job work_stealing_jobs[] = {
+  {
+    .init = ping_pong_init,
+    .body = ping_pong_body,
+    .fini = ping_pong_fini,
+    .arg = "WorkStealingSMP",
+    .cascade = true
+  }
+};
+
+static const rtems_test_parallel_job priority_jobs[] = {
+  {
+    .init = ping_pong_init,
+    .body = ping_pong_body,
+    .fini = ping_pong_fini,
+    .arg = "PrioritySMP",
+    .cascade = true
+  }
+};
+
+static void busy_task(rtems_task_argument arg)
+{
+  volatile uint32_t *cpu_index = (volatile uint32_t *) arg;
+
+  *cpu_index = rtems_get_current_processor();
+
+  while (true) {
+    /* Wait for deletion */
+  }
+}
+
+static void test_idle_processor_steals(void)
+{
+  rtems_status_code sc;
+  uint32_t cpu_count = rtems_get_processor_count();
+  volatile uint32_t cpu_index[CPU_COUNT];
+  rtems_id busy[CPU_COUNT];
+  uint32_t i;
+
+  if (cpu_count < 2) {
+    return;
+  }
+
+  /*
+   * All busy tasks are created on the same processor.  The idle processors
+   * must pick them up, so that each processor executes exactly one task.
+   */
+  for (i = 0; i < cpu_count - 1; ++i) {
+    cpu_index[i] = UINT32_MAX;
+
+    sc = rtems_task_create(
+      rtems_build_name('B', 'U', 'S', 'Y'),
+      TASK_PRIORITY - 1,
+      RTEMS_MINIMUM_STACK_SIZE,
+      RTEMS_DEFAULT_MODES,
+      RTEMS_DEFAULT_ATTRIBUTES,
+      &busy[i]
+    );
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    sc = rtems_task_start(
+      busy[i],
+      busy_task,
+      (rtems_task_argument) &cpu_index[i]
+    );
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  for (i = 0; i < cpu_count - 1; ++i) {
+    uint32_t j;
+
+    while (cpu_index[i] == UINT32_MAX) {
+      /* Wait for busy task */
+    }
+
+    rtems_test_assert(cpu_index[i] < cpu_count);
+    rtems_test_assert(cpu_index[i] != rtems_get_current_processor());
+
+    for (j = 0; j < i; ++j) {
+      rtems_test_assert(cpu_index[i] != cpu_index[j]);
+    }
+  }
+
+  for (i = 0; i < cpu_count - 1; ++i) {
+    sc = rtems_task_delete(busy[i]);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+}
+
+static void hog_task(rtems_task_argument arg)
+{
+  test_context *ctx = &test_instance;
+  size_t i = arg;
+
+  ctx->hog_cpu_index[i] = rtems_get_current_processor();
+
+  while (!ctx->hog_stop[i]) {
+    /* Wait for stop request */
+  }
+
+  (void) rtems_task_suspend(RTEMS_SELF);
+}
+
+static void stolen_task(rtems_task_argument arg)
+{
+  test_context *ctx = &test_instance;
+  rtems_status_code sc;
+
+  ctx->stolen_cpu_index = rtems_get_current_processor();
+
+  sc = rtems_event_send(ctx->main_task, EVENT_PING);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  (void) rtems_task_suspend(RTEMS_SELF);
+}
+
+static void test_idle_processor_steals_from_other_queue(void)
+{
+  test_context *ctx = &test_instance;
+  rtems_status_code sc;
+  rtems_event_set events;
+  uint32_t cpu_count = rtems_get_processor_count();
+  uint32_t last = cpu_count - 1;
+  uint32_t self_cpu_index;
+  uint32_t idle_cpu_index;
+  rtems_id hog[CPU_COUNT];
+  rtems_id stolen;
+  uint32_t i;
+
+  if (cpu_count < 2) {
+    return;
+  }
+
+  ctx->main_task = rtems_task_self();
+  ctx->stolen_cpu_index = UINT32_MAX;
+  self_cpu_index = rtems_get_current_processor();
+
+  /* Keep all other processors busy with higher priority tasks */
+  for (i = 0; i < cpu_count - 1; ++i) {
+    ctx->hog_cpu_index[i] = UINT32_MAX;
+    ctx->hog_stop[i] = false;
+
+    sc = rtems_task_create(
+      rtems_build_name('H', 'O', 'G', ' '),
+      TASK_PRIORITY - 1,
+      RTEMS_MINIMUM_STACK_SIZE,
+      RTEMS_DEFAULT_MODES,
+      RTEMS_DEFAULT_ATTRIBUTES,
+      &hog[i]
+    );
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    sc = rtems_task_start(hog[i], hog_task, i);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  for (i = 0; i < cpu_count - 1; ++i) {
+    while (ctx->hog_cpu_index[i] == UINT32_MAX) {
+      /* Wait for hog task */
+    }
+
+    rtems_test_assert(ctx->hog_cpu_index[i] != self_cpu_index);
+  }
+
+  /*
+   * No processor is idle and all scheduled tasks have a higher priority, so
+   * the new task is queued on the ready queue of its initial home processor,
+   * which is the last processor of the scheduler instance.
+   */
+  sc = rtems_task_create(
+    rtems_build_name('S', 'T', 'O', 'L'),
+    TASK_PRIORITY + 1,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &stolen
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_task_start(stolen, stolen_task, 0);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  rtems_test_assert(ctx->stolen_cpu_index == UINT32_MAX);
+
+  /*
+   * Let another processor become idle.  Its own ready queue is empty, so it
+   * must steal the queued task from the ready queue of the last processor.
+   */
+  if (self_cpu_index != last) {
+    idle_cpu_index = self_cpu_index;
+
+    sc = rtems_event_receive(
+      EVENT_PING,
+      RTEMS_EVENT_ALL | RTEMS_WAIT,
+      RTEMS_NO_TIMEOUT,
+      &events
+    );
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  } else {
+    idle_cpu_index = ctx->hog_cpu_index[0];
+    ctx->hog_stop[0] = true;
+
+    while (ctx->stolen_cpu_index == UINT32_MAX) {
+      /* Wait for stolen task */
+    }
+
+    sc = rtems_event_receive(
+      EVENT_PING,
+      RTEMS_EVENT_ALL | RTEMS_NO_WAIT,
+      RTEMS_NO_TIMEOUT,
+      &events
+    );
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  rtems_test_assert(idle_cpu_index != last);
+  rtems_test_assert(ctx->stolen_cpu_index == idle_cpu_index);
+
+  sc = rtems_task_delete(stolen);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  for (i = 0; i < cpu_count - 1; ++i) {
+    sc = rtems_task_delete(hog[i]);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+}
+
+static void move_processors_to_priority_scheduler(void)
+{
+  rtems_status_code sc;
+  rtems_id ws;
+  rtems_id prio;
+  uint32_t cpu_count = rtems_get_processor_count();
+  uint32_t cpu_index;
+
+  sc = rtems_scheduler_ident(SCHED_WS, &ws);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_scheduler_ident(SCHED_PRIO, &prio);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  for (cpu_index = 1; cpu_index < cpu_count; ++cpu_index) {
+    sc = rtems_scheduler_remove_processor(ws, cpu_index);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    sc = rtems_scheduler_add_processor(prio, cpu_index);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  sc = rtems_task_set_scheduler(RTEMS_SELF, prio, TASK_PRIORITY);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_scheduler_remove_processor(ws, 0);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_scheduler_add_processor(prio, 0);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void test(void)
+{
+  test_context *ctx = &test_instance;
+
+  test_idle_processor_steals();
+  test_idle_processor_steals_from_other_queue();
+
+  printf("<SMPSchedWS01>\n");
+
+  rtems_test_parallel(
+    &ctx->base,
+    NULL,
+    &work_stealing_jobs[0],
+    RTEMS_ARRAY_SIZE(work_stealing_jobs)
+  );
+
+  if (rtems_get_processor_count() >= 2) {
+    move_processors_to_priority_scheduler();
+
+    rtems_test_parallel(
+      &ctx->base,
+      NULL,
+      &priority_jobs[0],
+      RTEMS_ARRAY_SIZE(priority_jobs)
+    );
+  }
+
+  printf("</SMPSchedWS01>\n");
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_PROCESSORS CPU_COUNT
+
+#define CONFIGURE_SCHEDULER_WORK_STEALING_SMP
+
+#define CONFIGURE_SCHEDULER_PRIORITY_SMP
+
+#include <rtems/scheduler.h>
+
+RTEMS_SCHEDULER_WORK_STEALING_SMP(a, CONFIGURE_MAXIMUM_PROCESSORS);
+
+RTEMS_SCHEDULER_PRIORITY_SMP(b, 256);
+
+#define CONFIGURE_SCHEDULER_TABLE_ENTRIES \
+  RTEMS_SCHEDULER_TABLE_WORK_STEALING_SMP(a, SCHED_WS), \
+  RTEMS_SCHEDULER_TABLE_PRIORITY_SMP(b, SCHED_PRIO)
+
+#define CONFIGURE_SCHEDULER_ASSIGNMENTS \
+  RTEMS_SCHEDULER_ASSIGN(0, RTEMS_SCHEDULER_ASSIGN_PROCESSOR_MANDATORY), \
+  RTEMS_SCHEDULER_ASSIGN(0, RTEMS_SCHEDULER_ASSIGN_PROCESSOR_OPTIONAL), \
+  RTEMS_SCHEDULER_ASSIGN(0, RTEMS_SCHEDULER_ASSIGN_PROCESSOR_OPTIONAL), \
+  RTEMS_SCHEDULER_ASSIGN(0, RTEMS_SCHEDULER_ASSIGN_PROCESSOR_OPTIONAL)
+
+#define CONFIGURE_MAXIMUM_TASKS (2 * CPU_COUNT)
+
+#define CONFIGURE_MAXIMUM_TIMERS 1
+
+#define CONFIGURE_INIT_TASK_PRIORITY TASK_PRIORITY
+#define CONFIGURE_INIT_TASK_INITIAL_MODES RTEMS_DEFAULT_MODES
+#define CONFIGURE_INIT_TASK_ATTRIBUTES RTEMS_DEFAULT_ATTRIBUTES
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
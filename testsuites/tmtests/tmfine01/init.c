@@ -19,10 +19,13 @@
 #include "tmacros.h"
 
 #include <sys/lock.h>
+#include <sys/stat.h>
+#include <fcntl.h>
 #include <inttypes.h>
 #include <pthread.h>
 #include <sched.h>
 #include <stdio.h>
+#include <unistd.h>
 
 #include <rtems/test.h>
 
@@ -36,6 +39,8 @@ const char rtems_test_name[] = "TMFINE 1";
 
 #define MSG_COUNT 3
 
+#define FD_COUNT 64
+
 typedef struct {
   uint32_t value;
 } test_msg;
@@ -52,11 +57,16 @@ typedef struct {
   uint32_t self_msg_ops[CPU_COUNT][CPU_COUNT];
   uint32_t many_to_one_msg_ops[CPU_COUNT][CPU_COUNT];
   uint32_t many_sys_lock_mutex_ops[CPU_COUNT][CPU_COUNT];
+  uint32_t many_sys_lock_recursive_mutex_ops[CPU_COUNT][CPU_COUNT];
+  uint32_t many_sys_lock_semaphore_ops[CPU_COUNT][CPU_COUNT];
+  uint32_t many_sys_lock_condition_ops[CPU_COUNT][CPU_COUNT];
   uint32_t many_classic_ceiling_ops[CPU_COUNT][CPU_COUNT];
   uint32_t many_classic_mrsp_ops[CPU_COUNT][CPU_COUNT];
   uint32_t many_pthread_spinlock_ops[CPU_COUNT][CPU_COUNT];
   uint32_t many_pthread_mutex_inherit_ops[CPU_COUNT][CPU_COUNT];
   uint32_t many_pthread_mutex_protect_ops[CPU_COUNT][CPU_COUNT];
+  uint32_t many_open_close_ops[CPU_COUNT][CPU_COUNT];
+  int fds[FD_COUNT];
 } test_context;
 
 static test_context test_instance;
@@ -432,6 +442,124 @@ static void test_many_sys_lock_mutex_fini(
   );
 }
 
+static void test_many_sys_lock_recursive_mutex_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+  struct _Mutex_recursive_Control mtx;
+  uint32_t counter = 0;
+
+  _Mutex_recursive_Initialize(&mtx);
+
+  while (!rtems_test_parallel_stop_job(&ctx->base)) {
+    ++counter;
+
+    _Mutex_recursive_Acquire(&mtx);
+    _Mutex_recursive_Release(&mtx);
+  }
+
+  ctx->many_sys_lock_recursive_mutex_ops[active_workers - 1][worker_index] =
+    counter;
+}
+
+static void test_many_sys_lock_recursive_mutex_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  test_fini(
+    "ManySysLockRecursiveMutex",
+    &ctx->many_sys_lock_recursive_mutex_ops[active_workers - 1][0],
+    active_workers
+  );
+}
+
+static void test_many_sys_lock_semaphore_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+  struct _Semaphore_Control sem;
+  uint32_t counter = 0;
+
+  _Semaphore_Initialize(&sem, 1);
+
+  while (!rtems_test_parallel_stop_job(&ctx->base)) {
+    ++counter;
+
+    _Semaphore_Wait(&sem);
+    _Semaphore_Post(&sem);
+  }
+
+  ctx->many_sys_lock_semaphore_ops[active_workers - 1][worker_index] = counter;
+}
+
+static void test_many_sys_lock_semaphore_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  test_fini(
+    "ManySysLockSemaphore",
+    &ctx->many_sys_lock_semaphore_ops[active_workers - 1][0],
+    active_workers
+  );
+}
+
+static void test_many_sys_lock_condition_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+  struct _Mutex_Control mtx;
+  struct _Condition_Control cond;
+  uint32_t counter = 0;
+
+  _Mutex_Initialize(&mtx);
+  _Condition_Initialize(&cond);
+
+  while (!rtems_test_parallel_stop_job(&ctx->base)) {
+    ++counter;
+
+    _Mutex_Acquire(&mtx);
+    _Condition_Signal(&cond);
+    _Mutex_Release(&mtx);
+  }
+
+  ctx->many_sys_lock_condition_ops[active_workers - 1][worker_index] = counter;
+}
+
+static void test_many_sys_lock_condition_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  test_fini(
+    "ManySysLockCondition",
+    &ctx->many_sys_lock_condition_ops[active_workers - 1][0],
+    active_workers
+  );
+}
+
 static void test_many_classic_ceiling_body(
   rtems_test_parallel_context *base,
   void *arg,
@@ -697,6 +825,47 @@ static void test_many_pthread_mutex_protect_fini(
   );
 }
 
+static void test_many_open_close_body(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers,
+  size_t worker_index
+)
+{
+  test_context *ctx = (test_context *) base;
+  uint32_t counter = 0;
+
+  while (!rtems_test_parallel_stop_job(&ctx->base)) {
+    int fd;
+    int rv;
+
+    ++counter;
+
+    fd = open("/", O_RDONLY);
+    rtems_test_assert(fd >= 0);
+
+    rv = close(fd);
+    rtems_test_assert(rv == 0);
+  }
+
+  ctx->many_open_close_ops[active_workers - 1][worker_index] = counter;
+}
+
+static void test_many_open_close_fini(
+  rtems_test_parallel_context *base,
+  void *arg,
+  size_t active_workers
+)
+{
+  test_context *ctx = (test_context *) base;
+
+  test_fini(
+    "ManyOpenClose",
+    &ctx->many_open_close_ops[active_workers - 1][0],
+    active_workers
+  );
+}
+
 static const rtems_test_parallel_job test_jobs[] = {
   {
     .init = test_init,
@@ -733,6 +902,21 @@ static const rtems_test_parallel_job test_jobs[] = {
     .body = test_many_sys_lock_mutex_body,
     .fini = test_many_sys_lock_mutex_fini,
     .cascade = true
+  }, {
+    .init = test_init,
+    .body = test_many_sys_lock_recursive_mutex_body,
+    .fini = test_many_sys_lock_recursive_mutex_fini,
+    .cascade = true
+  }, {
+    .init = test_init,
+    .body = test_many_sys_lock_semaphore_body,
+    .fini = test_many_sys_lock_semaphore_fini,
+    .cascade = true
+  }, {
+    .init = test_init,
+    .body = test_many_sys_lock_condition_body,
+    .fini = test_many_sys_lock_condition_fini,
+    .cascade = true
   }, {
     .init = test_init,
     .body = test_many_classic_ceiling_body,
@@ -758,9 +942,39 @@ static const rtems_test_parallel_job test_jobs[] = {
     .body = test_many_pthread_mutex_protect_body,
     .fini = test_many_pthread_mutex_protect_fini,
     .cascade = true
+  }, {
+    .init = test_init,
+    .body = test_many_open_close_body,
+    .fini = test_many_open_close_fini,
+    .cascade = true
   }
 };
 
+static void test_fd_table_extension(test_context *ctx)
+{
+  size_t i;
+
+  /* The file descriptors 0, 1, and 2 are used by the console */
+  for (i = 0; i < FD_COUNT; ++i) {
+    ctx->fds[i] = open("/", O_RDONLY);
+    rtems_test_assert(ctx->fds[i] == (int) (3 + i));
+  }
+
+  rtems_test_assert(sysconf(_SC_OPEN_MAX) >= 3 + FD_COUNT);
+
+  for (i = 0; i < FD_COUNT; ++i) {
+    struct stat st;
+    int rv;
+
+    rv = fstat(ctx->fds[i], &st);
+    rtems_test_assert(rv == 0);
+    rtems_test_assert(S_ISDIR(st.st_mode));
+
+    rv = close(ctx->fds[i]);
+    rtems_test_assert(rv == 0);
+  }
+}
+
 static void Init(rtems_task_argument arg)
 {
   test_context *ctx = &test_instance;
@@ -792,6 +1006,8 @@ static void Init(rtems_task_argument arg)
     rtems_test_assert(sc == RTEMS_SUCCESSFUL);
   }
 
+  test_fd_table_extension(ctx);
+
   printf("<%s>\n", test);
 
   rtems_test_parallel(
@@ -810,6 +1026,10 @@ static void Init(rtems_task_argument arg)
 #define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
 #define CONFIGURE_APPLICATION_NEEDS_SIMPLE_CONSOLE_DRIVER
 
+#define CONFIGURE_UNIFIED_WORK_AREAS
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS rtems_resource_unlimited(4)
+
 #define CONFIGURE_MAXIMUM_TASKS CPU_COUNT
 
 #define CONFIGURE_MAXIMUM_TIMERS 1